@@ -22,6 +22,7 @@
 #include <string>
 #include <functional>
 #include <cav_srvs/PlanManeuvers.h>
+#include <planning_trace/tracer.h>
 
 namespace arbitrator 
 {
@@ -34,7 +35,13 @@ namespace arbitrator
         {
             ros::ServiceClient sc = nh_->serviceClient<cav_srvs::PlanManeuvers>(*i);
             ROS_DEBUG_STREAM("found client: " << *i);
-            if (sc.call(msg)) {
+            bool call_succeeded = false;
+            {
+                // Strategic plugins are timed from the arbitrator as the call blocks until the plugin has planned
+                planning_trace::ScopedSpan plugin_span("strategic/" + *i, "");
+                call_succeeded = sc.call(msg);
+            }
+            if (call_succeeded) {
                 responses.emplace(*i, msg);
             }
         }
@@ -19,6 +19,7 @@
 #include <cav_srvs/PlanManeuvers.h>
 #include "arbitrator_utils.hpp"
 #include <ros/ros.h>
+#include <planning_trace/tracer.h>
 #include <exception>
 #include <cstdlib>
 
@@ -115,7 +116,10 @@ namespace arbitrator
     {
         ROS_INFO("Aribtrator beginning planning process!");
         ros::Time planning_process_start = ros::Time::now();
+        // The cycle is identified by the plan id, which is only known once the plan has been generated
+        planning_trace::CycleScope planning_cycle("arbitrator/planning_cycle");
         cav_msgs::ManeuverPlan plan = planning_strategy_.generate_plan(vehicle_state_);
+        planning_cycle.setCycleId(plan.maneuver_plan_id);
         if (!plan.maneuvers.empty()) 
         {
             ros::Time plan_end_time = arbitrator_utils::get_plan_end_time(plan);
@@ -183,6 +187,7 @@ namespace arbitrator
         // If the route is available then set the downtrack and lane id
         if (wm_->getRoute()) {
 
+            planning_trace::ScopedSpan wm_query_span("arbitrator/world_model_query");
             vehicle_state_.downtrack = wm_->routeTrackPos( { vehicle_state_.x, vehicle_state_.y } ).downtrack;
 
             auto lanelets = wm_->getLaneletsBetween(vehicle_state_.downtrack, vehicle_state_.downtrack, true);
@@ -19,6 +19,7 @@
 #include <string>
 #include <carma_wm/WorldModel.h>
 #include <carma_wm/WMListener.h>
+#include <planning_trace/trace_reporter.h>
 #include "arbitrator.hpp"
 #include "arbitrator_state_machine.hpp"
 #include "cost_system_cost_function.hpp"
@@ -33,6 +34,8 @@ int main(int argc, char** argv)
     ros::CARMANodeHandle nh = ros::CARMANodeHandle();
     ros::CARMANodeHandle pnh = ros::CARMANodeHandle("~");
 
+    planning_trace::TraceReporter trace_reporter{nh, pnh};
+
     // Handle dependency injection
     arbitrator::CapabilitiesInterface ci{&nh};
     arbitrator::ArbitratorStateMachine sm;
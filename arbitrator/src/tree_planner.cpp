@@ -19,11 +19,13 @@
 #include <vector>
 #include <map>
 #include <limits>
+#include <planning_trace/tracer.h>
 
 namespace arbitrator
 {
     cav_msgs::ManeuverPlan TreePlanner::generate_plan(const VehicleState& start_state) 
     {
+        planning_trace::ScopedSpan generate_plan_span("arbitrator/generate_plan");
         cav_msgs::ManeuverPlan root;
         std::vector<std::pair<cav_msgs::ManeuverPlan, double>> open_list;
         const double INF = std::numeric_limits<double>::infinity();
@@ -57,9 +59,14 @@ namespace arbitrator
                 }
 
                 // Expand it, and reprioritize
-                std::vector<cav_msgs::ManeuverPlan> children = neighbor_generator_.generate_neighbors(cur_plan, start_state);
+                std::vector<cav_msgs::ManeuverPlan> children;
+                {
+                    planning_trace::ScopedSpan neighbor_span("arbitrator/neighbor_generation");
+                    children = neighbor_generator_.generate_neighbors(cur_plan, start_state);
+                }
                 
                 // Compute cost for each child and store in open list
+                planning_trace::ScopedSpan cost_span("arbitrator/cost_evaluation");
                 for (auto child = children.begin(); child != children.end(); child++)
                 {
                     if (child->maneuvers.empty())
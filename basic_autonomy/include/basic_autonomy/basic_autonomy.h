@@ -57,6 +57,8 @@ namespace basic_autonomy
 {
     namespace waypoint_generation
     {
+        class TrajectoryGenerationEngine;
+
         struct PointSpeedPair
         {
             lanelet::BasicPoint2d point;
@@ -128,6 +130,8 @@ namespace basic_autonomy
         /**
    * \brief Applies the longitudinal acceleration limit to each point's speed
    * 
+   * Runs one backward deceleration pass and one forward acceleration pass from basic_autonomy::speed_profile, so the cost is linear in the number of points.
+   * 
    * \param downtracks downtrack distances corresponding to each speed
    * \param curv_speeds vehicle velocity in m/s.
    * \param accel_limit vehicle longitudinal acceleration in m/s^2.
@@ -193,12 +197,13 @@ namespace basic_autonomy
       * \param state The vehicle state at the time the function is called
       * \param general_config Basic autonomy struct defined to load general config parameters from tactical plugins
       * \param detailed_config Basic autonomy struct defined to load detailed config parameters from tactical plugins
+      * \param engine Optional trajectory generation engine used to reuse lanelet and centerline data from previous calls
       * \return A vector of point speed pair struct which contains geometry points as basicpoint::lanelet2d and speed as a double for the maneuver
       */
      std::vector<PointSpeedPair> create_geometry_profile(const std::vector<cav_msgs::Maneuver> &maneuvers, double max_starting_downtrack, const carma_wm::WorldModelConstPtr &wm,
                                                                    cav_msgs::VehicleState &ending_state_before_buffer,
                                                                     const cav_msgs::VehicleState& state,const GeneralTrajConfig &general_config,
-                                                                   const DetailedTrajConfig &detailed_config);
+                                                                   const DetailedTrajConfig &detailed_config, TrajectoryGenerationEngine* engine = nullptr);
         /**
      * \brief Converts a set of requested LANE_FOLLOWING maneuvers to point speed limit pairs. 
      * \param maneuvers The list of maneuvers to convert geometry points and calculate associated speed
@@ -208,12 +213,14 @@ namespace basic_autonomy
      * \param ending_state_before_buffer reference to Vehicle state, which is state before applying extra points for curvature calculation that are removed later
      * \param general_config Basic autonomy struct defined to load general config parameters from tactical plugins
      * \param detailed_config Basic autonomy struct defined to load detailed config parameters from tactical plugins
+     * \param engine Optional trajectory generation engine used to reuse lanelet and centerline data from previous calls
      * 
      * \return List of centerline points paired with speed limits
      */
           std::vector<PointSpeedPair> create_lanefollow_geometry(const cav_msgs::Maneuver &maneuver, double max_starting_downtrack,
                                                                    const carma_wm::WorldModelConstPtr &wm, cav_msgs::VehicleState &ending_state_before_buffer,
-                                                                   const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id>& visited_lanelets);
+                                                                   const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id>& visited_lanelets,
+                                                                   TrajectoryGenerationEngine* engine = nullptr);
 
      /**
       * \brief Adds extra centerline points beyond required message length to lane follow maneuver points so that there's always enough points to calculate trajectory
@@ -235,6 +242,7 @@ namespace basic_autonomy
      *               These points must be in the same lane as the vehicle and must extend in front of it though it is fine if they also extend behind it. 
      * \param state The current state of the vehicle
      * \param state_time The abosolute time which the provided vehicle state corresponds to
+     * \param engine Optional trajectory generation engine used to reuse spline fits from previous calls
      * 
      * \return A list of trajectory points to send to the carma planning stack
      */
@@ -242,7 +250,7 @@ namespace basic_autonomy
         compose_lanefollow_trajectory_from_path(const std::vector<PointSpeedPair> &points, const cav_msgs::VehicleState &state,
                                                       const ros::Time &state_time, const carma_wm::WorldModelConstPtr &wm, 
                                                       const cav_msgs::VehicleState &ending_state_before_buffer, carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg,
-                                                      const DetailedTrajConfig &detailed_config);
+                                                      const DetailedTrajConfig &detailed_config, TrajectoryGenerationEngine* engine = nullptr);
 
      //Functions specific to lane change
      /**
@@ -57,6 +57,16 @@ namespace waypoint_generation
      */
     int get_nearest_index_by_downtrack(const std::vector<lanelet::BasicPoint2d>& points, const carma_wm::WorldModelConstPtr& wm, double target_downtrack);
 
+    /**
+     * \brief Overload: Returns the nearest "less than" index to the target downtrack given the already computed route downtracks of each point
+     * 
+     * \param downtracks Route downtrack of each point
+     * \param target_downtrack target downtrack along the route to get index near to
+     * 
+     * \return index of nearest point in downtracks
+     */
+    int get_nearest_index_by_downtrack(const std::vector<double>& downtracks, double target_downtrack);
+
     /**
      * \brief Helper method to split a list of PointSpeedPair into separate point and speed lists 
      * \param points Point Speed pair to split
@@ -1,7 +1,7 @@
 #pragma once
 
 /*
- * Copyright (C) 2019-2021 LEIDOS.
+ * Copyright (C) 2019-2022 LEIDOS.
  *
  * Licensed under the Apache License, Version 2.0 (the "License"); you may not
  * use this file except in compliance with the License. You may obtain a copy of
@@ -25,16 +25,73 @@ namespace basic_autonomy
 namespace smoothing
 {
 
+/**
+ * The filters below operate on contiguous arrays of count values. The output array may be the same as the
+ * input array to filter in place. Apart from the Savitzky-Golay filter when run in place, they do not allocate
+ * memory proportional to the input size and each run in O(N) independent of the window size.
+ */
+
+/**
+ * \brief Centered moving average filter computed with a running sum
+ *
+ * Each output is the average of the input values within window_size / 2 points on either side. The window
+ * is truncated at the ends of the input.
+ *
+ * \param input The values to be filtered
+ * \param output Array of count values which will be set to the filtered values. May be the same as input
+ * \param count The number of values
+ * \param window_size The number of points to use in the moving window for averaging. Must be odd
+ * \param ignore_first_point If true the first value is copied unfiltered
+ */
+void moving_average(const double* input, double* output, size_t count, int window_size, bool ignore_first_point = true);
+
+/**
+ * \brief Trailing moving average filter computed with a running sum
+ *
+ * Each output is the average of that input and up to window_size - 1 preceding inputs.
+ *
+ * \param input The values to be filtered
+ * \param output Array of count values which will be set to the filtered values. May be the same as input
+ * \param count The number of values
+ * \param window_size The number of points to use in the moving window for averaging
+ */
+void trailing_moving_average(const double* input, double* output, size_t count, int window_size);
+
+/**
+ * \brief Exponential moving average where output[i] = alpha * input[i] + (1 - alpha) * output[i - 1]
+ *
+ * \param input The values to be filtered
+ * \param output Array of count values which will be set to the filtered values. May be the same as input
+ * \param count The number of values
+ * \param alpha Smoothing factor in the range (0, 1]. Smaller values smooth more
+ */
+void exponential_filter(const double* input, double* output, size_t count, double alpha);
+
+/**
+ * \brief Savitzky-Golay filter which fits a polynomial to each window by least squares
+ *
+ * Unlike a moving average this preserves the height of peaks, such as the curvature at the apex of a turn.
+ * Points within window_size / 2 of the ends are evaluated on the polynomial fit to the first or last full window.
+ * If there are fewer values than window_size the window is reduced to the largest odd size which fits.
+ *
+ * \param input The values to be filtered
+ * \param output Array of count values which will be set to the filtered values. May be the same as input
+ * \param count The number of values
+ * \param window_size The number of points in each fit. Must be odd
+ * \param polynomial_order The order of the fit polynomial. Must be less than window_size
+ */
+void savitzky_golay_filter(const double* input, double* output, size_t count, int window_size, int polynomial_order);
 
 /**
  * \brief Extremely simplie moving average filter
  * 
  * \param input The points to be filtered
  * \param window_size The number of points to use in the moving window for averaging
+ * \param ignore_first_point If true the first point is not filtered
  * 
  * \return The filterted points
  */
-std::vector<double> moving_average_filter(const std::vector<double> input, int window_size, bool ignore_first_point=true);
+std::vector<double> moving_average_filter(const std::vector<double>& input, int window_size, bool ignore_first_point=true);
 
 };  // namespace smoothing
-};  // namespace basic_autonomy
\ No newline at end of file
+};  // namespace basic_autonomy
@@ -0,0 +1,94 @@
+#pragma once
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstddef>
+#include <limits>
+
+namespace basic_autonomy
+{
+    namespace speed_profile
+    {
+        /**
+         * \brief Constraints applied by the speed profile passes
+         */
+        struct SpeedProfileLimits
+        {
+            double max_accel = 0.0;            // Longitudinal acceleration limit in m/s^2. Must be positive
+            double max_decel = 0.0;            // Longitudinal deceleration limit in m/s^2. Must be positive
+            double lateral_accel_limit = 0.0;  // Lateral acceleration limit in m/s^2. Values <= 0 disable the curvature constraint
+            double speed_limit = std::numeric_limits<double>::infinity(); // Speed cap applied to every point in m/s
+            double max_jerk = 0.0;             // Limit on the growth of acceleration in m/s^3. Values <= 0 disable the jerk constraint
+        };
+
+        /**
+         * \brief Caps each speed by the speed limits and by the lateral acceleration limit for its curvature.
+         * The first point is the current vehicle state and is left unchanged.
+         *
+         * \param curvatures Curvature at each point in 1/m. May be nullptr to skip the lateral constraint
+         * \param speed_limits Speed limit at each point in m/s. May be nullptr to use only limits.speed_limit
+         * \param speeds Speeds in m/s which are modified in place
+         * \param count The number of points
+         * \param limits The constraints to apply
+         */
+        void apply_point_limits(const double *curvatures, const double *speed_limits, double *speeds, size_t count,
+                                const SpeedProfileLimits &limits);
+
+        /**
+         * \brief Reduces speeds walking backwards from the end so that each point can be slowed to the next at max_decel.
+         * A point is only reduced if it is faster than the following point. The first point is left unchanged.
+         *
+         * \param downtracks Downtrack distance of each point in m
+         * \param speeds Speeds in m/s which are modified in place
+         * \param count The number of points
+         * \param max_decel Deceleration limit in m/s^2
+         */
+        void backward_decel_pass(const double *downtracks, double *speeds, size_t count, double max_decel);
+
+        /**
+         * \brief Walks forwards from the first point so that each point can be reached from the previous one.
+         * Speeds above what max_accel allows are reduced and speeds below what max_decel allows are raised,
+         * matching trajectory_utils::apply_accel_limits_by_distance. When max_jerk is positive the acceleration
+         * may only grow by max_jerk per second between segments.
+         *
+         * \param downtracks Downtrack distance of each point in m
+         * \param speeds Speeds in m/s which are modified in place
+         * \param count The number of points
+         * \param max_accel Acceleration limit in m/s^2
+         * \param max_decel Deceleration limit in m/s^2
+         * \param max_jerk Jerk limit in m/s^3. Values <= 0 disable the jerk constraint
+         */
+        void forward_accel_pass(const double *downtracks, double *speeds, size_t count, double max_accel, double max_decel,
+                                double max_jerk = 0.0);
+
+        /**
+         * \brief Computes a speed profile satisfying all of the provided constraints in O(N).
+         * Applies the point limits followed by the backward and forward passes.
+         *
+         * \param downtracks Downtrack distance of each point in m
+         * \param speeds Speeds in m/s which are modified in place. The first point should be the current vehicle speed
+         * \param count The number of points
+         * \param limits The constraints to apply
+         * \param curvatures Curvature at each point in 1/m. May be nullptr
+         * \param speed_limits Speed limit at each point in m/s. May be nullptr
+         *
+         * \throw std::invalid_argument if the acceleration or deceleration limits are not positive
+         */
+        void optimize(const double *downtracks, double *speeds, size_t count, const SpeedProfileLimits &limits,
+                      const double *curvatures = nullptr, const double *speed_limits = nullptr);
+
+    } // namespace speed_profile
+} // namespace basic_autonomy
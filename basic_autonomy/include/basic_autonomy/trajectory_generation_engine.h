@@ -0,0 +1,224 @@
+#pragma once
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <basic_autonomy/basic_autonomy.h>
+
+namespace basic_autonomy
+{
+    namespace waypoint_generation
+    {
+        /**
+         * \brief A spline fit through a set of curve points resampled at the configured step size
+         */
+        struct ResampledCurve
+        {
+            std::vector<lanelet::BasicPoint2d> sampling_points;
+            std::vector<double> raw_curvatures;   // Curvature of the spline at each sample in 1/m
+            std::vector<double> curvatures;       // raw_curvatures smoothed by the curvature moving average window
+            std::vector<double> yaws;             // Tangent orientation at each sample in radians
+            std::vector<size_t> speed_indices;    // Index of the curve point whose speed limit applies to each sample
+            std::vector<double> route_downtracks; // Route downtrack of each sample. Only filled by TrajectoryGenerationEngine
+        };
+
+        /**
+         * \brief Fits a spline through the provided points and resamples it at detailed_config.curve_resample_step_size
+         *
+         * \param curve_points The points to fit. At least 4 are required
+         * \param detailed_config Supplies the resample step size and the curvature moving average window size
+         *
+         * \throws std::invalid_argument if no spline could be fit
+         *
+         * \return The resampled curve. route_downtracks is left empty
+         */
+        ResampledCurve resample_curve(const std::vector<lanelet::BasicPoint2d> &curve_points, const DetailedTrajConfig &detailed_config);
+
+        /**
+         * \brief Stateful trajectory generation which reuses work between consecutive planning requests.
+         *
+         * Consecutive plans from a tactical plugin cover largely the same stretch of road, so the engine keeps
+         *  - a horizon of shortest path lanelets with their downtrack extents, replacing the full map scan of getLaneletsBetween.
+         *    It is extended as queries reach further along the route and trimmed behind the vehicle
+         *  - the following lanelets and the downsampled centerlines of the lanelets in the horizon
+         *  - the most recent spline fits, with their curvature, yaw and route downtrack profiles, keyed by their curve points
+         *
+         * By default only fits of identical windows are reused and the results are identical to the uncached functions in
+         * basic_autonomy.h. A positive fit_extension_points opts into also reusing partially matching fits: new splines then
+         * pass through that many path points after the requested window, and later windows which lie within the fitted points,
+         * as they do while the vehicle advances along the same path, are cut from the existing fit rather than refit. The cut
+         * samples follow the extended spline, so they can differ slightly from the uncached results near the end of the window.
+         *
+         * All cached data is tied to the route (pointer and name) and map update count of the world model and is discarded
+         * when any of them changes, including when a geofence updates the map in place.
+         * The engine is not thread safe. Each plugin should own its own instance.
+         */
+        class TrajectoryGenerationEngine
+        {
+        public:
+            /**
+             * \brief Cache counters which can be used to confirm reuse is occurring
+             */
+            struct Stats
+            {
+                size_t horizon_builds = 0;      // Times the horizon was started from the beginning of the route
+                size_t horizon_extensions = 0;  // Lanelets added to the horizon
+                size_t centerline_hits = 0;
+                size_t centerline_misses = 0;
+                size_t curve_hits = 0;       // Windows matching a previous fit exactly
+                size_t curve_span_hits = 0;  // Windows cut from a previous fit which covers them
+                size_t curve_misses = 0;
+            };
+
+            /**
+             * \brief Constructor
+             *
+             * \param max_cached_curves The number of distinct spline fits to retain. Plugins which alternate between several
+             *                          paths, such as a lane change and its fallback lane follow, benefit from a value above 1
+             * \param fit_extension_points The number of path points past the requested window included in each new fit so
+             *                             following windows can reuse it. 0 disables reuse of partially matching fits and
+             *                             keeps the output identical to the uncached functions
+             */
+            explicit TrajectoryGenerationEngine(size_t max_cached_curves = 4, size_t fit_extension_points = 0);
+
+            /**
+             * \brief Cached equivalent of create_geometry_profile
+             */
+            std::vector<PointSpeedPair> create_geometry_profile(const std::vector<cav_msgs::Maneuver> &maneuvers, double max_starting_downtrack,
+                                                                const carma_wm::WorldModelConstPtr &wm, cav_msgs::VehicleState &ending_state_before_buffer,
+                                                                const cav_msgs::VehicleState &state, const GeneralTrajConfig &general_config,
+                                                                const DetailedTrajConfig &detailed_config);
+
+            /**
+             * \brief Cached equivalent of create_lanefollow_geometry
+             */
+            std::vector<PointSpeedPair> create_lanefollow_geometry(const cav_msgs::Maneuver &maneuver, double max_starting_downtrack,
+                                                                   const carma_wm::WorldModelConstPtr &wm, cav_msgs::VehicleState &ending_state_before_buffer,
+                                                                   const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config,
+                                                                   std::unordered_set<lanelet::Id> &visited_lanelets);
+
+            /**
+             * \brief Cached equivalent of compose_lanefollow_trajectory_from_path
+             */
+            std::vector<cav_msgs::TrajectoryPlanPoint> compose_lanefollow_trajectory_from_path(
+                const std::vector<PointSpeedPair> &points, const cav_msgs::VehicleState &state, const ros::Time &state_time,
+                const carma_wm::WorldModelConstPtr &wm, const cav_msgs::VehicleState &ending_state_before_buffer,
+                carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg, const DetailedTrajConfig &detailed_config);
+
+            /**
+             * \brief Equivalent of wm->getLaneletsBetween(start, end, true, true) using the cached route lanelet extents.
+             * The horizon is extended to end and lanelets ending before start are trimmed from it
+             *
+             * \throws std::invalid_argument if the route has not been loaded or start is greater than end
+             */
+            std::vector<lanelet::ConstLanelet> getLaneletsBetween(const carma_wm::WorldModelConstPtr &wm, double start, double end);
+
+            /**
+             * \brief Returns the lanelets which directly follow the provided lanelet in the routing graph
+             */
+            const lanelet::ConstLanelets &following(const carma_wm::WorldModelConstPtr &wm, const lanelet::ConstLanelet &lanelet);
+
+            /**
+             * \brief Returns the centerline of the provided lanelet keeping every downsample_ratio'th point
+             */
+            const lanelet::BasicLineString2d &downsampledCenterline(const carma_wm::WorldModelConstPtr &wm, const lanelet::ConstLanelet &lanelet,
+                                                                    int downsample_ratio);
+
+            /**
+             * \brief Returns the resample_curve result for path_points[window_begin, window_end) with route_downtracks filled.
+             * A previous fit is reused if its points contain the window and the configuration matches
+             *
+             * \param path_points The full path the window is taken from. Points past the window extend new fits
+             * \param window_begin Index of the first point of the window
+             * \param window_end Index past the last point of the window
+             * \param detailed_config Supplies the resample step size and the curvature moving average window size
+             *
+             * \throws std::invalid_argument if no spline could be fit
+             */
+            std::shared_ptr<const ResampledCurve> resampleCurve(const carma_wm::WorldModelConstPtr &wm, const std::vector<lanelet::BasicPoint2d> &path_points,
+                                                                size_t window_begin, size_t window_end, const DetailedTrajConfig &detailed_config);
+
+            /**
+             * \brief Discards all cached data
+             */
+            void clear();
+
+            /**
+             * \brief Returns the cache counters accumulated since construction
+             */
+            Stats getStats() const;
+
+        private:
+            struct RouteLanelet
+            {
+                lanelet::ConstLanelet lanelet;
+                double min_downtrack = 0;
+                double max_downtrack = 0;
+            };
+
+            struct CurveEntry
+            {
+                std::vector<lanelet::BasicPoint2d> curve_points;
+                std::vector<double> point_downtracks; // Route downtrack of each curve point
+                double curve_resample_step_size = 0;
+                int curvature_moving_average_window_size = 0;
+                std::shared_ptr<const ResampledCurve> curve;
+            };
+
+            /**
+             * \brief Discards cached data if the route or map of the world model has changed since the last call
+             */
+            void sync(const carma_wm::WorldModelConstPtr &wm);
+
+            /**
+             * \brief Extends the horizon until it covers end and trims the lanelets which end before start.
+             * Restarts the horizon from the beginning of the route if start lies within the trimmed part
+             */
+            void updateHorizon(const carma_wm::WorldModelConstPtr &wm, double start, double end);
+
+            /**
+             * \brief Cuts the samples between the first and last window point from a fit whose curve points contain the window
+             * at offset. Returns nullptr if fewer than two samples lie in the window
+             */
+            std::shared_ptr<const ResampledCurve> cutWindow(const CurveEntry &entry, size_t offset, size_t window_size) const;
+
+            size_t max_cached_curves_;
+            size_t fit_extension_points_;
+
+            // Cache key. The route is held so its address cannot be reused by a new route
+            carma_wm::LaneletRouteConstPtr route_;
+            std::string route_name_;
+            size_t map_update_count_ = 0;
+
+            bool horizon_valid_ = false;
+            std::deque<RouteLanelet> horizon_; // Consecutive shortest path lanelets in route order
+            size_t horizon_begin_ = 0; // Shortest path index of the first horizon lanelet
+            double trimmed_downtrack_ = -std::numeric_limits<double>::infinity(); // Greatest max_downtrack of the trimmed lanelets
+            std::unordered_map<lanelet::Id, lanelet::ConstLanelets> following_;
+            std::map<std::pair<lanelet::Id, int>, lanelet::BasicLineString2d> centerlines_;
+            std::deque<CurveEntry> curves_; // Most recently used first
+
+            Stats stats_;
+        };
+
+    }
+}
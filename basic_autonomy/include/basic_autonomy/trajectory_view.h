@@ -0,0 +1,95 @@
+#pragma once
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstddef>
+#include <vector>
+#include <cav_msgs/TrajectoryPlan.h>
+
+namespace basic_autonomy
+{
+    /**
+     * \brief Read only view of a trajectory plan with the per point profiles needed by the trajectory controllers.
+     *
+     * Points which repeat the target_time of the preceding kept point are skipped, matching the duplicate removal the
+     * controllers apply before computing speeds. The remaining points are referenced in place and their cumulative
+     * downtrack, relative time and speed are computed once on construction, so every consumer of a plan reads the same
+     * profiles without copying the points or recomputing them.
+     *
+     * Downtracks, times and speeds match trajectory_utils::conversions::trajectory_to_downtrack_time and time_to_speed
+     * applied to the kept points, with speeds clamped to be no less than 0.
+     *
+     * The view references the plan it was built from, which must outlive it.
+     */
+    class TrajectoryView
+    {
+    public:
+        /**
+         * \brief Builds the view of a plan
+         *
+         * \param plan The plan to view. The initial_longitudinal_velocity is used as the speed of the first point
+         */
+        explicit TrajectoryView(const cav_msgs::TrajectoryPlan &plan);
+
+        /**
+         * \brief Returns the plan this view references
+         */
+        const cav_msgs::TrajectoryPlan &plan() const;
+
+        /**
+         * \brief Number of kept points
+         */
+        size_t size() const;
+
+        /**
+         * \brief True if the plan contains no points
+         */
+        bool empty() const;
+
+        /**
+         * \brief Returns the i'th kept point
+         */
+        const cav_msgs::TrajectoryPlanPoint &point(size_t i) const;
+
+        /**
+         * \brief Returns the index in plan().trajectory_points of the i'th kept point
+         */
+        size_t plan_index(size_t i) const;
+
+        /**
+         * \brief Cumulative 2d distance along the kept points in m. The first value is 0
+         */
+        const std::vector<double> &downtracks() const;
+
+        /**
+         * \brief Time of each kept point relative to the first point in s
+         */
+        const std::vector<double> &times() const;
+
+        /**
+         * \brief Speed at each kept point in m/s. The first value is the plan's initial_longitudinal_velocity
+         */
+        const std::vector<double> &speeds() const;
+
+    private:
+        const cav_msgs::TrajectoryPlan *plan_;
+        std::vector<size_t> indices_;
+        std::vector<double> downtracks_;
+        std::vector<double> times_;
+        std::vector<double> speeds_;
+    };
+
+} // namespace basic_autonomy
@@ -16,6 +16,8 @@
 
 #include <basic_autonomy/log/log.h>
 #include <basic_autonomy/helper_functions.h>
+#include <basic_autonomy/speed_profile.h>
+#include <basic_autonomy/trajectory_generation_engine.h>
 
 namespace basic_autonomy
 {
@@ -23,7 +25,8 @@ namespace basic_autonomy
     {
          std::vector<PointSpeedPair> create_geometry_profile(const std::vector<cav_msgs::Maneuver> &maneuvers, double max_starting_downtrack,const carma_wm::WorldModelConstPtr &wm,
                                                                    cav_msgs::VehicleState &ending_state_before_buffer,const cav_msgs::VehicleState& state,
-                                                                   const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config){
+                                                                   const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config,
+                                                                   TrajectoryGenerationEngine* engine){
             std::vector<PointSpeedPair> points_and_target_speeds;
             
             bool first = true;
@@ -42,7 +45,7 @@ namespace basic_autonomy
 
                 if(maneuver.type == cav_msgs::Maneuver::LANE_FOLLOWING){
                     ROS_DEBUG_STREAM("Creating Lane Follow Geometry");
-                    std::vector<PointSpeedPair> lane_follow_points = create_lanefollow_geometry(maneuver, starting_downtrack, wm, ending_state_before_buffer, general_config, detailed_config, visited_lanelets);
+                    std::vector<PointSpeedPair> lane_follow_points = create_lanefollow_geometry(maneuver, starting_downtrack, wm, ending_state_before_buffer, general_config, detailed_config, visited_lanelets, engine);
                     points_and_target_speeds.insert(points_and_target_speeds.end(), lane_follow_points.begin(), lane_follow_points.end());
                 }
                 else if(maneuver.type == cav_msgs::Maneuver::LANE_CHANGE){
@@ -67,7 +70,8 @@ namespace basic_autonomy
 
         std::vector<PointSpeedPair> create_lanefollow_geometry(const cav_msgs::Maneuver &maneuver, double starting_downtrack,
                                                                 const carma_wm::WorldModelConstPtr &wm, cav_msgs::VehicleState &ending_state_before_buffer,
-                                                                const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id> &visited_lanelets)
+                                                                const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id> &visited_lanelets,
+                                                                TrajectoryGenerationEngine* engine)
         {
             if(maneuver.type != cav_msgs::Maneuver::LANE_FOLLOWING){
                 throw std::invalid_argument("Create_lanefollow called on a maneuver type which is not LANE_FOLLOW");
@@ -76,7 +80,13 @@ namespace basic_autonomy
 
             cav_msgs::LaneFollowingManeuver lane_following_maneuver = maneuver.lane_following_maneuver;
             
-            auto lanelets = wm->getLaneletsBetween(starting_downtrack, lane_following_maneuver.end_dist + detailed_config.buffer_ending_downtrack, true, true);
+            double ending_downtrack = lane_following_maneuver.end_dist + detailed_config.buffer_ending_downtrack;
+            auto lanelets = engine ? engine->getLaneletsBetween(wm, starting_downtrack, ending_downtrack)
+                                   : wm->getLaneletsBetween(starting_downtrack, ending_downtrack, true, true);
+
+            auto following_of = [&wm, engine](const lanelet::ConstLanelet& llt) {
+                return engine ? engine->following(wm, llt) : wm->getMapRoutingGraph()->following(llt);
+            };
 
             if (lanelets.empty())
             {
@@ -95,7 +105,7 @@ namespace basic_autonomy
             //which may return lanechange lanelets, so
             //exclude lanechanges and plan for only the straight part
             int curr_idx = 0;
-            auto following_lanelets = wm->getMapRoutingGraph()->following(lanelets[curr_idx]);
+            auto following_lanelets = following_of(lanelets[curr_idx]);
             lanelet::ConstLanelets straight_lanelets;
 
             if(lanelets.size() <= 1) //no lane change anyways if only size 1
@@ -111,7 +121,7 @@ namespace basic_autonomy
                 {
                     ROS_DEBUG_STREAM("As there were no directly following lanelets after this, skipping lanelet id: " << lanelets[curr_idx].id());
                     curr_idx ++;
-                    following_lanelets = wm->getMapRoutingGraph()->following(lanelets[curr_idx]);
+                    following_lanelets = following_of(lanelets[curr_idx]);
                 }
 
                 ROS_DEBUG_STREAM("Added lanelet Id for lane follow: " << lanelets[curr_idx].id());
@@ -124,7 +134,7 @@ namespace basic_autonomy
                     curr_idx++;
                     ROS_DEBUG_STREAM("Added lanelet Id forlane follow: " << lanelets[curr_idx].id());
                     straight_lanelets.push_back(lanelets[curr_idx]);
-                    following_lanelets = wm->getMapRoutingGraph()->following(lanelets[curr_idx]);
+                    following_lanelets = following_of(lanelets[curr_idx]);
                 }
                 
             }
@@ -141,12 +151,12 @@ namespace basic_autonomy
                         is_turn = turn_direction.compare("left") == 0 || turn_direction.compare("right") == 0;
                     }
                     
-                    lanelet::BasicLineString2d centerline = l.centerline2d().basicLineString();
+                    int downsample_ratio = is_turn ? general_config.turn_downsample_ratio : general_config.default_downsample_ratio;
                     lanelet::BasicLineString2d downsampled_points;
-                    if (is_turn) {
-                        downsampled_points = carma_utils::containers::downsample_vector(centerline, general_config.turn_downsample_ratio);
+                    if (engine) {
+                        downsampled_points = engine->downsampledCenterline(wm, l, downsample_ratio);
                     } else {
-                        downsampled_points = carma_utils::containers::downsample_vector(centerline, general_config.default_downsample_ratio);
+                        downsampled_points = carma_utils::containers::downsample_vector(l.centerline2d().basicLineString(), downsample_ratio);
                     }
                     
                     if(downsampled_centerline.size() != 0 && downsampled_points.size() != 0 // If this is not the first lanelet and the points are closer than 1m drop the first point to prevent overlap
@@ -634,52 +644,13 @@ namespace basic_autonomy
                 throw std::invalid_argument("Accel limits should be positive");
             }
 
-            bool optimize = true;
-            std::unordered_set<size_t> visited_idx;
-            visited_idx.reserve(curv_speeds.size());
-
+            // The first point is the current vehicle speed and is left unchanged by both passes
             std::vector<double> output = curv_speeds;
 
-            while (optimize)
-            {
-                auto min_pair = min_with_exclusions(curv_speeds, visited_idx);
-                size_t min_idx = std::get<1>(min_pair);
-                if (min_idx == -1)
-                {
-                    break;
-                }
-
-                visited_idx.insert(min_idx); // Mark this point as visited
-
-                double v_i = std::get<0>(min_pair);
-                double x_i = downtracks[min_idx];
-                for (int i = min_idx - 1; i > 0; i--)
-                {   // NOTE: Do not use size_t for i type here as -- with > 0 will result in overflow
-                    //       First point's speed is left unchanged as it is current speed of the vehicle
-                    double v_f = curv_speeds[i];
-                    double dv = v_f - v_i;
-
-                    double x_f = downtracks[i];
-                    double dx = x_f - x_i;
-
-                    if (dv > 0)
-                    {
-                        v_f = std::min(v_f, sqrt(v_i * v_i - 2 * accel_limit * dx)); // inverting accel as we are only visiting deceleration case
-                        visited_idx.insert(i);
-                    }
-                    else if (dv < 0)
-                    {
-                        break;
-                    }
-                    output[i] = v_f;
-                    v_i = v_f;
-                    x_i = x_f;
-                }
-            }
-
+            speed_profile::backward_decel_pass(downtracks.data(), output.data(), output.size(), accel_limit);
             log::printDoublesPerLineWithPrefix("only_reverse[i]: ", output);
 
-            output = trajectory_utils::apply_accel_limits_by_distance(downtracks, output, accel_limit, accel_limit);
+            speed_profile::forward_accel_pass(downtracks.data(), output.data(), output.size(), accel_limit, accel_limit);
             log::printDoublesPerLineWithPrefix("after_forward[i]: ", output);
 
             return output;
@@ -768,7 +739,8 @@ namespace basic_autonomy
 
         std::vector<cav_msgs::TrajectoryPlanPoint> compose_lanefollow_trajectory_from_path(
             const std::vector<PointSpeedPair> &points, const cav_msgs::VehicleState &state, const ros::Time &state_time, const carma_wm::WorldModelConstPtr &wm,
-            const cav_msgs::VehicleState &ending_state_before_buffer, carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg, const DetailedTrajConfig &detailed_config)
+            const cav_msgs::VehicleState &ending_state_before_buffer, carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg, const DetailedTrajConfig &detailed_config,
+            TrajectoryGenerationEngine* engine)
         {
             ROS_DEBUG_STREAM("VehicleState: "
                              << " x: " << state.x_pos_global << " y: " << state.y_pos_global << " yaw: " << state.orientation
@@ -795,72 +767,52 @@ namespace basic_autonomy
             std::vector<lanelet::BasicPoint2d> curve_points;
             split_point_speed_pairs(back_and_future, &curve_points, &speed_limits);
 
-            std::unique_ptr<smoothing::SplineI> fit_curve = compute_fit(curve_points); // Compute splines based on curve points
-            if (!fit_curve)
+            std::shared_ptr<const ResampledCurve> curve;
+            if (engine)
             {
-                throw std::invalid_argument("Could not fit a spline curve along the given trajectory!");
+                // back_and_future is a contiguous run of points, ending after the time bound points
+                std::vector<lanelet::BasicPoint2d> path_points;
+                std::vector<double> path_speeds;
+                split_point_speed_pairs(points, &path_points, &path_speeds);
+                size_t window_end = nearest_pt_index + 1 + time_bound_points.size();
+                curve = engine->resampleCurve(wm, path_points, window_end - back_and_future.size(), window_end, detailed_config);
+            }
+            else
+            {
+                curve = std::make_shared<const ResampledCurve>(resample_curve(curve_points, detailed_config));
             }
-
-            ROS_DEBUG("Got fit");
 
             ROS_DEBUG_STREAM("speed_limits.size() " << speed_limits.size());
 
-            std::vector<lanelet::BasicPoint2d> all_sampling_points;
-            all_sampling_points.reserve(1 + curve_points.size() * 2);
+            const std::vector<lanelet::BasicPoint2d>& sampling_points = curve->sampling_points;
+            const std::vector<double>& better_curvature = curve->raw_curvatures;
+            const std::vector<double>& curvatures = curve->curvatures;
+            const std::vector<double>& yaws = curve->yaws;
 
             std::vector<double> distributed_speed_limits;
-            distributed_speed_limits.reserve(1 + curve_points.size() * 2);
-
-            // compute total length of the trajectory to get correct number of points
-            // we expect using curve_resample_step_size
-            std::vector<double> downtracks_raw = carma_wm::geometry::compute_arc_lengths(curve_points);
-
-            auto total_step_along_curve = static_cast<int>(downtracks_raw.back() / detailed_config.curve_resample_step_size);
-
-            int current_speed_index = 0;
-            size_t total_point_size = curve_points.size();
-
-            double step_threshold_for_next_speed = (double)total_step_along_curve / (double)total_point_size;
-            double scaled_steps_along_curve = 0.0; // from 0 (start) to 1 (end) for the whole trajectory
-            std::vector<double> better_curvature;
-            better_curvature.reserve(1 + curve_points.size() * 2);
-
-            for (size_t steps_along_curve = 0; steps_along_curve < total_step_along_curve; steps_along_curve++) // Resample curve at tighter resolution
+            distributed_speed_limits.reserve(curve->speed_indices.size());
+            for (size_t speed_index : curve->speed_indices)
             {
-                lanelet::BasicPoint2d p = (*fit_curve)(scaled_steps_along_curve);
-
-                all_sampling_points.push_back(p);
-                double c = compute_curvature_at((*fit_curve), scaled_steps_along_curve);
-                better_curvature.push_back(c);
-                if ((double)steps_along_curve > step_threshold_for_next_speed)
-                {
-                    step_threshold_for_next_speed += (double)total_step_along_curve / (double)total_point_size;
-                    current_speed_index++;
-                }
-                distributed_speed_limits.push_back(speed_limits[current_speed_index]); // Identify speed limits for resampled points
-                scaled_steps_along_curve += 1.0 / total_step_along_curve;              //adding steps_along_curve_step_size
+                distributed_speed_limits.push_back(speed_limits[speed_index]); // Identify speed limits for resampled points
             }
 
-            ROS_DEBUG_STREAM("Got sampled points with size:" << all_sampling_points.size());
-            log::printDebugPerLine(all_sampling_points, &log::basicPointToStream);
-
-            std::vector<double> final_yaw_values = carma_wm::geometry::compute_tangent_orientations(all_sampling_points);
+            ROS_DEBUG_STREAM("Got sampled points with size:" << sampling_points.size());
+            log::printDebugPerLine(sampling_points, &log::basicPointToStream);
 
             log::printDoublesPerLineWithPrefix("raw_curvatures[i]: ", better_curvature);
 
-            std::vector<double> curvatures = smoothing::moving_average_filter(better_curvature, detailed_config.curvature_moving_average_window_size, false);
             std::vector<double> ideal_speeds =
                 trajectory_utils::constrained_speeds_for_curvatures(curvatures, detailed_config.lateral_accel_limit);
 
             log::printDoublesPerLineWithPrefix("curvatures[i]: ", curvatures);
             log::printDoublesPerLineWithPrefix("ideal_speeds: ", ideal_speeds);
-            log::printDoublesPerLineWithPrefix("final_yaw_values[i]: ", final_yaw_values);
+            log::printDoublesPerLineWithPrefix("final_yaw_values[i]: ", yaws);
 
             std::vector<double> constrained_speed_limits = apply_speed_limits(ideal_speeds, distributed_speed_limits);
 
             ROS_DEBUG("Processed all points in computed fit");
 
-            if (all_sampling_points.empty())
+            if (sampling_points.empty())
             {
                 ROS_WARN_STREAM("No trajectory points could be generated");
                 return {};
@@ -868,14 +820,25 @@ namespace basic_autonomy
 
             // Add current vehicle point to front of the trajectory
 
-            nearest_pt_index = get_nearest_index_by_downtrack(all_sampling_points, wm, state);
+            int buffer_pt_index = 0;
+            if (engine)
+            {
+                // Route downtracks of the samples are cached with the fit so only the two states need to be projected
+                nearest_pt_index = get_nearest_index_by_downtrack(curve->route_downtracks, wm->routeTrackPos(lanelet::BasicPoint2d(state.x_pos_global, state.y_pos_global)).downtrack);
+                buffer_pt_index = get_nearest_index_by_downtrack(curve->route_downtracks,
+                                                                 wm->routeTrackPos(lanelet::BasicPoint2d(ending_state_before_buffer.x_pos_global, ending_state_before_buffer.y_pos_global)).downtrack);
+            }
+            else
+            {
+                nearest_pt_index = get_nearest_index_by_downtrack(sampling_points, wm, state);
+                buffer_pt_index = get_nearest_index_by_downtrack(sampling_points, wm, ending_state_before_buffer);
+            }
             ROS_DEBUG_STREAM("Current state's nearest_pt_index: " << nearest_pt_index);
             ROS_DEBUG_STREAM("Curvature right now: " << better_curvature[nearest_pt_index] << ", at state x: " << state.x_pos_global << ", state y: " << state.y_pos_global);
-            ROS_DEBUG_STREAM("Corresponding to point: x: " << all_sampling_points[nearest_pt_index].x() << ", y:" << all_sampling_points[nearest_pt_index].y());
+            ROS_DEBUG_STREAM("Corresponding to point: x: " << sampling_points[nearest_pt_index].x() << ", y:" << sampling_points[nearest_pt_index].y());
 
-            int buffer_pt_index = get_nearest_index_by_downtrack(all_sampling_points, wm, ending_state_before_buffer);
             ROS_DEBUG_STREAM("Ending state's index before applying buffer (buffer_pt_index): " << buffer_pt_index);
-            ROS_DEBUG_STREAM("Corresponding to point: x: " << all_sampling_points[buffer_pt_index].x() << ", y:" << all_sampling_points[buffer_pt_index].y());
+            ROS_DEBUG_STREAM("Corresponding to point: x: " << sampling_points[buffer_pt_index].x() << ", y:" << sampling_points[buffer_pt_index].y());
 
             if(nearest_pt_index + 1 >= buffer_pt_index){
                 ROS_WARN_STREAM("Current state is at or past the planned end distance. Couldn't generate trajectory");
@@ -884,16 +847,16 @@ namespace basic_autonomy
 
             //drop buffer points here
 
-             std::vector<lanelet::BasicPoint2d> future_basic_points(all_sampling_points.begin() + nearest_pt_index + 1,
-                                            all_sampling_points.begin()+ buffer_pt_index);  // Points in front of current vehicle position
+             std::vector<lanelet::BasicPoint2d> future_basic_points(sampling_points.begin() + nearest_pt_index + 1,
+                                            sampling_points.begin()+ buffer_pt_index);  // Points in front of current vehicle position
 
             std::vector<double> future_speeds(constrained_speed_limits.begin() + nearest_pt_index + 1,
                                                         constrained_speed_limits.begin() + buffer_pt_index);  // Points in front of current vehicle position
-            std::vector<double> future_yaw(final_yaw_values.begin() + nearest_pt_index + 1,
-                                                        final_yaw_values.begin() + buffer_pt_index);  // Points in front of current vehicle position
+            std::vector<double> future_yaw(yaws.begin() + nearest_pt_index + 1,
+                                                        yaws.begin() + buffer_pt_index);  // Points in front of current vehicle position
             std::vector<double>  final_actual_speeds = future_speeds;
-            all_sampling_points = future_basic_points;
-            final_yaw_values = future_yaw;
+            std::vector<lanelet::BasicPoint2d> all_sampling_points = future_basic_points;
+            std::vector<double> final_yaw_values = future_yaw;
             ROS_DEBUG_STREAM("Trimmed future points to size: "<< future_basic_points.size());
 
             lanelet::BasicPoint2d cur_veh_point(state.x_pos_global, state.y_pos_global);
@@ -913,7 +876,7 @@ namespace basic_autonomy
 
             log::printDoublesPerLineWithPrefix("postAccel[i]: ", final_actual_speeds);
 
-            final_actual_speeds = smoothing::moving_average_filter(final_actual_speeds, detailed_config.speed_moving_average_window_size);
+            smoothing::moving_average(final_actual_speeds.data(), final_actual_speeds.data(), final_actual_speeds.size(), detailed_config.speed_moving_average_window_size);
 
             log::printDoublesPerLineWithPrefix("post_average[i]: ", final_actual_speeds);
 
@@ -1038,7 +1001,7 @@ namespace basic_autonomy
             ROS_DEBUG_STREAM("Got sampled points with size:" << all_sampling_points.size());
 
             std::vector<double> final_yaw_values = carma_wm::geometry::compute_tangent_orientations(future_geom_points);
-            final_actual_speeds = smoothing::moving_average_filter(final_actual_speeds, detailed_config.speed_moving_average_window_size);
+            smoothing::moving_average(final_actual_speeds.data(), final_actual_speeds.data(), final_actual_speeds.size(), detailed_config.speed_moving_average_window_size);
 
             //Convert speeds to time
             std::vector<double> times;
@@ -80,6 +80,21 @@ namespace waypoint_generation
         return best_index;
     }
 
+    int get_nearest_index_by_downtrack(const std::vector<double>& downtracks, double target_downtrack)
+    {
+        int best_index = downtracks.size() - 1;
+        for(int i = 0;i < downtracks.size(); i++){
+            if(downtracks[i] > target_downtrack){
+                //If value is negative, best index should be index 0
+                best_index = std::max(0, i - 1);
+                break;
+            }
+        }
+        ROS_DEBUG_STREAM("get_nearest_index_by_downtrack>> Found best_idx: " << best_index);
+
+        return best_index;
+    }
+
     void split_point_speed_pairs(const std::vector<PointSpeedPair>& points,
                                                 std::vector<lanelet::BasicPoint2d>* basic_points,
                                                 std::vector<double>* speeds)
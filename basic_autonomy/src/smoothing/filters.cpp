@@ -1,6 +1,5 @@
-
 /*
- * Copyright (C) 2021 LEIDOS.
+ * Copyright (C) 2021-2022 LEIDOS.
  *
  * Licensed under the Apache License, Version 2.0 (the "License"); you may not
  * use this file except in compliance with the License. You may obtain a copy of
@@ -15,50 +14,240 @@
  * the License.
  */
 
+#include <Eigen/Dense>
 #include <basic_autonomy/smoothing/filters.h>
 namespace basic_autonomy
 {
 namespace smoothing
 {
 
-std::vector<double> moving_average_filter(const std::vector<double> input, int window_size, bool ignore_first_point)
+namespace
+{
+// Windows up to this size keep their history on the stack
+constexpr size_t STACK_HISTORY_SIZE = 64;
+
+/**
+ * \brief Fixed capacity FIFO of the original inputs still inside the window, needed when filtering in place
+ * overwrites them. Values leave in the order they entered so indices wrap with a compare instead of a division.
+ */
+class History
+{
+public:
+  explicit History(size_t capacity) : capacity_(capacity)
+  {
+    if (capacity_ > STACK_HISTORY_SIZE) {
+      heap_.resize(capacity_);
+      data_ = heap_.data();
+    } else {
+      data_ = stack_;
+    }
+  }
+
+  void push(double value)
+  {
+    data_[tail_] = value;
+    tail_ = tail_ + 1 == capacity_ ? 0 : tail_ + 1;
+  }
+
+  double pop()
+  {
+    double value = data_[head_];
+    head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+    return value;
+  }
+
+private:
+  size_t capacity_;
+  size_t head_ = 0;
+  size_t tail_ = 0;
+  double* data_;
+  double stack_[STACK_HISTORY_SIZE];
+  std::vector<double> heap_;
+};
+
+/**
+ * \brief Computes the (2 * half + 1) x (2 * half + 1) matrix whose row r evaluates the least squares polynomial fit
+ * of a window at offset r - half from its center
+ */
+Eigen::MatrixXd savitzky_golay_coefficients(int half, int polynomial_order)
+{
+  const int size = 2 * half + 1;
+  Eigen::MatrixXd vandermonde(size, polynomial_order + 1);
+  for (int r = 0; r < size; r++) {
+    double t = r - half;
+    double power = 1.0;
+    for (int c = 0; c <= polynomial_order; c++) {
+      vandermonde(r, c) = power;
+      power *= t;
+    }
+  }
+  // Projection onto the polynomial space: V (V^T V)^-1 V^T
+  Eigen::MatrixXd pseudo_inverse = vandermonde.colPivHouseholderQr().solve(Eigen::MatrixXd::Identity(size, size));
+  return vandermonde * pseudo_inverse;
+}
+
+}  // namespace
+
+void moving_average(const double* input, double* output, size_t count, int window_size, bool ignore_first_point)
 {
   if (window_size % 2 == 0) {
     throw std::invalid_argument("moving_average_filter window size must be odd");
   }
 
-  std::vector<double> output;
-  output.reserve(input.size());
+  if (count == 0) {
+    return;
+  }
+
+  const size_t half = static_cast<size_t>(window_size / 2);
+  const bool in_place = input == output;
+  History history(in_place ? half + 1 : 1);
 
-  if (input.size() == 0) {
-    return output;
+  // Sum of the window centered on index 0
+  double total = 0;
+  size_t window_end = std::min(count - 1, half);  // Inclusive
+  for (size_t j = 0; j <= window_end; j++) {
+    total += input[j];
   }
 
-  int start_index = 0;
-  if (ignore_first_point) {
-    start_index = 1;
-    output.push_back(input[0]);
+  for (size_t i = 0; i < count; i++) {
+    size_t window_start = i > half ? i - half : 0;
+    double value = input[i];
+
+    if (in_place) {
+      history.push(value);
+    }
+
+    if (i != 0 || !ignore_first_point) {
+      output[i] = total / static_cast<double>(window_end - window_start + 1);
+    }
+
+    // Slide the window to be centered on i + 1
+    if (window_end + 1 < count) {
+      window_end++;
+      total += input[window_end];
+    }
+    if (i >= half) {
+      total -= in_place ? history.pop() : input[window_start];
+    }
+  }
+}
+
+void trailing_moving_average(const double* input, double* output, size_t count, int window_size)
+{
+  if (window_size <= 0) {
+    throw std::invalid_argument("moving_average_filter window size must be positive");
   }
 
-  for (int i = start_index; i<input.size(); i++) {
-    
-    
-    double total = 0;
-    int sample_min = std::max(0, i - window_size / 2);
-    int sample_max = std::min((int) input.size() - 1 , i + window_size / 2);
-
-    int count = sample_max - sample_min + 1;
-    std::vector<double> sample;
-    sample.reserve(count);
-    for (int j = sample_min; j <= sample_max; j++) {
-      total += input[j];
+  const size_t window = static_cast<size_t>(window_size);
+  const bool in_place = input == output;
+  History history(in_place ? window : 1);
+
+  double total = 0;
+  for (size_t i = 0; i < count; i++) {
+    double value = input[i];
+    total += value;
+    if (i >= window) {
+      total -= in_place ? history.pop() : input[i - window];
+    }
+    if (in_place) {
+      history.push(value);
+    }
+    output[i] = total / static_cast<double>(std::min(i + 1, window));
+  }
+}
+
+void exponential_filter(const double* input, double* output, size_t count, double alpha)
+{
+  if (alpha <= 0 || alpha > 1) {
+    throw std::invalid_argument("exponential_filter alpha must be in the range (0, 1]");
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  double previous = input[0];
+  output[0] = previous;
+  for (size_t i = 1; i < count; i++) {
+    previous += alpha * (input[i] - previous);
+    output[i] = previous;
+  }
+}
+
+void savitzky_golay_filter(const double* input, double* output, size_t count, int window_size, int polynomial_order)
+{
+  if (window_size % 2 == 0 || window_size <= 0) {
+    throw std::invalid_argument("savitzky_golay_filter window size must be odd and positive");
+  }
+  if (polynomial_order < 0 || polynomial_order >= window_size) {
+    throw std::invalid_argument("savitzky_golay_filter polynomial order must be less than the window size");
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  // Shrink the window to fit the input
+  int size = std::min<int>(window_size, count % 2 == 0 ? count - 1 : count);
+  int half = size / 2;
+  int order = std::min(polynomial_order, size - 1);
+
+  if (order == size - 1) {
+    // The polynomial passes through every point
+    if (input != output) {
+      std::copy(input, input + count, output);
     }
-    output.push_back(total / (double) count);
+    return;
+  }
 
+  Eigen::MatrixXd coefficients = savitzky_golay_coefficients(half, order);
+
+  // Filtering in place needs the original values of every window
+  std::vector<double> copy;
+  const double* source = input;
+  if (input == output) {
+    copy.assign(input, input + count);
+    source = copy.data();
+  }
+
+  // Leading and trailing points are evaluated on the fit of the first and last full windows
+  const size_t last_start = count - size;
+  for (int r = 0; r < half; r++) {
+    double head = 0;
+    double tail = 0;
+    for (int j = 0; j < size; j++) {
+      head += coefficients(r, j) * source[j];
+      tail += coefficients(half + 1 + r, j) * source[last_start + j];
+    }
+    output[r] = head;
+    output[last_start + half + 1 + r] = tail;
   }
 
+  // Interior points use the symmetric center row, a dot product over contiguous memory
+  std::vector<double> center(size);
+  for (int j = 0; j < size; j++) {
+    center[j] = coefficients(half, j);
+  }
+  const double* weights = center.data();
+  for (size_t i = 0; i <= last_start; i++) {
+    const double* window = source + i;
+    double total = 0;
+    for (int j = 0; j < size; j++) {
+      total += weights[j] * window[j];
+    }
+    output[i + half] = total;
+  }
+}
+
+std::vector<double> moving_average_filter(const std::vector<double>& input, int window_size, bool ignore_first_point)
+{
+  std::vector<double> output(input.size());
+  if (!input.empty() && ignore_first_point) {
+    output[0] = input[0];
+  }
+  moving_average(input.data(), output.data(), input.size(), window_size, ignore_first_point);
   return output;
 }
 
 };  // namespace smoothing
-};  // namespace basic_autonomy
\ No newline at end of file
+};  // namespace basic_autonomy
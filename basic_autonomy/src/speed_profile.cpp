@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <basic_autonomy/speed_profile.h>
+
+namespace basic_autonomy
+{
+    namespace speed_profile
+    {
+        void apply_point_limits(const double *curvatures, const double *speed_limits, double *speeds, size_t count,
+                                const SpeedProfileLimits &limits)
+        {
+            const bool use_lateral = curvatures && limits.lateral_accel_limit > 0;
+
+            for (size_t i = 1; i < count; i++)
+            {
+                double cap = limits.speed_limit;
+                if (speed_limits)
+                {
+                    cap = std::min(cap, speed_limits[i]);
+                }
+                if (use_lateral)
+                {
+                    double k = std::fabs(curvatures[i]);
+                    if (k > 0)
+                    {
+                        cap = std::min(cap, std::sqrt(limits.lateral_accel_limit / k));
+                    }
+                }
+                speeds[i] = std::min(speeds[i], cap);
+            }
+        }
+
+        void backward_decel_pass(const double *downtracks, double *speeds, size_t count, double max_decel)
+        {
+            if (count < 3)
+            {
+                return; // The first and last points are never modified
+            }
+
+            // Speed the following point was reduced to and its downtrack
+            double v_next = speeds[count - 1];
+            double x_next = downtracks[count - 1];
+
+            for (size_t i = count - 2; i > 0; i--)
+            {
+                double v = speeds[i];
+                double x = downtracks[i];
+
+                if (v > v_next)
+                {
+                    // dx is negative walking backwards so the allowed speed grows with distance from the next point
+                    v = std::min(v, std::sqrt(v_next * v_next - 2 * max_decel * (x - x_next)));
+                    speeds[i] = v;
+                }
+
+                v_next = v;
+                x_next = x;
+            }
+        }
+
+        void forward_accel_pass(const double *downtracks, double *speeds, size_t count, double max_accel, double max_decel,
+                                double max_jerk)
+        {
+            const bool use_jerk = max_jerk > 0;
+            double prev_accel = 0.0; // Acceleration over the previous segment. Only tracked when the jerk limit is used
+
+            for (size_t i = 1; i < count; i++)
+            {
+                double v_prev = speeds[i - 1];
+                double dx = downtracks[i] - downtracks[i - 1];
+                double accel = max_accel;
+
+                if (use_jerk && dx > 0 && v_prev > 0)
+                {
+                    // Approximate the segment duration at the previous speed, which overestimates it and so stays conservative
+                    double dt = dx / v_prev;
+                    accel = std::min(max_accel, prev_accel + max_jerk * dt);
+                }
+
+                if (speeds[i] > v_prev)
+                {
+                    speeds[i] = std::min(speeds[i], std::sqrt(v_prev * v_prev + 2 * accel * dx));
+                }
+                else
+                {
+                    // The backward pass cannot slow the fixed first point, so a point may still be below the slowest speed reachable from its predecessor
+                    speeds[i] = std::max(speeds[i], std::sqrt(std::max(0.0, v_prev * v_prev - 2 * max_decel * dx)));
+                }
+
+                if (use_jerk)
+                {
+                    prev_accel = dx > 0 ? std::max(0.0, (speeds[i] * speeds[i] - v_prev * v_prev) / (2 * dx)) : 0.0;
+                }
+            }
+        }
+
+        void optimize(const double *downtracks, double *speeds, size_t count, const SpeedProfileLimits &limits,
+                      const double *curvatures, const double *speed_limits)
+        {
+            if (limits.max_accel <= 0 || limits.max_decel <= 0)
+            {
+                throw std::invalid_argument("Accel limits should be positive");
+            }
+
+            apply_point_limits(curvatures, speed_limits, speeds, count, limits);
+            backward_decel_pass(downtracks, speeds, count, limits.max_decel);
+            forward_accel_pass(downtracks, speeds, count, limits.max_accel, limits.max_decel, limits.max_jerk);
+        }
+
+    } // namespace speed_profile
+} // namespace basic_autonomy
@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <basic_autonomy/trajectory_generation_engine.h>
+
+namespace basic_autonomy
+{
+    namespace waypoint_generation
+    {
+        ResampledCurve resample_curve(const std::vector<lanelet::BasicPoint2d> &curve_points, const DetailedTrajConfig &detailed_config)
+        {
+            std::unique_ptr<smoothing::SplineI> fit_curve = compute_fit(curve_points); // Compute splines based on curve points
+            if (!fit_curve)
+            {
+                throw std::invalid_argument("Could not fit a spline curve along the given trajectory!");
+            }
+
+            ROS_DEBUG("Got fit");
+
+            ResampledCurve curve;
+            curve.sampling_points.reserve(1 + curve_points.size() * 2);
+            curve.raw_curvatures.reserve(1 + curve_points.size() * 2);
+            curve.speed_indices.reserve(1 + curve_points.size() * 2);
+
+            // compute total length of the trajectory to get correct number of points
+            // we expect using curve_resample_step_size
+            std::vector<double> downtracks_raw = carma_wm::geometry::compute_arc_lengths(curve_points);
+
+            auto total_step_along_curve = static_cast<int>(downtracks_raw.back() / detailed_config.curve_resample_step_size);
+
+            size_t current_speed_index = 0;
+            size_t total_point_size = curve_points.size();
+
+            double step_threshold_for_next_speed = (double)total_step_along_curve / (double)total_point_size;
+            double scaled_steps_along_curve = 0.0; // from 0 (start) to 1 (end) for the whole trajectory
+
+            for (size_t steps_along_curve = 0; steps_along_curve < total_step_along_curve; steps_along_curve++) // Resample curve at tighter resolution
+            {
+                lanelet::BasicPoint2d p = (*fit_curve)(scaled_steps_along_curve);
+
+                curve.sampling_points.push_back(p);
+                curve.raw_curvatures.push_back(compute_curvature_at((*fit_curve), scaled_steps_along_curve));
+                if ((double)steps_along_curve > step_threshold_for_next_speed)
+                {
+                    step_threshold_for_next_speed += (double)total_step_along_curve / (double)total_point_size;
+                    current_speed_index++;
+                }
+                curve.speed_indices.push_back(current_speed_index);
+                scaled_steps_along_curve += 1.0 / total_step_along_curve; //adding steps_along_curve_step_size
+            }
+
+            curve.yaws = carma_wm::geometry::compute_tangent_orientations(curve.sampling_points);
+            curve.curvatures = smoothing::moving_average_filter(curve.raw_curvatures, detailed_config.curvature_moving_average_window_size, false);
+
+            return curve;
+        }
+
+        TrajectoryGenerationEngine::TrajectoryGenerationEngine(size_t max_cached_curves, size_t fit_extension_points)
+            : max_cached_curves_(std::max<size_t>(1, max_cached_curves)), fit_extension_points_(fit_extension_points)
+        {
+        }
+
+        std::vector<PointSpeedPair> TrajectoryGenerationEngine::create_geometry_profile(const std::vector<cav_msgs::Maneuver> &maneuvers, double max_starting_downtrack,
+                                                                                        const carma_wm::WorldModelConstPtr &wm, cav_msgs::VehicleState &ending_state_before_buffer,
+                                                                                        const cav_msgs::VehicleState &state, const GeneralTrajConfig &general_config,
+                                                                                        const DetailedTrajConfig &detailed_config)
+        {
+            return waypoint_generation::create_geometry_profile(maneuvers, max_starting_downtrack, wm, ending_state_before_buffer, state,
+                                                                general_config, detailed_config, this);
+        }
+
+        std::vector<PointSpeedPair> TrajectoryGenerationEngine::create_lanefollow_geometry(const cav_msgs::Maneuver &maneuver, double max_starting_downtrack,
+                                                                                           const carma_wm::WorldModelConstPtr &wm, cav_msgs::VehicleState &ending_state_before_buffer,
+                                                                                           const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config,
+                                                                                           std::unordered_set<lanelet::Id> &visited_lanelets)
+        {
+            return waypoint_generation::create_lanefollow_geometry(maneuver, max_starting_downtrack, wm, ending_state_before_buffer, general_config,
+                                                                   detailed_config, visited_lanelets, this);
+        }
+
+        std::vector<cav_msgs::TrajectoryPlanPoint> TrajectoryGenerationEngine::compose_lanefollow_trajectory_from_path(
+            const std::vector<PointSpeedPair> &points, const cav_msgs::VehicleState &state, const ros::Time &state_time,
+            const carma_wm::WorldModelConstPtr &wm, const cav_msgs::VehicleState &ending_state_before_buffer,
+            carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg, const DetailedTrajConfig &detailed_config)
+        {
+            return waypoint_generation::compose_lanefollow_trajectory_from_path(points, state, state_time, wm, ending_state_before_buffer, debug_msg,
+                                                                                detailed_config, this);
+        }
+
+        std::vector<lanelet::ConstLanelet> TrajectoryGenerationEngine::getLaneletsBetween(const carma_wm::WorldModelConstPtr &wm, double start, double end)
+        {
+            sync(wm);
+
+            if (start > end)
+            {
+                throw std::invalid_argument("Start distance is greater than end distance");
+            }
+
+            updateHorizon(wm, start, end);
+
+            // Same bounds inclusive 1d intersection test as CARMAWorldModel::getLaneletsBetween. The horizon is already in shortest path order
+            std::vector<lanelet::ConstLanelet> output;
+            for (const auto &entry : horizon_)
+            {
+                if (std::max(entry.min_downtrack, start) > std::min(entry.max_downtrack, end)
+                    || (start == end && (entry.min_downtrack > start || entry.max_downtrack < end)))
+                {
+                    continue;
+                }
+                output.push_back(entry.lanelet);
+            }
+
+            return output;
+        }
+
+        const lanelet::ConstLanelets &TrajectoryGenerationEngine::following(const carma_wm::WorldModelConstPtr &wm, const lanelet::ConstLanelet &lanelet)
+        {
+            sync(wm);
+
+            auto it = following_.find(lanelet.id());
+            if (it == following_.end())
+            {
+                it = following_.emplace(lanelet.id(), wm->getMapRoutingGraph()->following(lanelet)).first;
+            }
+            return it->second;
+        }
+
+        const lanelet::BasicLineString2d &TrajectoryGenerationEngine::downsampledCenterline(const carma_wm::WorldModelConstPtr &wm, const lanelet::ConstLanelet &lanelet,
+                                                                                            int downsample_ratio)
+        {
+            sync(wm);
+
+            auto key = std::make_pair(lanelet.id(), downsample_ratio);
+            auto it = centerlines_.find(key);
+            if (it != centerlines_.end())
+            {
+                stats_.centerline_hits++;
+                return it->second;
+            }
+
+            stats_.centerline_misses++;
+            lanelet::BasicLineString2d centerline = lanelet.centerline2d().basicLineString();
+            return centerlines_.emplace(key, carma_utils::containers::downsample_vector(centerline, downsample_ratio)).first->second;
+        }
+
+        std::shared_ptr<const ResampledCurve> TrajectoryGenerationEngine::resampleCurve(const carma_wm::WorldModelConstPtr &wm,
+                                                                                         const std::vector<lanelet::BasicPoint2d> &path_points,
+                                                                                         size_t window_begin, size_t window_end,
+                                                                                         const DetailedTrajConfig &detailed_config)
+        {
+            sync(wm);
+
+            if (window_begin >= window_end || window_end > path_points.size())
+            {
+                throw std::invalid_argument("Invalid curve window");
+            }
+            const size_t window_size = window_end - window_begin;
+            auto window_front = path_points.begin() + window_begin;
+
+            for (auto it = curves_.begin(); it != curves_.end(); ++it)
+            {
+                if (it->curve_resample_step_size != detailed_config.curve_resample_step_size
+                    || it->curvature_moving_average_window_size != detailed_config.curvature_moving_average_window_size
+                    || it->curve_points.size() < window_size)
+                {
+                    continue;
+                }
+
+                // Find the window as a run of the fitted points
+                std::shared_ptr<const ResampledCurve> curve;
+                for (size_t offset = 0; offset + window_size <= it->curve_points.size() && !curve; ++offset)
+                {
+                    if (!std::equal(window_front, window_front + window_size, it->curve_points.begin() + offset))
+                    {
+                        continue;
+                    }
+                    if (offset == 0 && window_size == it->curve_points.size())
+                    {
+                        stats_.curve_hits++;
+                        curve = it->curve;
+                    }
+                    else if (fit_extension_points_ > 0)
+                    {
+                        curve = cutWindow(*it, offset, window_size);
+                        if (curve)
+                        {
+                            stats_.curve_span_hits++;
+                        }
+                    }
+                }
+
+                if (curve)
+                {
+                    CurveEntry entry = std::move(*it);
+                    curves_.erase(it);
+                    curves_.push_front(std::move(entry));
+                    return curve;
+                }
+            }
+
+            stats_.curve_misses++;
+
+            auto fit = [&wm, &detailed_config](const std::vector<lanelet::BasicPoint2d> &curve_points) {
+                auto curve = std::make_shared<ResampledCurve>(resample_curve(curve_points, detailed_config));
+                curve->route_downtracks.reserve(curve->sampling_points.size());
+                for (const auto &p : curve->sampling_points)
+                {
+                    curve->route_downtracks.push_back(wm->routeTrackPos(p).downtrack);
+                }
+                return curve;
+            };
+
+            // Fit past the window so the windows of the next planning cycles fall within this fit
+            size_t fit_end = std::min(path_points.size(), window_end + fit_extension_points_);
+
+            CurveEntry entry;
+            entry.curve_points.assign(window_front, path_points.begin() + fit_end);
+            entry.curve_resample_step_size = detailed_config.curve_resample_step_size;
+            entry.curvature_moving_average_window_size = detailed_config.curvature_moving_average_window_size;
+            entry.curve = fit(entry.curve_points);
+            entry.point_downtracks.reserve(entry.curve_points.size());
+            for (const auto &p : entry.curve_points)
+            {
+                entry.point_downtracks.push_back(wm->routeTrackPos(p).downtrack);
+            }
+
+            std::shared_ptr<const ResampledCurve> result = entry.curve;
+            if (fit_end > window_end)
+            {
+                result = cutWindow(entry, 0, window_size);
+                if (!result)
+                {
+                    // The window is too short to cut from the extended fit so it is fit on its own
+                    result = fit(std::vector<lanelet::BasicPoint2d>(window_front, path_points.begin() + window_end));
+                }
+            }
+
+            curves_.push_front(std::move(entry));
+            if (curves_.size() > max_cached_curves_)
+            {
+                curves_.pop_back();
+            }
+
+            return result;
+        }
+
+        std::shared_ptr<const ResampledCurve> TrajectoryGenerationEngine::cutWindow(const CurveEntry &entry, size_t offset, size_t window_size) const
+        {
+            const ResampledCurve &fit = *entry.curve;
+            double start_downtrack = entry.point_downtracks[offset];
+            double end_downtrack = entry.point_downtracks[offset + window_size - 1];
+
+            // Like an uncached fit of the window, samples run from the first window point up to before the last one
+            size_t begin = 0;
+            while (begin < fit.route_downtracks.size() && fit.route_downtracks[begin] < start_downtrack)
+            {
+                begin++;
+            }
+            size_t end = begin;
+            while (end < fit.route_downtracks.size() && fit.route_downtracks[end] < end_downtrack)
+            {
+                end++;
+            }
+            if (end < begin + 2)
+            {
+                return nullptr;
+            }
+
+            auto cut = std::make_shared<ResampledCurve>();
+            cut->sampling_points.assign(fit.sampling_points.begin() + begin, fit.sampling_points.begin() + end);
+            cut->raw_curvatures.assign(fit.raw_curvatures.begin() + begin, fit.raw_curvatures.begin() + end);
+            cut->curvatures.assign(fit.curvatures.begin() + begin, fit.curvatures.begin() + end);
+            cut->yaws.assign(fit.yaws.begin() + begin, fit.yaws.begin() + end);
+            cut->route_downtracks.assign(fit.route_downtracks.begin() + begin, fit.route_downtracks.begin() + end);
+
+            // Speed indices refer to the fitted points so are shifted to the window
+            cut->speed_indices.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i)
+            {
+                size_t index = fit.speed_indices[i] > offset ? fit.speed_indices[i] - offset : 0;
+                cut->speed_indices.push_back(std::min(index, window_size - 1));
+            }
+
+            return cut;
+        }
+
+        void TrajectoryGenerationEngine::clear()
+        {
+            horizon_valid_ = false;
+            horizon_.clear();
+            horizon_begin_ = 0;
+            trimmed_downtrack_ = -std::numeric_limits<double>::infinity();
+            following_.clear();
+            centerlines_.clear();
+            curves_.clear();
+        }
+
+        TrajectoryGenerationEngine::Stats TrajectoryGenerationEngine::getStats() const
+        {
+            return stats_;
+        }
+
+        void TrajectoryGenerationEngine::sync(const carma_wm::WorldModelConstPtr &wm)
+        {
+            carma_wm::LaneletRouteConstPtr route = wm->getRoute();
+            size_t map_update_count = wm->getMapUpdateCount();
+            std::string route_name = wm->getRouteName();
+
+            if (route == route_ && map_update_count == map_update_count_ && route_name == route_name_)
+            {
+                return;
+            }
+
+            ROS_DEBUG_STREAM("Route or map changed, clearing trajectory generation cache. Map update: " << map_update_count << ", route: " << route_name);
+            clear();
+            route_ = route;
+            map_update_count_ = map_update_count;
+            route_name_ = route_name;
+        }
+
+        void TrajectoryGenerationEngine::updateHorizon(const carma_wm::WorldModelConstPtr &wm, double start, double end)
+        {
+            auto route = wm->getRoute();
+            if (!route)
+            {
+                throw std::invalid_argument("Route has not yet been loaded");
+            }
+            const auto &path = route->shortestPath();
+
+            if (!horizon_valid_ || start <= trimmed_downtrack_)
+            {
+                horizon_.clear();
+                horizon_begin_ = 0;
+                trimmed_downtrack_ = -std::numeric_limits<double>::infinity();
+                horizon_valid_ = true;
+                stats_.horizon_builds++;
+            }
+
+            // Extend until a lanelet starts past the end of the query. Shortest path lanelets are in downtrack order
+            while (horizon_begin_ + horizon_.size() < path.size() && (horizon_.empty() || horizon_.back().min_downtrack <= end))
+            {
+                const lanelet::ConstLanelet llt = path[horizon_begin_ + horizon_.size()];
+                lanelet::ConstLineString2d centerline = llt.centerline2d();
+
+                RouteLanelet entry;
+                entry.lanelet = llt;
+                entry.min_downtrack = wm->routeTrackPos(centerline.front()).downtrack;
+                entry.max_downtrack = wm->routeTrackPos(centerline.back()).downtrack;
+                horizon_.push_back(entry);
+                stats_.horizon_extensions++;
+            }
+
+            // Trim the lanelets the vehicle has passed along with their cached data
+            while (!horizon_.empty() && horizon_.front().max_downtrack < start)
+            {
+                lanelet::Id id = horizon_.front().lanelet.id();
+                following_.erase(id);
+                centerlines_.erase(centerlines_.lower_bound(std::make_pair(id, std::numeric_limits<int>::min())),
+                                   centerlines_.upper_bound(std::make_pair(id, std::numeric_limits<int>::max())));
+
+                trimmed_downtrack_ = std::max(trimmed_downtrack_, horizon_.front().max_downtrack);
+                horizon_.pop_front();
+                horizon_begin_++;
+            }
+        }
+
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <basic_autonomy/trajectory_view.h>
+
+namespace basic_autonomy
+{
+    TrajectoryView::TrajectoryView(const cav_msgs::TrajectoryPlan &plan) : plan_(&plan)
+    {
+        const auto &points = plan.trajectory_points;
+        if (points.empty())
+        {
+            return;
+        }
+
+        indices_.reserve(points.size());
+        downtracks_.reserve(points.size());
+        times_.reserve(points.size());
+        speeds_.reserve(points.size());
+
+        const double start_time = points[0].target_time.toSec();
+
+        indices_.push_back(0);
+        downtracks_.push_back(0.0);
+        times_.push_back(0.0);
+        speeds_.push_back(plan.initial_longitudinal_velocity);
+
+        // The unclamped speed of the previous point. Each speed is derived from the previous one so clamping is applied afterwards
+        double prev_speed = plan.initial_longitudinal_velocity;
+
+        for (size_t i = 1; i < points.size(); i++)
+        {
+            const cav_msgs::TrajectoryPlanPoint &prev = points[indices_.back()];
+            const cav_msgs::TrajectoryPlanPoint &cur = points[i];
+
+            if (cur.target_time == prev.target_time)
+            {
+                continue; // Sequential duplicate timestamps would result in a divide by zero
+            }
+
+            double delta_d = std::sqrt((cur.x - prev.x) * (cur.x - prev.x) + (cur.y - prev.y) * (cur.y - prev.y));
+            double time = cur.target_time.toSec() - start_time;
+            double delta_t = time - times_.back();
+
+            double speed = (2.0 * delta_d / delta_t) - prev_speed;
+            prev_speed = speed;
+
+            indices_.push_back(i);
+            downtracks_.push_back(downtracks_.back() + delta_d);
+            times_.push_back(time);
+            speeds_.push_back(speed);
+        }
+
+        for (double &speed : speeds_) // Ensure 0 is min speed
+        {
+            speed = std::max(0.0, speed);
+        }
+    }
+
+    const cav_msgs::TrajectoryPlan &TrajectoryView::plan() const
+    {
+        return *plan_;
+    }
+
+    size_t TrajectoryView::size() const
+    {
+        return indices_.size();
+    }
+
+    bool TrajectoryView::empty() const
+    {
+        return indices_.empty();
+    }
+
+    const cav_msgs::TrajectoryPlanPoint &TrajectoryView::point(size_t i) const
+    {
+        return plan_->trajectory_points[indices_[i]];
+    }
+
+    size_t TrajectoryView::plan_index(size_t i) const
+    {
+        return indices_[i];
+    }
+
+    const std::vector<double> &TrajectoryView::downtracks() const
+    {
+        return downtracks_;
+    }
+
+    const std::vector<double> &TrajectoryView::times() const
+    {
+        return times_;
+    }
+
+    const std::vector<double> &TrajectoryView::speeds() const
+    {
+        return speeds_;
+    }
+
+} // namespace basic_autonomy
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark comparing the smoothing filters against the moving average implementations they replace.
+ * Run with: rosrun basic_autonomy basic_autonomy-filters-benchmark
+ */
+
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <basic_autonomy/smoothing/filters.h>
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+// Centered moving average as implemented in basic_autonomy and inlanecruising_plugin before the running sum
+std::vector<double> legacyCentered(const std::vector<double> input, int window_size, bool ignore_first_point)
+{
+  std::vector<double> output;
+  output.reserve(input.size());
+  int start_index = 0;
+  if (ignore_first_point) {
+    start_index = 1;
+    output.push_back(input[0]);
+  }
+  for (int i = start_index; i < input.size(); i++) {
+    double total = 0;
+    int sample_min = std::max(0, i - window_size / 2);
+    int sample_max = std::min((int)input.size() - 1, i + window_size / 2);
+    int count = sample_max - sample_min + 1;
+    std::vector<double> sample;
+    sample.reserve(count);
+    for (int j = sample_min; j <= sample_max; j++) {
+      total += input[j];
+    }
+    output.push_back(total / (double)count);
+  }
+  return output;
+}
+
+// Trailing moving average as implemented in platooning_tactical_plugin before the running sum
+std::vector<double> legacyTrailing(const std::vector<double> input, int window_size)
+{
+  int i = 0;
+  std::deque<double> samples;
+  std::vector<double> output;
+  output.reserve(input.size());
+  for (auto value : input) {
+    if (i < window_size) {
+      samples.push_back(value);
+    } else {
+      samples.pop_front();
+      samples.push_back(value);
+    }
+    double total = 0;
+    for (auto s : samples) {
+      total += s;
+    }
+    output.push_back(total / samples.size());
+    i++;
+  }
+  return output;
+}
+
+template <typename F>
+double timeUs(size_t iterations, F&& func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+bool matches(const std::vector<double>& a, const std::vector<double>& b)
+{
+  for (size_t i = 0; i < a.size(); i++) {
+    if (std::fabs(a[i] - b[i]) > 1e-9) {
+      return false;
+    }
+  }
+  return a.size() == b.size();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  namespace sm = basic_autonomy::smoothing;
+  const int window = 9;  // Default curvature_moving_average_window_size
+
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> noise(-0.01, 0.01);
+
+  std::cout << "points, legacy centered, moving_average, moving_average in place, legacy trailing, trailing in place, "
+               "savitzky_golay, exponential (us)" << std::endl;
+  for (size_t size : { 100, 250, 500, 1000, 2500, 5000 }) {
+    std::vector<double> curvature(size);
+    for (size_t i = 0; i < size; i++) {
+      curvature[i] = 0.05 * std::sin(i / 50.0) + noise(gen);
+    }
+    std::vector<double> output(size);
+    size_t iterations = 2000000 / size;
+
+    double legacy_centered = timeUs(iterations, [&]() { g_sink = g_sink + legacyCentered(curvature, window, false).back(); });
+    double centered = timeUs(iterations, [&]() {
+      sm::moving_average(curvature.data(), output.data(), size, window, false);
+      g_sink = g_sink + output.back();
+    });
+    double centered_in_place = timeUs(iterations, [&]() {
+      output = curvature;
+      sm::moving_average(output.data(), output.data(), size, window, false);
+      g_sink = g_sink + output.back();
+    });
+    double legacy_trailing = timeUs(iterations, [&]() { g_sink = g_sink + legacyTrailing(curvature, window).back(); });
+    double trailing_in_place = timeUs(iterations, [&]() {
+      output = curvature;
+      sm::trailing_moving_average(output.data(), output.data(), size, window);
+      g_sink = g_sink + output.back();
+    });
+    double savitzky_golay = timeUs(iterations, [&]() {
+      sm::savitzky_golay_filter(curvature.data(), output.data(), size, window, 2);
+      g_sink = g_sink + output.back();
+    });
+    double exponential = timeUs(iterations, [&]() {
+      sm::exponential_filter(curvature.data(), output.data(), size, 0.3);
+      g_sink = g_sink + output.back();
+    });
+
+    // The running sums must agree with the filters they replace
+    output = curvature;
+    sm::moving_average(output.data(), output.data(), size, window, true);
+    if (!matches(legacyCentered(curvature, window, true), output)) {
+      std::cerr << "Centered moving average mismatch for " << size << " points" << std::endl;
+      return 1;
+    }
+    output = curvature;
+    sm::trailing_moving_average(output.data(), output.data(), size, window);
+    if (!matches(legacyTrailing(curvature, window), output)) {
+      std::cerr << "Trailing moving average mismatch for " << size << " points" << std::endl;
+      return 1;
+    }
+
+    std::cout << size << ", " << legacy_centered << ", " << centered << ", " << centered_in_place << ", "
+              << legacy_trailing << ", " << trailing_in_place << ", " << savitzky_golay << ", " << exponential
+              << std::endl;
+  }
+  return 0;
+}
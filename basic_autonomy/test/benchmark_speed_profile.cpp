@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark comparing the linear speed profile passes against the minimum search used by optimize_speed before them.
+ * Run with: rosrun basic_autonomy basic_autonomy-speed-profile-benchmark
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include <basic_autonomy/speed_profile.h>
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+std::pair<double, size_t> min_with_exclusions(const std::vector<double>& values, const std::unordered_set<size_t>& excluded)
+{
+    double min = std::numeric_limits<double>::max();
+    size_t best_idx = -1;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (excluded.find(i) != excluded.end())
+        {
+            continue;
+        }
+        if (values[i] < min)
+        {
+            min = values[i];
+            best_idx = i;
+        }
+    }
+    return std::make_pair(min, best_idx);
+}
+
+// Backward pass of optimize_speed before basic_autonomy::speed_profile
+std::vector<double> legacyBackward(const std::vector<double>& downtracks, const std::vector<double>& curv_speeds, double accel_limit)
+{
+    std::unordered_set<size_t> visited_idx;
+    visited_idx.reserve(curv_speeds.size());
+    std::vector<double> output = curv_speeds;
+
+    while (true)
+    {
+        auto min_pair = min_with_exclusions(curv_speeds, visited_idx);
+        size_t min_idx = std::get<1>(min_pair);
+        if (min_idx == -1)
+        {
+            break;
+        }
+        visited_idx.insert(min_idx);
+
+        double v_i = std::get<0>(min_pair);
+        double x_i = downtracks[min_idx];
+        for (int i = min_idx - 1; i > 0; i--)
+        {
+            double v_f = curv_speeds[i];
+            double dv = v_f - v_i;
+            double dx = downtracks[i] - x_i;
+            if (dv > 0)
+            {
+                v_f = std::min(v_f, std::sqrt(v_i * v_i - 2 * accel_limit * dx));
+                visited_idx.insert(i);
+            }
+            else if (dv < 0)
+            {
+                break;
+            }
+            output[i] = v_f;
+            v_i = v_f;
+            x_i = downtracks[i];
+        }
+    }
+    return output;
+}
+
+// Curvature limited speeds along a winding path sampled every meter
+void makeTrajectory(size_t size, std::vector<double>* downtracks, std::vector<double>* speeds)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+    downtracks->resize(size);
+    speeds->resize(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        (*downtracks)[i] = static_cast<double>(i);
+        (*speeds)[i] = 12.0 + 8.0 * std::sin(i / 40.0) + noise(gen);
+    }
+}
+
+template <typename F>
+double timeUs(size_t iterations, F&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    namespace sp = basic_autonomy::speed_profile;
+    const double accel_limit = 1.5;
+
+    std::cout << "points, legacy backward (us), speed_profile backward (us), speed_profile optimize with all limits (us)" << std::endl;
+    for (size_t size : { 100, 250, 500, 1000, 2500, 5000 })
+    {
+        std::vector<double> downtracks, speeds;
+        makeTrajectory(size, &downtracks, &speeds);
+        std::vector<double> curvatures(size, 0.01);
+
+        size_t iterations = std::max<size_t>(1, 200000 / (size * 10));
+        size_t legacy_iterations = std::max<size_t>(1, iterations / (size / 100));
+
+        double legacy_us = timeUs(legacy_iterations, [&]() {
+            g_sink = g_sink + legacyBackward(downtracks, speeds, accel_limit).back();
+        });
+
+        std::vector<double> output;
+        double backward_us = timeUs(iterations, [&]() {
+            output = speeds;
+            sp::backward_decel_pass(downtracks.data(), output.data(), output.size(), accel_limit);
+            g_sink = g_sink + output.back();
+        });
+
+        sp::SpeedProfileLimits limits;
+        limits.max_accel = accel_limit;
+        limits.max_decel = accel_limit;
+        limits.lateral_accel_limit = 2.0;
+        limits.speed_limit = 18.0;
+        limits.max_jerk = 1.0;
+        double optimize_us = timeUs(iterations, [&]() {
+            output = speeds;
+            sp::optimize(downtracks.data(), output.data(), output.size(), limits, curvatures.data());
+            g_sink = g_sink + output.back();
+        });
+
+        // Both backward passes must agree
+        std::vector<double> expected = legacyBackward(downtracks, speeds, accel_limit);
+        output = speeds;
+        sp::backward_decel_pass(downtracks.data(), output.data(), output.size(), accel_limit);
+        for (size_t i = 0; i < size; i++)
+        {
+            if (std::fabs(expected[i] - output[i]) > 1e-9)
+            {
+                std::cerr << "Mismatch at index " << i << " of " << size << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << size << ", " << legacy_us << ", " << backward_us << ", " << optimize_us << std::endl;
+    }
+    return 0;
+}
@@ -16,6 +16,9 @@
 
 #include <basic_autonomy/basic_autonomy.h>
 #include <basic_autonomy/helper_functions.h>
+#include <basic_autonomy/speed_profile.h>
+#include <basic_autonomy/trajectory_generation_engine.h>
+#include <basic_autonomy/trajectory_view.h>
 #include <gtest/gtest.h>
 #include <ros/ros.h>
 #include <carma_wm/CARMAWorldModel.h>
@@ -29,8 +32,10 @@
 #include <lanelet2_core/geometry/LineString.h>
 #include <lanelet2_extension/projection/local_frame_projector.h>
 #include <lanelet2_extension/io/autoware_osm_parser.h>
+#include <array>
 #include <string>
 #include <sstream>
+#include <random>
 #include <ros/package.h>
 #include <cav_msgs/Maneuver.h>
 #include <cav_msgs/VehicleState.h>
@@ -467,6 +472,193 @@ namespace basic_autonomy
         ASSERT_NEAR(expected_results[8], test_results[8], 0.001);
     }
 
+    // Speed optimization as implemented before the linear speed_profile passes. Used as a reference
+    std::vector<double> legacy_optimize_speed(const std::vector<double> &downtracks, const std::vector<double> &curv_speeds, double accel_limit)
+    {
+        std::unordered_set<size_t> visited_idx;
+        std::vector<double> output = curv_speeds;
+
+        while (true)
+        {
+            auto min_pair = waypoint_generation::min_with_exclusions(curv_speeds, visited_idx);
+            size_t min_idx = std::get<1>(min_pair);
+            if (min_idx == -1)
+            {
+                break;
+            }
+            visited_idx.insert(min_idx);
+
+            double v_i = std::get<0>(min_pair);
+            double x_i = downtracks[min_idx];
+            for (int i = min_idx - 1; i > 0; i--)
+            {
+                double v_f = curv_speeds[i];
+                double dv = v_f - v_i;
+                double dx = downtracks[i] - x_i;
+                if (dv > 0)
+                {
+                    v_f = std::min(v_f, sqrt(v_i * v_i - 2 * accel_limit * dx));
+                    visited_idx.insert(i);
+                }
+                else if (dv < 0)
+                {
+                    break;
+                }
+                output[i] = v_f;
+                v_i = v_f;
+                x_i = downtracks[i];
+            }
+        }
+
+        return trajectory_utils::apply_accel_limits_by_distance(downtracks, output, accel_limit, accel_limit);
+    }
+
+    TEST(BasicAutonomyTest, optimize_speed_matches_legacy)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> speed_dist(0.0, 20.0);
+        std::uniform_real_distribution<double> step_dist(0.1, 3.0);
+
+        for (size_t size : {2, 3, 10, 100, 500})
+        {
+            std::vector<double> downtracks(size), speeds(size);
+            double downtrack = 0;
+            for (size_t i = 0; i < size; i++)
+            {
+                downtracks[i] = downtrack;
+                downtrack += step_dist(gen);
+                // Plateaus of equal speeds exercise the legacy tie handling
+                speeds[i] = i % 7 == 3 ? speeds[i - 1] : speed_dist(gen);
+            }
+
+            auto expected = legacy_optimize_speed(downtracks, speeds, 1.5);
+            auto actual = waypoint_generation::optimize_speed(downtracks, speeds, 1.5);
+
+            ASSERT_EQ(expected.size(), actual.size());
+            for (size_t i = 0; i < size; i++)
+            {
+                ASSERT_NEAR(expected[i], actual[i], 0.000001) << "size: " << size << " index: " << i;
+            }
+        }
+    }
+
+    TEST(BasicAutonomyTest, speed_profile_constraints)
+    {
+        std::vector<double> downtracks = {0, 5, 10, 15, 20, 25, 30};
+        std::vector<double> curvatures = {0, 0, 0.1, 0.1, 0, 0, 0};
+        std::vector<double> speed_limits = {20, 20, 20, 20, 20, 8, 8};
+        std::vector<double> speeds = {5, 30, 30, 30, 30, 30, 30};
+
+        speed_profile::SpeedProfileLimits limits;
+        limits.max_accel = 2.0;
+        limits.max_decel = 2.0;
+        limits.lateral_accel_limit = 2.5;
+        limits.speed_limit = 25;
+
+        ASSERT_THROW(speed_profile::optimize(downtracks.data(), speeds.data(), speeds.size(), speed_profile::SpeedProfileLimits()), std::invalid_argument);
+
+        std::vector<double> initial_speeds = speeds;
+        speed_profile::optimize(downtracks.data(), speeds.data(), speeds.size(), limits, curvatures.data(), speed_limits.data());
+
+        EXPECT_NEAR(5.0, speeds[0], 0.000001); // Current speed is unchanged
+        EXPECT_NEAR(5.0, speeds[2], 0.000001); // sqrt(2.5 / 0.1)
+        EXPECT_NEAR(5.0, speeds[3], 0.000001);
+        EXPECT_NEAR(8.0, speeds[5], 0.000001);
+        EXPECT_NEAR(8.0, speeds[6], 0.000001);
+
+        for (size_t i = 1; i < speeds.size(); i++)
+        {
+            double accel = (speeds[i] * speeds[i] - speeds[i - 1] * speeds[i - 1]) / (2 * (downtracks[i] - downtracks[i - 1]));
+            EXPECT_LE(accel, limits.max_accel + 0.000001);
+            EXPECT_GE(accel, -limits.max_decel - 0.000001);
+        }
+
+        // The jerk limit delays the onset of full acceleration
+        std::vector<double> accel_limited = initial_speeds;
+        speed_profile::optimize(downtracks.data(), accel_limited.data(), accel_limited.size(), limits);
+
+        std::vector<double> jerk_limited = initial_speeds;
+        limits.max_jerk = 0.5;
+        speed_profile::optimize(downtracks.data(), jerk_limited.data(), jerk_limited.size(), limits);
+
+        EXPECT_LT(jerk_limited[1], accel_limited[1]);
+        for (size_t i = 1; i < jerk_limited.size(); i++)
+        {
+            EXPECT_LE(jerk_limited[i], accel_limited[i] + 0.000001);
+        }
+    }
+
+    TEST(BasicAutonomyTest, moving_average_filters)
+    {
+        std::vector<double> input = {0, 4, 1, 7, 2, 2, 9, 3};
+
+        // Centered window truncated at the ends
+        std::vector<double> expected = {5.0 / 3.0, 12.0 / 4.0, 14.0 / 5.0, 16.0 / 5.0, 21.0 / 5.0, 23.0 / 5.0, 16.0 / 4.0, 14.0 / 3.0};
+        auto output = smoothing::moving_average_filter(input, 5, false);
+        ASSERT_EQ(expected.size(), output.size());
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_NEAR(expected[i], output[i], 0.000001);
+        }
+
+        std::vector<double> in_place = input;
+        smoothing::moving_average(in_place.data(), in_place.data(), in_place.size(), 5);
+        EXPECT_NEAR(0.0, in_place[0], 0.000001);  // First point ignored
+        for (size_t i = 1; i < expected.size(); i++)
+        {
+            EXPECT_NEAR(expected[i], in_place[i], 0.000001);
+        }
+
+        ASSERT_THROW(smoothing::moving_average_filter(input, 4), std::invalid_argument);
+        EXPECT_TRUE(smoothing::moving_average_filter({}, 3).empty());
+
+        // Trailing window
+        expected = {0, 2, 5.0 / 3.0, 12.0 / 3.0, 10.0 / 3.0, 11.0 / 3.0, 13.0 / 3.0, 14.0 / 3.0};
+        in_place = input;
+        smoothing::trailing_moving_average(in_place.data(), in_place.data(), in_place.size(), 3);
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_NEAR(expected[i], in_place[i], 0.000001);
+        }
+    }
+
+    TEST(BasicAutonomyTest, exponential_and_savitzky_golay_filters)
+    {
+        std::vector<double> input = {2, 4, 4, 0};
+        std::vector<double> output(input.size());
+        smoothing::exponential_filter(input.data(), output.data(), input.size(), 0.5);
+        EXPECT_NEAR(2.0, output[0], 0.000001);
+        EXPECT_NEAR(3.0, output[1], 0.000001);
+        EXPECT_NEAR(3.5, output[2], 0.000001);
+        EXPECT_NEAR(1.75, output[3], 0.000001);
+        ASSERT_THROW(smoothing::exponential_filter(input.data(), output.data(), input.size(), 0.0), std::invalid_argument);
+
+        // A quadratic is reproduced exactly by a quadratic fit, including at the ends
+        input.clear();
+        for (int i = 0; i < 20; i++)
+        {
+            input.push_back(0.5 * i * i - 3 * i + 1);
+        }
+        output = input;
+        smoothing::savitzky_golay_filter(output.data(), output.data(), output.size(), 7, 2);
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            EXPECT_NEAR(input[i], output[i], 0.000001);
+        }
+
+        // With a linear fit the interior matches a centered moving average
+        std::vector<double> noisy = {1, 5, 2, 8, 3, 9, 4, 6, 1, 7};
+        std::vector<double> average = smoothing::moving_average_filter(noisy, 5, false);
+        output.resize(noisy.size());
+        smoothing::savitzky_golay_filter(noisy.data(), output.data(), noisy.size(), 5, 1);
+        for (size_t i = 2; i < noisy.size() - 2; i++)
+        {
+            EXPECT_NEAR(average[i], output[i], 0.000001);
+        }
+
+        ASSERT_THROW(smoothing::savitzky_golay_filter(noisy.data(), output.data(), noisy.size(), 5, 5), std::invalid_argument);
+    }
+
     TEST(BasicAutonomyTest, compute_curvature_at)
     {
         ///////////////////////
@@ -790,6 +982,219 @@ namespace basic_autonomy
         EXPECT_TRUE(visited_lanelets.find(1200) != visited_lanelets.end()); // new lanelets added to the set with the new maneuver
     }
 
+
+    TEST(BasicAutonomyTest, trajectory_generation_engine_matches_uncached)
+    {
+        std::shared_ptr<carma_wm::CARMAWorldModel> wm = std::make_shared<carma_wm::CARMAWorldModel>();
+        auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25, 10);
+        wm->setMap(map);
+        carma_wm::test::setSpeedLimit(25_mph, wm);
+        carma_wm::test::setRouteByIds({ 1200, 1201, 1202, 1203 }, wm);
+
+        waypoint_generation::GeneralTrajConfig general_config = waypoint_generation::compose_general_trajectory_config("inlanecruising", 2, 1);
+        waypoint_generation::DetailedTrajConfig detailed_config = waypoint_generation::compose_detailed_trajectory_config(6.0, 1.0, 2.2352, 2.0, 2.5, 5, 9, 20.0, 20.0);
+
+        cav_msgs::Maneuver maneuver;
+        maneuver.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        maneuver.lane_following_maneuver.lane_ids = { "1200", "1201", "1202" };
+        maneuver.lane_following_maneuver.start_dist = 0.0;
+        maneuver.lane_following_maneuver.end_dist = 70.0;
+        maneuver.lane_following_maneuver.end_speed = 10.0;
+        std::vector<cav_msgs::Maneuver> maneuvers = { maneuver };
+
+        // By default the engine must reproduce the uncached results exactly, both on the first call and when reusing cached data
+        waypoint_generation::TrajectoryGenerationEngine engine;
+
+        for (double y : { 10.0, 10.5, 10.5 })
+        {
+            cav_msgs::VehicleState state;
+            state.x_pos_global = 1.85;
+            state.y_pos_global = y;
+            state.orientation = M_PI / 2.0;
+            state.longitudinal_vel = 8.0;
+            double max_starting_downtrack = std::max(0.0, wm->routeTrackPos(lanelet::BasicPoint2d(state.x_pos_global, state.y_pos_global)).downtrack - 20.0);
+
+            cav_msgs::VehicleState expected_ending_state;
+            auto expected_points = waypoint_generation::create_geometry_profile(maneuvers, max_starting_downtrack, wm, expected_ending_state, state,
+                                                                                general_config, detailed_config);
+            cav_msgs::VehicleState ending_state;
+            auto points = engine.create_geometry_profile(maneuvers, max_starting_downtrack, wm, ending_state, state, general_config, detailed_config);
+
+            ASSERT_EQ(expected_points.size(), points.size());
+            for (size_t i = 0; i < points.size(); i++)
+            {
+                EXPECT_EQ(expected_points[i].point.x(), points[i].point.x());
+                EXPECT_EQ(expected_points[i].point.y(), points[i].point.y());
+                EXPECT_EQ(expected_points[i].speed, points[i].speed);
+            }
+            EXPECT_EQ(expected_ending_state.x_pos_global, ending_state.x_pos_global);
+            EXPECT_EQ(expected_ending_state.y_pos_global, ending_state.y_pos_global);
+
+            carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg;
+            auto expected_traj = waypoint_generation::compose_lanefollow_trajectory_from_path(expected_points, state, ros::Time(1.0), wm, expected_ending_state,
+                                                                                             debug_msg, detailed_config);
+            auto traj = engine.compose_lanefollow_trajectory_from_path(points, state, ros::Time(1.0), wm, ending_state, debug_msg, detailed_config);
+
+            ASSERT_FALSE(traj.empty());
+            ASSERT_EQ(expected_traj.size(), traj.size());
+            for (size_t i = 0; i < traj.size(); i++)
+            {
+                EXPECT_EQ(expected_traj[i].x, traj[i].x);
+                EXPECT_EQ(expected_traj[i].y, traj[i].y);
+                EXPECT_EQ(expected_traj[i].yaw, traj[i].yaw);
+                EXPECT_EQ(expected_traj[i].target_time, traj[i].target_time);
+            }
+        }
+
+        auto stats = engine.getStats();
+        EXPECT_EQ(1u, stats.horizon_builds);
+        EXPECT_LT(0u, stats.centerline_hits);
+        EXPECT_LE(1u, stats.curve_hits); // The repeated state reuses the previous fit
+
+        // Lanelet queries match the world model
+        auto expected_lanelets = wm->getLaneletsBetween(5.0, 60.0, true, true);
+        auto lanelets = engine.getLaneletsBetween(wm, 5.0, 60.0);
+        ASSERT_EQ(expected_lanelets.size(), lanelets.size());
+        for (size_t i = 0; i < lanelets.size(); i++)
+        {
+            EXPECT_EQ(expected_lanelets[i].id(), lanelets[i].id());
+        }
+        EXPECT_THROW(engine.getLaneletsBetween(wm, 10.0, 5.0), std::invalid_argument);
+
+        // A new route discards the cached horizon
+        carma_wm::test::setRouteByIds({ 1200, 1201, 1202, 1203 }, wm);
+        engine.getLaneletsBetween(wm, 5.0, 60.0);
+        EXPECT_EQ(2u, engine.getStats().horizon_builds);
+
+        // So does a map update which keeps the map version, such as a geofence
+        wm->setMap(wm->getMutableMap(), wm->getMapVersion(), false);
+        engine.getLaneletsBetween(wm, 5.0, 60.0);
+        EXPECT_EQ(3u, engine.getStats().horizon_builds);
+    }
+
+    TEST(BasicAutonomyTest, trajectory_generation_engine_reuses_overlapping_fits)
+    {
+        std::shared_ptr<carma_wm::CARMAWorldModel> wm = std::make_shared<carma_wm::CARMAWorldModel>();
+        auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25, 10);
+        wm->setMap(map);
+        carma_wm::test::setSpeedLimit(25_mph, wm);
+        carma_wm::test::setRouteByIds({ 1200, 1201, 1202, 1203 }, wm);
+
+        waypoint_generation::GeneralTrajConfig general_config = waypoint_generation::compose_general_trajectory_config("inlanecruising", 2, 1);
+        waypoint_generation::DetailedTrajConfig detailed_config = waypoint_generation::compose_detailed_trajectory_config(6.0, 1.0, 2.2352, 2.0, 2.5, 5, 9, 20.0, 20.0);
+
+        cav_msgs::Maneuver maneuver;
+        maneuver.type = cav_msgs::Maneuver::LANE_FOLLOWING;
+        maneuver.lane_following_maneuver.lane_ids = { "1200", "1201", "1202" };
+        maneuver.lane_following_maneuver.start_dist = 0.0;
+        maneuver.lane_following_maneuver.end_dist = 70.0;
+        maneuver.lane_following_maneuver.end_speed = 10.0;
+        std::vector<cav_msgs::Maneuver> maneuvers = { maneuver };
+
+        waypoint_generation::TrajectoryGenerationEngine engine(4, 8);
+
+        // The vehicle advances along the straight lane. Trajectories cut from an earlier fit stay on the lane centerline and
+        // end where the uncached trajectory ends, to within a resample step
+        size_t states = 0;
+        for (double y = 10.0; y <= 30.0; y += 1.0, states++)
+        {
+            cav_msgs::VehicleState state;
+            state.x_pos_global = 1.85;
+            state.y_pos_global = y;
+            state.orientation = M_PI / 2.0;
+            state.longitudinal_vel = 8.0;
+            double max_starting_downtrack = std::max(0.0, wm->routeTrackPos(lanelet::BasicPoint2d(state.x_pos_global, state.y_pos_global)).downtrack - 20.0);
+
+            cav_msgs::VehicleState ending_state;
+            auto points = engine.create_geometry_profile(maneuvers, max_starting_downtrack, wm, ending_state, state, general_config, detailed_config);
+
+            carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg;
+            auto expected_traj = waypoint_generation::compose_lanefollow_trajectory_from_path(points, state, ros::Time(1.0), wm, ending_state,
+                                                                                             debug_msg, detailed_config);
+            auto traj = engine.compose_lanefollow_trajectory_from_path(points, state, ros::Time(1.0), wm, ending_state, debug_msg, detailed_config);
+
+            ASSERT_FALSE(expected_traj.empty());
+            ASSERT_FALSE(traj.empty());
+            EXPECT_NEAR(expected_traj.size(), traj.size(), 2);
+            EXPECT_NEAR(expected_traj.back().y, traj.back().y, 2.0 * detailed_config.curve_resample_step_size);
+            for (size_t i = 1; i < traj.size(); i++)
+            {
+                EXPECT_NEAR(1.85, traj[i].x, 0.001);
+                EXPECT_LT(traj[i - 1].y, traj[i].y);
+                EXPECT_NEAR(M_PI / 2.0, traj[i].yaw, 0.001);
+            }
+        }
+
+        auto stats = engine.getStats();
+        EXPECT_LT(0u, stats.curve_span_hits);
+        EXPECT_GT(states, stats.curve_misses);
+        EXPECT_EQ(1u, stats.horizon_builds);
+
+        // The horizon is trimmed behind the queried span and restarted when a query reaches back past the trimmed part
+        size_t extensions = stats.horizon_extensions;
+        auto lanelets = engine.getLaneletsBetween(wm, 60.0, 70.0);
+        ASSERT_FALSE(lanelets.empty());
+        EXPECT_EQ(1202, lanelets.back().id());
+        EXPECT_EQ(1u, engine.getStats().horizon_builds);
+        EXPECT_EQ(extensions, engine.getStats().horizon_extensions); // The horizon already reaches the end of the route
+
+        auto expected_lanelets = wm->getLaneletsBetween(5.0, 30.0, true, true);
+        lanelets = engine.getLaneletsBetween(wm, 5.0, 30.0);
+        EXPECT_EQ(2u, engine.getStats().horizon_builds);
+        ASSERT_EQ(expected_lanelets.size(), lanelets.size());
+        for (size_t i = 0; i < lanelets.size(); i++)
+        {
+            EXPECT_EQ(expected_lanelets[i].id(), lanelets[i].id());
+        }
+    }
+
+    TEST(BasicAutonomyTest, trajectory_view)
+    {
+        cav_msgs::TrajectoryPlan plan;
+        plan.initial_longitudinal_velocity = 8.5;
+
+        cav_msgs::TrajectoryPlanPoint point;
+        for (auto xyt : std::vector<std::array<double, 3>>{ { 10, 10, 0.1 }, { 12, 12, 0.2 }, { 13, 13, 0.2 }, { 14, 14, 0.3 }, { 14.1, 14.1, 0.4 } })
+        {
+            point.x = xyt[0];
+            point.y = xyt[1];
+            point.target_time = ros::Time(xyt[2]);
+            plan.trajectory_points.push_back(point);
+        }
+
+        TrajectoryView view(plan);
+
+        // The point repeating the 0.2 s timestamp is skipped
+        ASSERT_EQ(4u, view.size());
+        EXPECT_EQ(&plan, &view.plan());
+        EXPECT_EQ(&plan.trajectory_points[3], &view.point(2));
+        EXPECT_EQ(3u, view.plan_index(2));
+
+        const double step = std::sqrt(8.0);
+        ASSERT_EQ(4u, view.downtracks().size());
+        EXPECT_NEAR(0.0, view.downtracks()[0], 0.0000001);
+        EXPECT_NEAR(step, view.downtracks()[1], 0.0000001);
+        EXPECT_NEAR(2 * step, view.downtracks()[2], 0.0000001);
+        EXPECT_NEAR(2.05 * step, view.downtracks()[3], 0.0000001);
+
+        EXPECT_NEAR(0.0, view.times()[0], 0.0000001);
+        EXPECT_NEAR(0.1, view.times()[1], 0.0000001);
+        EXPECT_NEAR(0.2, view.times()[2], 0.0000001);
+        EXPECT_NEAR(0.3, view.times()[3], 0.0000001);
+
+        // Each speed follows from the previous unclamped speed and the average speed over the segment
+        EXPECT_NEAR(8.5, view.speeds()[0], 0.0000001);
+        EXPECT_NEAR(48.068542495, view.speeds()[1], 0.0000001);
+        EXPECT_NEAR(8.5, view.speeds()[2], 0.0000001);
+        EXPECT_NEAR(0.0, view.speeds()[3], 0.0000001); // 2 * 1.41 - 8.5 is negative and clamped to 0
+
+
+        cav_msgs::TrajectoryPlan empty_plan;
+        TrajectoryView empty_view(empty_plan);
+        EXPECT_TRUE(empty_view.empty());
+        EXPECT_TRUE(empty_view.speeds().empty());
+    }
+
 } //basic_autonomy namespace
 
 // Run all the tests
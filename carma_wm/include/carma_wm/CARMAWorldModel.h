@@ -22,6 +22,8 @@
 #include <lanelet2_core/primitives/BasicRegulatoryElements.h>
 #include <lanelet2_core/primitives/LineString.h>
 #include "IndexedDistanceMap.h"
+#include "SpeedLimitProfile.h"
+#include "ObstacleOccupancyIndex.h"
 #include <cav_msgs/ExternalObject.h>
 #include <cav_msgs/ExternalObjectList.h>
 #include <cav_msgs/RoadwayObstacle.h>
@@ -32,6 +34,8 @@
 #include "boost/date_time/posix_time/posix_time.hpp"
 
 #include <carma_wm/SignalizedIntersectionManager.h>
+#include <mutex>
+#include <unordered_map>
 
 namespace carma_wm
 {
@@ -54,6 +58,19 @@ public:
    */
   CARMAWorldModel() = default;
 
+  /**
+   * @brief Copy constructor used to build world model snapshots.
+   *
+   * The copy shares the map, routing graph, route and shortest path views of the original rather than duplicating them.
+   * These are only ever replaced, never modified, by the setters of this class, so later calls to setMap, setRoute or
+   * setRoadwayObjects on either object do not affect the other. Edits made through getMutableMap() are visible to both.
+   *
+   * @param other The world model to copy
+   */
+  CARMAWorldModel(const CARMAWorldModel& other);
+
+  CARMAWorldModel& operator=(const CARMAWorldModel&) = delete;
+
   /**
    * @brief Destructor as required by interface
    *
@@ -83,12 +100,22 @@ public:
   /*! \brief Get a mutable version of the current map
    * 
    *  NOTE: the user must make sure to setMap() after any edit to the map and to set a valid route
+   *        If the regulations of route lanelets were edited, updateRouteSpeedLimits() should also be called for those lanelets
    */
   lanelet::LaneletMapPtr getMutableMap() const;
 
+  /*! \brief Recomputes the route speed limit profile entries of the provided lanelets from the current traffic rules.
+   *         Should be called after setMap() when a map update changes the regulatory elements of lanelets in place.
+   *         Lanelets which are not on the shortest path of the route are ignored.
+   *
+   *  \param lanelet_ids The ids of the lanelets whose regulations may have changed
+   */
+  void updateRouteSpeedLimits(const std::vector<lanelet::Id>& lanelet_ids);
+
   /*! \brief Update internal records of roadway objects. These objects MUST be guaranteed to be on the road. 
    * 
    * These are detected by the sensor fusion node and are passed as objects compatible with lanelet 
+   * The occupancy index used by getObjectsInLaneInterval is rebuilt from the new objects
    */
   void setRoadwayObjects(const std::vector<cav_msgs::RoadwayObstacle>& rw_objs);
 
@@ -203,10 +230,14 @@ public:
   lanelet::Optional<TrafficRulesConstPtr>
   getTrafficRules() const override;
 
+  const SpeedLimitProfile& getRouteSpeedLimitProfile() const override;
+
   std::vector<cav_msgs::RoadwayObstacle> getRoadwayObjects() const override;
 
   std::vector<cav_msgs::RoadwayObstacle> getInLaneObjects(const lanelet::ConstLanelet& lanelet, const LaneSection& section = LANE_AHEAD) const override;
 
+  std::vector<cav_msgs::RoadwayObstacle> getObjectsInLaneInterval(const std::vector<lanelet::ConstLanelet>& lane, double start_downtrack, double end_downtrack, const ros::Time& start_time, const ros::Time& end_time) const override;
+
   lanelet::Optional<lanelet::Lanelet> getIntersectingLanelet (const cav_msgs::ExternalObject& object) const override;
 
   lanelet::Optional<cav_msgs::RoadwayObstacle> toRoadwayObstacle(const cav_msgs::ExternalObject& object) const override;
@@ -221,6 +252,8 @@ public:
 
   size_t getMapVersion() const override;
 
+  size_t getMapUpdateCount() const override;
+
   std::vector<lanelet::ConstLanelet> getLaneletsFromPoint(const lanelet::BasicPoint2d& point, const unsigned int n = 10) const override;
 
   std::vector<lanelet::ConstLanelet> nonConnectedAdjacentLeft(const lanelet::BasicPoint2d& input_point, const unsigned int n = 10) const override;
@@ -250,6 +283,13 @@ private:
    */
   void computeDowntrackReferenceLine();
 
+  /*! \brief Helper function to compute the speed limit of every lanelet on the shortest path of the route.
+   *         Uses the route_ and shortest_path_distance_map_ member variables so should be called after computeDowntrackReferenceLine
+   *
+   *  Sets the route_speed_limits_ member variable
+   */
+  void computeRouteSpeedLimitProfile();
+
   /*! \brief Helper function to perform a deep copy of a LineString and assign new ids to all the elements. Used during
    * route centerline construction
    *
@@ -263,16 +303,25 @@ private:
   LaneletRoutePtr route_;
   LaneletRoutingGraphPtr map_routing_graph_;
   double route_length_ = 0;
-  lanelet::LaneletSubmapConstUPtr shortest_path_view_;  // Map containing only lanelets along the shortest path of the
+  lanelet::LaneletSubmapConstPtr shortest_path_view_;   // Map containing only lanelets along the shortest path of the
                                                      // route
   std::vector<lanelet::LineString3d> shortest_path_centerlines_;  // List of disjoint centerlines seperated by lane
                                                                   // changes along the shortest path
   IndexedDistanceMap shortest_path_distance_map_;
-  lanelet::LaneletMapUPtr shortest_path_filtered_centerline_view_;  // Lanelet map view of shortest path center lines
+  lanelet::LaneletMapPtr shortest_path_filtered_centerline_view_;   // Lanelet map view of shortest path center lines
                                                                     // only
   std::vector<cav_msgs::RoadwayObstacle> roadway_objects_; // 
+  ObstacleOccupancyIndex roadway_object_index_; // Predicted footprints of roadway_objects_. Rebuilt in setRoadwayObjects
+
+  SpeedLimitProfile route_speed_limits_; // Speed limit of each shortest path lanelet along the route downtrack
+
+  // Traffic rules objects are stateless for a given participant and config speed limit so they are built once and shared.
+  // The cache is cleared whenever the map or config speed limit change. Guarded by traffic_rules_mutex_ as getTrafficRules is const
+  mutable std::unordered_map<std::string, lanelet::Optional<TrafficRulesConstPtr>> traffic_rules_cache_;
+  mutable std::mutex traffic_rules_mutex_;
 
   size_t map_version_ = 0; // The current map version. This is cached from calls to setMap();
+  size_t map_update_count_ = 0; // Incremented by every call to setMap();
 
   std::string route_name_; // The current route name. This is set from calls to setRouteName();
   
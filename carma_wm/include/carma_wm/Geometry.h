@@ -88,6 +88,19 @@ TrackPos trackPos(const lanelet::BasicPoint2d& p, const lanelet::BasicPoint2d& s
 std::tuple<TrackPos, lanelet::BasicSegment2d> matchSegment(const lanelet::BasicPoint2d& p,
                                                            const lanelet::BasicLineString2d& line_string);
 
+/*! \brief Segment selection rule used by matchSegment once the nearest linestring point is found. Chooses between the
+ * segment ending at the nearest point and the segment starting at it.
+ *
+ * \param first_seg_trackPos The TrackPos of the external point relative to the preceeding segment
+ * \param second_seg_trackPos The TrackPos of the external point relative to the succeeding segment
+ * \param first_seg_length The length of the preceeding segment
+ * \param second_seg_length The length of the succeeding segment
+ *
+ * \return True if the preceeding segment is the better choice. False if the succeeding segment is the better choice.
+ */
+bool selectFirstSegment(const TrackPos& first_seg_trackPos, const TrackPos& second_seg_trackPos,
+                        double first_seg_length, double second_seg_length);
+
 /*! \brief Returns a list of local (computed by discrete derivative)
  * curvatures for the input centerlines. The list of returned curvatures matches
  * 1-to-1 with with list of points in the input centerlines.
@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/BoundingBox.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+namespace carma_wm
+{
+/*!
+ * \brief Uniform grid of the lanelets in a map, used to find the lanelets containing a point without searching the map.
+ *
+ * Each lanelet is added to every cell its 2d bounding box overlaps and the bounding box is cached, so a point lookup only
+ * evaluates the few lanelets of one cell and the bounds of a lanelet can be read without recomputing them.
+ * The index does not observe the map. It must be rebuilt when a new map is loaded and new lanelets must be inserted as they
+ * are added. The geometry of indexed lanelets is assumed not to change.
+ */
+class LaneletGridIndex
+{
+public:
+  /*!
+   * \brief Constructor
+   *
+   * \param cell_size The side length of a grid cell in m
+   *
+   * \throws std::invalid_argument if cell_size is not positive
+   */
+  explicit LaneletGridIndex(double cell_size = 20.0);
+
+  /*!
+   * \brief Replaces the contents of the index with every lanelet of the provided map
+   *
+   * \param map The map to index
+   */
+  void build(const lanelet::LaneletMapPtr& map);
+
+  /*!
+   * \brief Adds a lanelet to the index. Lanelets which are already in the index are ignored
+   *
+   * \param lanelet The lanelet to add
+   */
+  void insert(const lanelet::Lanelet& lanelet);
+
+  /*!
+   * \brief Returns the lanelets whose polygon contains the provided point, including points on the polygon boundary.
+   * This is the set of lanelets lanelet::geometry::findNearest reports at a distance of 0.
+   *
+   * \param point The point to look up in the map frame
+   *
+   * \return The containing lanelets in no particular order
+   */
+  std::vector<lanelet::Lanelet> containingLanelets(const lanelet::BasicPoint2d& point) const;
+
+  /*!
+   * \brief Returns the cached 2d bounding box of an indexed lanelet
+   *
+   * \param lanelet_id The id of the lanelet
+   *
+   * \throws std::invalid_argument if the lanelet is not in the index
+   */
+  const lanelet::BoundingBox2d& boundingBox(lanelet::Id lanelet_id) const;
+
+  /*!
+   * \brief Returns the 2d bounding box of a lanelet, read from the index if the lanelet is indexed and computed from its
+   * geometry otherwise, such as for a lanelet added to the map after the index was built
+   *
+   * \param lanelet The lanelet
+   */
+  lanelet::BoundingBox2d boundingBox(const lanelet::ConstLanelet& lanelet) const;
+
+  /*!
+   * \brief Removes all lanelets from the index
+   */
+  void clear();
+
+  /*!
+   * \brief Returns the number of indexed lanelets
+   */
+  size_t size() const;
+
+  /*!
+   * \brief Returns true if no lanelets are indexed
+   */
+  bool empty() const;
+
+private:
+  int64_t cellIndex(double coordinate) const;
+  static uint64_t cellKey(int64_t x_index, int64_t y_index);
+
+  double cell_size_;
+  std::unordered_map<uint64_t, std::vector<lanelet::Lanelet>> cells_;
+  std::unordered_map<lanelet::Id, lanelet::BoundingBox2d> bounding_boxes_;
+};
+}  // namespace carma_wm
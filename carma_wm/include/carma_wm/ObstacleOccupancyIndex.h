@@ -0,0 +1,149 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/optional.hpp>
+#include <cav_msgs/RoadwayObstacle.h>
+#include <lanelet2_core/Forward.h>
+
+namespace carma_wm
+{
+/*!
+ * \brief The region of a single lanelet occupied by an obstacle over a time interval.
+ *
+ * Downtracks are relative to the start of the lanelet centerline, as in the down_track and predicted_down_tracks fields
+ * of cav_msgs::RoadwayObstacle. Times are in seconds on the clock of the obstacle message stamps.
+ */
+struct ObstacleFootprint
+{
+  size_t obstacle_index = 0;  // Index of the obstacle in the vector the index was built from
+  lanelet::Id lanelet_id = lanelet::InvalId;
+  double start_downtrack = 0;
+  double end_downtrack = 0;
+  double start_time = 0;
+  double end_time = 0;
+};
+
+/*!
+ * \brief Spatio-temporal index of the current and predicted footprints of roadway obstacles.
+ *
+ * Each obstacle is sampled at its current state, stamped by the object header, and at each of its predictions, stamped
+ * by the prediction header. A sample occupies its lanelet over the downtrack interval covered by the obstacle's bounding
+ * circle, from its own time until the time of the next sample. When the next sample is in the same lanelet the interval
+ * is widened to include it, so the footprint covers the distance swept between the two samples. When the obstacle
+ * changes lanelet both samples occupy their lanelet for the whole time between them.
+ *
+ * Footprints are bucketed by lanelet, downtrack bin and time bin, so an occupancy query only evaluates the footprints
+ * which share a bucket with the queried region. The index keeps no reference to the obstacles and must be rebuilt when
+ * they change.
+ */
+class ObstacleOccupancyIndex
+{
+public:
+  /*!
+   * \brief Constructor
+   *
+   * \param downtrack_bin_size The length of a downtrack bin in m
+   * \param time_bin_size The duration of a time bin in s
+   *
+   * \throws std::invalid_argument if either bin size is not positive
+   */
+  explicit ObstacleOccupancyIndex(double downtrack_bin_size = 10.0, double time_bin_size = 1.0);
+
+  /*!
+   * \brief Replaces the contents of the index with the footprints of the provided obstacles
+   *
+   * \param obstacles The obstacles to index. Predictions beyond the length of the predicted_lanelet_ids or
+   * predicted_down_tracks fields are ignored
+   */
+  void build(const std::vector<cav_msgs::RoadwayObstacle>& obstacles);
+
+  /*!
+   * \brief Returns the obstacles which occupy part of a lanelet's downtrack interval at some point during a time window.
+   * Intervals are closed so footprints which only touch the queried region are included.
+   *
+   * \param lanelet_id The lanelet to query
+   * \param start_downtrack The start of the downtrack interval relative to the start of the lanelet centerline in m
+   * \param end_downtrack The end of the downtrack interval in m
+   * \param start_time The start of the time window in s
+   * \param end_time The end of the time window in s
+   *
+   * \return The indexes of the occupying obstacles in the vector the index was built from, in increasing order
+   */
+  std::vector<size_t> occupyingObstacles(lanelet::Id lanelet_id, double start_downtrack, double end_downtrack,
+                                         double start_time, double end_time) const;
+
+  /*!
+   * \brief Returns the downtrack interval covered by the footprints of a lanelet. Footprints can extend before the start
+   * or past the end of their lanelet, into the neighbouring lanelets.
+   *
+   * \param lanelet_id The lanelet to query
+   *
+   * \return The smallest start and largest end downtrack of the footprints on the lanelet, relative to the start of the
+   * lanelet centerline. boost::none if no footprints are on the lanelet
+   */
+  boost::optional<std::pair<double, double>> downtrackExtent(lanelet::Id lanelet_id) const;
+
+  /*!
+   * \brief Returns every indexed footprint
+   */
+  const std::vector<ObstacleFootprint>& footprints() const;
+
+  /*!
+   * \brief Removes all footprints from the index
+   */
+  void clear();
+
+  /*!
+   * \brief Returns the number of indexed footprints
+   */
+  size_t size() const;
+
+  /*!
+   * \brief Returns true if no footprints are indexed
+   */
+  bool empty() const;
+
+private:
+  struct LaneletBuckets
+  {
+    std::vector<size_t> footprints;  // Every footprint on the lanelet
+    std::vector<size_t> unbucketed;  // Footprints spanning too many buckets to be added to each of them
+    std::unordered_map<uint64_t, std::vector<size_t>> buckets;
+    double min_downtrack = std::numeric_limits<double>::infinity();
+    double max_downtrack = -std::numeric_limits<double>::infinity();
+  };
+
+  void insert(const ObstacleFootprint& footprint);
+  int64_t downtrackBin(double downtrack) const;
+  int64_t timeBin(double time) const;
+  static uint64_t bucketKey(int64_t downtrack_bin, int64_t time_bin);
+  static bool overlaps(const ObstacleFootprint& footprint, double start_downtrack, double end_downtrack,
+                       double start_time, double end_time);
+
+  double downtrack_bin_size_;
+  double time_bin_size_;
+  double reference_time_ = 0;  // Time bins are counted from the earliest sample so message stamps fit in 32 bits
+  std::vector<ObstacleFootprint> footprints_;
+  std::unordered_map<lanelet::Id, LaneletBuckets> lanelets_;
+};
+}  // namespace carma_wm
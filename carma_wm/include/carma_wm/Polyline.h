@@ -0,0 +1,162 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <tuple>
+#include <vector>
+#include <lanelet2_core/primitives/LineString.h>
+#include <lanelet2_core/primitives/Point.h>
+#include "TrackPos.h"
+
+namespace carma_wm
+{
+namespace geometry
+{
+/*! \brief A 2d polyline stored as separate arrays of x and y coordinates along with the length of each segment and the
+ * arc length to each point.
+ *
+ * The structure of arrays layout lets the polyline kernels below process several points per instruction. The segment
+ * and arc lengths are computed once when the points are assigned. Assigning new points reuses the existing storage, so
+ * a Polyline2d kept between planning cycles does not allocate once it has grown to the largest trajectory size.
+ */
+class Polyline2d
+{
+public:
+  Polyline2d() = default;
+
+  /*! \brief Constructor
+   *
+   * \param points The points of the polyline
+   */
+  explicit Polyline2d(const lanelet::BasicLineString2d& points);
+
+  explicit Polyline2d(const std::vector<lanelet::BasicPoint2d>& points);
+
+  /*! \brief Replaces the points of the polyline
+   *
+   * \param points The new points of the polyline
+   */
+  void assign(const lanelet::BasicLineString2d& points);
+
+  void assign(const std::vector<lanelet::BasicPoint2d>& points);
+
+  /*! \brief Returns the number of points
+   */
+  size_t size() const;
+
+  /*! \brief Returns true if the polyline has no points
+   */
+  bool empty() const;
+
+  /*! \brief Returns the point at the provided index
+   */
+  lanelet::BasicPoint2d point(size_t index) const;
+
+  /*! \brief Returns the x coordinates of the points
+   */
+  const std::vector<double>& x() const;
+
+  /*! \brief Returns the y coordinates of the points
+   */
+  const std::vector<double>& y() const;
+
+  /*! \brief Returns the length of each segment. Element i is the length of the segment from point i to point i + 1
+   */
+  const std::vector<double>& segmentLengths() const;
+
+  /*! \brief Returns the arc length from the first point to each point. Matches compute_arc_lengths
+   */
+  const std::vector<double>& arcLengths() const;
+
+private:
+  template <class P, class A>
+  void assignPoints(const std::vector<P, A>& points);
+
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> segment_lengths_;
+  std::vector<double> arc_lengths_;
+};
+
+/*! \brief Output buffers of computePolylineMetrics. Each vector has one element per polyline point.
+ *
+ * The buffers are resized by computePolylineMetrics, which reuses their storage when the same object is passed again.
+ */
+struct PolylineMetrics
+{
+  // Finite difference tangent at each point. Matches compute_finite_differences
+  std::vector<double> tangent_x;
+  std::vector<double> tangent_y;
+  // Unit length tangent at each point. Matches normalize_vectors applied to the tangents
+  std::vector<double> unit_tangent_x;
+  std::vector<double> unit_tangent_y;
+  // Heading of the tangent at each point. Matches compute_tangent_orientations
+  std::vector<double> headings;
+  // Curvature at each point. Matches local_curvatures
+  std::vector<double> curvatures;
+};
+
+/*! \brief Computes the tangents, headings and curvatures of a polyline into preallocated buffers.
+ *
+ * This is the combined equivalent of compute_finite_differences, normalize_vectors, compute_tangent_orientations and
+ * local_curvatures on the same points, without the intermediate vectors those functions allocate. The arc lengths
+ * are available from the polyline itself. Apart from the heading calculation, which calls atan2, the per point loops
+ * have no branches or cross iteration dependencies so the compiler vectorizes them.
+ *
+ * \param polyline The polyline to compute the metrics of
+ * \param metrics The buffers to write the results into
+ *
+ * \throw std::invalid_argument If the polyline has fewer than 2 points
+ */
+void computePolylineMetrics(const Polyline2d& polyline, PolylineMetrics& metrics);
+
+/*! \brief Returns the index of the polyline point nearest to the provided point. The first point is returned if
+ * several points are equally near, matching the vertex search in matchSegment.
+ *
+ * \param polyline The polyline to search
+ * \param p The point to find the nearest polyline point of
+ *
+ * \throw std::invalid_argument If the polyline is empty
+ */
+size_t nearestPointIndex(const Polyline2d& polyline, const lanelet::BasicPoint2d& p);
+
+/*! \brief Equivalent of matchSegment for a Polyline2d. Uses the vectorized nearest point search and the precomputed
+ * arc lengths of the polyline, then applies the same segment selection rules.
+ *
+ * \param p The 2d point to match with a segment
+ * \param polyline The polyline to match against
+ *
+ * \throw std::invalid_argument If the polyline contains fewer than 2 points
+ *
+ * \return An std::tuple where the first element is the TrackPos of the point and the second element is the index of
+ * the first point of the matched segment
+ */
+std::tuple<TrackPos, size_t> matchSegment(const lanelet::BasicPoint2d& p, const Polyline2d& polyline);
+
+/*! \brief Returns the TrackPos of the provided point relative to the polyline. Equivalent to the TrackPos returned by
+ * matchSegment.
+ *
+ * \param polyline The polyline which will serve as the TrackPos reference line
+ * \param p The point to compute the TrackPos of
+ *
+ * \throw std::invalid_argument If the polyline contains fewer than 2 points
+ */
+TrackPos trackPos(const Polyline2d& polyline, const lanelet::BasicPoint2d& p);
+
+}  // namespace geometry
+
+}  // namespace carma_wm
@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <vector>
+#include <unordered_map>
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_core/utility/Optional.h>
+
+namespace carma_wm
+{
+/*!
+ * \brief Piecewise constant speed limit along the route downtrack.
+ *
+ * Holds one segment per lanelet on the shortest path of the route, in route order. Each segment starts at the route
+ * downtrack of its lanelet and applies until the start of the next segment. The last segment applies to the end of the
+ * route. Segments are stored in parallel arrays so a query by downtrack is a binary search and a query by lanelet id is a
+ * hash lookup. Individual segments can be updated in place when the regulations of their lanelet change.
+ */
+class SpeedLimitProfile
+{
+public:
+  /*!
+   * \brief Removes all segments
+   */
+  void clear();
+
+  /*!
+   * \brief Appends a segment to the end of the profile
+   *
+   * \param lanelet_id The id of the lanelet the segment covers
+   * \param start_downtrack The route downtrack at which the segment begins in m
+   * \param speed_limit The speed limit of the segment in m/s
+   *
+   * \throws std::invalid_argument if the lanelet already has a segment or start_downtrack is less than the start of the
+   * previous segment
+   */
+  void pushBack(lanelet::Id lanelet_id, double start_downtrack, double speed_limit);
+
+  /*!
+   * \brief Updates the speed limit of the segment for the provided lanelet
+   *
+   * \param lanelet_id The lanelet id
+   * \param speed_limit The new speed limit in m/s
+   *
+   * \return True if the lanelet has a segment in this profile. False if it does not, in which case nothing is changed
+   */
+  bool update(lanelet::Id lanelet_id, double speed_limit);
+
+  /*!
+   * \brief Returns the speed limit at the provided route downtrack. Downtracks before the first segment use the first
+   * segment and downtracks after the last segment use the last segment
+   *
+   * \throws std::invalid_argument if the profile is empty
+   *
+   * \param downtrack The route downtrack in m
+   *
+   * \return The speed limit in m/s
+   */
+  double speedLimitAt(double downtrack) const;
+
+  /*!
+   * \brief Returns the speed limit of the segment for the provided lanelet
+   *
+   * \param lanelet_id The lanelet id
+   *
+   * \return The speed limit in m/s, or an empty optional if the lanelet has no segment in this profile
+   */
+  lanelet::Optional<double> speedLimit(lanelet::Id lanelet_id) const;
+
+  /*!
+   * \brief Returns the start downtrack of each segment in route order
+   */
+  const std::vector<double>& startDowntracks() const;
+
+  /*!
+   * \brief Returns the speed limit of each segment in route order
+   */
+  const std::vector<double>& speedLimits() const;
+
+  /*!
+   * \brief Returns the lanelet id of each segment in route order
+   */
+  const std::vector<lanelet::Id>& laneletIds() const;
+
+  /*!
+   * \brief Returns the number of segments
+   */
+  size_t size() const;
+
+  /*!
+   * \brief Returns true if the profile has no segments
+   */
+  bool empty() const;
+
+private:
+  std::vector<double> start_downtracks_;
+  std::vector<double> speed_limits_;
+  std::vector<lanelet::Id> lanelet_ids_;
+  std::unordered_map<lanelet::Id, size_t> id_index_map_;
+};
+}  // namespace carma_wm
@@ -36,7 +36,7 @@ class WMListenerWorker;  // Forward declaration of worker class
  * They can then retrieve a pointer to an initialized WorldModel object for doing queries.
  * By default this class follows the threading model of the host node, but it can operate in the background if specified
  * in the constructor. When used in a multi-threading case users can ensure threadsafe operation though usage of the
- * getLock function
+ * getLock function, or avoid locking entirely by enabling snapshots and querying getWorldModelSnapshot()
  *
  * NOTE: At the moment the mechanism of route communication in ROS is not defined therefore it is a TODO: to implement
  * full route support
@@ -51,8 +51,11 @@ public:
    * If the object is operating in multi-threaded mode a ros::AsyncSpinner is used to implement a background thread.
    *
    * \param multi_thread If true this object will subscribe using background threads. Defaults to false
+   * \param use_snapshots If true immutable snapshots of the world model are published for use with
+   * getWorldModelSnapshot(). A map update received after a snapshot was read copies the map and rebuilds the routing
+   * graph, at most once between two reads. Defaults to false
    */
-  WMListener(bool multi_thread = false);
+  WMListener(bool multi_thread = false, bool use_snapshots = false);
 
   /*! \brief Destructor
    */
@@ -65,6 +68,21 @@ public:
    */
   WorldModelConstPtr getWorldModel();
 
+  /*!
+   * \brief Returns the latest immutable snapshot of the world model without locking.
+   *
+   * Unlike the object returned by getWorldModel(), a snapshot is never modified by later updates, so users should
+   * retrieve one at the start of each planning cycle and use it for every query in that cycle. The only state which may
+   * change under a snapshot is traffic signal timing received from SPAT messages.
+   * A new snapshot is published by the first call after the world model changes. If an update is being applied at that
+   * time the previous snapshot is returned instead of waiting. The map and route callbacks should use getWorldModel().
+   *
+   * \throws std::invalid_argument if this object was not constructed with use_snapshots set to true
+   *
+   * \return Const pointer to the latest world model snapshot
+   */
+  WorldModelConstPtr getWorldModelSnapshot() const;
+
   /*!
    * \brief Allows user to set a callback to be triggered when a map update is received
    *        NOTE: If operating in multi-threaded mode the world model will remain locked until the user function
@@ -400,8 +400,10 @@ inline void setSpeedLimit (lanelet::Velocity speed_limit, std::shared_ptr<carma_
     throw std::invalid_argument("setSpeedLimit: Map is not set or does not contain lanelets");
   }
   // remove all speed limit regulatory element and set the new speed limit
+  std::vector<lanelet::Id> updated_lanelets;
   for (auto llt : cmw->getMutableMap()->laneletLayer)
   {
+    updated_lanelets.push_back(llt.id());
     for (auto regem : llt.regulatoryElements())
     {
       if (regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::DigitalSpeedLimit::RuleName) == 0)
@@ -413,6 +415,7 @@ inline void setSpeedLimit (lanelet::Velocity speed_limit, std::shared_ptr<carma_
                                                      { lanelet::Participants::Vehicle }));
     cmw->getMutableMap()->update(llt, sl);
   }
+  cmw->updateRouteSpeedLimits(updated_lanelets);
   ROS_INFO_STREAM("Set the new speed limit! Value: " << speed_limit.value());
 }
 
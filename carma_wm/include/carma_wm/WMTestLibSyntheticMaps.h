@@ -0,0 +1,404 @@
+#pragma once
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <carma_wm/CARMAWorldModel.h>
+#include <carma_wm/MapConformer.h>
+#include <cav_msgs/ExternalObject.h>
+#include <cav_msgs/SPAT.h>
+#include <lanelet2_core/Attribute.h>
+#include <lanelet2_core/utility/Units.h>
+#include <lanelet2_extension/regulatory_elements/CarmaTrafficSignal.h>
+
+/**
+ * This is a test library for building world models of realistic size, for benchmarks and scaling tests. Unlike the
+ * small maps of WMTestLibForGuidance.h, the maps are several kilometers long with several lanes, traffic signals along
+ * every road, a route and a population of external objects.
+ *
+ * Two layouts are supported:
+ * - CORRIDOR: A single straight multi-lane road along the x axis
+ * - GRID: Eastbound and northbound multi-lane roads crossing each other at regular intervals. The roads overlap at the
+ *         intersections but are not connected to each other, so routes follow a single road
+ *
+ * Generation is deterministic for a given seed.
+ */
+namespace carma_wm
+{
+namespace test
+{
+/**
+ * \brief Options controlling the size and content of a synthetic world
+ */
+struct SyntheticMapOptions
+{
+  enum class Layout
+  {
+    CORRIDOR,
+    GRID
+  };
+
+  Layout layout = Layout::CORRIDOR;
+  double road_length = 5000;     // Length of each road in m
+  int grid_road_count = 4;       // Number of roads in each direction for the GRID layout
+  int lane_count = 3;            // Lanes per road, all in the direction of travel
+  double lane_width = 3.7;       // m
+  double lanelet_length = 50;    // Length of each lanelet along the road in m
+  double point_spacing = 5;      // Spacing of the bound points in m
+  double signal_spacing = 500;   // Distance between signalized stop lines along each road in m. 0 disables signals
+  int object_count = 200;        // Number of external objects spread over all roads
+  int prediction_count = 10;     // Predicted states per object
+  double prediction_period = 0.5;  // Time between predicted states in s
+  unsigned int seed = 0;
+};
+
+/**
+ * \brief A world model built from SyntheticMapOptions along with the inputs needed to exercise it
+ */
+struct SyntheticWorld
+{
+  std::shared_ptr<carma_wm::CARMAWorldModel> world_model;
+  lanelet::LaneletMapPtr map;
+  std::vector<std::vector<std::vector<lanelet::Id>>> lanelet_ids;  // Lanelet ids indexed by [road][lane][segment]
+  std::vector<lanelet::Id> route_ids;  // Start and end lanelet of the route, which follows the first lane of road 0
+  std::vector<cav_msgs::ExternalObject> objects;  // The objects stored in the world model before conversion
+  cav_msgs::SPAT spat;  // A SPaT message covering every signal. See updateSyntheticSpat
+  size_t signal_count = 0;
+};
+
+/**
+ * \brief Returns the start point and unit direction of each road of the layout
+ */
+inline std::vector<std::pair<lanelet::BasicPoint2d, lanelet::BasicPoint2d>>
+getSyntheticRoadAxes(const SyntheticMapOptions& options)
+{
+  std::vector<std::pair<lanelet::BasicPoint2d, lanelet::BasicPoint2d>> axes;
+  if (options.layout == SyntheticMapOptions::Layout::CORRIDOR)
+  {
+    axes.emplace_back(lanelet::BasicPoint2d(0, 0), lanelet::BasicPoint2d(1, 0));
+    return axes;
+  }
+
+  // Roads cross every road_spacing m so signals line up with the intersections when signal_spacing matches it
+  double road_spacing = options.road_length / (options.grid_road_count + 1);
+  for (int i = 1; i <= options.grid_road_count; i++)
+  {
+    axes.emplace_back(lanelet::BasicPoint2d(0, i * road_spacing), lanelet::BasicPoint2d(1, 0));
+  }
+  for (int i = 1; i <= options.grid_road_count; i++)
+  {
+    axes.emplace_back(lanelet::BasicPoint2d(i * road_spacing, 0), lanelet::BasicPoint2d(0, 1));
+  }
+  return axes;
+}
+
+/**
+ * \brief Sets the phase and end time of every movement of a SPaT message built by buildSyntheticWorld.
+ *        All signals follow the same 20 s green, 4 s yellow, 20 s red cycle offset by their signal group
+ *
+ * \param spat The message to update
+ * \param time_s The time of the message in seconds since the most recent full hour
+ */
+inline void updateSyntheticSpat(cav_msgs::SPAT& spat, double time_s)
+{
+  constexpr double GREEN_DURATION = 20;
+  constexpr double YELLOW_DURATION = 4;
+  constexpr double CYCLE_DURATION = 44;
+
+  for (auto& intersection : spat.intersection_state_list)
+  {
+    for (auto& movement : intersection.movement_list)
+    {
+      double cycle_start = std::floor((time_s + movement.signal_group) / CYCLE_DURATION) * CYCLE_DURATION;
+      double cycle_time = time_s + movement.signal_group - cycle_start;
+
+      lanelet::CarmaTrafficSignalState state = lanelet::CarmaTrafficSignalState::STOP_AND_REMAIN;
+      double phase_end = cycle_start + CYCLE_DURATION;
+      if (cycle_time < GREEN_DURATION)
+      {
+        state = lanelet::CarmaTrafficSignalState::PROTECTED_MOVEMENT_ALLOWED;
+        phase_end = cycle_start + GREEN_DURATION;
+      }
+      else if (cycle_time < GREEN_DURATION + YELLOW_DURATION)
+      {
+        state = lanelet::CarmaTrafficSignalState::PROTECTED_CLEARANCE;
+        phase_end = cycle_start + GREEN_DURATION + YELLOW_DURATION;
+      }
+
+      auto& event = movement.movement_event_list.front();
+      event.event_state.movement_phase_state = static_cast<uint8_t>(state);
+      event.timing.min_end_time = phase_end - movement.signal_group;
+    }
+  }
+}
+
+/**
+ * \brief Builds the lanelets of a synthetic map, with a traffic signal per lane at every signalized stop line
+ *
+ * \param options The size of the map
+ * \param[out] lanelet_ids The lanelet ids indexed by [road][lane][segment]
+ * \param[out] signals The traffic signals added to the map, each controlling a single lane
+ *
+ * \return The map, made compliant with the MapConformer
+ */
+inline lanelet::LaneletMapPtr buildSyntheticMap(const SyntheticMapOptions& options,
+                                                std::vector<std::vector<std::vector<lanelet::Id>>>& lanelet_ids,
+                                                std::vector<std::shared_ptr<lanelet::CarmaTrafficSignal>>& signals)
+{
+  using namespace lanelet::units::literals;
+
+  if (options.lane_count < 1 || options.lanelet_length <= 0 || options.point_spacing <= 0 ||
+      options.road_length < options.lanelet_length)
+  {
+    throw std::invalid_argument("Invalid synthetic map options");
+  }
+
+  const int segment_count = static_cast<int>(options.road_length / options.lanelet_length);
+  const int points_per_segment = std::max(1, static_cast<int>(std::round(options.lanelet_length / options.point_spacing)));
+  const double step = options.lanelet_length / points_per_segment;
+  const double road_half_width = 0.5 * options.lane_count * options.lane_width;
+
+  std::vector<lanelet::Lanelet> lanelets;
+  lanelet_ids.clear();
+  signals.clear();
+
+  for (const auto& axis : getSyntheticRoadAxes(options))
+  {
+    const lanelet::BasicPoint2d& origin = axis.first;
+    const lanelet::BasicPoint2d& direction = axis.second;
+    const lanelet::BasicPoint2d left(-direction.y(), direction.x());
+
+    // Bound b lies b lane widths to the left of the right edge of the road. Points are shared between consecutive
+    // lanelets and bound linestrings between adjacent lanes so the routing graph connects them
+    std::vector<std::vector<lanelet::LineString3d>> bounds(options.lane_count + 1);
+    for (int b = 0; b <= options.lane_count; b++)
+    {
+      double offset = b * options.lane_width - road_half_width;
+      std::vector<lanelet::Point3d> points;
+      points.reserve(segment_count * points_per_segment + 1);
+      for (int k = 0; k <= segment_count * points_per_segment; k++)
+      {
+        lanelet::BasicPoint2d p = origin + direction * (k * step) + left * offset;
+        points.emplace_back(lanelet::utils::getId(), p.x(), p.y(), 0.0);
+      }
+
+      bool outer = (b == 0 || b == options.lane_count);
+      for (int s = 0; s < segment_count; s++)
+      {
+        lanelet::LineString3d bound(lanelet::utils::getId(),
+                                    std::vector<lanelet::Point3d>(points.begin() + s * points_per_segment,
+                                                                  points.begin() + (s + 1) * points_per_segment + 1));
+        bound.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::LineThin;
+        bound.attributes()[lanelet::AttributeName::Subtype] =
+            outer ? lanelet::AttributeValueString::Solid : lanelet::AttributeValueString::Dashed;
+        bounds[b].push_back(bound);
+      }
+    }
+
+    std::vector<std::vector<lanelet::Id>> road_ids(options.lane_count);
+    std::vector<std::vector<lanelet::Lanelet>> road_lanelets(options.lane_count);
+    for (int lane = 0; lane < options.lane_count; lane++)
+    {
+      for (int s = 0; s < segment_count; s++)
+      {
+        lanelet::Lanelet ll(lanelet::utils::getId(), bounds[lane + 1][s], bounds[lane][s]);
+        ll.attributes()[lanelet::AttributeName::Type] = lanelet::AttributeValueString::Lanelet;
+        ll.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+        ll.attributes()[lanelet::AttributeName::Location] = lanelet::AttributeValueString::Urban;
+        ll.attributes()[lanelet::AttributeName::OneWay] = "yes";
+        ll.attributes()[lanelet::AttributeName::Dynamic] = "no";
+        road_ids[lane].push_back(ll.id());
+        road_lanelets[lane].push_back(ll);
+      }
+    }
+
+    // A signal per lane at the end of the first lanelet reaching each multiple of signal_spacing
+    if (options.signal_spacing > 0)
+    {
+      for (int s = 0; s + 1 < segment_count; s++)
+      {
+        double start = s * options.lanelet_length + 1e-6;
+        double end = start + options.lanelet_length;
+        if (std::floor(end / options.signal_spacing) == std::floor(start / options.signal_spacing))
+        {
+          continue;
+        }
+        for (int lane = 0; lane < options.lane_count; lane++)
+        {
+          lanelet::Lanelet& owning_lanelet = road_lanelets[lane][s];
+          lanelet::LineString3d stop_line(lanelet::utils::getId(),
+                                          { owning_lanelet.leftBound().back(), owning_lanelet.rightBound().back() });
+          std::shared_ptr<lanelet::CarmaTrafficSignal> signal(new lanelet::CarmaTrafficSignal(
+              lanelet::CarmaTrafficSignal::buildData(lanelet::utils::getId(), { stop_line }, { owning_lanelet },
+                                                     { road_lanelets[lane][s + 1] })));
+          signal->revision_ = 0;
+          owning_lanelet.addRegulatoryElement(signal);
+          signals.push_back(signal);
+        }
+      }
+    }
+
+    for (auto& lane : road_lanelets)
+    {
+      lanelets.insert(lanelets.end(), lane.begin(), lane.end());
+    }
+    lanelet_ids.push_back(road_ids);
+  }
+
+  lanelet::LaneletMapPtr map = lanelet::utils::createMap(lanelets, {});
+  for (const auto& signal : signals)
+  {
+    map->add(signal);
+  }
+  lanelet::MapConformer::ensureCompliance(map, 25_mph);
+  return map;
+}
+
+/**
+ * \brief Builds external objects driving along the lanes of a synthetic map at 5 to 20 m/s
+ *
+ * \param options The size of the map and the number of objects
+ * \param stamp The time of the objects. Predictions follow it at options.prediction_period intervals
+ */
+inline std::vector<cav_msgs::ExternalObject> buildSyntheticObjects(const SyntheticMapOptions& options,
+                                                                   const ros::Time& stamp)
+{
+  std::mt19937 rng(options.seed);
+  auto axes = getSyntheticRoadAxes(options);
+  std::uniform_int_distribution<size_t> road_dist(0, axes.size() - 1);
+  std::uniform_int_distribution<int> lane_dist(0, options.lane_count - 1);
+  std::uniform_real_distribution<double> station_dist(0, options.road_length * 0.9);
+  std::uniform_real_distribution<double> speed_dist(5, 20);
+  std::uniform_real_distribution<double> lateral_dist(-0.5, 0.5);
+
+  const double road_half_width = 0.5 * options.lane_count * options.lane_width;
+
+  std::vector<cav_msgs::ExternalObject> objects;
+  objects.reserve(options.object_count);
+  for (int i = 0; i < options.object_count; i++)
+  {
+    const auto& axis = axes[road_dist(rng)];
+    const lanelet::BasicPoint2d& direction = axis.second;
+    const lanelet::BasicPoint2d left(-direction.y(), direction.x());
+    double lateral = (lane_dist(rng) + 0.5) * options.lane_width - road_half_width + lateral_dist(rng);
+    double station = station_dist(rng);
+    double speed = speed_dist(rng);
+    double yaw = std::atan2(direction.y(), direction.x());
+
+    cav_msgs::ExternalObject object;
+    object.header.stamp = stamp;
+    object.header.frame_id = "map";
+    object.id = i;
+    object.size.x = 4.5;
+    object.size.y = 1.8;
+    object.size.z = 1.5;
+
+    auto setPose = [&](geometry_msgs::Pose& pose, double s) {
+      lanelet::BasicPoint2d p = axis.first + direction * s + left * lateral;
+      pose.position.x = p.x();
+      pose.position.y = p.y();
+      pose.orientation.z = std::sin(yaw / 2);
+      pose.orientation.w = std::cos(yaw / 2);
+    };
+    setPose(object.pose.pose, station);
+
+    for (int k = 1; k <= options.prediction_count; k++)
+    {
+      cav_msgs::PredictedState prediction;
+      prediction.header.stamp = stamp + ros::Duration(k * options.prediction_period);
+      setPose(prediction.predicted_position, station + speed * k * options.prediction_period);
+      prediction.predicted_position_confidence = 0.9;
+      object.predictions.push_back(prediction);
+    }
+    objects.push_back(object);
+  }
+  return objects;
+}
+
+/**
+ * \brief Builds a world model on a synthetic map with its route, roadway objects and traffic signal ids set
+ *
+ * The route follows the first lane of road 0 from its first to its last lanelet. Each signalized stop line is an
+ * intersection of the SPaT message with a signal group per lane, whose states are set with updateSyntheticSpat.
+ *
+ * \param options The size and content of the world
+ * \param stamp The time of the external objects
+ *
+ * \throw std::invalid_argument if the options are invalid or the route cannot be computed
+ */
+inline SyntheticWorld buildSyntheticWorld(const SyntheticMapOptions& options, const ros::Time& stamp = ros::Time(0))
+{
+  SyntheticWorld world;
+  std::vector<std::shared_ptr<lanelet::CarmaTrafficSignal>> signals;
+  world.map = buildSyntheticMap(options, world.lanelet_ids, signals);
+  world.signal_count = signals.size();
+
+  world.world_model = std::make_shared<carma_wm::CARMAWorldModel>();
+  world.world_model->setMap(world.map);
+
+  // Signals were created road by road and stop line by stop line with one signal per lane
+  uint16_t intersection_id = 0;
+  for (size_t i = 0; i < signals.size(); i++)
+  {
+    uint8_t signal_group = static_cast<uint8_t>(i % options.lane_count + 1);
+    if (signal_group == 1)
+    {
+      intersection_id++;
+      cav_msgs::IntersectionState intersection;
+      intersection.id.id = intersection_id;
+      intersection.revision = 0;
+      world.spat.intersection_state_list.push_back(intersection);
+    }
+    world.world_model->setTrafficLightIds((static_cast<uint32_t>(intersection_id) << 8) | signal_group, signals[i]->id());
+
+    cav_msgs::MovementState movement;
+    movement.signal_group = signal_group;
+    movement.movement_event_list.resize(1);
+    world.spat.intersection_state_list.back().movement_list.push_back(movement);
+  }
+  updateSyntheticSpat(world.spat, 0);
+
+  const auto& route_lane = world.lanelet_ids.front().front();
+  world.route_ids = { route_lane.front(), route_lane.back() };
+  auto route = world.world_model->getMapRoutingGraph()->getRoute(world.map->laneletLayer.get(route_lane.front()),
+                                                                 world.map->laneletLayer.get(route_lane.back()));
+  if (!route)
+  {
+    throw std::invalid_argument("Could not route along the synthetic map");
+  }
+  world.world_model->setRoute(std::make_shared<lanelet::routing::Route>(std::move(*route)));
+
+  world.objects = buildSyntheticObjects(options, stamp);
+  std::vector<cav_msgs::RoadwayObstacle> obstacles;
+  obstacles.reserve(world.objects.size());
+  for (const auto& object : world.objects)
+  {
+    auto obstacle = world.world_model->toRoadwayObstacle(object);
+    if (obstacle)
+    {
+      obstacles.push_back(obstacle.get());
+    }
+  }
+  world.world_model->setRoadwayObjects(obstacles);
+
+  return world;
+}
+}  // namespace test
+}  // namespace carma_wm
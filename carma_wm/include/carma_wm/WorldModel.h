@@ -35,6 +35,7 @@
 #include <lanelet2_extension/regulatory_elements/SignalizedIntersection.h>
 #include <lanelet2_core/primitives/BasicRegulatoryElements.h>
 #include "TrackPos.h"
+#include "SpeedLimitProfile.h"
 
 namespace carma_wm
 {
@@ -232,6 +233,18 @@ public:
   virtual lanelet::Optional<TrafficRulesConstPtr>
   getTrafficRules() const = 0;
 
+  /*! \brief Get the speed limit along the shortest path of the current route as a function of route downtrack.
+   *
+   * The profile holds the speed limit of each shortest path lanelet, as given by the traffic rules returned by
+   * getTrafficRules(), starting at that lanelet's route downtrack. It is computed when the route is set and kept up to
+   * date as map updates change the regulations of route lanelets, so route wide speed queries do not need to evaluate
+   * the traffic rules.
+   *
+   * \return The speed limit profile. Empty if no route is loaded or no traffic rules are available. The reference is
+   * invalidated by the next route or map change
+   */
+  virtual const SpeedLimitProfile& getRouteSpeedLimitProfile() const = 0;
+
   /**
    * \brief Converts an ExternalObject in a RoadwayObstacle by mapping its position onto the semantic map. Can also be
    * used to determine if the object is on the roadway
@@ -276,6 +289,29 @@ public:
   virtual std::vector<cav_msgs::RoadwayObstacle> getInLaneObjects(const lanelet::ConstLanelet& lanelet,
                                                                   const LaneSection& section = LANE_AHEAD) const = 0;
 
+  /**
+   * \brief Gets the roadway objects whose current or predicted footprint occupies part of a lane between two downtracks
+   * at some point during a time window. Objects are looked up in an index of their predicted footprints built when the
+   * roadway objects are set, so this does not iterate over every roadway object.
+   *
+   * A footprint is the downtrack interval covered by the bounding circle of an object in a lanelet, held from the time of
+   * one prediction until the next and widened to cover the distance moved between them. Objects with no predictions only
+   * occupy their current position at the time of their header stamp.
+   *
+   * \param lane Consecutive lanelets forming the lane, such as those returned by getLane
+   * \param start_downtrack The start of the interval as a distance along the lane centerline from the start of the first
+   * lanelet in m
+   * \param end_downtrack The end of the interval in m
+   * \param start_time The start of the time window
+   * \param end_time The end of the time window
+   *
+   * \return The occupying objects in the order they were provided to the world model. Empty if there are none or the
+   * lane is empty
+   */
+  virtual std::vector<cav_msgs::RoadwayObstacle>
+  getObjectsInLaneInterval(const std::vector<lanelet::ConstLanelet>& lane, double start_downtrack, double end_downtrack,
+                           const ros::Time& start_time, const ros::Time& end_time) const = 0;
+
   /**
    * \brief Gets Cartesian distance to the closest object on the same lane as the given point
    *
@@ -346,6 +382,14 @@ public:
    */ 
   virtual size_t getMapVersion() const = 0;
 
+  /**
+   * \brief Returns a counter which increases every time the map is set, including in place updates such as geofences which
+   *        leave the map version unchanged. Can be used to invalidate data derived from the map or its routing graph.
+   *
+   * \return number of times the map has been set
+   */
+  virtual size_t getMapUpdateCount() const = 0;
+
   /**
    * \brief Gets the underlying lanelet, given the cartesian point on the map
    *
@@ -33,6 +33,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <lanelet2_routing/RoutingGraph.h>
+#include <carma_wm/LaneletGridIndex.h>
 
 
 namespace carma_wm
@@ -119,6 +120,19 @@ std::vector<lanelet::Lanelet> nonConnectedAdjacentLeft(const lanelet::LaneletMap
   */
 lanelet::ConstLaneletOrAreas getAffectedLaneletOrAreas(const lanelet::Points3d& gf_pts, const lanelet::LaneletMapPtr& lanelet_map, std::shared_ptr<const lanelet::routing::RoutingGraph> routing_graph, double max_lane_width);
 
+/*!
+  * \brief Gets the affected lanelet or areas based on the points in the given map's frame.
+  *        Identical to the overload above except that the lanelets containing each point are looked up in the provided grid index
+  *        instead of searching the map, which makes the cost per point independent of the map size.
+  * \param geofence_msg lanelet::Points3d in local frame
+  * \param lanelet_map Lanelet Map Ptr
+  * \param routing_graph Routing graph of the lanelet map
+  * \param lanelet_index Grid index containing every lanelet of lanelet_map
+  * 
+  * NOTE:Currently this function only checks lanelets and will be expanded to areas in the future.
+  */
+lanelet::ConstLaneletOrAreas getAffectedLaneletOrAreas(const lanelet::Points3d& gf_pts, const lanelet::LaneletMapPtr& lanelet_map, std::shared_ptr<const lanelet::routing::RoutingGraph> routing_graph, const LaneletGridIndex& lanelet_index);
+
 /*!
   * \brief A function that filters successor lanelets of root_lanelets from possible_lanelets
   * \param possible_lanelets all possible lanelets to check
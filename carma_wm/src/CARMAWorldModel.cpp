@@ -27,6 +27,7 @@
 #include <Eigen/LU>
 #include <cmath>
 #include <lanelet2_core/geometry/Polygon.h>
+#include <lanelet2_core/geometry/Lanelet.h>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
 #include <carma_wm/Geometry.h>
@@ -35,6 +36,30 @@
 
 namespace carma_wm
 {
+  CARMAWorldModel::CARMAWorldModel(const CARMAWorldModel& other)
+    : traffic_light_ids_(other.traffic_light_ids_),
+      sim_(other.sim_),
+      config_speed_limit_(other.config_speed_limit_),
+      participant_type_(other.participant_type_),
+      semantic_map_(other.semantic_map_),
+      route_(other.route_),
+      map_routing_graph_(other.map_routing_graph_),
+      route_length_(other.route_length_),
+      shortest_path_view_(other.shortest_path_view_),
+      shortest_path_centerlines_(other.shortest_path_centerlines_),
+      shortest_path_distance_map_(other.shortest_path_distance_map_),
+      shortest_path_filtered_centerline_view_(other.shortest_path_filtered_centerline_view_),
+      roadway_objects_(other.roadway_objects_),
+      roadway_object_index_(other.roadway_object_index_),
+      route_speed_limits_(other.route_speed_limits_),
+      map_version_(other.map_version_),
+      map_update_count_(other.map_update_count_),
+      route_name_(other.route_name_)
+  {
+    std::lock_guard<std::mutex> lock(other.traffic_rules_mutex_);
+    traffic_rules_cache_ = other.traffic_rules_cache_;
+  }
+
 
   std::pair<TrackPos, TrackPos> CARMAWorldModel::routeTrackPos(const lanelet::ConstArea& area) const
   {
@@ -539,8 +564,19 @@ namespace carma_wm
       recompute_routing_graph = true;
     }
 
+    if (semantic_map_ != map)
+    {
+      route_speed_limits_.clear(); // The route, and so its profile, is tied to the previous map until a new route is set
+    }
+
     semantic_map_ = map;
     map_version_ = map_version;
+    map_update_count_++;
+
+    {
+      std::lock_guard<std::mutex> lock(traffic_rules_mutex_);
+      traffic_rules_cache_.clear();
+    }
 
     // If the routing graph should be updated then recompute it
     if (recompute_routing_graph)
@@ -562,6 +598,11 @@ namespace carma_wm
     return map_version_;
   }
 
+  size_t CARMAWorldModel::getMapUpdateCount() const
+  {
+    return map_update_count_;
+  }
+
   lanelet::LaneletMapPtr CARMAWorldModel::getMutableMap() const
   {
     return semantic_map_;
@@ -576,6 +617,64 @@ namespace carma_wm
     // NOTE: Setting the route_length_ field here will likely result in the final lanelets final point being used. Call setRouteEndPoint to use the destination point value
     route_length_ = routeTrackPos(route_->getEndPoint().basicPoint2d()).downtrack;  // Cache the route length with
                                                                                    // consideration for endpoint
+    computeRouteSpeedLimitProfile();
+  }
+
+  void CARMAWorldModel::computeRouteSpeedLimitProfile()
+  {
+    route_speed_limits_.clear();
+
+    if (!route_)
+    {
+      return;
+    }
+
+    lanelet::Optional<TrafficRulesConstPtr> traffic_rules = getTrafficRules(participant_type_);
+    if (!traffic_rules)
+    {
+      return;
+    }
+
+    double prev_downtrack = 0;
+    for (const lanelet::ConstLanelet& llt : route_->shortestPath())
+    {
+      if (route_speed_limits_.speedLimit(llt.id()))
+      {
+        continue;
+      }
+      // After a lane change the start of the next lanelet can fall slightly behind the start of the previous one
+      prev_downtrack = std::max(prev_downtrack, routeTrackPos(llt).downtrack);
+      route_speed_limits_.pushBack(llt.id(), prev_downtrack, (*traffic_rules)->speedLimit(llt).speedLimit.value());
+    }
+  }
+
+  void CARMAWorldModel::updateRouteSpeedLimits(const std::vector<lanelet::Id>& lanelet_ids)
+  {
+    if (route_speed_limits_.empty() || !semantic_map_)
+    {
+      return;
+    }
+
+    lanelet::Optional<TrafficRulesConstPtr> traffic_rules = getTrafficRules(participant_type_);
+    if (!traffic_rules)
+    {
+      return;
+    }
+
+    for (lanelet::Id id : lanelet_ids)
+    {
+      if (!route_speed_limits_.speedLimit(id) || !semantic_map_->laneletLayer.exists(id))
+      {
+        continue;
+      }
+      lanelet::ConstLanelet llt = semantic_map_->laneletLayer.get(id);
+      route_speed_limits_.update(id, (*traffic_rules)->speedLimit(llt).speedLimit.value());
+    }
+  }
+
+  const SpeedLimitProfile& CARMAWorldModel::getRouteSpeedLimitProfile() const
+  {
+    return route_speed_limits_;
   }
 
   void CARMAWorldModel::setRouteEndPoint(const lanelet::BasicPoint3d& end_point)
@@ -705,6 +804,14 @@ namespace carma_wm
 
   lanelet::Optional<TrafficRulesConstPtr> CARMAWorldModel::getTrafficRules(const std::string& participant) const
   {
+    std::lock_guard<std::mutex> lock(traffic_rules_mutex_);
+
+    auto cached = traffic_rules_cache_.find(participant);
+    if (cached != traffic_rules_cache_.end())
+    {
+      return cached->second;
+    }
+
     lanelet::Optional<TrafficRulesConstPtr> optional_ptr;
     // Create carma traffic rules object
     try
@@ -722,9 +829,11 @@ namespace carma_wm
     }
     catch (const lanelet::InvalidInputError& e)
     {
+      traffic_rules_cache_[participant] = optional_ptr; // Unsupported participants are also cached to avoid repeating the failed lookup
       return optional_ptr;
     }
 
+    traffic_rules_cache_[participant] = optional_ptr;
     return optional_ptr;
   }
 
@@ -790,6 +899,7 @@ namespace carma_wm
   void CARMAWorldModel::setRoadwayObjects(const std::vector<cav_msgs::RoadwayObstacle>& rw_objs)
   {
     roadway_objects_ = rw_objs;
+    roadway_object_index_.build(roadway_objects_);
   }
 
   std::vector<cav_msgs::RoadwayObstacle> CARMAWorldModel::getRoadwayObjects() const
@@ -867,6 +977,42 @@ namespace carma_wm
     return lane_objects;
   }
 
+  std::vector<cav_msgs::RoadwayObstacle> CARMAWorldModel::getObjectsInLaneInterval(
+      const std::vector<lanelet::ConstLanelet>& lane, double start_downtrack, double end_downtrack,
+      const ros::Time& start_time, const ros::Time& end_time) const
+  {
+    std::vector<size_t> object_indexes;
+    double lanelet_start = 0; // Downtrack of the start of the current lanelet along the lane
+    for (size_t i = 0; i < lane.size(); i++)
+    {
+      double lanelet_end = lanelet_start + lanelet::geometry::length2d(lane[i]);
+
+      // Footprints are stored under their own lanelet but can overhang into its neighbours, so a lanelet is skipped only
+      // if the interval misses the downtracks covered by its footprints rather than the lanelet itself
+      auto extent = roadway_object_index_.downtrackExtent(lane[i].id());
+      if (extent && end_downtrack - lanelet_start >= extent->first && start_downtrack - lanelet_start <= extent->second)
+      {
+        std::vector<size_t> lanelet_indexes = roadway_object_index_.occupyingObstacles(
+            lane[i].id(), start_downtrack - lanelet_start, end_downtrack - lanelet_start, start_time.toSec(),
+            end_time.toSec());
+        object_indexes.insert(object_indexes.end(), lanelet_indexes.begin(), lanelet_indexes.end());
+      }
+
+      lanelet_start = lanelet_end;
+    }
+
+    std::sort(object_indexes.begin(), object_indexes.end());
+    object_indexes.erase(std::unique(object_indexes.begin(), object_indexes.end()), object_indexes.end());
+
+    std::vector<cav_msgs::RoadwayObstacle> lane_objects;
+    lane_objects.reserve(object_indexes.size());
+    for (size_t index : object_indexes)
+    {
+      lane_objects.push_back(roadway_objects_[index]);
+    }
+    return lane_objects;
+  }
+
   lanelet::Optional<lanelet::Lanelet>
   CARMAWorldModel::getIntersectingLanelet(const cav_msgs::ExternalObject& object) const
   {
@@ -1127,11 +1273,18 @@ namespace carma_wm
   void CARMAWorldModel::setConfigSpeedLimit(double config_lim)
   {
     config_speed_limit_ = config_lim;
+
+    {
+      std::lock_guard<std::mutex> lock(traffic_rules_mutex_);
+      traffic_rules_cache_.clear();
+    }
+    computeRouteSpeedLimitProfile();
   }
 
   void CARMAWorldModel::setVehicleParticipationType(const std::string& participant)
   {
     participant_type_ = participant;
+    computeRouteSpeedLimitProfile();
   }
 
   std::string CARMAWorldModel::getVehicleParticipationType()
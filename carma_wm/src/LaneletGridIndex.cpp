@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/LaneletGridIndex.h>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <lanelet2_core/geometry/Lanelet.h>
+
+namespace carma_wm
+{
+LaneletGridIndex::LaneletGridIndex(double cell_size) : cell_size_(cell_size)
+{
+  if (cell_size_ <= 0.0)
+  {
+    throw std::invalid_argument("LaneletGridIndex cell size must be positive. Received " + std::to_string(cell_size));
+  }
+}
+
+void LaneletGridIndex::build(const lanelet::LaneletMapPtr& map)
+{
+  clear();
+  if (!map)
+  {
+    return;
+  }
+  bounding_boxes_.reserve(map->laneletLayer.size());
+  for (const auto& lanelet : map->laneletLayer)
+  {
+    insert(lanelet);
+  }
+}
+
+void LaneletGridIndex::insert(const lanelet::Lanelet& lanelet)
+{
+  if (bounding_boxes_.find(lanelet.id()) != bounding_boxes_.end())
+  {
+    return;
+  }
+
+  lanelet::BoundingBox2d box = lanelet::geometry::boundingBox2d(lanelet);
+  bounding_boxes_.emplace(lanelet.id(), box);
+
+  int64_t min_x = cellIndex(box.min().x());
+  int64_t min_y = cellIndex(box.min().y());
+  int64_t max_x = cellIndex(box.max().x());
+  int64_t max_y = cellIndex(box.max().y());
+
+  for (int64_t x = min_x; x <= max_x; x++)
+  {
+    for (int64_t y = min_y; y <= max_y; y++)
+    {
+      cells_[cellKey(x, y)].push_back(lanelet);
+    }
+  }
+}
+
+std::vector<lanelet::Lanelet> LaneletGridIndex::containingLanelets(const lanelet::BasicPoint2d& point) const
+{
+  std::vector<lanelet::Lanelet> containing;
+
+  auto cell = cells_.find(cellKey(cellIndex(point.x()), cellIndex(point.y())));
+  if (cell == cells_.end())
+  {
+    return containing;
+  }
+
+  for (const auto& lanelet : cell->second)
+  {
+    const auto& box = bounding_boxes_.at(lanelet.id());
+    if (!box.contains(point))
+    {
+      continue;
+    }
+    // boost geometry uses a distance of 0 to indicate a point is within a polygon which matches the findNearest search
+    if (lanelet::geometry::distance2d(lanelet, point) == 0.0)
+    {
+      containing.push_back(lanelet);
+    }
+  }
+  return containing;
+}
+
+const lanelet::BoundingBox2d& LaneletGridIndex::boundingBox(lanelet::Id lanelet_id) const
+{
+  auto it = bounding_boxes_.find(lanelet_id);
+  if (it == bounding_boxes_.end())
+  {
+    throw std::invalid_argument("Lanelet " + std::to_string(lanelet_id) + " is not in the LaneletGridIndex");
+  }
+  return it->second;
+}
+
+lanelet::BoundingBox2d LaneletGridIndex::boundingBox(const lanelet::ConstLanelet& lanelet) const
+{
+  auto it = bounding_boxes_.find(lanelet.id());
+  if (it == bounding_boxes_.end())
+  {
+    return lanelet::geometry::boundingBox2d(lanelet);
+  }
+  return it->second;
+}
+
+void LaneletGridIndex::clear()
+{
+  cells_.clear();
+  bounding_boxes_.clear();
+}
+
+size_t LaneletGridIndex::size() const
+{
+  return bounding_boxes_.size();
+}
+
+bool LaneletGridIndex::empty() const
+{
+  return bounding_boxes_.empty();
+}
+
+int64_t LaneletGridIndex::cellIndex(double coordinate) const
+{
+  return static_cast<int64_t>(std::floor(coordinate / cell_size_));
+}
+
+uint64_t LaneletGridIndex::cellKey(int64_t x_index, int64_t y_index)
+{
+  // Map coordinates are within a few hundred km of the origin so 32 bits per axis is sufficient
+  return (static_cast<uint64_t>(x_index) << 32) ^ (static_cast<uint64_t>(y_index) & 0xFFFFFFFF);
+}
+}  // namespace carma_wm
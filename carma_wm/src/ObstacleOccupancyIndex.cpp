@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/ObstacleOccupancyIndex.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace carma_wm
+{
+namespace
+{
+// A footprint covering more buckets than this, such as one between predictions with a long gap, is kept in a per
+// lanelet list checked by every query instead of being copied into each bucket
+constexpr double MAX_BUCKETS_PER_FOOTPRINT = 64;
+
+// Bins are packed into 32 bits each in the bucket key
+constexpr double MIN_BIN = std::numeric_limits<int32_t>::min();
+constexpr double MAX_BIN = std::numeric_limits<int32_t>::max();
+
+struct Sample
+{
+  lanelet::Id lanelet_id;
+  double downtrack;
+  double time;
+};
+}  // namespace
+
+ObstacleOccupancyIndex::ObstacleOccupancyIndex(double downtrack_bin_size, double time_bin_size)
+  : downtrack_bin_size_(downtrack_bin_size), time_bin_size_(time_bin_size)
+{
+  if (downtrack_bin_size_ <= 0.0 || time_bin_size_ <= 0.0)
+  {
+    throw std::invalid_argument("ObstacleOccupancyIndex bin sizes must be positive. Received downtrack bin size " +
+                                std::to_string(downtrack_bin_size) + " and time bin size " +
+                                std::to_string(time_bin_size));
+  }
+}
+
+void ObstacleOccupancyIndex::build(const std::vector<cav_msgs::RoadwayObstacle>& obstacles)
+{
+  clear();
+
+  std::vector<std::vector<Sample>> obstacle_samples(obstacles.size());
+  reference_time_ = std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < obstacles.size(); i++)
+  {
+    const cav_msgs::RoadwayObstacle& obstacle = obstacles[i];
+    size_t prediction_count = std::min(obstacle.object.predictions.size(),
+                                       std::min(obstacle.predicted_lanelet_ids.size(),
+                                                obstacle.predicted_down_tracks.size()));
+
+    std::vector<Sample>& samples = obstacle_samples[i];
+    samples.reserve(prediction_count + 1);
+    samples.push_back({ obstacle.lanelet_id, obstacle.down_track, obstacle.object.header.stamp.toSec() });
+    for (size_t k = 0; k < prediction_count; k++)
+    {
+      samples.push_back({ obstacle.predicted_lanelet_ids[k], obstacle.predicted_down_tracks[k],
+                          obstacle.object.predictions[k].header.stamp.toSec() });
+    }
+
+    for (const auto& sample : samples)
+    {
+      reference_time_ = std::min(reference_time_, sample.time);
+    }
+  }
+  if (!std::isfinite(reference_time_))
+  {
+    reference_time_ = 0;
+  }
+
+  for (size_t i = 0; i < obstacles.size(); i++)
+  {
+    const std::vector<Sample>& samples = obstacle_samples[i];
+    // The bounding circle of the object covers its extent along the lane for any heading
+    double half_extent = 0.5 * std::hypot(obstacles[i].object.size.x, obstacles[i].object.size.y);
+
+    for (size_t k = 0; k < samples.size(); k++)
+    {
+      const Sample& sample = samples[k];
+
+      ObstacleFootprint footprint;
+      footprint.obstacle_index = i;
+      footprint.lanelet_id = sample.lanelet_id;
+      footprint.start_downtrack = sample.downtrack - half_extent;
+      footprint.end_downtrack = sample.downtrack + half_extent;
+      footprint.start_time = sample.time;
+      footprint.end_time = sample.time;
+
+      if (k > 0 && samples[k - 1].lanelet_id != sample.lanelet_id)
+      {
+        // The obstacle entered this lanelet at some point since the previous sample
+        footprint.start_time = std::min(footprint.start_time, samples[k - 1].time);
+        footprint.end_time = std::max(footprint.end_time, samples[k - 1].time);
+      }
+
+      if (k + 1 < samples.size())
+      {
+        const Sample& next = samples[k + 1];
+        footprint.start_time = std::min(footprint.start_time, next.time);
+        footprint.end_time = std::max(footprint.end_time, next.time);
+        if (next.lanelet_id == sample.lanelet_id)
+        {
+          footprint.start_downtrack = std::min(footprint.start_downtrack, next.downtrack - half_extent);
+          footprint.end_downtrack = std::max(footprint.end_downtrack, next.downtrack + half_extent);
+        }
+      }
+
+      insert(footprint);
+    }
+  }
+}
+
+void ObstacleOccupancyIndex::insert(const ObstacleFootprint& footprint)
+{
+  if (!std::isfinite(footprint.start_downtrack) || !std::isfinite(footprint.end_downtrack) ||
+      !std::isfinite(footprint.start_time) || !std::isfinite(footprint.end_time))
+  {
+    return;
+  }
+
+  size_t footprint_index = footprints_.size();
+  footprints_.push_back(footprint);
+
+  LaneletBuckets& lanelet = lanelets_[footprint.lanelet_id];
+  lanelet.footprints.push_back(footprint_index);
+  lanelet.min_downtrack = std::min(lanelet.min_downtrack, footprint.start_downtrack);
+  lanelet.max_downtrack = std::max(lanelet.max_downtrack, footprint.end_downtrack);
+
+  int64_t min_downtrack = downtrackBin(footprint.start_downtrack);
+  int64_t max_downtrack = downtrackBin(footprint.end_downtrack);
+  int64_t min_time = timeBin(footprint.start_time);
+  int64_t max_time = timeBin(footprint.end_time);
+
+  double bucket_count =
+      static_cast<double>(max_downtrack - min_downtrack + 1) * static_cast<double>(max_time - min_time + 1);
+  if (bucket_count > MAX_BUCKETS_PER_FOOTPRINT)
+  {
+    lanelet.unbucketed.push_back(footprint_index);
+    return;
+  }
+
+  for (int64_t d = min_downtrack; d <= max_downtrack; d++)
+  {
+    for (int64_t t = min_time; t <= max_time; t++)
+    {
+      lanelet.buckets[bucketKey(d, t)].push_back(footprint_index);
+    }
+  }
+}
+
+std::vector<size_t> ObstacleOccupancyIndex::occupyingObstacles(lanelet::Id lanelet_id, double start_downtrack,
+                                                               double end_downtrack, double start_time,
+                                                               double end_time) const
+{
+  std::vector<size_t> occupying;
+
+  auto lanelet_it = lanelets_.find(lanelet_id);
+  if (lanelet_it == lanelets_.end() || !(start_downtrack <= end_downtrack) || !(start_time <= end_time))
+  {
+    return occupying;
+  }
+  const LaneletBuckets& lanelet = lanelet_it->second;
+
+  auto add_if_overlapping = [&](size_t footprint_index) {
+    const ObstacleFootprint& footprint = footprints_[footprint_index];
+    if (overlaps(footprint, start_downtrack, end_downtrack, start_time, end_time))
+    {
+      occupying.push_back(footprint.obstacle_index);
+    }
+  };
+
+  int64_t min_downtrack = downtrackBin(start_downtrack);
+  int64_t max_downtrack = downtrackBin(end_downtrack);
+  int64_t min_time = timeBin(start_time);
+  int64_t max_time = timeBin(end_time);
+
+  double bucket_count =
+      static_cast<double>(max_downtrack - min_downtrack + 1) * static_cast<double>(max_time - min_time + 1);
+  if (bucket_count >= static_cast<double>(lanelet.footprints.size()))
+  {
+    // Checking every footprint on the lanelet is cheaper than visiting the buckets of a large query region
+    for (size_t footprint_index : lanelet.footprints)
+    {
+      add_if_overlapping(footprint_index);
+    }
+  }
+  else
+  {
+    for (int64_t d = min_downtrack; d <= max_downtrack; d++)
+    {
+      for (int64_t t = min_time; t <= max_time; t++)
+      {
+        auto bucket = lanelet.buckets.find(bucketKey(d, t));
+        if (bucket == lanelet.buckets.end())
+        {
+          continue;
+        }
+        for (size_t footprint_index : bucket->second)
+        {
+          add_if_overlapping(footprint_index);
+        }
+      }
+    }
+    for (size_t footprint_index : lanelet.unbucketed)
+    {
+      add_if_overlapping(footprint_index);
+    }
+  }
+
+  // An obstacle is found once per overlapping footprint and bucket
+  std::sort(occupying.begin(), occupying.end());
+  occupying.erase(std::unique(occupying.begin(), occupying.end()), occupying.end());
+  return occupying;
+}
+
+boost::optional<std::pair<double, double>> ObstacleOccupancyIndex::downtrackExtent(lanelet::Id lanelet_id) const
+{
+  auto lanelet_it = lanelets_.find(lanelet_id);
+  if (lanelet_it == lanelets_.end())
+  {
+    return boost::none;
+  }
+  return std::make_pair(lanelet_it->second.min_downtrack, lanelet_it->second.max_downtrack);
+}
+
+const std::vector<ObstacleFootprint>& ObstacleOccupancyIndex::footprints() const
+{
+  return footprints_;
+}
+
+void ObstacleOccupancyIndex::clear()
+{
+  footprints_.clear();
+  lanelets_.clear();
+  reference_time_ = 0;
+}
+
+size_t ObstacleOccupancyIndex::size() const
+{
+  return footprints_.size();
+}
+
+bool ObstacleOccupancyIndex::empty() const
+{
+  return footprints_.empty();
+}
+
+int64_t ObstacleOccupancyIndex::downtrackBin(double downtrack) const
+{
+  return static_cast<int64_t>(std::max(MIN_BIN, std::min(MAX_BIN, std::floor(downtrack / downtrack_bin_size_))));
+}
+
+int64_t ObstacleOccupancyIndex::timeBin(double time) const
+{
+  return static_cast<int64_t>(
+      std::max(MIN_BIN, std::min(MAX_BIN, std::floor((time - reference_time_) / time_bin_size_))));
+}
+
+uint64_t ObstacleOccupancyIndex::bucketKey(int64_t downtrack_bin, int64_t time_bin)
+{
+  return (static_cast<uint64_t>(downtrack_bin) << 32) ^ (static_cast<uint64_t>(time_bin) & 0xFFFFFFFF);
+}
+
+bool ObstacleOccupancyIndex::overlaps(const ObstacleFootprint& footprint, double start_downtrack, double end_downtrack,
+                                      double start_time, double end_time)
+{
+  return footprint.start_downtrack <= end_downtrack && start_downtrack <= footprint.end_downtrack &&
+         footprint.start_time <= end_time && start_time <= footprint.end_time;
+}
+}  // namespace carma_wm
@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/Polyline.h>
+#include <carma_wm/Geometry.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace carma_wm
+{
+namespace geometry
+{
+namespace
+{
+// Number of squared distances computed per block of the nearest point search. Small enough to stay on the stack
+constexpr size_t NEAREST_POINT_BLOCK_SIZE = 64;
+}  // namespace
+
+Polyline2d::Polyline2d(const lanelet::BasicLineString2d& points)
+{
+  assign(points);
+}
+
+Polyline2d::Polyline2d(const std::vector<lanelet::BasicPoint2d>& points)
+{
+  assign(points);
+}
+
+void Polyline2d::assign(const lanelet::BasicLineString2d& points)
+{
+  assignPoints(points);
+}
+
+void Polyline2d::assign(const std::vector<lanelet::BasicPoint2d>& points)
+{
+  assignPoints(points);
+}
+
+template <class P, class A>
+void Polyline2d::assignPoints(const std::vector<P, A>& points)
+{
+  const size_t n = points.size();
+  x_.resize(n);
+  y_.resize(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    x_[i] = points[i].x();
+    y_[i] = points[i].y();
+  }
+
+  segment_lengths_.resize(n > 0 ? n - 1 : 0);
+  const double* x = x_.data();
+  const double* y = y_.data();
+  double* seg = segment_lengths_.data();
+  for (size_t i = 0; i + 1 < n; i++)
+  {
+    const double dx = x[i + 1] - x[i];
+    const double dy = y[i + 1] - y[i];
+    seg[i] = std::sqrt(dx * dx + dy * dy);
+  }
+
+  // The prefix sum is sequential but only a single add per point
+  arc_lengths_.resize(n);
+  if (n > 0)
+  {
+    arc_lengths_[0] = 0;
+  }
+  for (size_t i = 1; i < n; i++)
+  {
+    arc_lengths_[i] = arc_lengths_[i - 1] + seg[i - 1];
+  }
+}
+
+size_t Polyline2d::size() const
+{
+  return x_.size();
+}
+
+bool Polyline2d::empty() const
+{
+  return x_.empty();
+}
+
+lanelet::BasicPoint2d Polyline2d::point(size_t index) const
+{
+  return lanelet::BasicPoint2d(x_[index], y_[index]);
+}
+
+const std::vector<double>& Polyline2d::x() const
+{
+  return x_;
+}
+
+const std::vector<double>& Polyline2d::y() const
+{
+  return y_;
+}
+
+const std::vector<double>& Polyline2d::segmentLengths() const
+{
+  return segment_lengths_;
+}
+
+const std::vector<double>& Polyline2d::arcLengths() const
+{
+  return arc_lengths_;
+}
+
+void computePolylineMetrics(const Polyline2d& polyline, PolylineMetrics& metrics)
+{
+  const size_t n = polyline.size();
+  if (n < 2)
+  {
+    throw std::invalid_argument("computePolylineMetrics requires a polyline with at least 2 points");
+  }
+
+  metrics.tangent_x.resize(n);
+  metrics.tangent_y.resize(n);
+  metrics.unit_tangent_x.resize(n);
+  metrics.unit_tangent_y.resize(n);
+  metrics.headings.resize(n);
+  metrics.curvatures.resize(n);
+
+  const double* x = polyline.x().data();
+  const double* y = polyline.y().data();
+  const double* s = polyline.arcLengths().data();
+  double* tx = metrics.tangent_x.data();
+  double* ty = metrics.tangent_y.data();
+  double* ux = metrics.unit_tangent_x.data();
+  double* uy = metrics.unit_tangent_y.data();
+  double* heading = metrics.headings.data();
+  double* curvature = metrics.curvatures.data();
+
+  // Tangents. Forward and backward differences at the ends, centered differences between them
+  tx[0] = x[1] - x[0];
+  ty[0] = y[1] - y[0];
+  for (size_t i = 1; i + 1 < n; i++)
+  {
+    tx[i] = (x[i + 1] - x[i - 1]) / 2.0;
+    ty[i] = (y[i + 1] - y[i - 1]) / 2.0;
+  }
+  tx[n - 1] = x[n - 1] - x[n - 2];
+  ty[n - 1] = y[n - 1] - y[n - 2];
+
+  // Unit tangents. A zero tangent stays zero as in Eigen's normalized(). Clamping the norm to the smallest normal double
+  // instead of branching on zero keeps the loop vectorizable and leaves every non zero norm unchanged
+  for (size_t i = 0; i < n; i++)
+  {
+    const double squared_norm = tx[i] * tx[i] + ty[i] * ty[i];
+    const double norm = std::max(std::sqrt(squared_norm), std::numeric_limits<double>::min());
+    ux[i] = tx[i] / norm;
+    uy[i] = ty[i] / norm;
+  }
+
+  // Curvature is the magnitude of the derivative of the unit tangent with respect to arc length
+  auto curvature_between = [&](size_t a, size_t b) {
+    const double ds = s[b] - s[a];
+    const double dx = (ux[b] - ux[a]) / ds;
+    const double dy = (uy[b] - uy[a]) / ds;
+    return std::sqrt(dx * dx + dy * dy);
+  };
+  curvature[0] = curvature_between(0, 1);
+  for (size_t i = 1; i + 1 < n; i++)
+  {
+    const double ds = s[i + 1] - s[i - 1];
+    const double dx = (ux[i + 1] - ux[i - 1]) / ds;
+    const double dy = (uy[i + 1] - uy[i - 1]) / ds;
+    curvature[i] = std::sqrt(dx * dx + dy * dy);
+  }
+  curvature[n - 1] = curvature_between(n - 2, n - 1);
+
+  // Headings. Kept in a separate loop as atan2 is a library call which would stop the loops above from vectorizing
+  for (size_t i = 0; i < n; i++)
+  {
+    const bool has_direction = tx[i] * tx[i] + ty[i] * ty[i] > 0.0;
+    heading[i] = has_direction ? std::atan2(uy[i], ux[i]) : 0.0;
+  }
+}
+
+size_t nearestPointIndex(const Polyline2d& polyline, const lanelet::BasicPoint2d& p)
+{
+  const size_t n = polyline.size();
+  if (n == 0)
+  {
+    throw std::invalid_argument("nearestPointIndex provided with an empty polyline");
+  }
+
+  const double* x = polyline.x().data();
+  const double* y = polyline.y().data();
+  const double px = p.x();
+  const double py = p.y();
+
+  // Squared distances are computed a block at a time so the distance loop vectorizes while the minimum search keeps
+  // the first of equally near points
+  double squared_distances[NEAREST_POINT_BLOCK_SIZE];
+  double min_squared_distance = std::numeric_limits<double>::infinity();
+  size_t best_index = 0;
+  for (size_t block_start = 0; block_start < n; block_start += NEAREST_POINT_BLOCK_SIZE)
+  {
+    const size_t count = std::min(NEAREST_POINT_BLOCK_SIZE, n - block_start);
+    const double* bx = x + block_start;
+    const double* by = y + block_start;
+    for (size_t j = 0; j < count; j++)
+    {
+      const double dx = px - bx[j];
+      const double dy = py - by[j];
+      squared_distances[j] = dx * dx + dy * dy;
+    }
+    for (size_t j = 0; j < count; j++)
+    {
+      if (squared_distances[j] < min_squared_distance)
+      {
+        min_squared_distance = squared_distances[j];
+        best_index = block_start + j;
+      }
+    }
+  }
+  return best_index;
+}
+
+std::tuple<TrackPos, size_t> matchSegment(const lanelet::BasicPoint2d& p, const Polyline2d& polyline)
+{
+  const size_t n = polyline.size();
+  if (n < 2)
+  {
+    throw std::invalid_argument("Provided with polyline containing fewer than 2 points");
+  }
+
+  const size_t best_point_index = nearestPointIndex(polyline, p);
+  const std::vector<double>& arc_lengths = polyline.arcLengths();
+  const std::vector<double>& segment_lengths = polyline.segmentLengths();
+
+  // Same segment selection rules as the linestring matchSegment
+  if (best_point_index == 0)
+  {
+    return std::make_tuple(trackPos(p, polyline.point(0), polyline.point(1)), size_t(0));
+  }
+  if (best_point_index == n - 1)
+  {
+    TrackPos pos = trackPos(p, polyline.point(n - 2), polyline.point(n - 1));
+    pos.downtrack += arc_lengths[n - 2];
+    return std::make_tuple(pos, n - 2);
+  }
+
+  const lanelet::BasicPoint2d best_point = polyline.point(best_point_index);
+  TrackPos first_seg_trackPos = trackPos(p, polyline.point(best_point_index - 1), best_point);
+  TrackPos second_seg_trackPos = trackPos(p, best_point, polyline.point(best_point_index + 1));
+  if (selectFirstSegment(first_seg_trackPos, second_seg_trackPos, segment_lengths[best_point_index - 1],
+                         segment_lengths[best_point_index]))
+  {
+    first_seg_trackPos.downtrack += arc_lengths[best_point_index - 1];
+    return std::make_tuple(first_seg_trackPos, best_point_index - 1);
+  }
+  second_seg_trackPos.downtrack += arc_lengths[best_point_index];
+  return std::make_tuple(second_seg_trackPos, best_point_index);
+}
+
+TrackPos trackPos(const Polyline2d& polyline, const lanelet::BasicPoint2d& p)
+{
+  return std::get<0>(matchSegment(p, polyline));
+}
+
+}  // namespace geometry
+
+}  // namespace carma_wm
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/SpeedLimitProfile.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace carma_wm
+{
+void SpeedLimitProfile::clear()
+{
+  start_downtracks_.clear();
+  speed_limits_.clear();
+  lanelet_ids_.clear();
+  id_index_map_.clear();
+}
+
+void SpeedLimitProfile::pushBack(lanelet::Id lanelet_id, double start_downtrack, double speed_limit)
+{
+  if (id_index_map_.find(lanelet_id) != id_index_map_.end())
+  {
+    throw std::invalid_argument("SpeedLimitProfile already contains lanelet " + std::to_string(lanelet_id));
+  }
+  if (!start_downtracks_.empty() && start_downtrack < start_downtracks_.back())
+  {
+    throw std::invalid_argument("SpeedLimitProfile segments must be added in downtrack order. Received " +
+                                std::to_string(start_downtrack) + " after " + std::to_string(start_downtracks_.back()));
+  }
+
+  id_index_map_[lanelet_id] = start_downtracks_.size();
+  start_downtracks_.push_back(start_downtrack);
+  speed_limits_.push_back(speed_limit);
+  lanelet_ids_.push_back(lanelet_id);
+}
+
+bool SpeedLimitProfile::update(lanelet::Id lanelet_id, double speed_limit)
+{
+  auto it = id_index_map_.find(lanelet_id);
+  if (it == id_index_map_.end())
+  {
+    return false;
+  }
+  speed_limits_[it->second] = speed_limit;
+  return true;
+}
+
+double SpeedLimitProfile::speedLimitAt(double downtrack) const
+{
+  if (start_downtracks_.empty())
+  {
+    throw std::invalid_argument("No data available in speed limit profile");
+  }
+
+  // The segment containing the downtrack is the last one starting at or before it
+  auto upper = std::upper_bound(start_downtracks_.begin(), start_downtracks_.end(), downtrack);
+  size_t index = upper == start_downtracks_.begin() ? 0 : (upper - start_downtracks_.begin()) - 1;
+  return speed_limits_[index];
+}
+
+lanelet::Optional<double> SpeedLimitProfile::speedLimit(lanelet::Id lanelet_id) const
+{
+  auto it = id_index_map_.find(lanelet_id);
+  if (it == id_index_map_.end())
+  {
+    return boost::none;
+  }
+  return speed_limits_[it->second];
+}
+
+const std::vector<double>& SpeedLimitProfile::startDowntracks() const
+{
+  return start_downtracks_;
+}
+
+const std::vector<double>& SpeedLimitProfile::speedLimits() const
+{
+  return speed_limits_;
+}
+
+const std::vector<lanelet::Id>& SpeedLimitProfile::laneletIds() const
+{
+  return lanelet_ids_;
+}
+
+size_t SpeedLimitProfile::size() const
+{
+  return start_downtracks_.size();
+}
+
+bool SpeedLimitProfile::empty() const
+{
+  return start_downtracks_.empty();
+}
+}  // namespace carma_wm
@@ -22,7 +22,7 @@
 namespace carma_wm
 {
   // @SONAR_STOP@
-WMListener::WMListener(bool multi_thread) : worker_(std::unique_ptr<WMListenerWorker>(new WMListenerWorker)), multi_threaded_(multi_thread)
+WMListener::WMListener(bool multi_thread, bool use_snapshots) : worker_(std::unique_ptr<WMListenerWorker>(new WMListenerWorker)), multi_threaded_(multi_thread)
 {
 
   ROS_DEBUG_STREAM("WMListener: Creating world model listener");
@@ -46,6 +46,12 @@ WMListener::WMListener(bool multi_thread) : worker_(std::unique_ptr<WMListenerWo
   nh2_.getParam("/vehicle_participant_type", participant);
   worker_->setVehicleParticipationType(participant);
 
+  if (use_snapshots)
+  {
+    ROS_DEBUG_STREAM("WMListener: Publishing world model snapshots");
+    worker_->enableSnapshots();
+  }
+
 
   // Set up AsyncSpinner for multi-threaded use case
   if (multi_threaded_)
@@ -79,6 +85,11 @@ WorldModelConstPtr WMListener::getWorldModel()
   return worker_->getWorldModel();
 }
 
+WorldModelConstPtr WMListener::getWorldModelSnapshot() const
+{
+  return worker_->getSnapshot();
+}
+
 void WMListener::mapUpdateCallback(const autoware_lanelet2_msgs::MapBinPtr& geofence_msg)
 {
   const std::lock_guard<std::mutex> lock(mw_mutex_);
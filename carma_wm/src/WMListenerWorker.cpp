@@ -19,6 +19,7 @@
 #include <lanelet2_extension/regulatory_elements/StopRule.h>
 #include <lanelet2_extension/regulatory_elements/CarmaTrafficSignal.h>
 #include <lanelet2_extension/regulatory_elements/SignalizedIntersection.h>
+#include <memory>
 #include "WMListenerWorker.h"
 
 namespace carma_wm
@@ -50,7 +51,75 @@ WorldModelConstPtr WMListenerWorker::getWorldModel() const
   return std::static_pointer_cast<const WorldModel>(world_model_);  // Cast pointer to const variant
 }
 
+void WMListenerWorker::enableSnapshots()
+{
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
+  snapshots_enabled_ = true;
+  publishSnapshot();
+}
+
+WorldModelConstPtr WMListenerWorker::getSnapshot() const
+{
+  if (!snapshots_enabled_)
+  {
+    throw std::invalid_argument("World model snapshots requested before they were enabled");
+  }
+
+  // Publish the pending updates unless they are still being applied, in which case the previous snapshot is returned
+  if (snapshot_stale_ && update_mutex_.try_lock())
+  {
+    std::lock_guard<std::recursive_mutex> lock(update_mutex_, std::adopt_lock);
+    if (snapshot_stale_)
+    {
+      publishSnapshot();
+    }
+  }
+
+  return std::atomic_load(&snapshot_);
+}
+
+void WMListenerWorker::markUpdated()
+{
+  snapshot_stale_ = snapshots_enabled_;
+}
+
+void WMListenerWorker::publishSnapshot() const
+{
+  // The copy shares the map, routing graph and route with world_model_, which replaces rather than edits them on update
+  std::atomic_store(&snapshot_, std::shared_ptr<const CARMAWorldModel>(std::make_shared<CARMAWorldModel>(*world_model_)));
+  snapshot_stale_ = false;
+}
+
+bool WMListenerWorker::detachMapFromSnapshot()
+{
+  // snapshot_ is only stored while update_mutex_ is held so it can be read without atomic_load here
+  if (!snapshot_ || snapshot_->getMutableMap() != world_model_->getMutableMap())
+  {
+    return false;
+  }
+
+  ROS_DEBUG_STREAM("Copying map so the update does not modify the published world model snapshot");
+
+  // A round trip through the map message is a deep copy which preserves the references between primitives
+  autoware_lanelet2_msgs::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(world_model_->getMutableMap(), &map_msg);
+
+  lanelet::LaneletMapPtr map_copy(new lanelet::LaneletMap);
+  lanelet::utils::conversion::fromBinMsg(map_msg, map_copy);
+
+  // The routing graph still references the snapshot's map until it is rebuilt once the update is applied
+  world_model_->setMap(map_copy, current_map_version_, false);
+  return true;
+}
+
 void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg)
+{
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
+  applyMap(map_msg);
+  markUpdated();
+}
+
+void WMListenerWorker::applyMap(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg)
 {
   current_map_version_ = map_msg->map_version;
 
@@ -72,7 +141,7 @@ void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr&
       continue;
     }
     if (update->map_version == current_map_version_) { // Current update goes with current map
-      mapUpdateCallback(update); // Apply the update
+      applyMapUpdate(update); // Apply the update
     } else {
       ROS_INFO_STREAM("Done applying updates for new map. However, more updates are waiting for a future map.");
       more_updates_to_apply = false; // If there is more updates queued that are not for this map version assume they are for a future map version
@@ -88,7 +157,7 @@ void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr&
 
   if (delayed_route_msg_) {
     if (delayed_route_msg_.get()->map_version == current_map_version_) { // If there is a delayed route message to apply then do so
-      routeCallback(delayed_route_msg_.get());
+      applyRoute(delayed_route_msg_.get());
     } else if (delayed_route_msg_.get()->map_version < current_map_version_) {
       ROS_WARN_STREAM("Dropping delayed route message which was never applied as updated map was not recieved");
       delayed_route_msg_ = boost::none;
@@ -100,7 +169,9 @@ void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::MapBinConstPtr&
 
 void WMListenerWorker::incomingSpatCallback(const cav_msgs::SPAT& spat_msg)
 {
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
   world_model_->processSpatFromMsg(spat_msg);
+  markUpdated();
 }
 
 bool WMListenerWorker::checkIfReRoutingNeeded() const
@@ -141,6 +212,13 @@ void logSignalizedIntersectionManager(const carma_wm::SignalizedIntersectionMana
 }
 
 void WMListenerWorker::mapUpdateCallback(const autoware_lanelet2_msgs::MapBinPtr& geofence_msg)
+{
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
+  applyMapUpdate(geofence_msg);
+  markUpdated();
+}
+
+void WMListenerWorker::applyMapUpdate(const autoware_lanelet2_msgs::MapBinPtr& geofence_msg)
 {
   ROS_INFO_STREAM("Map Update Being Evaluated. SeqNum: " << geofence_msg->header.seq);
   if (rerouting_flag_) // no update should be applied if rerouting 
@@ -183,6 +261,8 @@ void WMListenerWorker::mapUpdateCallback(const autoware_lanelet2_msgs::MapBinPtr
 
   most_recent_update_msg_seq_ = geofence_msg->header.seq; // Update current sequence count
 
+  bool map_copied = detachMapFromSnapshot();
+
   auto gf_ptr = std::shared_ptr<carma_wm::TrafficControl>(new carma_wm::TrafficControl);
   
   // convert ros msg to geofence object
@@ -276,7 +356,42 @@ void WMListenerWorker::mapUpdateCallback(const autoware_lanelet2_msgs::MapBinPtr
   }
   
   // set the Map to trigger a new route graph construction if rerouting was required by the updates. 
-  world_model_->setMap(world_model_->getMutableMap(), current_map_version_, recompute_route_flag_);
+  world_model_->setMap(world_model_->getMutableMap(), current_map_version_, recompute_route_flag_ || map_copied);
+
+  // A copied map needs its own route as the previous one references the lanelets of the snapshot's map
+  if (map_copied && world_model_->getRoute())
+  {
+    std::vector<lanelet::Id> shortest_path_ids;
+    for (const auto& llt : world_model_->getRoute()->shortestPath())
+    {
+      shortest_path_ids.push_back(llt.id());
+    }
+    lanelet::BasicPoint3d end_point = world_model_->getRoute()->getEndPoint().basicPoint();
+
+    LaneletRoutePtr route = buildRoute(shortest_path_ids);
+    if (route)
+    {
+      world_model_->setRoute(route);
+      world_model_->setRouteEndPoint(end_point);
+    }
+    else
+    {
+      ROS_WARN_STREAM("Route could not be rebuilt on the updated map. Keeping the previous route until rerouting occurs");
+    }
+  }
+
+  // Refresh the route speed limits of lanelets whose regulations changed, such as by a DigitalSpeedLimit geofence
+  std::vector<lanelet::Id> updated_lanelets;
+  updated_lanelets.reserve(gf_ptr->remove_list_.size() + gf_ptr->update_list_.size());
+  for (const auto& pair : gf_ptr->remove_list_)
+  {
+    updated_lanelets.push_back(pair.first);
+  }
+  for (const auto& pair : gf_ptr->update_list_)
+  {
+    updated_lanelets.push_back(pair.first);
+  }
+  world_model_->updateRouteSpeedLimits(updated_lanelets);
 
   // no need to reroute again unless received invalidated msg again
   if (recompute_route_flag_)
@@ -436,10 +551,19 @@ std::string WMListenerWorker::getVehicleParticipationType() const
 void WMListenerWorker::roadwayObjectListCallback(const cav_msgs::RoadwayObstacleList& msg)
 {
   // this topic publishes only the objects that are on the road
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
   world_model_->setRoadwayObjects(msg.roadway_obstacles);
+  markUpdated();
 }
 
 void WMListenerWorker::routeCallback(const cav_msgs::RouteConstPtr& route_msg)
+{
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
+  applyRoute(route_msg);
+  markUpdated();
+}
+
+void WMListenerWorker::applyRoute(const cav_msgs::RouteConstPtr& route_msg)
 {
   if (route_msg->map_version < current_map_version_) {
     ROS_WARN_STREAM("Route message rejected as it is for an older map");
@@ -473,7 +597,7 @@ void WMListenerWorker::routeCallback(const cav_msgs::RouteConstPtr& route_msg)
       }
       if (update->map_version == current_map_version_) { // Current update goes with current map which is also the map used by this route
         ROS_DEBUG_STREAM("Applying queued update after route was recieved. ");
-        mapUpdateCallback(update); // Apply the update
+        applyMapUpdate(update); // Apply the update
       } else {
         ROS_INFO_STREAM("Apply from reroute: Done applying updates for new map. However, more updates are waiting for a future map.");
         more_updates_to_apply = false; // If there is more updates queued that are not for this map version assume they are for a future map version
@@ -491,17 +615,9 @@ void WMListenerWorker::routeCallback(const cav_msgs::RouteConstPtr& route_msg)
     return;
   }
 
-  auto path = lanelet::ConstLanelets();
-  for(auto id : route_msg->shortest_path_lanelet_ids)
-  {
-    auto ll = world_model_->getMap()->laneletLayer.get(id);
-    path.push_back(ll);
-  }
-  if(path.empty()) return;
-  auto route_opt = path.size() == 1 ? world_model_->getMapRoutingGraph()->getRoute(path.front(), path.back())
-                               : world_model_->getMapRoutingGraph()->getRouteVia(path.front(), lanelet::ConstLanelets(path.begin() + 1, path.end() - 1), path.back());
-  if(route_opt.is_initialized()) {
-    auto ptr = std::make_shared<lanelet::routing::Route>(std::move(route_opt.get()));
+  if(route_msg->shortest_path_lanelet_ids.empty()) return;
+  auto ptr = buildRoute(route_msg->shortest_path_lanelet_ids);
+  if(ptr) {
     world_model_->setRoute(ptr);
   }
 
@@ -516,6 +632,22 @@ void WMListenerWorker::routeCallback(const cav_msgs::RouteConstPtr& route_msg)
   }
 }
 
+LaneletRoutePtr WMListenerWorker::buildRoute(const std::vector<lanelet::Id>& shortest_path_ids) const
+{
+  auto path = lanelet::ConstLanelets();
+  for(auto id : shortest_path_ids)
+  {
+    auto ll = world_model_->getMap()->laneletLayer.get(id);
+    path.push_back(ll);
+  }
+  auto route_opt = path.size() == 1 ? world_model_->getMapRoutingGraph()->getRoute(path.front(), path.back())
+                               : world_model_->getMapRoutingGraph()->getRouteVia(path.front(), lanelet::ConstLanelets(path.begin() + 1, path.end() - 1), path.back());
+  if(!route_opt.is_initialized()) {
+    return nullptr;
+  }
+  return std::make_shared<lanelet::routing::Route>(std::move(route_opt.get()));
+}
+
 void WMListenerWorker::setMapCallback(std::function<void()> callback)
 {
   map_callback_ = callback;
@@ -528,9 +660,11 @@ void WMListenerWorker::setRouteCallback(std::function<void()> callback)
 
 void WMListenerWorker::setConfigSpeedLimit(double config_lim)
 {
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
   config_speed_limit_ = config_lim;
   //Function to load config_limit into CarmaWorldModel
    world_model_->setConfigSpeedLimit(config_speed_limit_);
+   markUpdated();
 }
 
 double WMListenerWorker::getConfigSpeedLimit() const
@@ -541,7 +675,9 @@ double WMListenerWorker::getConfigSpeedLimit() const
 void WMListenerWorker::setVehicleParticipationType(std::string participant)
 {  
   //Function to load participation type into CarmaWorldModel
+  std::lock_guard<std::recursive_mutex> lock(update_mutex_);
   world_model_->setVehicleParticipationType(participant);
+  markUpdated();
 }
 
 
@@ -21,6 +21,8 @@
 #include <carma_wm/CARMAWorldModel.h>
 #include <carma_wm/TrafficControl.h>
 #include <queue>
+#include <mutex>
+#include <atomic>
 #include <cav_msgs/SPAT.h>
 #include <carma_wm/SignalizedIntersectionManager.h>
 
@@ -43,6 +45,31 @@ public:
    */
   WorldModelConstPtr getWorldModel() const;
 
+  /*!
+   * \brief Enables publication of world model snapshots and publishes the first one from the current state.
+   *
+   * Once enabled, the callbacks which change the world model mark the latest snapshot as stale and the next call to
+   * getSnapshot() publishes a new one, so a burst of updates between two reads results in a single snapshot. Map updates
+   * (geofences) are applied to a copy of the map only when the current map is still referenced by the latest snapshot,
+   * in which case the routing graph and route are rebuilt on that copy.
+   */
+  void enableSnapshots();
+
+  /*!
+   * \brief Returns the most recently published world model snapshot. Safe to call from any thread.
+   *
+   * A snapshot is an immutable version of the world model which is never modified by later updates, so it can be
+   * held for the duration of a planning cycle without locking. The one exception is traffic signal timing from SPAT
+   * messages, which is written to the signal regulatory elements shared by all snapshots of the same map.
+   * If the world model is being updated when this is called, the previous snapshot is returned rather than waiting
+   * for the update to complete. User map and route callbacks should use getWorldModel().
+   *
+   * \throws std::invalid_argument if enableSnapshots() has not been called
+   *
+   * \return Const pointer to the latest world model snapshot
+   */
+  WorldModelConstPtr getSnapshot() const;
+
   /*!
    * \brief Callback for new map messages. Updates the underlying map
    *
@@ -127,7 +154,38 @@ public:
   void incomingSpatCallback(const cav_msgs::SPAT& spat_msg);
 
 private:
+  // Implementations of the callbacks above, which may call each other without publishing intermediate snapshots
+  void applyMap(const autoware_lanelet2_msgs::MapBinConstPtr& map_msg);
+  void applyMapUpdate(const autoware_lanelet2_msgs::MapBinPtr& geofence_msg);
+  void applyRoute(const cav_msgs::RouteConstPtr& route_msg);
+
+  /*!
+   * \brief Builds a route over the current map which follows the provided lanelet ids
+   *
+   * \return The route or nullptr if no route could be found
+   */
+  LaneletRoutePtr buildRoute(const std::vector<lanelet::Id>& shortest_path_ids) const;
+
+  /*!
+   * \brief Replaces the map of world_model_ with a deep copy if the map is referenced by the latest snapshot
+   *
+   * \return True if the map was copied, in which case the routing graph and route must be rebuilt on the copy
+   */
+  bool detachMapFromSnapshot();
+
+  // Publishes a copy of world_model_ as the latest snapshot. update_mutex_ must be held
+  void publishSnapshot() const;
+
+  // Marks the latest snapshot as stale after a callback changed world_model_. update_mutex_ must be held
+  void markUpdated();
+
   std::shared_ptr<CARMAWorldModel> world_model_;
+  // Held by the callbacks while they change world_model_ and by getSnapshot() while it copies world_model_.
+  // Recursive so a user callback which requests a snapshot on the updating thread does not deadlock
+  mutable std::recursive_mutex update_mutex_;
+  mutable std::shared_ptr<const CARMAWorldModel> snapshot_; // Latest published snapshot. Accessed through std::atomic_load/atomic_store
+  mutable std::atomic<bool> snapshot_stale_{ false }; // True if world_model_ changed since snapshot_ was published
+  bool snapshots_enabled_ = false;
   std::function<void()> map_callback_;
   std::function<void()> route_callback_;
   void newRegemUpdateHelper(lanelet::Lanelet parent_llt, lanelet::RegulatoryElement* regem) const;
@@ -113,8 +113,56 @@ std::vector<lanelet::ConstLanelet> nonConnectedAdjacentLeft(const lanelet::Lanel
   return opposite_lanelets;
 }
 
+namespace
+{
+// The lanelets containing the point found by iteratively calling findNearest on the lanelet map
+std::unordered_set<lanelet::Lanelet> containingLaneletsByNearest(const lanelet::BasicPoint2d& point, const lanelet::LaneletMapPtr& lanelet_map, double max_lane_width)
+{
+  std::unordered_set<lanelet::Lanelet> possible_lanelets;
+
+  // This loop identifes the lanelets which this point lies within that could be impacted by the geofence
+  // This loop somewhat inefficiently calls the findNearest method iteratively until all the possible lanelets are identified. 
+  // The reason findNearest is used instead of nearestUntil is because that method orders results by bounding box which
+  // can give invalid sequences when dealing with large curved lanelets.  
+  bool continue_search = true; 
+  size_t nearest_count = 0;
+  while (continue_search) {
+    
+    nearest_count += 10; // Increase the index search radius by 10 each loop until all nearby lanelets are found
+
+    for (const auto& ll_pair : lanelet::geometry::findNearest(lanelet_map->laneletLayer, point, nearest_count)) { // Get the nearest lanelets and iterate over them
+      auto ll = std::get<1>(ll_pair);
+
+      if (possible_lanelets.find(ll) != possible_lanelets.end()) { // Skip if already found
+        continue;
+      }
 
-lanelet::ConstLaneletOrAreas getAffectedLaneletOrAreas(const lanelet::Points3d& gf_pts, const lanelet::LaneletMapPtr& lanelet_map, std::shared_ptr<const lanelet::routing::RoutingGraph> routing_graph, double max_lane_width)
+      double dist = std::get<0>(ll_pair);
+      ROS_DEBUG_STREAM("Distance to lanelet " << ll.id() << ": " << dist << " max_lane_width: " << max_lane_width);
+      
+      if (dist > max_lane_width) { // Only save values closer than max_lane_width. Since we are iterating in distance order when we reach this distance the search can stop
+        continue_search = false;
+        break;
+      }
+
+      // Check if the point is inside this lanelet
+      if(dist == 0.0) { // boost geometry uses a distance of 0 to indicate a point is within a polygon
+        possible_lanelets.insert(ll);
+      }
+
+    }
+
+    if (nearest_count >= lanelet_map->laneletLayer.size()) { // if we are out of lanelets to evaluate then end the search
+      continue_search = false;
+    }
+  }
+  return possible_lanelets;
+}
+
+// Shared implementation of getAffectedLaneletOrAreas. containing_lanelets returns the lanelets which contain the provided point
+template <typename ContainingLaneletsFunc>
+lanelet::ConstLaneletOrAreas affectedLaneletOrAreas(const lanelet::Points3d& gf_pts, const lanelet::LaneletMapPtr& lanelet_map, std::shared_ptr<const lanelet::routing::RoutingGraph> routing_graph,
+                                                    const ContainingLaneletsFunc& containing_lanelets)
 {
   // Logic to detect which part is affected
   ROS_DEBUG_STREAM("Get affected lanelets loop");
@@ -122,44 +170,7 @@ lanelet::ConstLaneletOrAreas getAffectedLaneletOrAreas(const lanelet::Points3d&
   for (size_t idx = 0; idx < gf_pts.size(); idx ++)
   {
     ROS_DEBUG_STREAM("Index: " << idx << " Point: " << gf_pts[idx].x() << ", " << gf_pts[idx].y());
-    std::unordered_set<lanelet::Lanelet> possible_lanelets;
-
-    // This loop identifes the lanelets which this point lies within that could be impacted by the geofence
-    // This loop somewhat inefficiently calls the findNearest method iteratively until all the possible lanelets are identified. 
-    // The reason findNearest is used instead of nearestUntil is because that method orders results by bounding box which
-    // can give invalid sequences when dealing with large curved lanelets.  
-    bool continue_search = true; 
-    size_t nearest_count = 0;
-    while (continue_search) {
-      
-      nearest_count += 10; // Increase the index search radius by 10 each loop until all nearby lanelets are found
-
-      for (const auto& ll_pair : lanelet::geometry::findNearest(lanelet_map->laneletLayer, gf_pts[idx].basicPoint2d(), nearest_count)) { // Get the nearest lanelets and iterate over them
-        auto ll = std::get<1>(ll_pair);
-
-        if (possible_lanelets.find(ll) != possible_lanelets.end()) { // Skip if already found
-          continue;
-        }
-
-        double dist = std::get<0>(ll_pair);
-        ROS_DEBUG_STREAM("Distance to lanelet " << ll.id() << ": " << dist << " max_lane_width: " << max_lane_width);
-        
-        if (dist > max_lane_width) { // Only save values closer than max_lane_width. Since we are iterating in distance order when we reach this distance the search can stop
-          continue_search = false;
-          break;
-        }
-
-        // Check if the point is inside this lanelet
-        if(dist == 0.0) { // boost geometry uses a distance of 0 to indicate a point is within a polygon
-          possible_lanelets.insert(ll);
-        }
-
-      }
-
-      if (nearest_count >= lanelet_map->laneletLayer.size()) { // if we are out of lanelets to evaluate then end the search
-        continue_search = false;
-      }
-    }
+    std::unordered_set<lanelet::Lanelet> possible_lanelets = containing_lanelets(gf_pts[idx].basicPoint2d());
 
     // among these llts, filter the ones that are on same direction as the geofence using routing
     if (idx + 1 == gf_pts.size()) // we only check this for the last gf_pt after saving everything
@@ -244,6 +255,22 @@ lanelet::ConstLaneletOrAreas getAffectedLaneletOrAreas(const lanelet::Points3d&
 
   return affected_parts;
 }
+}  // namespace
+
+lanelet::ConstLaneletOrAreas getAffectedLaneletOrAreas(const lanelet::Points3d& gf_pts, const lanelet::LaneletMapPtr& lanelet_map, std::shared_ptr<const lanelet::routing::RoutingGraph> routing_graph, double max_lane_width)
+{
+  return affectedLaneletOrAreas(gf_pts, lanelet_map, routing_graph, [&](const lanelet::BasicPoint2d& point) {
+    return containingLaneletsByNearest(point, lanelet_map, max_lane_width);
+  });
+}
+
+lanelet::ConstLaneletOrAreas getAffectedLaneletOrAreas(const lanelet::Points3d& gf_pts, const lanelet::LaneletMapPtr& lanelet_map, std::shared_ptr<const lanelet::routing::RoutingGraph> routing_graph, const LaneletGridIndex& lanelet_index)
+{
+  return affectedLaneletOrAreas(gf_pts, lanelet_map, routing_graph, [&](const lanelet::BasicPoint2d& point) {
+    auto containing = lanelet_index.containingLanelets(point);
+    return std::unordered_set<lanelet::Lanelet>(containing.begin(), containing.end());
+  });
+}
 
 // helper function that filters successor lanelets of root_lanelets from possible_lanelets
 std::unordered_set<lanelet::Lanelet> filterSuccessorLanelets(const std::unordered_set<lanelet::Lanelet>& possible_lanelets, const std::unordered_set<lanelet::Lanelet>& root_lanelets,
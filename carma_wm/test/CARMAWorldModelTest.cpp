@@ -940,6 +940,125 @@ TEST(CARMAWorldModelTest, getTrafficRules2)
   ASSERT_FALSE(!!default_participant);
 }
 
+TEST(CARMAWorldModelTest, getTrafficRulesCached)
+{
+  CARMAWorldModel cmw;
+
+  addStraightRoute(cmw);
+
+  // Repeated requests share the same rules object
+  auto first = cmw.getTrafficRules();
+  ASSERT_TRUE(!!first);
+  ASSERT_EQ(first.get(), cmw.getTrafficRules().get());
+  ASSERT_EQ(first.get(), cmw.getTrafficRules(lanelet::Participants::Vehicle).get());
+
+  auto car = cmw.getTrafficRules(lanelet::Participants::VehicleCar);
+  ASSERT_TRUE(!!car);
+  ASSERT_NE(first.get(), car.get());
+  ASSERT_EQ(car.get(), cmw.getTrafficRules(lanelet::Participants::VehicleCar).get());
+
+  ASSERT_FALSE(!!cmw.getTrafficRules("fake_person"));
+  ASSERT_FALSE(!!cmw.getTrafficRules("fake_person"));
+
+  // A map update or config speed limit change rebuilds the rules
+  cmw.setMap(cmw.getMutableMap(), 1, false);
+  auto after_map = cmw.getTrafficRules();
+  ASSERT_TRUE(!!after_map);
+  ASSERT_NE(first.get(), after_map.get());
+
+  cmw.setConfigSpeedLimit(20.0);
+  auto after_config = cmw.getTrafficRules();
+  ASSERT_TRUE(!!after_config);
+  ASSERT_NE(after_map.get(), after_config.get());
+}
+
+TEST(CARMAWorldModelTest, speedLimitProfile)
+{
+  SpeedLimitProfile profile;
+  ASSERT_TRUE(profile.empty());
+  ASSERT_THROW(profile.speedLimitAt(0.0), std::invalid_argument);
+
+  profile.pushBack(10, 0.0, 5.0);
+  profile.pushBack(11, 25.0, 10.0);
+  profile.pushBack(12, 50.0, 15.0);
+
+  ASSERT_THROW(profile.pushBack(11, 75.0, 10.0), std::invalid_argument); // Duplicate lanelet
+  ASSERT_THROW(profile.pushBack(13, 40.0, 10.0), std::invalid_argument); // Out of order
+
+  ASSERT_EQ(3u, profile.size());
+  ASSERT_NEAR(5.0, profile.speedLimitAt(-1.0), 0.00001);
+  ASSERT_NEAR(5.0, profile.speedLimitAt(0.0), 0.00001);
+  ASSERT_NEAR(5.0, profile.speedLimitAt(24.9), 0.00001);
+  ASSERT_NEAR(10.0, profile.speedLimitAt(25.0), 0.00001);
+  ASSERT_NEAR(15.0, profile.speedLimitAt(50.0), 0.00001);
+  ASSERT_NEAR(15.0, profile.speedLimitAt(500.0), 0.00001);
+
+  ASSERT_TRUE(profile.update(11, 7.0));
+  ASSERT_FALSE(profile.update(99, 7.0));
+  ASSERT_NEAR(7.0, profile.speedLimitAt(30.0), 0.00001);
+  ASSERT_NEAR(7.0, profile.speedLimit(11).get(), 0.00001);
+  ASSERT_FALSE(!!profile.speedLimit(99));
+
+  profile.clear();
+  ASSERT_TRUE(profile.empty());
+  ASSERT_FALSE(!!profile.speedLimit(11));
+}
+
+TEST(CARMAWorldModelTest, getRouteSpeedLimitProfile)
+{
+  std::shared_ptr<carma_wm::CARMAWorldModel> wm = std::make_shared<carma_wm::CARMAWorldModel>();
+
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+  wm->setMap(map);
+  carma_wm::test::setSpeedLimit(20_mph, wm);
+
+  ASSERT_TRUE(wm->getRouteSpeedLimitProfile().empty()); // No route yet
+
+  carma_wm::test::setRouteByIds({ 1200, 1201, 1202, 1203 }, wm);
+
+  const SpeedLimitProfile& profile = wm->getRouteSpeedLimitProfile();
+  ASSERT_EQ(4u, profile.size());
+  ASSERT_EQ(std::vector<lanelet::Id>({ 1200, 1201, 1202, 1203 }), profile.laneletIds());
+
+  auto traffic_rules = wm->getTrafficRules();
+  ASSERT_TRUE(!!traffic_rules);
+  for (size_t i = 0; i < profile.size(); i++)
+  {
+    auto llt = wm->getMap()->laneletLayer.get(profile.laneletIds()[i]);
+    ASSERT_NEAR(wm->routeTrackPos(llt).downtrack, profile.startDowntracks()[i], 0.00001);
+    ASSERT_NEAR((*traffic_rules)->speedLimit(llt).speedLimit.value(), profile.speedLimits()[i], 0.00001);
+  }
+  ASSERT_NEAR((*traffic_rules)->speedLimit(wm->getMap()->laneletLayer.get(1201)).speedLimit.value(), profile.speedLimitAt(30.0), 0.00001);
+
+  // An in place regulation change, as applied by a DigitalSpeedLimit geofence, only updates the provided lanelets
+  auto llt_1201 = wm->getMutableMap()->laneletLayer.get(1201);
+  for (auto regem : llt_1201.regulatoryElements())
+  {
+    if (regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::DigitalSpeedLimit::RuleName) == 0)
+    {
+      wm->getMutableMap()->remove(llt_1201, regem);
+    }
+  }
+  lanelet::DigitalSpeedLimitPtr slower = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(
+      lanelet::utils::getId(), 10_mph, { llt_1201 }, {}, { lanelet::Participants::Vehicle }));
+  wm->getMutableMap()->update(llt_1201, slower);
+  wm->setMap(wm->getMutableMap(), 1, false);
+
+  double original_limit = profile.speedLimit(1200).get();
+  wm->updateRouteSpeedLimits({ 1201, 1210 }); // 1210 is not on the route and is ignored
+
+  traffic_rules = wm->getTrafficRules();
+  ASSERT_NEAR((*traffic_rules)->speedLimit(wm->getMap()->laneletLayer.get(1201)).speedLimit.value(),
+              profile.speedLimit(1201).get(), 0.00001);
+  ASSERT_NE(original_limit, profile.speedLimit(1201).get());
+  ASSERT_NEAR(original_limit, profile.speedLimit(1200).get(), 0.00001);
+  ASSERT_NEAR(profile.speedLimit(1201).get(), profile.speedLimitAt(30.0), 0.00001);
+
+  // A new map invalidates the profile until a route is set on it
+  wm->setMap(carma_wm::test::buildGuidanceTestMap(3.7, 25));
+  ASSERT_TRUE(wm->getRouteSpeedLimitProfile().empty());
+}
+
 TEST(CARMAWorldModelTest, toRoadwayObstacle)
 {
   CARMAWorldModel cmw;
@@ -1545,4 +1664,22 @@ TEST(CARMAWorldModelTest, getIntersectionAlongRoute)
 }
 
 
+TEST(CARMAWorldModelTest, getMapUpdateCount)
+{
+  carma_wm::CARMAWorldModel cmw;
+  EXPECT_EQ(0u, cmw.getMapUpdateCount());
+
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+  cmw.setMap(map, 3);
+  EXPECT_EQ(1u, cmw.getMapUpdateCount());
+
+  // In place updates keep the map version but still count as an update
+  cmw.setMap(map, 3, false);
+  EXPECT_EQ(3u, cmw.getMapVersion());
+  EXPECT_EQ(2u, cmw.getMapUpdateCount());
+
+  carma_wm::CARMAWorldModel copy(cmw);
+  EXPECT_EQ(2u, copy.getMapUpdateCount());
+}
+
 }  // namespace carma_wm
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <carma_wm/LaneletGridIndex.h>
+#include <carma_wm/WorldModelUtils.h>
+#include <carma_wm/WMTestLibForGuidance.h>
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+#include <lanelet2_extension/traffic_rules/CarmaUSTrafficRules.h>
+
+namespace carma_wm
+{
+namespace
+{
+std::vector<lanelet::Id> sortedIds(const std::vector<lanelet::Lanelet>& lanelets)
+{
+  std::vector<lanelet::Id> ids;
+  for (const auto& llt : lanelets)
+  {
+    ids.push_back(llt.id());
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+}  // namespace
+
+TEST(LaneletGridIndex, containingLanelets)
+{
+  // 3 lanes of 4 lanelets, each 3.7m wide and 25m long. Lanelets span several cells of the 10m grid
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+  LaneletGridIndex index(10.0);
+  index.build(map);
+
+  ASSERT_EQ(12u, index.size());
+
+  EXPECT_EQ(std::vector<lanelet::Id>({ 1200 }), sortedIds(index.containingLanelets({ 1.0, 1.0 })));
+  EXPECT_EQ(std::vector<lanelet::Id>({ 1211 }), sortedIds(index.containingLanelets({ 5.0, 40.0 })));
+  EXPECT_EQ(std::vector<lanelet::Id>({ 1223 }), sortedIds(index.containingLanelets({ 10.0, 99.0 })));
+
+  // Points on a shared boundary are contained by both lanelets
+  EXPECT_EQ(std::vector<lanelet::Id>({ 1200, 1210 }), sortedIds(index.containingLanelets({ 3.7, 10.0 })));
+  EXPECT_EQ(std::vector<lanelet::Id>({ 1201, 1202 }), sortedIds(index.containingLanelets({ 1.0, 50.0 })));
+
+  // Points in an indexed cell but outside every lanelet, and in a cell with no lanelets
+  EXPECT_TRUE(index.containingLanelets({ 12.0, 5.0 }).empty());
+  EXPECT_TRUE(index.containingLanelets({ -50.0, -50.0 }).empty());
+}
+
+TEST(LaneletGridIndex, boundingBox)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+  LaneletGridIndex index;
+  index.build(map);
+
+  const auto& box = index.boundingBox(1211);
+  EXPECT_NEAR(3.7, box.min().x(), 0.00001);
+  EXPECT_NEAR(25.0, box.min().y(), 0.00001);
+  EXPECT_NEAR(7.4, box.max().x(), 0.00001);
+  EXPECT_NEAR(50.0, box.max().y(), 0.00001);
+
+  EXPECT_THROW(index.boundingBox(5), std::invalid_argument);
+  EXPECT_THROW(LaneletGridIndex(0.0), std::invalid_argument);
+
+  // Indexed lanelets use the cached box
+  auto llt_box = index.boundingBox(map->laneletLayer.get(1211));
+  EXPECT_NEAR(3.7, llt_box.min().x(), 0.00001);
+  EXPECT_NEAR(50.0, llt_box.max().y(), 0.00001);
+
+  // A lanelet added to the map after the index was built has its box computed from its geometry
+  auto added = carma_wm::test::getLanelet(
+      1300, { carma_wm::test::getPoint(-3.7, 0, 0), carma_wm::test::getPoint(-3.7, 25, 0) },
+      { carma_wm::test::getPoint(0, 0, 0), carma_wm::test::getPoint(0, 25, 0) }, lanelet::AttributeValueString::Solid,
+      lanelet::AttributeValueString::Solid);
+  map->add(added);
+
+  EXPECT_THROW(index.boundingBox(added.id()), std::invalid_argument);
+  auto added_box = index.boundingBox(added);
+  EXPECT_NEAR(-3.7, added_box.min().x(), 0.00001);
+  EXPECT_NEAR(0.0, added_box.min().y(), 0.00001);
+  EXPECT_NEAR(0.0, added_box.max().x(), 0.00001);
+  EXPECT_NEAR(25.0, added_box.max().y(), 0.00001);
+}
+
+TEST(LaneletGridIndex, insert)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+  LaneletGridIndex index;
+  index.build(map);
+
+  // A lanelet added after the index was built is only found once inserted
+  auto added = carma_wm::test::getLanelet(
+      1300, { carma_wm::test::getPoint(-3.7, 0, 0), carma_wm::test::getPoint(-3.7, 25, 0) },
+      { carma_wm::test::getPoint(0, 0, 0), carma_wm::test::getPoint(0, 25, 0) }, lanelet::AttributeValueString::Solid,
+      lanelet::AttributeValueString::Solid);
+  map->add(added);
+
+  EXPECT_TRUE(index.containingLanelets({ -1.0, 1.0 }).empty());
+  index.insert(added);
+  EXPECT_EQ(std::vector<lanelet::Id>({ 1300 }), sortedIds(index.containingLanelets({ -1.0, 1.0 })));
+
+  // Inserting a lanelet again has no effect
+  index.insert(added);
+  EXPECT_EQ(13u, index.size());
+  EXPECT_EQ(std::vector<lanelet::Id>({ 1300 }), sortedIds(index.containingLanelets({ -1.0, 1.0 })));
+
+  // Building replaces the contents
+  index.build(carma_wm::test::buildGuidanceTestMap(3.7, 25));
+  EXPECT_EQ(12u, index.size());
+  EXPECT_TRUE(index.containingLanelets({ -1.0, 1.0 }).empty());
+
+  index.clear();
+  EXPECT_TRUE(index.empty());
+}
+
+TEST(LaneletGridIndex, getAffectedLaneletOrAreas)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
+  lanelet::routing::RoutingGraphPtr graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+
+  LaneletGridIndex index;
+  index.build(map);
+
+  // Geofences along the middle lane and across a lane change
+  std::vector<lanelet::Points3d> geofences = {
+    { carma_wm::test::getPoint(5.5, 5, 0), carma_wm::test::getPoint(5.5, 30, 0), carma_wm::test::getPoint(5.5, 60, 0) },
+    { carma_wm::test::getPoint(1.5, 10, 0), carma_wm::test::getPoint(1.5, 35, 0), carma_wm::test::getPoint(5.5, 80, 0) },
+    { carma_wm::test::getPoint(9.0, 20, 0), carma_wm::test::getPoint(9.0, 22, 0) },
+  };
+
+  for (const auto& gf_pts : geofences)
+  {
+    auto expected = carma_wm::query::getAffectedLaneletOrAreas(gf_pts, map, graph, 3.7);
+    auto indexed = carma_wm::query::getAffectedLaneletOrAreas(gf_pts, map, graph, index);
+
+    ASSERT_EQ(expected.size(), indexed.size());
+    ASSERT_FALSE(expected.empty());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+      EXPECT_EQ(expected[i].id(), indexed[i].id());
+    }
+  }
+}
+}  // namespace carma_wm
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <carma_wm/ObstacleOccupancyIndex.h>
+#include <carma_wm/WMTestLibForGuidance.h>
+
+namespace carma_wm
+{
+namespace
+{
+// A 3m by 4m obstacle, giving a bounding circle radius of 2.5m, at each of the provided lanelet downtracks. The first
+// sample is the current state at time 0 and each following sample is a prediction 1s after the previous one
+cav_msgs::RoadwayObstacle getObstacle(const std::vector<std::pair<lanelet::Id, double>>& samples)
+{
+  cav_msgs::RoadwayObstacle obstacle;
+  obstacle.object.size.x = 3;
+  obstacle.object.size.y = 4;
+  obstacle.object.header.stamp = ros::Time(0);
+  obstacle.lanelet_id = samples[0].first;
+  obstacle.down_track = samples[0].second;
+  for (size_t i = 1; i < samples.size(); i++)
+  {
+    cav_msgs::PredictedState prediction;
+    prediction.header.stamp = ros::Time(static_cast<double>(i));
+    obstacle.object.predictions.push_back(prediction);
+    obstacle.predicted_lanelet_ids.push_back(samples[i].first);
+    obstacle.predicted_down_tracks.push_back(samples[i].second);
+  }
+  return obstacle;
+}
+}  // namespace
+
+TEST(ObstacleOccupancyIndex, constructor)
+{
+  ASSERT_THROW(ObstacleOccupancyIndex(0.0, 1.0), std::invalid_argument);
+  ASSERT_THROW(ObstacleOccupancyIndex(10.0, -1.0), std::invalid_argument);
+}
+
+TEST(ObstacleOccupancyIndex, sweptFootprints)
+{
+  ObstacleOccupancyIndex index(10.0, 1.0);
+  // Moves 10m/s along lanelet 1 then into lanelet 2 between 2s and 3s
+  auto moving = getObstacle({ { 1, 10 }, { 1, 20 }, { 1, 30 }, { 2, 5 } });
+  // Stationary in lanelet 1 with no predictions
+  auto stationary = getObstacle({ { 1, 80 } });
+  index.build({ moving, stationary });
+
+  ASSERT_EQ(5u, index.size());
+  const ObstacleFootprint& first = index.footprints()[0];
+  ASSERT_EQ(1, first.lanelet_id);
+  ASSERT_NEAR(7.5, first.start_downtrack, 0.00001);
+  ASSERT_NEAR(22.5, first.end_downtrack, 0.00001);
+  ASSERT_NEAR(0.0, first.start_time, 0.00001);
+  ASSERT_NEAR(1.0, first.end_time, 0.00001);
+
+  // Between samples the footprint covers the swept distance
+  ASSERT_EQ(std::vector<size_t>({ 0 }), index.occupyingObstacles(1, 14.0, 16.0, 0.5, 0.5));
+  ASSERT_EQ(std::vector<size_t>({ 0 }), index.occupyingObstacles(1, 25.0, 26.0, 1.5, 1.6));
+  ASSERT_TRUE(index.occupyingObstacles(1, 25.0, 26.0, 0.2, 0.4).empty());
+
+  // After leaving lanelet 1 the obstacle only occupies lanelet 2
+  ASSERT_EQ(std::vector<size_t>({ 0 }), index.occupyingObstacles(1, 30.0, 31.0, 2.5, 2.6));
+  ASSERT_EQ(std::vector<size_t>({ 0 }), index.occupyingObstacles(2, 4.0, 6.0, 2.5, 2.6));
+  ASSERT_TRUE(index.occupyingObstacles(2, 4.0, 6.0, 0.0, 1.9).empty());
+  ASSERT_TRUE(index.occupyingObstacles(1, 30.0, 31.0, 3.5, 4.0).empty());
+
+  // The stationary obstacle only occupies its position at its header stamp
+  ASSERT_EQ(std::vector<size_t>({ 1 }), index.occupyingObstacles(1, 75.0, 78.0, 0.0, 0.0));
+  ASSERT_TRUE(index.occupyingObstacles(1, 75.0, 78.0, 0.1, 5.0).empty());
+
+  // Large regions are answered by checking every footprint of the lanelet and give the same result
+  ASSERT_EQ(std::vector<size_t>({ 0, 1 }), index.occupyingObstacles(1, -1000.0, 1000.0, -100.0, 100.0));
+  ASSERT_EQ(std::vector<size_t>({ 0, 1 }), index.occupyingObstacles(1, 0.0, 100.0, 0.0, 0.0));
+
+  // The extent of a lanelet covers all of its footprints
+  auto extent = index.downtrackExtent(1);
+  ASSERT_TRUE(!!extent);
+  ASSERT_NEAR(7.5, extent->first, 0.00001);
+  ASSERT_NEAR(82.5, extent->second, 0.00001);
+  ASSERT_FALSE(!!index.downtrackExtent(3));
+
+  // Unknown lanelets and inverted intervals have no occupants
+  ASSERT_TRUE(index.occupyingObstacles(3, 0.0, 100.0, 0.0, 10.0).empty());
+  ASSERT_TRUE(index.occupyingObstacles(1, 20.0, 10.0, 0.0, 10.0).empty());
+  ASSERT_TRUE(index.occupyingObstacles(1, 10.0, 20.0, 1.0, 0.0).empty());
+
+  index.clear();
+  ASSERT_TRUE(index.empty());
+  ASSERT_TRUE(index.occupyingObstacles(1, -1000.0, 1000.0, -100.0, 100.0).empty());
+}
+
+TEST(ObstacleOccupancyIndex, longPredictionGap)
+{
+  // A footprint spanning more buckets than are copied into is still found by small queries
+  ObstacleOccupancyIndex index(1.0, 0.1);
+  index.build({ getObstacle({ { 1, 0 }, { 1, 200 } }) });
+  ASSERT_EQ(std::vector<size_t>({ 0 }), index.occupyingObstacles(1, 100.0, 100.5, 0.5, 0.55));
+}
+
+TEST(ObstacleOccupancyIndex, getObjectsInLaneInterval)
+{
+  auto cmw = test::getGuidanceTestMap(
+      test::MapOptions(3.7, 25, test::MapOptions::Obstacle::NONE, test::MapOptions::SpeedLimit::DEFAULT));
+
+  // Moving from 10m into lanelet 1200 to 5m into lanelet 1201 over 2s, and stationary in the right lane
+  test::addObstacle(TrackPos(10, 0), 1200, cmw, { TrackPos(20, 0), TrackPos(30, 0) }, 1000);
+  test::addObstacle(TrackPos(10, 0), 1220, cmw);
+
+  auto lane = cmw->getLane(cmw->getMap()->laneletLayer.get(1200), LANE_AHEAD);
+  ASSERT_EQ(4u, lane.size());
+
+  auto objects = cmw->getObjectsInLaneInterval(lane, 0.0, 8.0, ros::Time(0), ros::Time(10));
+  ASSERT_EQ(1u, objects.size());
+  ASSERT_EQ(1200, objects[0].lanelet_id);
+
+  ASSERT_TRUE(cmw->getObjectsInLaneInterval(lane, 0.0, 5.0, ros::Time(0), ros::Time(10)).empty());
+  ASSERT_TRUE(cmw->getObjectsInLaneInterval(lane, 50.0, 60.0, ros::Time(0), ros::Time(10)).empty());
+
+  // Lane downtracks past the first lanelet are queried relative to the lanelet which contains them
+  ASSERT_EQ(1u, cmw->getObjectsInLaneInterval(lane, 30.0, 31.0, ros::Time(1.5), ros::Time(3)).size());
+  ASSERT_TRUE(cmw->getObjectsInLaneInterval(lane, 30.0, 31.0, ros::Time(0), ros::Time(0.5)).empty());
+  ASSERT_TRUE(cmw->getObjectsInLaneInterval(lane, 30.0, 31.0, ros::Time(2.5), ros::Time(3)).empty());
+
+  auto right_lane = cmw->getLane(cmw->getMap()->laneletLayer.get(1220), LANE_AHEAD);
+  objects = cmw->getObjectsInLaneInterval(right_lane, 0.0, 100.0, ros::Time(0), ros::Time(10));
+  ASSERT_EQ(1u, objects.size());
+  ASSERT_EQ(1220, objects[0].lanelet_id);
+
+  ASSERT_TRUE(cmw->getObjectsInLaneInterval({}, 0.0, 100.0, ros::Time(0), ros::Time(10)).empty());
+}
+
+TEST(ObstacleOccupancyIndex, getObjectsInLaneIntervalStraddlingLanelets)
+{
+  auto cmw = test::getGuidanceTestMap(
+      test::MapOptions(3.7, 25, test::MapOptions::Obstacle::NONE, test::MapOptions::SpeedLimit::DEFAULT));
+
+  // Each 3m by 3m obstacle is stored under its own lanelet but overhangs the boundary between lanelets 1200 and 1201,
+  // which is at 25m along the lane
+  test::addObstacle(TrackPos(24, 0), 1200, cmw);
+  auto lane = cmw->getLane(cmw->getMap()->laneletLayer.get(1200), LANE_AHEAD);
+
+  auto objects = cmw->getObjectsInLaneInterval(lane, 25.5, 26.0, ros::Time(0), ros::Time(10));
+  ASSERT_EQ(1u, objects.size());
+  ASSERT_EQ(1200, objects[0].lanelet_id);
+  ASSERT_TRUE(cmw->getObjectsInLaneInterval(lane, 26.5, 27.0, ros::Time(0), ros::Time(10)).empty());
+
+  cmw->setRoadwayObjects({});
+  test::addObstacle(TrackPos(1, 0), 1201, cmw);
+
+  objects = cmw->getObjectsInLaneInterval(lane, 24.5, 24.8, ros::Time(0), ros::Time(10));
+  ASSERT_EQ(1u, objects.size());
+  ASSERT_EQ(1201, objects[0].lanelet_id);
+  ASSERT_TRUE(cmw->getObjectsInLaneInterval(lane, 23.0, 23.5, ros::Time(0), ros::Time(10)).empty());
+}
+
+}  // namespace carma_wm
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <cmath>
+#include <random>
+#include <carma_wm/Geometry.h>
+#include <carma_wm/Polyline.h>
+
+namespace carma_wm
+{
+namespace
+{
+// A winding line with roughly 1m spacing. When repeat_points is set some points are repeated so the line has zero
+// length segments
+std::vector<lanelet::BasicPoint2d> makeWindingLine(size_t point_count, bool repeat_points, std::mt19937& rng)
+{
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::vector<lanelet::BasicPoint2d> points;
+  double x = 0, y = 0, heading = 0;
+  for (size_t i = 0; i < point_count; i++)
+  {
+    points.emplace_back(x, y);
+    heading += 0.1 * dist(rng);
+    double step = (repeat_points && i % 5 == 0) ? 0.0 : 1.0 + 0.5 * dist(rng);
+    x += step * std::cos(heading);
+    y += step * std::sin(heading);
+  }
+  return points;
+}
+
+// Exact comparison where two NaNs are equal. Zero length segments give NaN curvatures in both implementations
+bool sameValue(double a, double b)
+{
+  return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+}  // namespace
+
+TEST(PolylineTest, assign)
+{
+  geometry::Polyline2d polyline;
+  ASSERT_TRUE(polyline.empty());
+
+  std::vector<lanelet::BasicPoint2d> points = { { 0, 0 }, { 3, 4 }, { 3, 5 } };
+  polyline.assign(points);
+  ASSERT_EQ(3u, polyline.size());
+  ASSERT_EQ(std::vector<double>({ 5.0, 1.0 }), polyline.segmentLengths());
+  ASSERT_EQ(std::vector<double>({ 0.0, 5.0, 6.0 }), polyline.arcLengths());
+  ASSERT_EQ(lanelet::BasicPoint2d(3, 4), polyline.point(1));
+
+  // Assigning fewer points shrinks the polyline
+  lanelet::BasicLineString2d line_string = { { 1, 1 } };
+  polyline.assign(line_string);
+  ASSERT_EQ(1u, polyline.size());
+  ASSERT_TRUE(polyline.segmentLengths().empty());
+  ASSERT_EQ(std::vector<double>({ 0.0 }), polyline.arcLengths());
+}
+
+TEST(PolylineTest, computePolylineMetricsMatchesGeometry)
+{
+  std::mt19937 rng(3);
+  geometry::PolylineMetrics metrics;  // Reused so the buffers are resized both up and down
+  for (size_t trial = 0; trial < 40; trial++)
+  {
+    auto points = makeWindingLine(2 + (trial * 37) % 150, trial % 7 == 0, rng);
+    geometry::Polyline2d polyline(points);
+    geometry::computePolylineMetrics(polyline, metrics);
+
+    auto curvatures = geometry::local_curvatures(points);
+    auto headings = geometry::compute_tangent_orientations(points);
+    auto arc_lengths = geometry::compute_arc_lengths(points);
+    auto tangents = geometry::compute_finite_differences(points);
+
+    ASSERT_EQ(points.size(), metrics.curvatures.size());
+    ASSERT_EQ(arc_lengths, polyline.arcLengths());
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      ASSERT_TRUE(sameValue(curvatures[i], metrics.curvatures[i])) << "trial " << trial << " index " << i;
+      ASSERT_EQ(headings[i], metrics.headings[i]) << "trial " << trial << " index " << i;
+      ASSERT_EQ(tangents[i].x(), metrics.tangent_x[i]);
+      ASSERT_EQ(tangents[i].y(), metrics.tangent_y[i]);
+    }
+  }
+}
+
+TEST(PolylineTest, computePolylineMetricsZeroTangent)
+{
+  // A repeated end point has a zero tangent. The heading is 0 and the unit tangent stays zero
+  geometry::Polyline2d polyline(std::vector<lanelet::BasicPoint2d>({ { 0, 0 }, { 1, 1 }, { 1, 1 } }));
+  geometry::PolylineMetrics metrics;
+  geometry::computePolylineMetrics(polyline, metrics);
+  ASSERT_EQ(0.0, metrics.unit_tangent_x[2]);
+  ASSERT_EQ(0.0, metrics.unit_tangent_y[2]);
+  ASSERT_EQ(0.0, metrics.headings[2]);
+  ASSERT_NEAR(M_PI / 4.0, metrics.headings[0], 0.000001);
+
+  geometry::Polyline2d single_point(std::vector<lanelet::BasicPoint2d>({ { 0, 0 } }));
+  ASSERT_THROW(geometry::computePolylineMetrics(single_point, metrics), std::invalid_argument);
+}
+
+TEST(PolylineTest, matchSegmentMatchesGeometry)
+{
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> dist(-20.0, 20.0);
+  for (size_t trial = 0; trial < 40; trial++)
+  {
+    auto points = makeWindingLine(2 + (trial * 53) % 300, trial % 7 == 0, rng);
+    geometry::Polyline2d polyline(points);
+    lanelet::BasicLineString2d line_string(points.begin(), points.end());
+    const lanelet::BasicPoint2d& end = points.back();
+
+    for (size_t k = 0; k < 25; k++)
+    {
+      // Points before, along and beyond the line
+      double along = (static_cast<double>(k) / 20.0) - 0.1;
+      lanelet::BasicPoint2d p(along * end.x() + dist(rng), along * end.y() + dist(rng));
+
+      auto expected = geometry::matchSegment(p, line_string);
+      auto result = geometry::matchSegment(p, polyline);
+      size_t index = std::get<1>(result);
+
+      ASSERT_EQ(std::get<0>(expected), std::get<0>(result)) << "trial " << trial << " point " << k;
+      ASSERT_EQ(std::get<1>(expected).first, polyline.point(index));
+      ASSERT_EQ(std::get<1>(expected).second, polyline.point(index + 1));
+      ASSERT_EQ(std::get<0>(expected), geometry::trackPos(polyline, p));
+    }
+  }
+}
+
+TEST(PolylineTest, nearestPointIndex)
+{
+  // More points than a single search block, with the nearest point in the second block
+  std::vector<lanelet::BasicPoint2d> points;
+  for (size_t i = 0; i < 200; i++)
+  {
+    points.emplace_back(static_cast<double>(i), 0.0);
+  }
+  geometry::Polyline2d polyline(points);
+  ASSERT_EQ(150u, geometry::nearestPointIndex(polyline, { 150.2, 3.0 }));
+  ASSERT_EQ(0u, geometry::nearestPointIndex(polyline, { -10.0, 0.0 }));
+  ASSERT_EQ(199u, geometry::nearestPointIndex(polyline, { 500.0, 0.0 }));
+
+  // Equally near points give the first of them
+  ASSERT_EQ(70u, geometry::nearestPointIndex(polyline, { 70.5, 1.0 }));
+
+  ASSERT_THROW(geometry::nearestPointIndex(geometry::Polyline2d(), { 0, 0 }), std::invalid_argument);
+  geometry::Polyline2d single_point(std::vector<lanelet::BasicPoint2d>({ { 0, 0 } }));
+  ASSERT_THROW(geometry::matchSegment({ 0, 0 }, single_point), std::invalid_argument);
+}
+
+}  // namespace carma_wm
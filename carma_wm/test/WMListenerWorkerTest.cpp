@@ -329,4 +329,187 @@ TEST(WMListenerWorkerTest, checkIfReRoutingNeeded2)
   ASSERT_EQ(true, wmlw.checkIfReRoutingNeeded());
 }
 
+TEST(WMListenerWorkerTest, snapshotsNotEnabled)
+{
+  WMListenerWorker wmlw;
+  EXPECT_THROW(wmlw.getSnapshot(), std::invalid_argument);
+
+  wmlw.enableSnapshots();
+  ASSERT_TRUE((bool)wmlw.getSnapshot());
+  ASSERT_FALSE((bool)wmlw.getSnapshot()->getMap());
+}
+
+TEST(WMListenerWorkerTest, snapshotUnchangedByMapUpdate)
+{
+  using namespace lanelet::units::literals;
+  auto p1 = getPoint(0, 0, 0);
+  auto p2 = getPoint(0, 1, 0);
+  auto p3 = getPoint(1, 1, 0);
+  auto p4 = getPoint(1, 0, 0);
+  lanelet::LineString3d left_ls_1(lanelet::utils::getId(), { p1, p2 });
+  lanelet::LineString3d right_ls_1(lanelet::utils::getId(), { p4, p3 });
+
+  auto ll_1 = getLanelet(left_ls_1, right_ls_1, lanelet::AttributeValueString::SolidSolid,
+                         lanelet::AttributeValueString::Dashed);
+  auto ll_2 = getLanelet(left_ls_1, right_ls_1, lanelet::AttributeValueString::SolidSolid,
+                         lanelet::AttributeValueString::Dashed);
+
+  lanelet::DigitalSpeedLimitPtr speed_limit_old = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(9000, 5_mph, {ll_1}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+  lanelet::DigitalSpeedLimitPtr speed_limit_new = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(9001, 5_mph, {ll_1}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+
+  auto gf_ptr = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  gf_ptr->id_ = boost::uuids::random_generator()();
+  gf_ptr->remove_list_.push_back(std::make_pair(ll_1.id(), speed_limit_old));
+  gf_ptr->update_list_.push_back(std::make_pair(ll_1.id(), speed_limit_new));
+
+  autoware_lanelet2_msgs::MapBin gf_obj_msg;
+  auto received_data = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(gf_ptr->id_, gf_ptr->update_list_, gf_ptr->remove_list_, {ll_2}));
+  carma_wm::toBinMsg(received_data, &gf_obj_msg);
+
+  WMListenerWorker wmlw;
+  wmlw.enableSnapshots();
+
+  ll_1.addRegulatoryElement(speed_limit_old);
+  lanelet::LaneletMapPtr map = lanelet::utils::createMap({ ll_1 }, { });
+  autoware_lanelet2_msgs::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(map, &map_msg);
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(map_msg));
+  wmlw.mapCallback(map_msg_ptr);
+
+  auto snapshot = wmlw.getSnapshot();
+  ASSERT_TRUE((bool)snapshot->getMap());
+  ASSERT_EQ(snapshot->getMap(), wmlw.getWorldModel()->getMap()); // The map is shared until it is updated
+
+  wmlw.mapUpdateCallback(boost::make_shared<autoware_lanelet2_msgs::MapBin>(gf_obj_msg));
+
+  // The held snapshot still has the map it was published with
+  auto regems = snapshot->getMap()->laneletLayer.get(ll_1.id()).regulatoryElements();
+  ASSERT_EQ(regems.size(), 1);
+  ASSERT_EQ(regems[0]->id(), speed_limit_old->id());
+  ASSERT_EQ(snapshot->getMap()->laneletLayer.size(), 1);
+
+  // The new snapshot and the live world model have the update applied to a copy of the map
+  auto updated = wmlw.getSnapshot();
+  ASSERT_NE(updated->getMap(), snapshot->getMap());
+  ASSERT_EQ(updated->getMap(), wmlw.getWorldModel()->getMap());
+  regems = updated->getMap()->laneletLayer.get(ll_1.id()).regulatoryElements();
+  ASSERT_EQ(regems.size(), 1);
+  ASSERT_EQ(regems[0]->id(), speed_limit_new->id());
+  ASSERT_EQ(updated->getMap()->laneletLayer.size(), 2);
+  ASSERT_TRUE((bool)updated->getMapRoutingGraph());
+  ASSERT_NE(updated->getMapRoutingGraph(), snapshot->getMapRoutingGraph());
+
+  // Roadway objects only replace that layer of the new snapshot
+  cav_msgs::RoadwayObstacleList obstacles;
+  obstacles.roadway_obstacles.resize(1);
+  wmlw.roadwayObjectListCallback(obstacles);
+
+  ASSERT_TRUE(updated->getRoadwayObjects().empty());
+  ASSERT_EQ(wmlw.getSnapshot()->getRoadwayObjects().size(), 1);
+  ASSERT_EQ(wmlw.getSnapshot()->getMap(), updated->getMap());
+}
+
+TEST(WMListenerWorkerTest, snapshotPublishedOncePerBatch)
+{
+  auto p1 = getPoint(0, 0, 0);
+  auto p2 = getPoint(0, 1, 0);
+  auto p3 = getPoint(1, 1, 0);
+  auto p4 = getPoint(1, 0, 0);
+  lanelet::LineString3d left_ls_1(lanelet::utils::getId(), { p1, p2 });
+  lanelet::LineString3d right_ls_1(lanelet::utils::getId(), { p4, p3 });
+  auto ll_1 = getLanelet(left_ls_1, right_ls_1, lanelet::AttributeValueString::SolidSolid,
+                         lanelet::AttributeValueString::Dashed);
+
+  WMListenerWorker wmlw;
+  wmlw.enableSnapshots();
+
+  lanelet::LaneletMapPtr map = lanelet::utils::createMap({ ll_1 }, { });
+  autoware_lanelet2_msgs::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(map, &map_msg);
+  wmlw.mapCallback(boost::make_shared<autoware_lanelet2_msgs::MapBin>(map_msg));
+
+  auto snapshot = wmlw.getSnapshot();
+  ASSERT_EQ(snapshot->getMap(), wmlw.getWorldModel()->getMap());
+
+  // Callbacks between two reads do not publish, so only the first map update of the batch copies the map
+  cav_msgs::RoadwayObstacleList obstacles;
+  obstacles.roadway_obstacles.resize(1);
+  wmlw.roadwayObjectListCallback(obstacles);
+
+  lanelet::LaneletMapConstPtr copied_map;
+  for (uint32_t seq = 0; seq < 3; seq++)
+  {
+    auto gf_ptr = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+    gf_ptr->id_ = boost::uuids::random_generator()();
+    autoware_lanelet2_msgs::MapBin gf_msg;
+    carma_wm::toBinMsg(gf_ptr, &gf_msg);
+    gf_msg.header.seq = seq;
+    wmlw.mapUpdateCallback(boost::make_shared<autoware_lanelet2_msgs::MapBin>(gf_msg));
+    if (!copied_map)
+    {
+      copied_map = wmlw.getWorldModel()->getMap();
+    }
+
+    wmlw.roadwayObjectListCallback(obstacles);
+  }
+
+  ASSERT_NE(copied_map, snapshot->getMap());
+  ASSERT_EQ(wmlw.getWorldModel()->getMap(), copied_map);
+
+  auto updated = wmlw.getSnapshot();
+  ASSERT_EQ(updated->getMap(), copied_map);
+  ASSERT_EQ(updated->getRoadwayObjects().size(), 1);
+  ASSERT_TRUE(snapshot->getRoadwayObjects().empty());
+
+  // Without further updates the same snapshot is returned
+  ASSERT_EQ(wmlw.getSnapshot(), updated);
+}
+
+TEST(WMListenerWorkerTest, snapshotRouteRebuiltOnMapCopy)
+{
+  CARMAWorldModel cwm;
+  addStraightRoute(cwm);
+
+  auto map_ptr = lanelet::utils::removeConst(cwm.getMap());
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map_ptr, &msg);
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(msg));
+
+  WMListenerWorker wmlw;
+  wmlw.enableSnapshots();
+  wmlw.mapCallback(map_msg_ptr);
+
+  cav_msgs::Route route_msg;
+  route_msg.shortest_path_lanelet_ids.push_back(cwm.getRoute()->shortestPath()[0].id());
+  route_msg.shortest_path_lanelet_ids.push_back(cwm.getRoute()->shortestPath()[1].id());
+  route_msg.end_point.y = 1.5;
+  route_msg.route_name = "snapshot_route";
+  wmlw.routeCallback(cav_msgs::RouteConstPtr(new cav_msgs::Route(route_msg)));
+
+  auto routed = wmlw.getSnapshot();
+  ASSERT_TRUE((bool)routed->getRoute());
+
+  // An update with no changes still moves the live world model onto a copy of the map
+  autoware_lanelet2_msgs::MapBin gf_msg;
+  auto empty_update = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  empty_update->id_ = boost::uuids::random_generator()();
+  carma_wm::toBinMsg(empty_update, &gf_msg);
+  wmlw.mapUpdateCallback(boost::make_shared<autoware_lanelet2_msgs::MapBin>(gf_msg));
+
+  auto updated = wmlw.getSnapshot();
+  ASSERT_NE(updated->getMap(), routed->getMap());
+  ASSERT_TRUE((bool)updated->getRoute());
+  ASSERT_NE(updated->getRoute(), routed->getRoute());
+
+  // The rebuilt route references the lanelets of the copied map and keeps the route end point and name
+  auto first = updated->getRoute()->shortestPath().front();
+  ASSERT_EQ(first.constData(), updated->getMap()->laneletLayer.get(first.id()).constData());
+  ASSERT_NE(first.constData(), routed->getMap()->laneletLayer.get(first.id()).constData());
+  ASSERT_NEAR(updated->getRouteEndTrackPos().downtrack, routed->getRouteEndTrackPos().downtrack, 0.0001);
+  ASSERT_EQ(updated->getRouteName(), "snapshot_route");
+  ASSERT_EQ(updated->getRouteSpeedLimitProfile().size(), routed->getRouteSpeedLimitProfile().size());
+}
+
 }  // namespace carma_wm
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <carma_wm/WMTestLibSyntheticMaps.h>
+
+namespace carma_wm
+{
+TEST(WMTestLibSyntheticMaps, corridor)
+{
+  test::SyntheticMapOptions options;
+  options.road_length = 1000;
+  options.lane_count = 3;
+  options.signal_spacing = 500;
+  options.object_count = 20;
+
+  test::SyntheticWorld world = test::buildSyntheticWorld(options, ros::Time(100));
+  auto wm = world.world_model;
+
+  // 20 lanelets per lane and a signal per lane at 500 m. None at the end of the road
+  ASSERT_EQ(1u, world.lanelet_ids.size());
+  ASSERT_EQ(3u, world.lanelet_ids[0].size());
+  EXPECT_EQ(60u, world.map->laneletLayer.size());
+  EXPECT_EQ(3u, world.signal_count);
+  ASSERT_EQ(1u, world.spat.intersection_state_list.size());
+  EXPECT_EQ(3u, world.spat.intersection_state_list[0].movement_list.size());
+
+  ASSERT_TRUE(!!wm->getRoute());
+  EXPECT_NEAR(1000.0, wm->getRoute()->length2d(), 0.001);
+  EXPECT_NEAR(500.0, wm->routeTrackPos(lanelet::BasicPoint2d(500, -3.7)).downtrack, 0.001);
+
+  // Adjacent lanes share bounds so the routing graph connects them
+  auto left = wm->getMapRoutingGraph()->left(world.map->laneletLayer.get(world.lanelet_ids[0][0][0]));
+  ASSERT_TRUE(!!left);
+  EXPECT_EQ(world.lanelet_ids[0][1][0], left->id());
+
+  EXPECT_EQ(1u, wm->getSignalsAlongRoute(lanelet::BasicPoint2d(100, -3.7)).size());
+  EXPECT_TRUE(wm->getSignalsAlongRoute(lanelet::BasicPoint2d(600, -3.7)).empty());
+
+  // Every object is on the road and has its predictions matched to lanelets
+  EXPECT_EQ(20u, world.objects.size());
+  ASSERT_EQ(20u, wm->getRoadwayObjects().size());
+  EXPECT_EQ(10u, wm->getRoadwayObjects()[0].predicted_lanelet_ids.size());
+
+  // The SPaT message reaches the signals
+  test::updateSyntheticSpat(world.spat, 1.0);
+  wm->processSpatFromMsg(world.spat);
+  auto lights = world.map->laneletLayer.get(world.lanelet_ids[0][0][9]).regulatoryElementsAs<lanelet::CarmaTrafficSignal>();
+  ASSERT_EQ(1u, lights.size());
+  EXPECT_FALSE(lights[0]->recorded_time_stamps.empty());
+}
+
+TEST(WMTestLibSyntheticMaps, grid)
+{
+  test::SyntheticMapOptions options;
+  options.layout = test::SyntheticMapOptions::Layout::GRID;
+  options.road_length = 600;
+  options.grid_road_count = 2;
+  options.lane_count = 2;
+  options.signal_spacing = 200;
+  options.object_count = 0;
+
+  test::SyntheticWorld world = test::buildSyntheticWorld(options);
+
+  // 2 eastbound and 2 northbound roads of 12 lanelets per lane, with signals at 200 and 400 m
+  ASSERT_EQ(4u, world.lanelet_ids.size());
+  EXPECT_EQ(96u, world.map->laneletLayer.size());
+  EXPECT_EQ(16u, world.signal_count);
+  EXPECT_NEAR(600.0, world.world_model->getRoute()->length2d(), 0.001);
+
+  // The first northbound road crosses the route at x = 200
+  auto crossing = world.map->laneletLayer.get(world.lanelet_ids[2][0][0]);
+  EXPECT_NEAR(200.0 + 1.85, crossing.centerline2d().front().x(), 0.001);
+}
+}  // namespace carma_wm
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark of the polyline kernels against the geometry functions they replace. Each trajectory has its arc lengths,
+ * headings and curvatures computed and a set of points matched to it, once through the Polyline2d kernels and once
+ * through compute_arc_lengths, compute_tangent_orientations, local_curvatures and the linestring matchSegment.
+ *
+ * Run with: rosrun carma_wm carma_wm-polyline-benchmark [point_count] [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <carma_wm/Geometry.h>
+#include <carma_wm/Polyline.h>
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+// Number of points matched to the trajectory per iteration, as when a trajectory is checked against object predictions
+constexpr int MATCH_POINT_COUNT = 50;
+
+// A trajectory with 0.5 m spacing curving away from the origin
+std::vector<lanelet::BasicPoint2d> makeTrajectory(int point_count)
+{
+  std::vector<lanelet::BasicPoint2d> points;
+  points.reserve(point_count);
+  for (int i = 0; i < point_count; i++)
+  {
+    double s = 0.5 * i;
+    points.emplace_back(s, 40.0 * std::sin(s / 150.0));
+  }
+  return points;
+}
+
+struct LatencyStats
+{
+  std::vector<double> samples_us;
+
+  void print(const std::string& name)
+  {
+    std::sort(samples_us.begin(), samples_us.end());
+    double total = 0;
+    for (double s : samples_us)
+    {
+      total += s;
+    }
+    std::cout << name << ": mean " << total / samples_us.size() << " us, p99 "
+              << samples_us[samples_us.size() * 99 / 100] << " us, max " << samples_us.back() << " us" << std::endl;
+  }
+};
+
+double elapsedUs(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int point_count = argc > 1 ? std::max(2, std::stoi(argv[1])) : 1000;
+  const int iterations = argc > 2 ? std::stoi(argv[2]) : 200;
+
+  std::vector<lanelet::BasicPoint2d> points = makeTrajectory(point_count);
+  lanelet::BasicLineString2d line_string(points.begin(), points.end());
+
+  // Points spread along the trajectory and offset to either side of it
+  std::vector<lanelet::BasicPoint2d> match_points;
+  for (int i = 0; i < MATCH_POINT_COUNT; i++)
+  {
+    const lanelet::BasicPoint2d& p = points[(static_cast<size_t>(i) * (point_count - 1)) / (MATCH_POINT_COUNT - 1)];
+    match_points.emplace_back(p.x() + 0.3, p.y() + (i % 2 == 0 ? 1.5 : -1.5));
+  }
+
+  carma_wm::geometry::Polyline2d polyline;
+  carma_wm::geometry::PolylineMetrics metrics;
+
+  LatencyStats legacy_metrics, kernel_metrics, legacy_match, kernel_match;
+  double max_curvature_difference = 0;
+  double max_downtrack_difference = 0;
+  for (int it = 0; it < iterations; it++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    auto arc_lengths = carma_wm::geometry::compute_arc_lengths(points);
+    auto headings = carma_wm::geometry::compute_tangent_orientations(points);
+    auto curvatures = carma_wm::geometry::local_curvatures(points);
+    legacy_metrics.samples_us.push_back(elapsedUs(start));
+
+    start = std::chrono::steady_clock::now();
+    polyline.assign(points);
+    carma_wm::geometry::computePolylineMetrics(polyline, metrics);
+    kernel_metrics.samples_us.push_back(elapsedUs(start));
+
+    double legacy_downtrack = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& p : match_points)
+    {
+      legacy_downtrack += std::get<0>(carma_wm::geometry::matchSegment(p, line_string)).downtrack;
+    }
+    legacy_match.samples_us.push_back(elapsedUs(start));
+
+    double kernel_downtrack = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& p : match_points)
+    {
+      kernel_downtrack += std::get<0>(carma_wm::geometry::matchSegment(p, polyline)).downtrack;
+    }
+    kernel_match.samples_us.push_back(elapsedUs(start));
+
+    // Largest difference between the two paths, to confirm they agree
+    for (int i = 0; i < point_count; i++)
+    {
+      max_curvature_difference = std::max(max_curvature_difference, std::fabs(curvatures[i] - metrics.curvatures[i]));
+    }
+    max_downtrack_difference = std::max(max_downtrack_difference, std::fabs(legacy_downtrack - kernel_downtrack));
+
+    g_sink += arc_lengths.back() + headings.back() + polyline.arcLengths().back() + metrics.headings.back() +
+              legacy_downtrack + kernel_downtrack;
+  }
+
+  std::cout << iterations << " trajectories of " << point_count << " points, " << MATCH_POINT_COUNT
+            << " matched points each" << std::endl;
+  legacy_metrics.print("arc length, heading, curvature geometry ");
+  kernel_metrics.print("arc length, heading, curvature polyline ");
+  legacy_match.print("matchSegment linestring                 ");
+  kernel_match.print("matchSegment polyline                   ");
+  std::cout << "max difference curvature: " << max_curvature_difference
+            << ", summed downtrack: " << max_downtrack_difference << " m" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark of the world model queries used on every planning cycle, on synthetic maps of realistic size built by
+ * WMTestLibSyntheticMaps.h: a 10 km three lane corridor and a 4 km by 4 km grid of two lane roads, both with signals
+ * every 500 m and a population of predicted objects.
+ *
+ * Results are printed and, if a path is given, written as CSV with one row per map and query. If a baseline CSV from an
+ * earlier run is given, the benchmark exits with status 1 when the mean latency of any query exceeds its baseline by
+ * more than the tolerance fraction, so regressions can be caught offline.
+ *
+ * Run with: rosrun carma_wm carma_wm-world-model-benchmark [iterations] [results_csv] [baseline_csv] [tolerance]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ros/console.h>
+#include <carma_wm/WMTestLibSyntheticMaps.h>
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+struct LatencyStats
+{
+  std::vector<double> samples_us;
+
+  double mean() const
+  {
+    double total = 0;
+    for (double s : samples_us)
+    {
+      total += s;
+    }
+    return samples_us.empty() ? 0.0 : total / samples_us.size();
+  }
+
+  // Samples must be sorted
+  double percentile(double fraction) const
+  {
+    return samples_us.empty() ? 0.0 : samples_us[static_cast<size_t>(fraction * (samples_us.size() - 1))];
+  }
+};
+
+struct BenchmarkResult
+{
+  std::string map;
+  std::string query;
+  LatencyStats stats;
+};
+
+double elapsedUs(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Times iterations calls of query, each given its iteration index. prepare is called untimed before each call
+BenchmarkResult run(const std::string& map, const std::string& query, int iterations,
+                    const std::function<double(int)>& call, const std::function<void(int)>& prepare = nullptr)
+{
+  BenchmarkResult result{ map, query, {} };
+  result.stats.samples_us.reserve(iterations);
+  for (int i = 0; i < iterations; i++)
+  {
+    if (prepare)
+    {
+      prepare(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    g_sink += call(i);
+    result.stats.samples_us.push_back(elapsedUs(start));
+  }
+  std::sort(result.stats.samples_us.begin(), result.stats.samples_us.end());
+
+  std::cout << "  " << query << ": mean " << result.stats.mean() << " us, p50 " << result.stats.percentile(0.5)
+            << " us, p99 " << result.stats.percentile(0.99) << " us, max " << result.stats.samples_us.back() << " us"
+            << std::endl;
+  return result;
+}
+
+std::vector<BenchmarkResult> benchmarkMap(const std::string& name, const carma_wm::test::SyntheticMapOptions& options,
+                                          int iterations)
+{
+  const ros::Time stamp(1000);
+  auto build_start = std::chrono::steady_clock::now();
+  carma_wm::test::SyntheticWorld world = carma_wm::test::buildSyntheticWorld(options, stamp);
+  auto wm = world.world_model;
+  const double route_length = wm->getRoute()->length2d();
+
+  std::cout << name << ": " << world.map->laneletLayer.size() << " lanelets, " << world.signal_count << " signals, "
+            << wm->getRoadwayObjects().size() << " of " << world.objects.size() << " objects on the map, route of "
+            << route_length << " m. Built in " << elapsedUs(build_start) / 1e6 << " s" << std::endl;
+
+  // Query positions spread along the route and across its road
+  std::mt19937 rng(options.seed + 1);
+  std::uniform_real_distribution<double> downtrack_dist(0, std::max(0.0, route_length - 250));
+  std::uniform_real_distribution<double> lateral_dist(-0.5 * options.lane_count * options.lane_width,
+                                                      0.5 * options.lane_count * options.lane_width);
+  const auto route_axis = carma_wm::test::getSyntheticRoadAxes(options).front();
+  const lanelet::BasicPoint2d left(-route_axis.second.y(), route_axis.second.x());
+
+  std::vector<double> downtracks;
+  std::vector<lanelet::BasicPoint2d> points;
+  std::vector<lanelet::ConstLanelet> route_lanelets;
+  std::vector<std::vector<lanelet::ConstLanelet>> lanes;
+  for (int i = 0; i < iterations; i++)
+  {
+    double downtrack = downtrack_dist(rng);
+    downtracks.push_back(downtrack);
+    points.push_back(route_axis.first + route_axis.second * downtrack + left * lateral_dist(rng));
+    route_lanelets.push_back(wm->getLaneletsBetween(downtrack, downtrack, true).front());
+    lanes.push_back(wm->getLane(route_lanelets.back(), carma_wm::LANE_AHEAD));
+  }
+
+  std::vector<BenchmarkResult> results;
+  results.push_back(run(name, "routeTrackPos", iterations,
+                        [&](int i) { return wm->routeTrackPos(points[i]).downtrack; }));
+  results.push_back(run(name, "getLaneletsBetween", iterations, [&](int i) {
+    return static_cast<double>(wm->getLaneletsBetween(downtracks[i], downtracks[i] + 100, true).size());
+  }));
+  results.push_back(run(name, "sampleRoutePoints", iterations, [&](int i) {
+    return static_cast<double>(wm->sampleRoutePoints(downtracks[i], downtracks[i] + 200, 1.0).size());
+  }));
+  results.push_back(run(name, "getInLaneObjects", iterations, [&](int i) {
+    return static_cast<double>(wm->getInLaneObjects(route_lanelets[i], carma_wm::LANE_AHEAD).size());
+  }));
+  results.push_back(run(name, "getObjectsInLaneInterval", iterations, [&](int i) {
+    return static_cast<double>(
+        wm->getObjectsInLaneInterval(lanes[i], 0, 100, stamp, stamp + ros::Duration(options.prediction_count *
+                                                                                      options.prediction_period))
+            .size());
+  }));
+  results.push_back(run(name, "toRoadwayObstacle", iterations, [&](int i) {
+    return static_cast<double>(!!wm->toRoadwayObstacle(world.objects[i % world.objects.size()]));
+  }));
+  results.push_back(run(name, "getSignalsAlongRoute", iterations, [&](int i) {
+    return static_cast<double>(wm->getSignalsAlongRoute(points[i]).size());
+  }));
+  // SPaT messages arrive at 10 Hz and walk the signals through their cycle
+  results.push_back(run(
+      name, "processSpatFromMsg", iterations,
+      [&](int) {
+        wm->processSpatFromMsg(world.spat);
+        return 0.0;
+      },
+      [&](int i) { carma_wm::test::updateSyntheticSpat(world.spat, 0.1 * (i + 1)); }));
+
+  // Map updates are rare and rebuild the routing graph, so are repeated fewer times
+  results.push_back(run(name, "setMap", std::max(1, iterations / 20), [&](int) {
+    wm->setMap(world.map);
+    return 0.0;
+  }));
+
+  // The route must be recomputed on the routing graph built by the last setMap
+  auto route = wm->getMapRoutingGraph()->getRoute(world.map->laneletLayer.get(world.route_ids.front()),
+                                                  world.map->laneletLayer.get(world.route_ids.back()));
+  auto route_ptr = std::make_shared<lanelet::routing::Route>(std::move(*route));
+  results.push_back(run(name, "setRoute", std::max(1, iterations / 20), [&](int) {
+    wm->setRoute(route_ptr);
+    return 0.0;
+  }));
+
+  return results;
+}
+
+void writeResults(const std::string& path, const std::vector<BenchmarkResult>& results)
+{
+  std::ofstream out(path);
+  out << "map,query,samples,mean_us,p50_us,p99_us,max_us\n";
+  for (const auto& r : results)
+  {
+    out << r.map << ',' << r.query << ',' << r.stats.samples_us.size() << ',' << r.stats.mean() << ','
+        << r.stats.percentile(0.5) << ',' << r.stats.percentile(0.99) << ',' << r.stats.samples_us.back() << '\n';
+  }
+}
+
+// Returns the mean latency of each map and query in a results file
+std::map<std::string, double> readBaseline(const std::string& path)
+{
+  std::map<std::string, double> means;
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);  // Header
+  while (std::getline(in, line))
+  {
+    std::stringstream row(line);
+    std::string map, query, samples, mean;
+    if (std::getline(row, map, ',') && std::getline(row, query, ',') && std::getline(row, samples, ',') &&
+        std::getline(row, mean, ','))
+    {
+      means[map + "," + query] = std::stod(mean);
+    }
+  }
+  return means;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int iterations = argc > 1 ? std::max(1, std::stoi(argv[1])) : 200;
+  const std::string results_path = argc > 2 ? argv[2] : "";
+  const std::string baseline_path = argc > 3 ? argv[3] : "";
+  const double tolerance = argc > 4 ? std::stod(argv[4]) : 0.2;
+
+  ros::Time::init();
+  // Per call logging would dominate some of the timings
+  if (ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME, ros::console::levels::Error))
+  {
+    ros::console::notifyLoggerLevelsChanged();
+  }
+
+  carma_wm::test::SyntheticMapOptions corridor;
+  corridor.layout = carma_wm::test::SyntheticMapOptions::Layout::CORRIDOR;
+  corridor.road_length = 10000;
+  corridor.lane_count = 3;
+  corridor.object_count = 300;
+
+  carma_wm::test::SyntheticMapOptions grid;
+  grid.layout = carma_wm::test::SyntheticMapOptions::Layout::GRID;
+  grid.road_length = 4000;
+  grid.grid_road_count = 7;  // Roads cross every 500 m
+  grid.lane_count = 2;
+  grid.object_count = 1000;
+
+  std::vector<BenchmarkResult> results = benchmarkMap("corridor", corridor, iterations);
+  std::vector<BenchmarkResult> grid_results = benchmarkMap("grid", grid, iterations);
+  results.insert(results.end(), grid_results.begin(), grid_results.end());
+
+  if (!results_path.empty())
+  {
+    writeResults(results_path, results);
+    std::cout << "Results written to " << results_path << std::endl;
+  }
+
+  if (baseline_path.empty())
+  {
+    return 0;
+  }
+
+  std::map<std::string, double> baseline = readBaseline(baseline_path);
+  int regressions = 0;
+  for (const auto& r : results)
+  {
+    auto it = baseline.find(r.map + "," + r.query);
+    if (it == baseline.end())
+    {
+      continue;
+    }
+    if (r.stats.mean() > it->second * (1.0 + tolerance))
+    {
+      std::cout << "REGRESSION " << r.map << " " << r.query << ": mean " << r.stats.mean() << " us, baseline "
+                << it->second << " us" << std::endl;
+      regressions++;
+    }
+  }
+  std::cout << regressions << " regressions against " << baseline_path << " with tolerance " << tolerance << std::endl;
+  return regressions == 0 ? 0 : 1;
+}
@@ -14,6 +14,7 @@
  * License for the specific language governing permissions and limitations under
  * the License.
  */
+#include <future>
 #include <lanelet2_core/primitives/Point.h>
 #include "GeofenceSchedule.h"
 #include <lanelet2_core/LaneletMap.h>
@@ -86,6 +87,10 @@ specific type of regulatory element (such as digital speed limit, passing contro
   // original traffic control message for this geofence
   cav_msgs::TrafficControlMessageV01 msg_;
 
+  // points of msg_ in the map frame, projected on a decoding thread when the message was received.
+  // Not valid if the points were not decoded in advance, in which case they are projected when the geofence is applied
+  std::shared_future<lanelet::Points3d> decoded_pts_;
+
   // original MAP message for this geofence
   cav_msgs::MapData map_msg_;
   
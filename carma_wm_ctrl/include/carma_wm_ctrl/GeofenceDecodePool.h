@@ -0,0 +1,76 @@
+#pragma once
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace carma_wm_ctrl
+{
+/**
+ * @brief Fixed set of threads which decode received geofence messages ahead of their application.
+ *
+ * Tasks wait in a bounded queue until a thread is free. Submitting to a full queue waits for space, so every
+ * geofence is decoded in advance while a burst of messages cannot grow the queue without limit.
+ * Tasks return their results through promises they own, so dropping a geofence never waits on its decoding.
+ */
+class GeofenceDecodePool
+{
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param thread_count Number of decoding threads
+   * @param max_queue_size Maximum number of tasks waiting for a thread
+   */
+  GeofenceDecodePool(size_t thread_count, size_t max_queue_size);
+
+  /**
+   * @brief Destructor. Waits for the running tasks to finish and discards the queued ones, which breaks their promises
+   */
+  ~GeofenceDecodePool();
+
+  GeofenceDecodePool(const GeofenceDecodePool&) = delete;
+  GeofenceDecodePool& operator=(const GeofenceDecodePool&) = delete;
+
+  /**
+   * @brief Queues a task to run on a decoding thread, waiting for space if the queue is full
+   *
+   * @param task The task to run
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Returns the number of tasks waiting for a thread
+   */
+  size_t queuedCount() const;
+
+private:
+  void workerLoop();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  size_t max_queue_size_;
+  bool stopping_ = false;
+  mutable std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable space_available_;
+};
+
+}  // namespace carma_wm_ctrl
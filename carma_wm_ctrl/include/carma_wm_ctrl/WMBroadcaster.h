@@ -16,8 +16,11 @@
  * the License.
  */
 
+#include <algorithm>
+#include <memory>
 #include <functional>
 #include <mutex>
+#include <thread>
 #include <lanelet2_core/LaneletMap.h>
 #include <autoware_lanelet2_msgs/MapBin.h>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -32,6 +35,7 @@
 #include <autoware_lanelet2_ros_interface/utility/message_conversion.h>
 #include <lanelet2_extension/projection/local_frame_projector.h>
 #include <carma_wm_ctrl/GeofenceScheduler.h>
+#include <carma_wm_ctrl/GeofenceDecodePool.h>
 #include <lanelet2_core/geometry/BoundingBox.h>
 #include <lanelet2_core/primitives/BoundingBox.h>
 #include <carma_wm/WMListener.h>
@@ -57,6 +61,7 @@
 #include <std_msgs/Int32MultiArray.h>
 #include <cav_msgs/MapData.h>
 #include <carma_wm/SignalizedIntersectionManager.h>
+#include <carma_wm/LaneletGridIndex.h>
 
 
 namespace carma_wm_ctrl
@@ -160,6 +165,13 @@ public:
    * \return lanelet::Points3d in local frame
    */
   lanelet::Points3d getPointsInLocalFrame(const cav_msgs::TrafficControlMessageV01& geofence_msg);
+
+  /*!
+   * \brief Sets the number of threads which project the points of received geofence messages into the map frame
+   *        before the geofences are applied. Messages received while every thread is busy wait in a bounded queue.
+   *        A value of 0 disables decoding in advance.
+   */
+  void setMaxParallelDecodes(size_t max_parallel_decodes);
   
   /*!
    * \brief Gets the affected lanelet or areas based on the points in local frame
@@ -400,6 +412,8 @@ private:
   void addPassingControlLineFromMsg(std::shared_ptr<Geofence> gf_ptr, const cav_msgs::TrafficControlMessageV01& msg_v01, const std::vector<lanelet::Lanelet>& affected_llts) const; 
   void addScheduleFromMsg(std::shared_ptr<Geofence> gf_ptr, const cav_msgs::TrafficControlMessageV01& msg_v01);
   void scheduleGeofence(std::shared_ptr<carma_wm_ctrl::Geofence> gf_ptr_list);
+  void decodeGeofenceAsync(std::shared_ptr<Geofence> gf_ptr);
+  static lanelet::Points3d projectPointsToMapFrame(const cav_msgs::TrafficControlMessageV01& geofence_msg, const std::string& map_georef);
   lanelet::LineString3d createLinearInterpolatingLinestring(const lanelet::Point3d& front_pt, const lanelet::Point3d& back_pt, double increment_distance = 0.25);
   lanelet::Lanelet  createLinearInterpolatingLanelet(const lanelet::Point3d& left_front_pt, const lanelet::Point3d& right_front_pt, 
                                                       const lanelet::Point3d& left_back_pt, const lanelet::Point3d& right_back_pt, double increment_distance = 0.25);
@@ -408,6 +422,14 @@ private:
   lanelet::LaneletMapPtr base_map_;
   lanelet::LaneletMapPtr current_map_;
   lanelet::routing::RoutingGraphPtr current_routing_graph_; // Current map routing graph
+  /* Grid index of the lanelets in current_map_. Rebuilt whenever current_map_version_ changes and extended when
+   * geofences add lanelets. Used to associate geofence points with lanelets and for the bounds of route lanelets
+   */
+  carma_wm::LaneletGridIndex lanelet_index_;
+  // Threads projecting received geofence messages into the map frame. Created on the first decode
+  std::unique_ptr<GeofenceDecodePool> decode_pool_;
+  size_t max_parallel_decodes_ = std::max(1u, std::thread::hardware_concurrency());
+  size_t max_queued_decodes_ = 256; // Messages waiting for a decoding thread before the geofence callback waits for space
   lanelet::Velocity config_limit;
   std::string participant_ = lanelet::Participants::VehicleCar;//Default participant type
   std::unordered_set<std::string>  checked_geofence_ids_;
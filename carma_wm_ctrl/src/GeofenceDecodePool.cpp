@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include <algorithm>
+#include <carma_wm_ctrl/GeofenceDecodePool.h>
+
+namespace carma_wm_ctrl
+{
+GeofenceDecodePool::GeofenceDecodePool(size_t thread_count, size_t max_queue_size)
+  : max_queue_size_(std::max<size_t>(1, max_queue_size))
+{
+  workers_.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; i++)
+  {
+    workers_.emplace_back(&GeofenceDecodePool::workerLoop, this);
+  }
+}
+
+GeofenceDecodePool::~GeofenceDecodePool()
+{
+  std::deque<std::function<void()>> discarded;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    discarded.swap(tasks_);
+  }
+  task_available_.notify_all();
+  space_available_.notify_all();
+  for (auto& worker : workers_)
+  {
+    worker.join();
+  }
+  // The discarded tasks are destroyed here, outside the lock, breaking the promises they own
+}
+
+void GeofenceDecodePool::submit(std::function<void()> task)
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_available_.wait(lock, [this] { return stopping_ || tasks_.size() < max_queue_size_; });
+    if (stopping_)
+    {
+      return;
+    }
+    tasks_.push_back(std::move(task));
+  }
+  task_available_.notify_one();
+}
+
+size_t GeofenceDecodePool::queuedCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tasks_.size();
+}
+
+void GeofenceDecodePool::workerLoop()
+{
+  while (true)
+  {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (stopping_)
+      {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    space_available_.notify_one();
+
+    task();
+  }
+}
+
+}  // namespace carma_wm_ctrl
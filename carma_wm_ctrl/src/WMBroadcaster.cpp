@@ -80,6 +80,8 @@ void WMBroadcaster::baseMapCallback(const autoware_lanelet2_msgs::MapBinConstPtr
   lanelet::MapConformer::ensureCompliance(base_map_, config_limit);     // Update map to ensure it complies with expectations
   lanelet::MapConformer::ensureCompliance(current_map_, config_limit);
 
+  lanelet_index_.build(current_map_);
+
   ROS_INFO_STREAM("Building routing graph for base map");
 
   lanelet::traffic_rules::TrafficRulesUPtr traffic_rules_car = lanelet::traffic_rules::TrafficRulesFactory::create(
@@ -245,7 +247,24 @@ void WMBroadcaster::geofenceFromMsg(std::shared_ptr<Geofence> gf_ptr, const cav_
   // Get ID
   std::copy(msg_v01.id.id.begin(), msg_v01.id.id.end(), gf_ptr->id_.begin());
   
-  gf_ptr->gf_pts = getPointsInLocalFrame(msg_v01);
+  // The points were usually projected on a decoding thread when the message was received. Map state is still required here
+  bool decoded = false;
+  if (gf_ptr->decoded_pts_.valid() && current_map_ && current_map_->laneletLayer.size() != 0)
+  {
+    try
+    {
+      gf_ptr->gf_pts = gf_ptr->decoded_pts_.get();
+      decoded = true;
+    }
+    catch (const std::future_error&)
+    {
+      // The decoding was discarded when the decoding threads were reconfigured
+    }
+  }
+  if (!decoded)
+  {
+    gf_ptr->gf_pts = getPointsInLocalFrame(msg_v01);
+  }
 
   gf_ptr->affected_parts_ = getAffectedLaneletOrAreas(gf_ptr->gf_pts);
 
@@ -1080,10 +1099,45 @@ void WMBroadcaster::geofenceCallback(const cav_msgs::TrafficControlMessage& geof
 
   // process schedule from message
   addScheduleFromMsg(gf_ptr, geofence_msg.tcmV01);
+
+  // Project the points while the geofence waits to be scheduled. This only depends on the message and georeference
+  // so many messages can be decoded in parallel, leaving only the map changes to be done when the geofence is applied
+  decodeGeofenceAsync(gf_ptr);
   
   scheduleGeofence(gf_ptr);
 };
 
+void WMBroadcaster::decodeGeofenceAsync(std::shared_ptr<Geofence> gf_ptr)
+{
+  if (base_map_georef_.empty() || max_parallel_decodes_ == 0)
+  {
+    return; // The points will be projected when the geofence is applied
+  }
+
+  if (!decode_pool_)
+  {
+    decode_pool_.reset(new GeofenceDecodePool(max_parallel_decodes_, max_queued_decodes_));
+  }
+
+  // The task owns the promise so a geofence dropped before it is applied does not wait for its decoding
+  auto decoded_pts = std::make_shared<std::promise<lanelet::Points3d>>();
+  gf_ptr->decoded_pts_ = decoded_pts->get_future().share();
+
+  std::string map_georef = base_map_georef_;
+  cav_msgs::TrafficControlMessageV01 msg_v01 = gf_ptr->msg_;
+
+  decode_pool_->submit([decoded_pts, map_georef, msg_v01]() {
+    try
+    {
+      decoded_pts->set_value(projectPointsToMapFrame(msg_v01, map_georef));
+    }
+    catch (...)
+    {
+      decoded_pts->set_exception(std::current_exception()); // Rethrown when the geofence is applied
+    }
+  });
+}
+
 void WMBroadcaster::scheduleGeofence(std::shared_ptr<carma_wm_ctrl::Geofence> gf_ptr)
 {
   ROS_INFO_STREAM("Scheduling new geofence message received by WMBroadcaster with id: " << gf_ptr->id_);
@@ -1119,6 +1173,7 @@ void WMBroadcaster::scheduleGeofence(std::shared_ptr<carma_wm_ctrl::Geofence> gf
     duplicate_msg.geometry.nodes[0].y = first_y;
     
     gf_ptr_speed->msg_ = duplicate_msg;
+    decodeGeofenceAsync(gf_ptr_speed);
     scheduler_.addGeofence(gf_ptr_speed);
   }
   if (detected_workzone_signal && msg_detail.choice != cav_msgs::TrafficControlDetail::MAXSPEED_CHOICE) // if workzone message detected, save to cache to process later
@@ -1152,6 +1207,12 @@ void WMBroadcaster::geoReferenceCallback(const std_msgs::String& geo_ref)
   base_map_georef_ = geo_ref.data;
 }
 
+void WMBroadcaster::setMaxParallelDecodes(size_t max_parallel_decodes)
+{
+  max_parallel_decodes_ = max_parallel_decodes;
+  decode_pool_.reset(); // Recreated with the new thread count by the next decode
+}
+
 void WMBroadcaster::setMaxLaneWidth(double max_lane_width)
 {
   max_lane_width_ = max_lane_width;
@@ -1197,6 +1258,11 @@ lanelet::Points3d WMBroadcaster::getPointsInLocalFrame(const cav_msgs::TrafficCo
     throw lanelet::InvalidObjectStateError(std::string("Base lanelet map has empty proj string loaded as georeference. Therefore, WMBroadcaster failed to\n ") +
                                           std::string("get transformation between the geofence and the map"));
 
+  return projectPointsToMapFrame(tcmV01, base_map_georef_);
+}
+
+lanelet::Points3d WMBroadcaster::projectPointsToMapFrame(const cav_msgs::TrafficControlMessageV01& tcmV01, const std::string& map_georef)
+{
   // This next section handles the geofence projection conversion
   // The datum field is used to identify the frame for the provided referance lat/lon. 
   // This reference is then converted to the provided projection as a reference origin point
@@ -1216,22 +1282,27 @@ lanelet::Points3d WMBroadcaster::getPointsInLocalFrame(const cav_msgs::TrafficCo
 
   ROS_DEBUG_STREAM("Traffic Control heading provided: " << tcmV01.geometry.heading << " System understanding is that this value will not affect the projection and is only provided for supporting derivative calculations.");
   
+  // Messages may be projected concurrently on decoding threads. A proj context is not thread safe so each call uses its own
+  std::unique_ptr<PJ_CONTEXT, decltype(&proj_context_destroy)> ctx(proj_context_create(), &proj_context_destroy);
+
   // Create the resulting projection transformation
-  PJ* universal_to_target = proj_create_crs_to_crs(PJ_DEFAULT_CTX, universal_frame.c_str(), projection.c_str(), nullptr);
+  std::unique_ptr<PJ, decltype(&proj_destroy)> universal_to_target(
+    proj_create_crs_to_crs(ctx.get(), universal_frame.c_str(), projection.c_str(), nullptr), &proj_destroy);
   if (universal_to_target == nullptr) { // proj_create_crs_to_crs returns 0 when there is an error in the projection
     
-    ROS_ERROR_STREAM("Failed to generate projection between geofence and map with error number: " <<  proj_context_errno(PJ_DEFAULT_CTX) 
+    ROS_ERROR_STREAM("Failed to generate projection between geofence and map with error number: " <<  proj_context_errno(ctx.get()) 
       << " universal_frame: " << universal_frame << " projection: " << projection);
 
     return {}; // Ignore geofence if it could not be projected from universal to TCM frame
   }
   
-  PJ* target_to_map = proj_create_crs_to_crs(PJ_DEFAULT_CTX, projection.c_str(), base_map_georef_.c_str(), nullptr);
+  std::unique_ptr<PJ, decltype(&proj_destroy)> target_to_map(
+    proj_create_crs_to_crs(ctx.get(), projection.c_str(), map_georef.c_str(), nullptr), &proj_destroy);
 
   if (target_to_map == nullptr) { // proj_create_crs_to_crs returns 0 when there is an error in the projection
     
-    ROS_ERROR_STREAM("Failed to generate projection between geofence and map with error number: " <<  proj_context_errno(PJ_DEFAULT_CTX) 
-      << " target_to_map: " << target_to_map << " base_map_georef_: " << base_map_georef_);
+    ROS_ERROR_STREAM("Failed to generate projection between geofence and map with error number: " <<  proj_context_errno(ctx.get()) 
+      << " map_georef: " << map_georef);
 
     return {}; // Ignore geofence if it could not be projected into the map frame
   
@@ -1241,7 +1312,7 @@ lanelet::Points3d WMBroadcaster::getPointsInLocalFrame(const cav_msgs::TrafficCo
   std::vector<lanelet::Point3d> gf_pts;
   cav_msgs::PathNode prev_pt;
   PJ_COORD c_init_latlong{{tcmV01.geometry.reflat, tcmV01.geometry.reflon, tcmV01.geometry.refelv}};
-  PJ_COORD c_init = proj_trans(universal_to_target, PJ_FWD, c_init_latlong);
+  PJ_COORD c_init = proj_trans(universal_to_target.get(), PJ_FWD, c_init_latlong);
 
   prev_pt.x = c_init.xyz.x;
   prev_pt.y =  c_init.xyz.y;
@@ -1253,9 +1324,9 @@ lanelet::Points3d WMBroadcaster::getPointsInLocalFrame(const cav_msgs::TrafficCo
 
     PJ_COORD c {{prev_pt.x + pt.x, prev_pt.y + pt.y, 0, 0}}; // z is not currently used
     PJ_COORD c_out;
-    c_out = proj_trans(target_to_map, PJ_FWD, c);
+    c_out = proj_trans(target_to_map.get(), PJ_FWD, c);
 
-    gf_pts.push_back(lanelet::Point3d{current_map_->pointLayer.uniqueId(), c_out.xyz.x, c_out.xyz.y});
+    gf_pts.push_back(lanelet::Point3d{lanelet::utils::getId(), c_out.xyz.x, c_out.xyz.y});
     prev_pt.x += pt.x;
     prev_pt.y += pt.y;
 
@@ -1268,7 +1339,7 @@ lanelet::Points3d WMBroadcaster::getPointsInLocalFrame(const cav_msgs::TrafficCo
 
 lanelet::ConstLaneletOrAreas WMBroadcaster::getAffectedLaneletOrAreas(const lanelet::Points3d& gf_pts)
 {
-  return carma_wm::query::getAffectedLaneletOrAreas(gf_pts, current_map_, current_routing_graph_, max_lane_width_);
+  return carma_wm::query::getAffectedLaneletOrAreas(gf_pts, current_map_, current_routing_graph_, lanelet_index_);
 }
 
 /*!
@@ -1308,9 +1379,9 @@ void WMBroadcaster::addRegulatoryComponent(std::shared_ptr<Geofence> gf_ptr) con
 
   // First loop is to save the relation between element and regulatory element
   // so that we can add back the old one after geofence deactivates
-  for (auto el: gf_ptr->affected_parts_)
+  for (const auto& el: gf_ptr->affected_parts_)
   {
-    for (auto regem : el.regulatoryElements())
+    for (const auto& regem : el.regulatoryElements())
     {
       if (!shouldChangeControlLine(el, regem, gf_ptr)) continue;
 
@@ -1347,9 +1418,9 @@ void WMBroadcaster::addBackRegulatoryComponent(std::shared_ptr<Geofence> gf_ptr)
 {
   // First loop is to remove the relation between element and regulatory element that this geofence added initially
   
-  for (auto el: gf_ptr->affected_parts_)
+  for (const auto& el: gf_ptr->affected_parts_)
   {
-    for (auto regem : el.regulatoryElements())
+    for (const auto& regem : el.regulatoryElements())
     {
       if (!shouldChangeControlLine(el, regem, gf_ptr)) continue;
 
@@ -1514,40 +1585,21 @@ cav_msgs::TrafficControlRequest WMBroadcaster::controlRequestFromRoute(const cav
   if(path.size() == 0) throw lanelet::InvalidObjectStateError(std::string("No lanelets available in path."));
 
    /*logic to determine route bounds*/
-  std::vector<lanelet::ConstLanelet> llt; 
-  std::vector<lanelet::BoundingBox2d> pathBox; 
   double minX = std::numeric_limits<double>::max();
   double minY = std::numeric_limits<double>::max();
   double maxX = std::numeric_limits<double>::lowest();
   double maxY = std::numeric_limits<double>::lowest();
 
-  while (path.size() != 0) //Continue until there are no more lanelet elements in path
+  for (const auto& llt : path)
   {
-      llt.push_back(path.back()); //Add a lanelet to the vector
-    
-
-      pathBox.push_back(lanelet::geometry::boundingBox2d(llt.back())); //Create a bounding box of the added lanelet and add it to the vector
+    // Cached by the lanelet index when the lanelet is indexed and computed otherwise
+    lanelet::BoundingBox2d box = lanelet_index_.boundingBox(llt);
 
-
-      if (pathBox.back().corner(lanelet::BoundingBox2d::BottomLeft).x() < minX)
-        minX = pathBox.back().corner(lanelet::BoundingBox2d::BottomLeft).x(); //minimum x-value
-
-
-      if (pathBox.back().corner(lanelet::BoundingBox2d::BottomLeft).y() < minY)
-        minY = pathBox.back().corner(lanelet::BoundingBox2d::BottomLeft).y(); //minimum y-value
-
-
-
-     if (pathBox.back().corner(lanelet::BoundingBox2d::TopRight).x() > maxX)
-        maxX = pathBox.back().corner(lanelet::BoundingBox2d::TopRight).x(); //maximum x-value
-
-
-     if (pathBox.back().corner(lanelet::BoundingBox2d::TopRight).y() > maxY)
-        maxY = pathBox.back().corner(lanelet::BoundingBox2d::TopRight).y(); //maximum y-value
-
-
-      path.pop_back(); //remove the added lanelet from path an reduce pack.size() by 1
-  } //end of while loop
+    minX = std::min(minX, box.corner(lanelet::BoundingBox2d::BottomLeft).x()); //minimum x-value
+    minY = std::min(minY, box.corner(lanelet::BoundingBox2d::BottomLeft).y()); //minimum y-value
+    maxX = std::max(maxX, box.corner(lanelet::BoundingBox2d::TopRight).x()); //maximum x-value
+    maxY = std::max(maxY, box.corner(lanelet::BoundingBox2d::TopRight).y()); //maximum y-value
+  }
   
 
   std::string target_frame = base_map_georef_;
@@ -1772,6 +1824,7 @@ void WMBroadcaster::addGeofenceHelper(std::shared_ptr<Geofence> gf_ptr)
   for (auto llt : gf_ptr->lanelet_additions_)
   {
     current_map_->add(llt);
+    lanelet_index_.insert(llt);
   }
 
   // add trafficlight id mapping
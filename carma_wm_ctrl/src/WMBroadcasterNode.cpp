@@ -87,6 +87,12 @@ int WMBroadcasterNode::run()
   pnh_.getParam("max_lane_width", lane_max_width);
   wmb_.setMaxLaneWidth(lane_max_width);
 
+  int max_parallel_decodes;
+  if (pnh_.getParam("max_parallel_geofence_decodes", max_parallel_decodes))
+  {
+    wmb_.setMaxParallelDecodes(std::max(0, max_parallel_decodes));
+  }
+
   pnh2_.getParam("/config_speed_limit", config_limit);
   wmb_.setConfigSpeedLimit(config_limit);
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <carma_wm_ctrl/GeofenceDecodePool.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace carma_wm_ctrl
+{
+TEST(GeofenceDecodePoolTest, runsEveryTask)
+{
+  std::atomic<int> run_count(0);
+  std::vector<std::future<int>> results;
+  {
+    GeofenceDecodePool pool(2, 2);
+    for (int i = 0; i < 20; i++)
+    {
+      auto result = std::make_shared<std::promise<int>>();
+      results.push_back(result->get_future());
+      // More tasks than the queue holds, so submit waits for the threads to make space
+      pool.submit([result, i, &run_count]() {
+        run_count++;
+        result->set_value(i);
+      });
+    }
+
+    for (int i = 0; i < 20; i++)
+    {
+      ASSERT_EQ(results[i].get(), i);
+    }
+  }
+  ASSERT_EQ(run_count, 20);
+}
+
+TEST(GeofenceDecodePoolTest, submitWaitsForSpace)
+{
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+
+  GeofenceDecodePool pool(1, 1);
+  pool.submit([released]() { released.wait(); });  // Occupies the only thread
+
+  // Wait for the thread to take the first task so the queue is empty
+  while (pool.queuedCount() != 0)
+  {
+    std::this_thread::yield();
+  }
+  pool.submit([]() {});  // Fills the queue
+  ASSERT_EQ(pool.queuedCount(), 1u);
+
+  std::atomic<bool> submitted(false);
+  std::thread submitter([&]() {
+    pool.submit([]() {});
+    submitted = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_FALSE(submitted);  // The queue is full
+
+  release.set_value();
+  submitter.join();
+  ASSERT_TRUE(submitted);
+}
+
+TEST(GeofenceDecodePoolTest, destructionDiscardsQueuedTasks)
+{
+  std::future<int> queued_result;
+  {
+    GeofenceDecodePool pool(0, 4);  // No threads, so the task stays queued
+
+    auto result = std::make_shared<std::promise<int>>();
+    queued_result = result->get_future();
+    pool.submit([result]() { result->set_value(1); });
+    ASSERT_EQ(pool.queuedCount(), 1u);
+  }
+
+  // The queued task never ran, so its future reports a broken promise instead of blocking
+  ASSERT_THROW(queued_result.get(), std::future_error);
+}
+
+}  // namespace carma_wm_ctrl
@@ -2815,4 +2815,105 @@ ASSERT_EQ(value, p1);
 
 }
 
+TEST(WMBroadcaster, decodedGeofenceMatchesSynchronousDecode)
+{
+  // Geofence points projected on a decoding thread when the message is received are the same as points projected when
+  // the geofence is applied
+  ros::Time::setNow(ros::Time(0));
+
+  auto map = carma_wm::getDisjointRouteMap();
+  autoware_lanelet2_msgs::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(msg));
+
+  std_msgs::String base_map_proj;
+  base_map_proj.data = "+proj=tmerc +lat_0=39.46636844371259 +lon_0=-76.16919523566943 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +vunits=m +no_defs";
+  std::string geofence_proj_string = "+proj=tmerc +lat_0=39.46645851394806215 +lon_0=-76.16907903057393980 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +vunits=m +no_defs";
+
+  std::atomic<uint32_t> decoded_update_count(0), serial_update_count(0);
+
+  WMBroadcaster decoded_wmb(
+      [](const autoware_lanelet2_msgs::MapBin&) {},
+      [&](const autoware_lanelet2_msgs::MapBin&) { decoded_update_count++; },
+      [](const cav_msgs::TrafficControlRequest&) {}, [](const cav_msgs::CheckActiveGeofence&) {},
+      std::make_unique<TestTimerFactory>());
+
+  WMBroadcaster serial_wmb(
+      [](const autoware_lanelet2_msgs::MapBin&) {},
+      [&](const autoware_lanelet2_msgs::MapBin&) { serial_update_count++; },
+      [](const cav_msgs::TrafficControlRequest&) {}, [](const cav_msgs::CheckActiveGeofence&) {},
+      std::make_unique<TestTimerFactory>());
+  serial_wmb.setMaxParallelDecodes(0);
+
+  for (auto wmb : { &decoded_wmb, &serial_wmb })
+  {
+    wmb->baseMapCallback(map_msg_ptr);
+    wmb->geoReferenceCallback(base_map_proj);
+  }
+
+  // Several geofences applied immediately
+  std::vector<cav_msgs::TrafficControlMessage> gf_msgs;
+  for (int i = 0; i < 4; i++)
+  {
+    cav_msgs::TrafficControlMessage gf_msg;
+    gf_msg.choice = cav_msgs::TrafficControlMessage::TCMV01;
+    boost::uuids::uuid id = boost::uuids::random_generator()();
+    std::copy(id.begin(), id.end(), gf_msg.tcmV01.id.id.begin());
+    gf_msg.tcmV01.geometry.proj = geofence_proj_string;
+    gf_msg.tcmV01.geometry.datum = geofence_proj_string;
+    gf_msg.tcmV01.params.schedule.start = ros::Time(0);
+    gf_msg.tcmV01.params.schedule.end = ros::Time(10);
+    gf_msg.tcmV01.params.schedule.end_exists = true;
+
+    cav_msgs::PathNode pt;
+    pt.x = -8.5 + i * 0.1; pt.y = -9.5;
+    gf_msg.tcmV01.geometry.nodes.push_back(pt);
+    pt.x = 0.0; pt.y = 1.0;
+    gf_msg.tcmV01.geometry.nodes.push_back(pt);
+    gf_msgs.push_back(gf_msg);
+  }
+
+  for (const auto& gf_msg : gf_msgs)
+  {
+    decoded_wmb.geofenceCallback(gf_msg);
+    serial_wmb.geofenceCallback(gf_msg);
+  }
+
+  ros::Time::setNow(ros::Time(1.0));
+  ASSERT_TRUE(carma_utils::testing::waitForEqOrTimeout(10.0, 4, decoded_update_count));
+  ASSERT_TRUE(carma_utils::testing::waitForEqOrTimeout(10.0, 4, serial_update_count));
+
+  // Markers hold the points of each applied geofence. Geofences may be applied in any order so compare them by first point
+  auto sorted_points = [](const visualization_msgs::MarkerArray& markers) {
+    std::vector<std::vector<std::pair<double, double>>> points;
+    for (const auto& marker : markers.markers)
+    {
+      std::vector<std::pair<double, double>> marker_points;
+      for (const auto& p : marker.points)
+      {
+        marker_points.emplace_back(p.x, p.y);
+      }
+      points.push_back(marker_points);
+    }
+    std::sort(points.begin(), points.end());
+    return points;
+  };
+
+  auto decoded_points = sorted_points(decoded_wmb.tcm_marker_array_);
+  auto serial_points = sorted_points(serial_wmb.tcm_marker_array_);
+
+  ASSERT_EQ(4u, decoded_points.size());
+  ASSERT_EQ(decoded_points.size(), serial_points.size());
+  for (size_t i = 0; i < decoded_points.size(); i++)
+  {
+    ASSERT_EQ(2u, decoded_points[i].size());
+    ASSERT_EQ(decoded_points[i].size(), serial_points[i].size());
+    for (size_t j = 0; j < decoded_points[i].size(); j++)
+    {
+      EXPECT_NEAR(serial_points[i][j].first, decoded_points[i][j].first, 0.000001);
+      EXPECT_NEAR(serial_points[i][j].second, decoded_points[i][j].second, 0.000001);
+    }
+  }
+}
+
 }  // namespace carma_wm_ctrl
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark of geofence to lanelet association and route control request generation for a corridor TCM response.
+ * Every geofence is associated once using the broadcaster's lanelet grid index and once using the findNearest search it replaced.
+ *
+ * Run with: rosrun carma_wm_ctrl carma_wm_ctrl-geofence-benchmark [geofence_count] [corridor_length_m]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <carma_utils/timers/testing/TestTimerFactory.h>
+#include <carma_wm/WMTestLibForGuidance.h>
+#include <carma_wm/WorldModelUtils.h>
+#include <carma_wm_ctrl/WMBroadcaster.h>
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile size_t g_sink = 0;
+
+const double LANE_WIDTH = 3.7;
+const double LANELET_LENGTH = 25.0;
+const int LANE_COUNT = 3;
+const int POINTS_PER_BOUND = 6;
+
+// Point at the provided downtrack and lateral offset from the centerline of a gently curving corridor
+lanelet::Point3d corridorPoint(double downtrack, double offset)
+{
+  double heading = 0.2 * std::sin(downtrack / 800.0);
+  double x = downtrack + offset * -std::sin(heading);
+  double y = 150.0 * std::sin(downtrack / 1600.0) + offset * std::cos(heading);
+  return carma_wm::test::getPoint(x, y, 0);
+}
+
+// A multi lane one way corridor. Adjacent lanelets share their bounds so the routing graph connects them
+lanelet::LaneletMapPtr buildCorridorMap(double length, std::vector<lanelet::Id>* route_ids)
+{
+  int lanelets_per_lane = static_cast<int>(length / LANELET_LENGTH);
+  std::vector<std::vector<lanelet::LineString3d>> bounds(LANE_COUNT + 1);
+
+  for (int b = 0; b <= LANE_COUNT; b++)
+  {
+    lanelet::Point3d previous_end;
+    for (int s = 0; s < lanelets_per_lane; s++)
+    {
+      std::vector<lanelet::Point3d> points;
+      for (int p = 0; p < POINTS_PER_BOUND; p++)
+      {
+        if (p == 0 && s > 0)
+        {
+          points.push_back(previous_end);
+          continue;
+        }
+        double downtrack = (s + static_cast<double>(p) / (POINTS_PER_BOUND - 1)) * LANELET_LENGTH;
+        points.push_back(corridorPoint(downtrack, -b * LANE_WIDTH));
+      }
+      previous_end = points.back();
+      bounds[b].emplace_back(lanelet::utils::getId(), points);
+    }
+  }
+
+  std::vector<lanelet::Lanelet> lanelets;
+  for (int lane = 0; lane < LANE_COUNT; lane++)
+  {
+    for (int s = 0; s < lanelets_per_lane; s++)
+    {
+      lanelet::Id id = 100000 + lane * 10000 + s;
+      lanelets.push_back(carma_wm::test::getLanelet(id, bounds[lane][s], bounds[lane + 1][s],
+                                                    lanelet::AttributeValueString::Dashed,
+                                                    lanelet::AttributeValueString::Dashed));
+      if (lane == 1)
+      {
+        route_ids->push_back(id);
+      }
+    }
+  }
+
+  return lanelet::utils::createMap(lanelets, {});
+}
+
+// Geofences evenly spread along the corridor, each covering a few lanelets of one lane as in a corridor TCM response
+std::vector<lanelet::Points3d> buildGeofences(int geofence_count, double length)
+{
+  std::vector<lanelet::Points3d> geofences;
+  double spacing = (length - 4 * LANELET_LENGTH) / geofence_count;
+  for (int g = 0; g < geofence_count; g++)
+  {
+    double offset = -(g % LANE_COUNT + 0.5) * LANE_WIDTH;
+    double start = 1.0 + g * spacing;
+    lanelet::Points3d points;
+    for (int p = 0; p < 6; p++)
+    {
+      points.push_back(corridorPoint(start + p * 12.0, offset));
+    }
+    geofences.push_back(points);
+  }
+  return geofences;
+}
+
+double elapsedMs(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int geofence_count = argc > 1 ? std::stoi(argv[1]) : 500;
+  const double length = argc > 2 ? std::stod(argv[2]) : 20000.0;
+
+  ros::Time::init();
+
+  std::vector<lanelet::Id> route_ids;
+  auto map = buildCorridorMap(length, &route_ids);
+  auto geofences = buildGeofences(geofence_count, length);
+
+  carma_wm_ctrl::WMBroadcaster wmb(
+      [](const autoware_lanelet2_msgs::MapBin&) {}, [](const autoware_lanelet2_msgs::MapBin&) {},
+      [](const cav_msgs::TrafficControlRequest&) {}, [](const cav_msgs::CheckActiveGeofence&) {},
+      std::make_unique<carma_utils::timers::testing::TestTimerFactory>());
+  wmb.setMaxLaneWidth(LANE_WIDTH);
+
+  autoware_lanelet2_msgs::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(map, &map_msg);
+  autoware_lanelet2_msgs::MapBinConstPtr map_msg_ptr(new autoware_lanelet2_msgs::MapBin(map_msg));
+
+  auto start = std::chrono::steady_clock::now();
+  wmb.baseMapCallback(map_msg_ptr);
+  double load_ms = elapsedMs(start);
+
+  std_msgs::String georef;
+  georef.data = "+proj=tmerc +lat_0=39.46636844371259 +lon_0=-76.16919523566943 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m "
+                "+vunits=m +no_defs";
+  wmb.geoReferenceCallback(georef);
+
+  // The legacy search runs against a separate copy of the map with the same routing graph setup as the broadcaster
+  lanelet::LaneletMapPtr legacy_map(new lanelet::LaneletMap);
+  lanelet::utils::conversion::fromBinMsg(map_msg, legacy_map);
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
+  lanelet::routing::RoutingGraphPtr legacy_graph = lanelet::routing::RoutingGraph::build(*legacy_map, *traffic_rules);
+
+  size_t mismatches = 0;
+  double legacy_ms = 0, indexed_ms = 0;
+  for (const auto& gf_pts : geofences)
+  {
+    start = std::chrono::steady_clock::now();
+    auto legacy = carma_wm::query::getAffectedLaneletOrAreas(gf_pts, legacy_map, legacy_graph, LANE_WIDTH);
+    legacy_ms += elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    auto indexed = wmb.getAffectedLaneletOrAreas(gf_pts);
+    indexed_ms += elapsedMs(start);
+
+    if (legacy.size() != indexed.size())
+    {
+      mismatches++;
+      continue;
+    }
+    for (size_t i = 0; i < legacy.size(); i++)
+    {
+      if (legacy[i].id() != indexed[i].id())
+      {
+        mismatches++;
+        break;
+      }
+    }
+    g_sink += indexed.size();
+  }
+
+  cav_msgs::Route route_msg;
+  route_msg.route_path_lanelet_ids = route_ids;
+  const int route_requests = 50;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < route_requests; i++)
+  {
+    g_sink += wmb.controlRequestFromRoute(route_msg).tcrV01.bounds.size();
+  }
+  double request_ms = elapsedMs(start) / route_requests;
+
+  // Route bounds as computed before the lanelet index, from the lanelet geometry on every request
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < route_requests; i++)
+  {
+    double min_x = std::numeric_limits<double>::max();
+    for (auto id : route_ids)
+    {
+      min_x = std::min(min_x, lanelet::geometry::boundingBox2d(legacy_map->laneletLayer.get(id)).min().x());
+    }
+    g_sink += static_cast<size_t>(std::abs(min_x));
+  }
+  double legacy_bounds_ms = elapsedMs(start) / route_requests;
+
+  std::cout << map->laneletLayer.size() << " lanelets, " << geofence_count << " geofences of 6 points" << std::endl;
+  std::cout << "base map load including index build: " << load_ms << " ms" << std::endl;
+  std::cout << "findNearest association: " << legacy_ms << " ms total, " << legacy_ms / geofence_count << " ms per geofence"
+            << std::endl;
+  std::cout << "indexed association:     " << indexed_ms << " ms total, " << indexed_ms / geofence_count
+            << " ms per geofence" << std::endl;
+  std::cout << "geofences with different affected lanelets: " << mismatches << std::endl;
+  std::cout << "control request for a " << route_ids.size() << " lanelet route: " << request_ms
+            << " ms (recomputing route lanelet bounds alone took " << legacy_bounds_ms << " ms)" << std::endl;
+
+  return 0;
+}
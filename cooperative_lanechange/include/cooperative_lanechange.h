@@ -37,7 +37,7 @@
 #include <cav_msgs/LaneChangeStatus.h>
 #include <basic_autonomy/basic_autonomy.h>
 #include <std_msgs/String.h>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <ecef_projection/batch_projector.h>
 
 
 
@@ -110,6 +110,13 @@ namespace cooperative_lanechange
              */
             cav_msgs::LocationECEF trajectory_point_to_ecef(const cav_msgs::TrajectoryPlanPoint& traj_point) const;
 
+            /**
+             * \brief Converts a projected ECEF point in m to the cm location used by V2X messages
+             * \param ecef_point The ECEF point in m
+             * \return The location message
+             */
+            cav_msgs::LocationECEF ecef_point_to_location(const lanelet::BasicPoint3d& ecef_point) const;
+
             void add_maneuver_to_response(cav_srvs::PlanTrajectoryRequest &req, cav_srvs::PlanTrajectoryResponse &resp, std::vector<cav_msgs::TrajectoryPlanPoint>& planned_trajectory_points);
             
               /**
@@ -169,7 +176,7 @@ namespace cooperative_lanechange
             ros::Subscriber georeference_sub_;
             ros::Timer discovery_pub_timer_;
 
-            std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+            std::shared_ptr<const ecef_projection::BatchProjector> map_projector_;
 
             // trajectory frequency
             double traj_freq = 10;
@@ -448,9 +448,21 @@ namespace cooperative_lanechange
     }
 
     cav_msgs::Trajectory CooperativeLaneChangePlugin::trajectory_plan_to_trajectory(const std::vector<cav_msgs::TrajectoryPlanPoint>& traj_points) const{
+        if (!map_projector_) {
+            throw std::invalid_argument("No map projector available for ecef conversion");
+        }
         cav_msgs::Trajectory traj;
 
-        cav_msgs::LocationECEF ecef_location = trajectory_point_to_ecef(traj_points[0]);
+        // Project the whole trajectory at once rather than point by point
+        std::vector<lanelet::BasicPoint3d> map_points;
+        map_points.reserve(traj_points.size());
+        for (const auto& traj_point : traj_points) {
+            map_points.emplace_back(traj_point.x, traj_point.y, 0.0);
+        }
+        std::vector<lanelet::BasicPoint3d> ecef_points;
+        map_projector_->mapToEcef(map_points, ecef_points);
+
+        cav_msgs::LocationECEF ecef_location = ecef_point_to_location(ecef_points[0]);
 
         if (traj_points.size()<2){
             ROS_WARN("Received Trajectory Plan is too small");
@@ -461,7 +473,7 @@ namespace cooperative_lanechange
             for (size_t i=1; i<traj_points.size(); i++){
                 
                 cav_msgs::LocationOffsetECEF offset;
-                cav_msgs::LocationECEF new_point = trajectory_point_to_ecef(traj_points[i]); //m to cm to fit the msg standard
+                cav_msgs::LocationECEF new_point = ecef_point_to_location(ecef_points[i]); //m to cm to fit the msg standard
                 offset.offset_x = (int16_t)(new_point.ecef_x - prev_point.ecef_x);  
                 offset.offset_y = (int16_t)(new_point.ecef_y - prev_point.ecef_y);
                 offset.offset_z = (int16_t)(new_point.ecef_z - prev_point.ecef_z);
@@ -479,15 +491,17 @@ namespace cooperative_lanechange
         if (!map_projector_) {
             throw std::invalid_argument("No map projector available for ecef conversion");
         }
+        return ecef_point_to_location(map_projector_->mapToEcef({traj_point.x, traj_point.y, 0.0}));
+    } 
+
+    cav_msgs::LocationECEF CooperativeLaneChangePlugin::ecef_point_to_location(const lanelet::BasicPoint3d& ecef_point) const{
         cav_msgs::LocationECEF location;    
-        
-        lanelet::BasicPoint3d ecef_point = map_projector_->projectECEF({traj_point.x, traj_point.y, 0.0}, 1);
-        location.ecef_x = ecef_point.x() * 100.0; // Convert cm to m
+        location.ecef_x = ecef_point.x() * 100.0; // Convert m to cm
         location.ecef_y = ecef_point.y() * 100.0;
         location.ecef_z = ecef_point.z() * 100.0;
 
         return location;
-    } 
+    }
 
     std::vector<cav_msgs::TrajectoryPlanPoint> CooperativeLaneChangePlugin::plan_lanechange(cav_srvs::PlanTrajectoryRequest &req){
         
@@ -538,7 +552,7 @@ namespace cooperative_lanechange
 
     void CooperativeLaneChangePlugin::georeference_callback(const std_msgs::StringConstPtr& msg) 
     {
-        map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());  // Build projector from proj string
+        map_projector_ = ecef_projection::BatchProjector::forGeoreference(msg->data);  // Build projector from proj string
     }
    
 }
@@ -0,0 +1,172 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <lanelet2_core/primitives/Point.h>
+#include <lanelet2_extension/projection/local_frame_projector.h>
+
+namespace ecef_projection
+{
+/*!
+ * \brief Second order Taylor model of a projection about a single point.
+ *
+ * Each output coordinate is c + J * d + d' * Q * d where d is the offset of the input from the expansion point. The
+ * coefficients are estimated by central differences of the exact projection.
+ */
+struct LocalModel
+{
+  /*!
+   * \brief Evaluates the model at the provided input point
+   */
+  lanelet::BasicPoint3d evaluate(const lanelet::BasicPoint3d& point) const;
+
+  // The point the model is expanded about in the input frame
+  lanelet::BasicPoint3d input_origin;
+
+  // The projection of input_origin
+  lanelet::BasicPoint3d output_origin;
+
+  // Row major Jacobian. linear[3 * output + input]
+  std::array<double, 9> linear;
+
+  // Quadratic coefficients of each output ordered as xx, yy, zz, xy, xz, yz
+  std::array<std::array<double, 6>, 3> quadratic;
+};
+
+/*!
+ * \brief Projects points between the map frame and ECEF for a single georeference.
+ *
+ * V2X messages carry trajectories as an ECEF location followed by a chain of ECEF offsets and each point of those
+ * trajectories needs to be moved to or from the map frame. Doing this through PROJ one point at a time is expensive, so
+ * on construction this class fits a local model of the map to ECEF projection and its inverse about the map origin.
+ * Inside the model radius points are projected by evaluating the model. Outside it they are projected exactly with
+ * lanelet::projection::LocalFrameProjector.
+ *
+ * The model radius is chosen on construction by comparing the model against the exact projection at sample points on
+ * spheres about the origin. The radius starts at max_model_radius and is halved until the error at every sample in both
+ * directions is below the tolerance. If no radius down to min_model_radius satisfies the tolerance the model is not used
+ * and every point is projected exactly.
+ *
+ * All coordinates are in meters. Evaluating the model is thread safe. Exact projections are serialized internally since
+ * PROJ objects may not be used from several threads at once.
+ */
+class BatchProjector
+{
+public:
+  /*!
+   * \brief Constructor
+   *
+   * \param georeference The proj string of the map frame as published on the georeference topic
+   * \param tolerance The largest error in m allowed for points projected with the local model
+   * \param max_model_radius The largest distance in m from the map origin at which the local model will be used
+   * \param min_model_radius The smallest model radius in m worth using. Below this the model is disabled
+   *
+   * \throws std::invalid_argument if the tolerance or either radius is not positive
+   */
+  explicit BatchProjector(const std::string& georeference, double tolerance = 0.001, double max_model_radius = 5000.0,
+                          double min_model_radius = 50.0);
+
+  /*!
+   * \brief Returns a projector for the provided georeference with the default tolerance and radii.
+   *
+   * Projectors are cached by georeference for the life of the process so every consumer of the same georeference in a
+   * process shares one model fit.
+   *
+   * \param georeference The proj string of the map frame
+   */
+  static std::shared_ptr<const BatchProjector> forGeoreference(const std::string& georeference);
+
+  /*!
+   * \brief Projects a map frame point to ECEF
+   */
+  lanelet::BasicPoint3d mapToEcef(const lanelet::BasicPoint3d& map_point) const;
+
+  /*!
+   * \brief Projects an ECEF point to the map frame
+   */
+  lanelet::BasicPoint3d ecefToMap(const lanelet::BasicPoint3d& ecef_point) const;
+
+  /*!
+   * \brief Projects a sequence of map frame points, such as a trajectory, to ECEF
+   *
+   * \param map_points The points to project
+   * \param[out] ecef_points The projected points. Resized to match map_points
+   */
+  void mapToEcef(const std::vector<lanelet::BasicPoint3d>& map_points,
+                 std::vector<lanelet::BasicPoint3d>& ecef_points) const;
+
+  /*!
+   * \brief Projects a sequence of ECEF points to the map frame
+   *
+   * \param ecef_points The points to project
+   * \param[out] map_points The projected points. Resized to match ecef_points
+   */
+  void ecefToMap(const std::vector<lanelet::BasicPoint3d>& ecef_points,
+                 std::vector<lanelet::BasicPoint3d>& map_points) const;
+
+  /*!
+   * \brief Projects an ECEF offset chain to the map frame.
+   *
+   * The chain starts at the provided location and each offset is relative to the point before it, as in the trajectory
+   * of a MobilityPath or MobilityRequest message once converted to m.
+   *
+   * \param ecef_location The first point of the chain in ECEF
+   * \param ecef_offsets The offset of each following point from the one before it
+   * \param[out] map_points The map frame points of the chain. Resized to ecef_offsets.size() + 1 with the location first
+   */
+  void ecefChainToMap(const lanelet::BasicPoint3d& ecef_location, const std::vector<lanelet::BasicPoint3d>& ecef_offsets,
+                      std::vector<lanelet::BasicPoint3d>& map_points) const;
+
+  /*!
+   * \brief Returns the radius in m about the map origin inside which the local model is used. Zero if it is never used
+   */
+  double modelRadius() const;
+
+  /*!
+   * \brief Returns the largest error in m measured between the local model and the exact projection when the model
+   * radius was chosen
+   */
+  double modelError() const;
+
+  /*!
+   * \brief Returns the georeference this projector was built for
+   */
+  const std::string& georeference() const;
+
+private:
+  lanelet::BasicPoint3d exactProjection(const lanelet::BasicPoint3d& point, int proj_dir) const;
+
+  LocalModel fitModel(const lanelet::BasicPoint3d& input_origin, int proj_dir) const;
+
+  double modelErrorAt(double radius) const;
+
+  std::string georeference_;
+  mutable lanelet::projection::LocalFrameProjector projector_;
+  mutable std::mutex projector_mutex_;
+
+  LocalModel map_to_ecef_;
+  LocalModel ecef_to_map_;
+  double model_radius_ = 0.0;
+  double model_radius_sq_ = 0.0;
+  double model_error_ = 0.0;
+};
+}  // namespace ecef_projection
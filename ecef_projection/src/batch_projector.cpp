@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <ecef_projection/batch_projector.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace ecef_projection
+{
+namespace
+{
+// Step in m used for the central differences of the model fit. Small relative to the earth radius so the truncation
+// error of the differences is negligible and large enough that rounding in the projection does not dominate
+constexpr double FIT_STEP = 100.0;
+
+// Directions of the verification samples. The faces, edges and corners of a cube about the origin
+std::vector<lanelet::BasicPoint3d> sampleDirections()
+{
+  std::vector<lanelet::BasicPoint3d> directions;
+  for (int x = -1; x <= 1; x++)
+  {
+    for (int y = -1; y <= 1; y++)
+    {
+      for (int z = -1; z <= 1; z++)
+      {
+        if (x == 0 && y == 0 && z == 0)
+        {
+          continue;
+        }
+        directions.emplace_back(lanelet::BasicPoint3d(x, y, z).normalized());
+      }
+    }
+  }
+  return directions;
+}
+}  // namespace
+
+lanelet::BasicPoint3d LocalModel::evaluate(const lanelet::BasicPoint3d& point) const
+{
+  const double dx = point.x() - input_origin.x();
+  const double dy = point.y() - input_origin.y();
+  const double dz = point.z() - input_origin.z();
+
+  const double xx = dx * dx, yy = dy * dy, zz = dz * dz;
+  const double xy = dx * dy, xz = dx * dz, yz = dy * dz;
+
+  lanelet::BasicPoint3d output;
+  for (size_t i = 0; i < 3; i++)
+  {
+    const auto& q = quadratic[i];
+    output[i] = output_origin[i] + linear[3 * i] * dx + linear[3 * i + 1] * dy + linear[3 * i + 2] * dz + q[0] * xx +
+                q[1] * yy + q[2] * zz + q[3] * xy + q[4] * xz + q[5] * yz;
+  }
+  return output;
+}
+
+BatchProjector::BatchProjector(const std::string& georeference, double tolerance, double max_model_radius,
+                               double min_model_radius)
+  : georeference_(georeference), projector_(georeference.c_str())
+{
+  if (tolerance <= 0.0 || max_model_radius <= 0.0 || min_model_radius <= 0.0)
+  {
+    throw std::invalid_argument("BatchProjector tolerance and model radii must be positive");
+  }
+
+  try
+  {
+    map_to_ecef_ = fitModel(lanelet::BasicPoint3d(0, 0, 0), 1);
+    ecef_to_map_ = fitModel(map_to_ecef_.output_origin, -1);
+
+    for (double radius = max_model_radius; radius >= min_model_radius; radius *= 0.5)
+    {
+      double error = modelErrorAt(radius);
+      if (error <= tolerance)  // False for NaN so a degenerate projection disables the model
+      {
+        model_radius_ = radius;
+        model_error_ = error;
+        break;
+      }
+    }
+  }
+  catch (const std::exception&)
+  {
+    // The projection could not be evaluated about the map origin so every point will be projected exactly
+    model_radius_ = 0.0;
+    model_error_ = 0.0;
+  }
+  model_radius_sq_ = model_radius_ * model_radius_;
+}
+
+std::shared_ptr<const BatchProjector> BatchProjector::forGeoreference(const std::string& georeference)
+{
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, std::shared_ptr<const BatchProjector>> cache;
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = cache.find(georeference);
+  if (it != cache.end())
+  {
+    return it->second;
+  }
+  auto projector = std::make_shared<const BatchProjector>(georeference);
+  cache.emplace(georeference, projector);
+  return projector;
+}
+
+lanelet::BasicPoint3d BatchProjector::mapToEcef(const lanelet::BasicPoint3d& map_point) const
+{
+  if ((map_point - map_to_ecef_.input_origin).squaredNorm() <= model_radius_sq_)
+  {
+    return map_to_ecef_.evaluate(map_point);
+  }
+  return exactProjection(map_point, 1);
+}
+
+lanelet::BasicPoint3d BatchProjector::ecefToMap(const lanelet::BasicPoint3d& ecef_point) const
+{
+  if ((ecef_point - ecef_to_map_.input_origin).squaredNorm() <= model_radius_sq_)
+  {
+    return ecef_to_map_.evaluate(ecef_point);
+  }
+  return exactProjection(ecef_point, -1);
+}
+
+void BatchProjector::mapToEcef(const std::vector<lanelet::BasicPoint3d>& map_points,
+                               std::vector<lanelet::BasicPoint3d>& ecef_points) const
+{
+  ecef_points.resize(map_points.size());
+  for (size_t i = 0; i < map_points.size(); i++)
+  {
+    ecef_points[i] = mapToEcef(map_points[i]);
+  }
+}
+
+void BatchProjector::ecefToMap(const std::vector<lanelet::BasicPoint3d>& ecef_points,
+                               std::vector<lanelet::BasicPoint3d>& map_points) const
+{
+  map_points.resize(ecef_points.size());
+  for (size_t i = 0; i < ecef_points.size(); i++)
+  {
+    map_points[i] = ecefToMap(ecef_points[i]);
+  }
+}
+
+void BatchProjector::ecefChainToMap(const lanelet::BasicPoint3d& ecef_location,
+                                    const std::vector<lanelet::BasicPoint3d>& ecef_offsets,
+                                    std::vector<lanelet::BasicPoint3d>& map_points) const
+{
+  map_points.resize(ecef_offsets.size() + 1);
+
+  lanelet::BasicPoint3d ecef_point = ecef_location;
+  map_points[0] = ecefToMap(ecef_point);
+  for (size_t i = 0; i < ecef_offsets.size(); i++)
+  {
+    ecef_point += ecef_offsets[i];
+    map_points[i + 1] = ecefToMap(ecef_point);
+  }
+}
+
+double BatchProjector::modelRadius() const
+{
+  return model_radius_;
+}
+
+double BatchProjector::modelError() const
+{
+  return model_error_;
+}
+
+const std::string& BatchProjector::georeference() const
+{
+  return georeference_;
+}
+
+lanelet::BasicPoint3d BatchProjector::exactProjection(const lanelet::BasicPoint3d& point, int proj_dir) const
+{
+  std::lock_guard<std::mutex> lock(projector_mutex_);
+  return projector_.projectECEF(point, proj_dir);
+}
+
+LocalModel BatchProjector::fitModel(const lanelet::BasicPoint3d& input_origin, int proj_dir) const
+{
+  const double h = FIT_STEP;
+  auto f = [&](const lanelet::BasicPoint3d& offset) { return exactProjection(input_origin + offset, proj_dir); };
+  auto step = [&](size_t axis, double sign) {
+    lanelet::BasicPoint3d d(0, 0, 0);
+    d[axis] = sign * h;
+    return d;
+  };
+
+  LocalModel model;
+  model.input_origin = input_origin;
+  model.output_origin = f(lanelet::BasicPoint3d(0, 0, 0));
+
+  // Diagonal terms
+  for (size_t j = 0; j < 3; j++)
+  {
+    lanelet::BasicPoint3d fp = f(step(j, 1.0));
+    lanelet::BasicPoint3d fm = f(step(j, -1.0));
+    for (size_t i = 0; i < 3; i++)
+    {
+      model.linear[3 * i + j] = (fp[i] - fm[i]) / (2.0 * h);
+      model.quadratic[i][j] = (fp[i] - 2.0 * model.output_origin[i] + fm[i]) / (2.0 * h * h);
+    }
+  }
+
+  // Mixed terms in the order xy, xz, yz
+  const std::array<std::array<size_t, 2>, 3> pairs = { { { 0, 1 }, { 0, 2 }, { 1, 2 } } };
+  for (size_t p = 0; p < pairs.size(); p++)
+  {
+    lanelet::BasicPoint3d j_plus = step(pairs[p][0], 1.0), j_minus = step(pairs[p][0], -1.0);
+    lanelet::BasicPoint3d k_plus = step(pairs[p][1], 1.0), k_minus = step(pairs[p][1], -1.0);
+    lanelet::BasicPoint3d fpp = f(j_plus + k_plus);
+    lanelet::BasicPoint3d fpm = f(j_plus + k_minus);
+    lanelet::BasicPoint3d fmp = f(j_minus + k_plus);
+    lanelet::BasicPoint3d fmm = f(j_minus + k_minus);
+    for (size_t i = 0; i < 3; i++)
+    {
+      model.quadratic[i][3 + p] = (fpp[i] - fpm[i] - fmp[i] + fmm[i]) / (4.0 * h * h);
+    }
+  }
+
+  return model;
+}
+
+double BatchProjector::modelErrorAt(double radius) const
+{
+  static const std::vector<lanelet::BasicPoint3d> directions = sampleDirections();
+
+  // The model error grows with distance from the origin so the outer sphere bounds it. The inner sphere guards
+  // against a poor fit which happens to cross the exact projection near the boundary
+  double max_error = 0.0;
+  for (double r : { radius, 0.5 * radius })
+  {
+    for (const auto& direction : directions)
+    {
+      lanelet::BasicPoint3d map_point = map_to_ecef_.input_origin + r * direction;
+      double forward_error = (map_to_ecef_.evaluate(map_point) - exactProjection(map_point, 1)).norm();
+
+      lanelet::BasicPoint3d ecef_point = ecef_to_map_.input_origin + r * direction;
+      double reverse_error = (ecef_to_map_.evaluate(ecef_point) - exactProjection(ecef_point, -1)).norm();
+
+      if (std::isnan(forward_error) || std::isnan(reverse_error))
+      {
+        return std::numeric_limits<double>::quiet_NaN();
+      }
+      max_error = std::max({ max_error, forward_error, reverse_error });
+    }
+  }
+  return max_error;
+}
+
+}  // namespace ecef_projection
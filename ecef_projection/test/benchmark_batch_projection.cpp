@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark of map to ECEF projection of outgoing trajectories and ECEF offset chain to map projection of incoming
+ * trajectories. Each trajectory is projected once through the BatchProjector and once one point at a time through the
+ * LocalFrameProjector calls it replaced.
+ *
+ * Run with: rosrun ecef_projection ecef_projection-benchmark [point_count] [iterations]
+ *       or, in ROS 2: build/ecef_projection/ecef_projection-benchmark [point_count] [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <ecef_projection/batch_projector.h>
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+const std::string BASE_PROJ = "+proj=tmerc +lat_0=38.95 +lon_0=-77.15 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m "
+                              "+vunits=m +no_defs";
+
+// A trajectory with 0.5 m spacing curving away from a point near the map origin
+std::vector<lanelet::BasicPoint3d> makeTrajectory(int point_count)
+{
+  std::vector<lanelet::BasicPoint3d> points;
+  points.reserve(point_count);
+  for (int i = 0; i < point_count; i++)
+  {
+    double s = 0.5 * i;
+    points.emplace_back(-120.0 + s, 35.0 + 40.0 * std::sin(s / 150.0), 0.0);
+  }
+  return points;
+}
+
+struct LatencyStats
+{
+  std::vector<double> samples_us;
+
+  void print(const std::string& name)
+  {
+    std::sort(samples_us.begin(), samples_us.end());
+    double total = 0;
+    for (double s : samples_us)
+    {
+      total += s;
+    }
+    std::cout << name << ": mean " << total / samples_us.size() << " us, p99 "
+              << samples_us[samples_us.size() * 99 / 100] << " us, max " << samples_us.back() << " us" << std::endl;
+  }
+};
+
+double elapsedUs(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int point_count = argc > 1 ? std::stoi(argv[1]) : 1000;
+  const int iterations = argc > 2 ? std::stoi(argv[2]) : 200;
+
+  auto construction_start = std::chrono::steady_clock::now();
+  ecef_projection::BatchProjector projector(BASE_PROJ);
+  double construction_us = elapsedUs(construction_start);
+
+  lanelet::projection::LocalFrameProjector exact(BASE_PROJ.c_str());
+
+  std::vector<lanelet::BasicPoint3d> map_points = makeTrajectory(point_count);
+
+  // The ECEF offset chain of the trajectory as carried by a MobilityPath message
+  std::vector<lanelet::BasicPoint3d> exact_ecef(point_count);
+  for (int i = 0; i < point_count; i++)
+  {
+    exact_ecef[i] = exact.projectECEF(map_points[i], 1);
+  }
+  lanelet::BasicPoint3d location = exact_ecef.front();
+  std::vector<lanelet::BasicPoint3d> offsets;
+  for (int i = 1; i < point_count; i++)
+  {
+    offsets.push_back(exact_ecef[i] - exact_ecef[i - 1]);
+  }
+
+  std::vector<lanelet::BasicPoint3d> legacy_ecef(point_count), batch_ecef;
+  std::vector<lanelet::BasicPoint3d> legacy_map(point_count), batch_map;
+
+  LatencyStats legacy_forward, batch_forward, legacy_reverse, batch_reverse;
+  for (int it = 0; it < iterations; it++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < point_count; i++)
+    {
+      legacy_ecef[i] = exact.projectECEF(map_points[i], 1);
+    }
+    legacy_forward.samples_us.push_back(elapsedUs(start));
+
+    start = std::chrono::steady_clock::now();
+    projector.mapToEcef(map_points, batch_ecef);
+    batch_forward.samples_us.push_back(elapsedUs(start));
+
+    start = std::chrono::steady_clock::now();
+    lanelet::BasicPoint3d ecef_point = location;
+    legacy_map[0] = exact.projectECEF(ecef_point, -1);
+    for (size_t i = 0; i < offsets.size(); i++)
+    {
+      ecef_point += offsets[i];
+      legacy_map[i + 1] = exact.projectECEF(ecef_point, -1);
+    }
+    legacy_reverse.samples_us.push_back(elapsedUs(start));
+
+    start = std::chrono::steady_clock::now();
+    projector.ecefChainToMap(location, offsets, batch_map);
+    batch_reverse.samples_us.push_back(elapsedUs(start));
+
+    g_sink += legacy_ecef.back().x() + batch_ecef.back().x() + legacy_map.back().x() + batch_map.back().x();
+  }
+
+  // Largest difference between the two paths, to confirm they agree
+  double max_forward_error = 0;
+  double max_reverse_error = 0;
+  for (int i = 0; i < point_count; i++)
+  {
+    max_forward_error = std::max(max_forward_error, (legacy_ecef[i] - batch_ecef[i]).norm());
+    max_reverse_error = std::max(max_reverse_error, (legacy_map[i] - batch_map[i]).norm());
+  }
+
+  std::cout << iterations << " trajectories of " << point_count << " points" << std::endl;
+  std::cout << "projector construction: " << construction_us << " us, model radius " << projector.modelRadius()
+            << " m, model error " << projector.modelError() << " m" << std::endl;
+  legacy_forward.print("map to ecef per point PROJ ");
+  batch_forward.print("map to ecef batched        ");
+  legacy_reverse.print("ecef chain per point PROJ  ");
+  batch_reverse.print("ecef chain batched         ");
+  std::cout << "max difference map to ecef: " << max_forward_error << " m, ecef chain to map: " << max_reverse_error
+            << " m" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <ecef_projection/batch_projector.h>
+
+namespace ecef_projection
+{
+namespace
+{
+// Transverse mercator map frame centered away from the equator so the projection is not symmetric about the origin
+const std::string BASE_PROJ = "+proj=tmerc +lat_0=38.95 +lon_0=-77.15 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m "
+                              "+vunits=m +no_defs";
+
+void expectNear(const lanelet::BasicPoint3d& expected, const lanelet::BasicPoint3d& actual, double tolerance)
+{
+  EXPECT_NEAR(expected.x(), actual.x(), tolerance);
+  EXPECT_NEAR(expected.y(), actual.y(), tolerance);
+  EXPECT_NEAR(expected.z(), actual.z(), tolerance);
+}
+}  // namespace
+
+TEST(BatchProjector, rejectsInvalidParameters)
+{
+  EXPECT_THROW(BatchProjector(BASE_PROJ, 0.0), std::invalid_argument);
+  EXPECT_THROW(BatchProjector(BASE_PROJ, 0.001, -1.0), std::invalid_argument);
+  EXPECT_THROW(BatchProjector(BASE_PROJ, 0.001, 5000.0, 0.0), std::invalid_argument);
+}
+
+TEST(BatchProjector, modelWithinToleranceInsideRadius)
+{
+  const double tolerance = 0.001;
+  BatchProjector projector(BASE_PROJ, tolerance);
+  lanelet::projection::LocalFrameProjector exact(BASE_PROJ.c_str());
+
+  ASSERT_GT(projector.modelRadius(), 0.0);
+  EXPECT_LE(projector.modelError(), tolerance);
+
+  // Points spread over the model radius, including ones off the sample directions used to choose it
+  const double radius = projector.modelRadius();
+  for (int i = 0; i < 64; i++)
+  {
+    double angle = 0.37 * i;
+    double distance = radius * (i + 1) / 65.0;
+    lanelet::BasicPoint3d map_point(distance * std::cos(angle), distance * std::sin(angle), 0.1 * i);
+
+    lanelet::BasicPoint3d ecef_point = exact.projectECEF(map_point, 1);
+    expectNear(ecef_point, projector.mapToEcef(map_point), tolerance);
+    expectNear(map_point, projector.ecefToMap(ecef_point), tolerance);
+  }
+}
+
+TEST(BatchProjector, exactOutsideRadius)
+{
+  BatchProjector projector(BASE_PROJ);
+  lanelet::projection::LocalFrameProjector exact(BASE_PROJ.c_str());
+
+  lanelet::BasicPoint3d map_point(3.0 * projector.modelRadius() + 20000.0, -15000.0, 12.0);
+  lanelet::BasicPoint3d ecef_point = exact.projectECEF(map_point, 1);
+
+  expectNear(ecef_point, projector.mapToEcef(map_point), 1e-9);
+  expectNear(exact.projectECEF(ecef_point, -1), projector.ecefToMap(ecef_point), 1e-9);
+}
+
+TEST(BatchProjector, batchMatchesSinglePoints)
+{
+  BatchProjector projector(BASE_PROJ);
+
+  // A trajectory which starts inside the model radius and leaves it
+  std::vector<lanelet::BasicPoint3d> map_points;
+  for (int i = 0; i < 100; i++)
+  {
+    map_points.emplace_back(-500.0 + 100.0 * i, 20.0 * i, 0.0);
+  }
+
+  std::vector<lanelet::BasicPoint3d> ecef_points;
+  projector.mapToEcef(map_points, ecef_points);
+  ASSERT_EQ(map_points.size(), ecef_points.size());
+
+  std::vector<lanelet::BasicPoint3d> round_trip;
+  projector.ecefToMap(ecef_points, round_trip);
+  ASSERT_EQ(map_points.size(), round_trip.size());
+
+  for (size_t i = 0; i < map_points.size(); i++)
+  {
+    expectNear(projector.mapToEcef(map_points[i]), ecef_points[i], 1e-9);
+    expectNear(map_points[i], round_trip[i], 0.002);
+  }
+}
+
+TEST(BatchProjector, offsetChain)
+{
+  BatchProjector projector(BASE_PROJ);
+
+  lanelet::BasicPoint3d location = projector.mapToEcef(lanelet::BasicPoint3d(10.0, -30.0, 0.0));
+  std::vector<lanelet::BasicPoint3d> offsets = { { 1.0, 0.5, -0.25 }, { 1.0, 0.5, -0.25 }, { -2.0, 3.0, 0.0 } };
+
+  std::vector<lanelet::BasicPoint3d> map_points;
+  projector.ecefChainToMap(location, offsets, map_points);
+  ASSERT_EQ(4u, map_points.size());
+
+  lanelet::BasicPoint3d ecef_point = location;
+  expectNear(projector.ecefToMap(ecef_point), map_points[0], 1e-9);
+  for (size_t i = 0; i < offsets.size(); i++)
+  {
+    ecef_point += offsets[i];
+    expectNear(projector.ecefToMap(ecef_point), map_points[i + 1], 1e-9);
+  }
+
+  projector.ecefChainToMap(location, {}, map_points);
+  ASSERT_EQ(1u, map_points.size());
+}
+
+TEST(BatchProjector, ecefMapFrame)
+{
+  // A map frame which is ECEF, as used by several of the V2X consumer tests
+  std::string ecef_proj = lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR;
+  BatchProjector projector(ecef_proj);
+  lanelet::projection::LocalFrameProjector exact(ecef_proj.c_str());
+
+  lanelet::BasicPoint3d point(1.0, 2.0, 3.0);
+  expectNear(exact.projectECEF(point, 1), projector.mapToEcef(point), 0.001);
+  expectNear(exact.projectECEF(point, -1), projector.ecefToMap(point), 0.001);
+}
+
+TEST(BatchProjector, cachedByGeoreference)
+{
+  auto first = BatchProjector::forGeoreference(BASE_PROJ);
+  auto second = BatchProjector::forGeoreference(BASE_PROJ);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(BASE_PROJ, first->georeference());
+
+  auto other = BatchProjector::forGeoreference(lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR);
+  EXPECT_NE(first.get(), other.get());
+}
+
+}  // namespace ecef_projection
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
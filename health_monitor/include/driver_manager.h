@@ -19,9 +19,18 @@
 #include <cav_msgs/SystemAlert.h>
 #include "entry_manager.h"
 #include <iostream>
+#include <climits>
 
 namespace health_monitor
 {
+    /**
+     * \brief Tracks driver status and evaluates whether the critical drivers are operational.
+     *
+     * When a driver first reports, the sensor groups (ssc, lidar, gps, camera) it belongs to are resolved once.
+     * Each group is decided by the most recently registered driver in it, so evaluating the
+     * critical driver status only reads a handful of entries regardless of how many drivers report. The last
+     * status is cached and only recomputed when a status change affects a group or a driver times out.
+     */
     class DriverManager
     {
         public:
@@ -50,7 +59,7 @@ namespace health_monitor
             /*!
              * \brief Evaluate if the sensor is available
              */
-            void evaluate_sensor(int &sensor_input,bool available,long current_time,long timestamp,long driver_timeout);
+            void evaluate_sensor(int &sensor_input,bool available,long current_time,long timestamp,long driver_timeout) const;
             /*!
              * \brief Handle the spin and publisher
              */
@@ -58,7 +67,60 @@ namespace health_monitor
 
         private:
 
+            // Slot in the entry list of the driver which decides each sensor group or -1 if no driver has reported.
+            // Drivers are never deleted from the entry list so the slots remain valid
+            struct TruckSensorGroups
+            {
+                int ssc = -1;
+                int lidar1 = -1;
+                int lidar2 = -1;
+                int gps = -1;
+                int camera = -1;
+            };
+
+            struct CarSensorGroups
+            {
+                int ssc = -1;
+                int lidar = -1;
+                int gps = -1;
+                int camera = -1;
+            };
+
+            /*!
+             * \brief Assign a newly registered driver to the sensor groups it belongs to
+             */
+            void register_driver(size_t slot, const std::string& name);
+
+            /*!
+             * \brief Check if the driver in the provided slot decides any sensor group
+             */
+            bool is_group_driver(int slot) const;
+
+            /*!
+             * \brief Evaluate the driver deciding a sensor group. Groups without a driver evaluate to 0
+             */
+            int evaluate_group(int slot, long current_time) const;
+
+            /*!
+             * \brief Get the time after which the first currently operational group driver times out
+             */
+            long next_group_timeout(bool truck, long current_time) const;
+
+            /*!
+             * \brief Get the critical driver status for the truck or car, reusing the previous result if nothing has changed
+             */
+            std::string critical_driver_status(bool truck, long current_time);
+
             EntryManager em_;
+            TruckSensorGroups truck_groups_;
+            CarSensorGroups car_groups_;
+
+            // Cached result of critical_driver_status
+            bool status_dirty_ = true;
+            bool status_truck_ = false;
+            long status_valid_until_ = LONG_MIN;
+            std::string status_;
+
             bool starting_up_ = true;
             // timeout for critical driver timeout
             long driver_timeout_ {1000};
@@ -16,12 +16,22 @@
  * the License.
  */
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <boost/optional.hpp>
 #include "entry.h"
 
 namespace health_monitor
 {
+    /**
+     * \brief Registry of plugin or driver entries.
+     *
+     * Each name is mapped to a slot in the entry list on first registration, so updates and lookups
+     * are a single hash lookup. Entries keep their registration order, so deleting an entry moves every later
+     * entry down one slot. Slots returned earlier are only valid until the next delete_entry. The required,
+     * lidar/gps and camera name lists are stored as hash indices when the manager is constructed.
+     */
     class EntryManager
     {
         public:
@@ -44,14 +54,27 @@ namespace health_monitor
             /*!
              * \brief Add a new entry if the given name does not exist.
              * Update an existing entry if the given name exists.
+             *
+             * \return The slot of the entry in the list returned by get_entry_list
              */
-            void update_entry(const Entry& entry);
+            size_t update_entry(const Entry& entry);
 
             /*!
              * \brief Get all registed entries as a list.
              */
             std::vector<Entry> get_entries() const;
 
+            /*!
+             * \brief Get a reference to all registered entries in registration order.
+             * The reference is invalidated by update_entry and delete_entry.
+             */
+            const std::vector<Entry>& get_entry_list() const;
+
+            /*!
+             * \brief Get the slot of an entry in get_entry_list using name as the key.
+             */
+            boost::optional<size_t> get_entry_index(const std::string& name) const;
+
             /*!
              * \brief Get a entry using name as the key.
              */
@@ -59,6 +82,7 @@ namespace health_monitor
 
             /*!
              * \brief Delete an entry using the given name as the key.
+             * Entries registered after it move down one slot.
              */
             void delete_entry(const std::string& name);
 
@@ -67,24 +91,34 @@ namespace health_monitor
              */
             bool is_entry_required(const std::string& name) const;
             /*!
-             * \brief Check if the entry is required
+             * \brief Get the position of the entry in the lidar and gps entry list or -1 if it is not in the list
              */
             int is_lidar_gps_entry_required(const std::string& name) const;
 
+            /*!
+             * \brief Get the position of the entry in the camera entry list or -1 if it is not in the list
+             */
             int is_camera_entry_required(const std::string& name) const;
 
         private:
 
+            // Maps each name to its first position in the provided list
+            static std::unordered_map<std::string, int> build_position_index(const std::vector<std::string>& names);
+
             // private list to keep track of all entries
             std::vector<Entry> entry_list_;
 
-            // list of required entries
-            std::vector<std::string> required_entries_;
+            // slot of each entry in entry_list_ by name
+            std::unordered_map<std::string, size_t> entry_index_;
+
+            // set of required entries
+            std::unordered_set<std::string> required_entries_;
 
-            // list of lidar and gps entries 
-            std::vector<std::string> lidar_gps_entries_; 
+            // position of each lidar and gps entry in the configured list
+            std::unordered_map<std::string, int> lidar_gps_entries_;
 
-            std::vector<std::string> camera_entries_; 
+            // position of each camera entry in the configured list
+            std::unordered_map<std::string, int> camera_entries_;
 
     };
 }
\ No newline at end of file
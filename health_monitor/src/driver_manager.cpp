@@ -15,6 +15,7 @@
  */
 
 #include "driver_manager.h"
+#include <algorithm>
 namespace health_monitor
 {
 
@@ -27,12 +28,31 @@ namespace health_monitor
     void DriverManager::update_driver_status(const cav_msgs::DriverStatusConstPtr& msg, long current_time)
     {
         Entry driver_status(msg->status == cav_msgs::DriverStatus::OPERATIONAL || msg->status == cav_msgs::DriverStatus::DEGRADED,true, msg->name, current_time, 0, "");
-        em_.update_entry(driver_status);
+
+        boost::optional<size_t> previous_slot = em_.get_entry_index(msg->name);
+        // A repeat of an available and fresh status cannot change the critical driver status
+        bool changed = true;
+        if(previous_slot)
+        {
+            const Entry& previous = em_.get_entry_list()[*previous_slot];
+            changed = previous.available_ != driver_status.available_ || current_time - previous.timestamp_ > driver_timeout_;
+        }
+
+        size_t slot = em_.update_entry(driver_status);
+        if(!previous_slot)
+        {
+            register_driver(slot, msg->name);
+        }
+        else if(changed && is_group_driver(slot))
+        {
+            status_dirty_ = true;
+        }
+
         // NOTE: The following is a temporary hack to allow the lidar driver to be moved to ROS2 which will not use this node
         Entry fake_entry(msg->status == cav_msgs::DriverStatus::OPERATIONAL,true, msg->name, current_time, 0, "");
     }
 
-    void DriverManager::evaluate_sensor(int &sensor_input,bool available,long current_time,long timestamp,long driver_timeout)
+    void DriverManager::evaluate_sensor(int &sensor_input,bool available,long current_time,long timestamp,long driver_timeout) const
     {
         if((!available) || (current_time-timestamp > driver_timeout))
         {
@@ -44,40 +64,96 @@ namespace health_monitor
         }
     }
 
-    std::string DriverManager::are_critical_drivers_operational_truck(long current_time)
+    void DriverManager::register_driver(size_t slot, const std::string& name)
     {
-        int ssc=0;
-        int lidar1=0;
-        int lidar2=0;
-        int gps=0;
-        int camera=0; //Add Camera Driver
+        // Mirrors the order of the checks in the original scan over all drivers, where the last registered match of a group wins
+        int index = static_cast<int>(slot);
+        if(em_.is_entry_required(name))
+        {
+            truck_groups_.ssc = index;
+            car_groups_.ssc = index;
+        }
 
-        std::vector<Entry> driver_list = em_.get_entries(); //Real time driver list from driver status
-        for(auto i = driver_list.begin(); i < driver_list.end(); ++i)
+        int lidar_gps = em_.is_lidar_gps_entry_required(name);
+        int camera = em_.is_camera_entry_required(name);
+
+        if(lidar_gps == 0) truck_groups_.lidar1 = index;
+        else if(lidar_gps == 1) truck_groups_.lidar2 = index;
+        else if(lidar_gps == 2) truck_groups_.gps = index;
+        else if(camera == 0) truck_groups_.camera = index;
+
+        if(lidar_gps == 0) car_groups_.lidar = index;
+        else if(lidar_gps == 1) car_groups_.gps = index;
+        else if(camera == 0) car_groups_.camera = index;
+
+        if(is_group_driver(index))
         {
-            if(em_.is_entry_required(i->name_))
-            {
-              evaluate_sensor(ssc,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
+            status_dirty_ = true;
+        }
+    }
 
-            if(em_.is_lidar_gps_entry_required(i->name_)==0) //Lidar1
-            {
-               evaluate_sensor(lidar1,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
-            else if(em_.is_lidar_gps_entry_required(i->name_)==1) //Lidar2
-            {
-              evaluate_sensor(lidar2,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
-            else if(em_.is_lidar_gps_entry_required(i->name_)==2) //GPS
-            {
-              evaluate_sensor(gps,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
-            else if(em_.is_camera_entry_required(i->name_)==0)
+    bool DriverManager::is_group_driver(int slot) const
+    {
+        return slot == truck_groups_.ssc || slot == truck_groups_.lidar1 || slot == truck_groups_.lidar2 || slot == truck_groups_.gps
+            || slot == truck_groups_.camera || slot == car_groups_.lidar || slot == car_groups_.gps || slot == car_groups_.camera;
+    }
+
+    int DriverManager::evaluate_group(int slot, long current_time) const
+    {
+        if(slot < 0)
+        {
+            return 0;
+        }
+
+        const Entry& driver = em_.get_entry_list()[slot];
+        int sensor_input = 0;
+        evaluate_sensor(sensor_input, driver.available_, current_time, driver.timestamp_, driver_timeout_);
+        return sensor_input;
+    }
+
+    long DriverManager::next_group_timeout(bool truck, long current_time) const
+    {
+        std::vector<int> slots;
+        if(truck)
+        {
+            slots = { truck_groups_.ssc, truck_groups_.lidar1, truck_groups_.lidar2, truck_groups_.gps, truck_groups_.camera };
+        }
+        else
+        {
+            slots = { car_groups_.ssc, car_groups_.lidar, car_groups_.gps, car_groups_.camera };
+        }
+
+        long valid_until = LONG_MAX;
+        for(int slot : slots)
+        {
+            if(evaluate_group(slot, current_time) == 1)
             {
-                evaluate_sensor(camera,i->available_,current_time,i->timestamp_,driver_timeout_);
+                // The driver times out once current_time - timestamp exceeds the timeout
+                valid_until = std::min(valid_until, em_.get_entry_list()[slot].timestamp_ + driver_timeout_);
             }
-            
         }
+        return valid_until;
+    }
+
+    std::string DriverManager::critical_driver_status(bool truck, long current_time)
+    {
+        if(status_dirty_ || status_truck_ != truck || current_time > status_valid_until_)
+        {
+            status_ = truck ? are_critical_drivers_operational_truck(current_time) : are_critical_drivers_operational_car(current_time);
+            status_truck_ = truck;
+            status_valid_until_ = next_group_timeout(truck, current_time);
+            status_dirty_ = false;
+        }
+        return status_;
+    }
+
+    std::string DriverManager::are_critical_drivers_operational_truck(long current_time)
+    {
+        int ssc = evaluate_group(truck_groups_.ssc, current_time);
+        int lidar1 = evaluate_group(truck_groups_.lidar1, current_time);
+        int lidar2 = evaluate_group(truck_groups_.lidar2, current_time);
+        int gps = evaluate_group(truck_groups_.gps, current_time);
+        int camera = evaluate_group(truck_groups_.camera, current_time); //Add Camera Driver
 
         //////////////////////
         // NOTE: THIS IS A MANUAL DISABLE OF ALL LIDAR AND GPS FAILURE DETECTION FOLLOWING THE ROS2 PORT
@@ -135,30 +211,10 @@ namespace health_monitor
 
     std::string DriverManager::are_critical_drivers_operational_car(long current_time)
     {
-        int ssc=0;
-        int lidar=0;
-        int gps=0;
-        int camera=0;
-        std::vector<Entry> driver_list = em_.get_entries(); //Real time driver list from driver status
-        for(auto i = driver_list.begin(); i < driver_list.end(); ++i)
-        {
-            if(em_.is_entry_required(i->name_))
-            {
-                evaluate_sensor(ssc,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
-            if(em_.is_lidar_gps_entry_required(i->name_)==0) //Lidar
-            {   
-                evaluate_sensor(lidar,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
-            else if(em_.is_lidar_gps_entry_required(i->name_)==1) //GPS
-            {
-                evaluate_sensor(gps,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
-            else if(em_.is_camera_entry_required(i->name_)==0)
-            {
-                evaluate_sensor(camera,i->available_,current_time,i->timestamp_,driver_timeout_);
-            }
-        }
+        int ssc = evaluate_group(car_groups_.ssc, current_time);
+        int lidar = evaluate_group(car_groups_.lidar, current_time);
+        int gps = evaluate_group(car_groups_.gps, current_time);
+        int camera = evaluate_group(car_groups_.camera, current_time);
 
         //////////////////////
         // NOTE: THIS IS A MANUAL DISABLE OF ALL LIDAR FAILURE DETECTION FOLLOWING THE ROS2 PORT
@@ -214,7 +270,7 @@ namespace health_monitor
 
         if(truck==true)
         {
-            std::string status = are_critical_drivers_operational_truck(time_now);
+            std::string status = critical_driver_status(true, time_now);
             if(status.compare("s_1_l1_1_l2_1_g_1_c_1") == 0)
             {
                 starting_up_ = false;
@@ -280,7 +336,7 @@ namespace health_monitor
         }
         else if(car==true)
         {
-            std::string status = are_critical_drivers_operational_car(time_now);
+            std::string status = critical_driver_status(false, time_now);
             if(status.compare("s_1_l_1_g_1_c_1") == 0)
             {
                 starting_up_ = false;
@@ -22,25 +22,39 @@ namespace health_monitor
 
     EntryManager::EntryManager() {}
 
-    EntryManager::EntryManager(std::vector<std::string> required_entries):required_entries_(required_entries) {} 
+    EntryManager::EntryManager(std::vector<std::string> required_entries):required_entries_(required_entries.begin(), required_entries.end()) {} 
     
     EntryManager::EntryManager(std::vector<std::string> required_entries,std::vector<std::string> lidar_gps_entries, 
-    std::vector<std::string> camera_entries) :required_entries_(required_entries),lidar_gps_entries_(lidar_gps_entries), camera_entries_(camera_entries){}
+    std::vector<std::string> camera_entries) :required_entries_(required_entries.begin(), required_entries.end()),
+                                              lidar_gps_entries_(build_position_index(lidar_gps_entries)),
+                                              camera_entries_(build_position_index(camera_entries)) {}
 
-    void EntryManager::update_entry(const Entry& entry)
+    std::unordered_map<std::string, int> EntryManager::build_position_index(const std::vector<std::string>& names)
     {
-        for(auto i = entry_list_.begin(); i < entry_list_.end(); ++i)
+        std::unordered_map<std::string, int> index;
+        for(int i = 0; i < names.size(); i++)
         {
-            if(i->name_.compare(entry.name_) == 0)
-            {
-                // name and type of the entry wont change
-                i->active_ = entry.active_;
-                i->available_ = entry.available_;
-                i->timestamp_ = entry.timestamp_;
-                return;
-            }
+            // emplace keeps the first position if a name is listed twice
+            index.emplace(names[i], i);
         }
+        return index;
+    }
+
+    size_t EntryManager::update_entry(const Entry& entry)
+    {
+        auto it = entry_index_.find(entry.name_);
+        if(it != entry_index_.end())
+        {
+            Entry& existing = entry_list_[it->second];
+            // name and type of the entry wont change
+            existing.active_ = entry.active_;
+            existing.available_ = entry.available_;
+            existing.timestamp_ = entry.timestamp_;
+            return it->second;
+        }
+        entry_index_.emplace(entry.name_, entry_list_.size());
         entry_list_.push_back(entry);
+        return entry_list_.size() - 1;
     }
 
 
@@ -50,26 +64,44 @@ namespace health_monitor
         return std::vector<Entry>(entry_list_);
     }
 
+    const std::vector<Entry>& EntryManager::get_entry_list() const
+    {
+        return entry_list_;
+    }
+
+    boost::optional<size_t> EntryManager::get_entry_index(const std::string& name) const
+    {
+        auto it = entry_index_.find(name);
+        if(it == entry_index_.end())
+        {
+            return boost::none;
+        }
+        return it->second;
+    }
+
     void EntryManager::delete_entry(const std::string& name)
     {
-        for(auto i = entry_list_.begin(); i < entry_list_.end(); ++i)
+        auto it = entry_index_.find(name);
+        if(it == entry_index_.end())
+        {
+            return;
+        }
+        size_t removed = it->second;
+        entry_list_.erase(entry_list_.begin() + removed);
+        entry_index_.erase(it);
+        // entries after the removed one shift down by one slot
+        for(size_t i = removed; i < entry_list_.size(); ++i)
         {
-            if(i->name_.compare(name) == 0)
-            {
-                entry_list_.erase(i);
-                return;
-            }
+            entry_index_[entry_list_[i].name_] = i;
         }
     }
 
     boost::optional<Entry> EntryManager::get_entry_by_name(const std::string&  name) const
     {
-        for(auto i = entry_list_.begin(); i < entry_list_.end(); ++i)
+        auto it = entry_index_.find(name);
+        if(it != entry_index_.end())
         {
-            if(i->name_.compare(name) == 0)
-            {
-                return *i;
-            }
+            return entry_list_[it->second];
         }
         // use boost::optional because requested entry might not exist
         return boost::none;
@@ -77,43 +109,27 @@ namespace health_monitor
 
     bool EntryManager::is_entry_required(const std::string&  name) const
     {
-        for(auto i = required_entries_.begin(); i < required_entries_.end(); ++i)
-        {
-            if(i->compare(name) == 0)
-            {
-                return true;
-            }
-        }
-        return false;
+        return required_entries_.find(name) != required_entries_.end();
     }
 
     int EntryManager::is_lidar_gps_entry_required(const std::string& name) const
     {
-        
-        for(int i=0;i<lidar_gps_entries_.size();i++)
+        auto it = lidar_gps_entries_.find(name);
+        if(it == lidar_gps_entries_.end())
         {
-            if(lidar_gps_entries_[i].compare(name) == 0)
-            {
-                return i;
-            }
-
+            return -1;
         }
-
-        return -1;
+        return it->second;
     }
 
     int EntryManager::is_camera_entry_required(const std::string& name) const
     {
-        for(int i = 0;i < camera_entries_.size(); i++)
+        auto it = camera_entries_.find(name);
+        if(it == camera_entries_.end())
         {
-            if(camera_entries_[i].compare(name) == 0)
-            {
-                return i;
-            }
+            return -1;
         }
-        
-        // default like above?
-        return -1;
+        return it->second;
     }
 
 }
@@ -31,7 +31,7 @@ namespace health_monitor
 
     void PluginManager::get_registered_plugins(cav_srvs::PluginListResponse& res)
     {
-        std::vector<Entry> plugins = em_.get_entries();
+        const std::vector<Entry>& plugins = em_.get_entry_list();
         // convert to plugin list
         for(auto i = plugins.begin(); i < plugins.end(); ++i)
         {
@@ -46,7 +46,7 @@ namespace health_monitor
 
     void PluginManager::get_active_plugins(cav_srvs::PluginListResponse& res)
     {
-        std::vector<Entry> plugins = em_.get_entries();
+        const std::vector<Entry>& plugins = em_.get_entry_list();
         // convert to plugin list
         for(auto i = plugins.begin(); i < plugins.end(); ++i)
         {
@@ -94,7 +94,7 @@ namespace health_monitor
 
     bool PluginManager::get_tactical_plugins_by_capability(cav_srvs::GetPluginApiRequest& req, cav_srvs::GetPluginApiResponse& res)
     {
-        for(const auto& plugin : em_.get_entries())
+        for(const auto& plugin : em_.get_entry_list())
         {
             if(plugin.type_ == cav_msgs::Plugin::TACTICAL &&
                (req.capability.size() == 0 || (plugin.capability_.compare(0, req.capability.size(), req.capability) == 0 && plugin.active_ && plugin.available_)))
@@ -107,7 +107,7 @@ namespace health_monitor
 
     bool PluginManager::get_strategic_plugins_by_capability(cav_srvs::GetPluginApiRequest& req, cav_srvs::GetPluginApiResponse& res)
     {
-        for(const auto& plugin : em_.get_entries())
+        for(const auto& plugin : em_.get_entry_list())
         {
             if(plugin.type_ == cav_msgs::Plugin::STRATEGIC && 
                 (req.capability.size() == 0 || (plugin.capability_.compare(0, req.capability.size(), req.capability) == 0 && plugin.active_ && plugin.available_)))
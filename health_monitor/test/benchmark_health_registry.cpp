@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark of the driver and plugin registries with many drivers and plugins reporting at a high rate.
+ * Every driver and plugin reports once per status period and the health monitor spins at 10 Hz.
+ *
+ * Run with: rosrun health_monitor health_monitor-registry-benchmark [driver_count] [plugin_count] [status_rate_hz]
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "driver_manager.h"
+#include "plugin_manager.h"
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile size_t g_sink = 0;
+
+double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int driver_count = argc > 1 ? std::stoi(argv[1]) : 400;
+  const int plugin_count = argc > 2 ? std::stoi(argv[2]) : 300;
+  const int status_rate_hz = argc > 3 ? std::stoi(argv[3]) : 50;
+  const int simulated_seconds = 10;
+  const int spin_rate_hz = 10;
+
+  // The critical drivers report last so that every scan over the registry has to reach them
+  std::vector<std::string> required_drivers{ "controller" };
+  std::vector<std::string> lidar_gps_drivers{ "lidar1", "lidar2", "gps" };
+  std::vector<std::string> camera_drivers{ "camera" };
+
+  std::vector<cav_msgs::DriverStatusConstPtr> driver_msgs;
+  for (int i = 0; i < driver_count; i++)
+  {
+    cav_msgs::DriverStatus msg;
+    msg.name = "/hardware_interface/sensor_" + std::to_string(i);
+    msg.status = cav_msgs::DriverStatus::OPERATIONAL;
+    driver_msgs.emplace_back(new cav_msgs::DriverStatus(msg));
+  }
+  for (const auto& name : { "controller", "lidar1", "lidar2", "gps", "camera" })
+  {
+    cav_msgs::DriverStatus msg;
+    msg.name = name;
+    msg.status = cav_msgs::DriverStatus::OPERATIONAL;
+    driver_msgs.emplace_back(new cav_msgs::DriverStatus(msg));
+  }
+
+  std::vector<std::string> required_plugins{ "route_following_plugin", "inlanecruising_plugin", "pure_pursuit_wrapper" };
+  std::vector<cav_msgs::PluginConstPtr> plugin_msgs;
+  for (int i = 0; i < plugin_count; i++)
+  {
+    cav_msgs::Plugin msg;
+    msg.name = i < required_plugins.size() ? required_plugins[i] : "plugin_" + std::to_string(i);
+    msg.type = i % 2 == 0 ? cav_msgs::Plugin::TACTICAL : cav_msgs::Plugin::STRATEGIC;
+    msg.available = true;
+    msg.activated = true;
+    msg.capability = "tactical_plan/plan_trajectory";
+    plugin_msgs.emplace_back(new cav_msgs::Plugin(msg));
+  }
+
+  health_monitor::DriverManager dm(required_drivers, 1000L, lidar_gps_drivers, camera_drivers);
+  health_monitor::PluginManager pm(required_plugins, "/guidance/plugins/", "/plan_maneuvers", "/plan_trajectory");
+
+  const long status_period_ms = 1000 / status_rate_hz;
+  const long spin_period_ms = 1000 / spin_rate_hz;
+
+  double driver_update_ms = 0, plugin_update_ms = 0, spin_ms = 0, query_ms = 0;
+  size_t driver_updates = 0, plugin_updates = 0, spins = 0, queries = 0;
+
+  for (long time = 0; time < simulated_seconds * 1000; time += status_period_ms)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& msg : driver_msgs)
+    {
+      dm.update_driver_status(msg, time);
+    }
+    driver_update_ms += elapsedMs(start);
+    driver_updates += driver_msgs.size();
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& msg : plugin_msgs)
+    {
+      pm.update_plugin_status(msg);
+    }
+    plugin_update_ms += elapsedMs(start);
+    plugin_updates += plugin_msgs.size();
+
+    if (time % spin_period_ms == 0)
+    {
+      start = std::chrono::steady_clock::now();
+      cav_msgs::SystemAlert alert = dm.handleSpin(false, true, time, 0, 0);
+      spin_ms += elapsedMs(start);
+      g_sink += alert.type;
+      spins++;
+
+      // The arbitrator and plan delegator query the available plugins at roughly the spin rate
+      start = std::chrono::steady_clock::now();
+      cav_srvs::GetPluginApiRequest req;
+      req.capability = "tactical_plan";
+      cav_srvs::GetPluginApiResponse res;
+      pm.get_tactical_plugins_by_capability(req, res);
+      cav_srvs::PluginListResponse list;
+      pm.get_active_plugins(list);
+      query_ms += elapsedMs(start);
+      g_sink += res.plan_service.size() + list.plugins.size();
+      queries++;
+    }
+  }
+
+  std::cout << driver_count + 5 << " drivers and " << plugin_count << " plugins reporting at " << status_rate_hz << " Hz" << std::endl;
+  std::cout << "driver status update: " << 1e6 * driver_update_ms / driver_updates << " ns per message" << std::endl;
+  std::cout << "plugin status update: " << 1e6 * plugin_update_ms / plugin_updates << " ns per message" << std::endl;
+  std::cout << "driver alert spin:    " << 1e3 * spin_ms / spins << " us per spin" << std::endl;
+  std::cout << "plugin queries:       " << 1e3 * query_ms / queries << " us per query" << std::endl;
+  std::cout << "total:                " << driver_update_ms + plugin_update_ms + spin_ms + query_ms << " ms for "
+            << simulated_seconds << " s of traffic" << std::endl;
+
+  return 0;
+}
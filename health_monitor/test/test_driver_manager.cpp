@@ -1800,4 +1800,54 @@ namespace health_monitor
         EXPECT_EQ(6, alert.type);
     }
 
+    TEST(DriverManagerTest, testCarHandleSpinStatusChangesAndTimeout)
+    {
+        std::vector<std::string> required_drivers{"controller"};
+        std::vector<std::string> lidar_gps_drivers{"lidar","gps"};
+        std::vector<std::string> camera_drivers{"camera"};
+
+        DriverManager dm(required_drivers, 1000L,lidar_gps_drivers,camera_drivers);
+
+        auto report = [&dm](const std::string& name, uint8_t status, long time) {
+            cav_msgs::DriverStatus msg;
+            msg.name = name;
+            msg.status = status;
+            cav_msgs::DriverStatusConstPtr msg_pointer(new cav_msgs::DriverStatus(msg));
+            dm.update_driver_status(msg_pointer, time);
+        };
+
+        report("controller", cav_msgs::DriverStatus::OPERATIONAL, 1000);
+        report("lidar", cav_msgs::DriverStatus::OPERATIONAL, 1000);
+        report("gps", cav_msgs::DriverStatus::OPERATIONAL, 1000);
+        report("camera", cav_msgs::DriverStatus::OPERATIONAL, 1000);
+        for (int i = 0; i < 50; i++)
+        {
+            report("unrelated_driver_" + std::to_string(i), cav_msgs::DriverStatus::OFF, 1000);
+        }
+
+        EXPECT_EQ(cav_msgs::SystemAlert::DRIVERS_READY, dm.handleSpin(false,true,1500,150,750).type);
+
+        // Camera failure is picked up on the next spin
+        report("camera", cav_msgs::DriverStatus::FAULT, 1600);
+        EXPECT_EQ(cav_msgs::SystemAlert::SHUTDOWN, dm.handleSpin(false,true,1700,150,750).type);
+
+        report("camera", cav_msgs::DriverStatus::OPERATIONAL, 1800);
+        EXPECT_EQ(cav_msgs::SystemAlert::DRIVERS_READY, dm.handleSpin(false,true,1900,150,750).type);
+
+        // The controller last reported at 1000 so it times out after 2000 without any new status
+        EXPECT_EQ(cav_msgs::SystemAlert::DRIVERS_READY, dm.handleSpin(false,true,2000,150,750).type);
+        EXPECT_EQ(cav_msgs::SystemAlert::SHUTDOWN, dm.handleSpin(false,true,2001,150,750).type);
+        EXPECT_EQ("s_0", dm.are_critical_drivers_operational_car(2001));
+
+        // A timed out driver recovers as soon as it reports again
+        report("controller", cav_msgs::DriverStatus::OPERATIONAL, 2100);
+        report("camera", cav_msgs::DriverStatus::OPERATIONAL, 2100);
+        EXPECT_EQ(cav_msgs::SystemAlert::DRIVERS_READY, dm.handleSpin(false,true,2200,150,750).type);
+
+        // Evaluating the truck status directly does not disturb the cached car status
+        report("camera", cav_msgs::DriverStatus::OFF, 2300);
+        EXPECT_EQ("s_1_l1_1_l2_1_g_1_c_0", dm.are_critical_drivers_operational_truck(2300));
+        EXPECT_EQ("Camera Failed", dm.handleSpin(false,true,2300,150,750).description);
+    }
+
 }
\ No newline at end of file
@@ -158,5 +158,29 @@ namespace health_monitor
         EXPECT_EQ(1, em.is_lidar_gps_entry_required("gps"));
         EXPECT_EQ(0, em.is_camera_entry_required("camera"));
     }
+
+    TEST(EntryManagerTest, testEntryIndexAfterDelete)
+    {
+        EntryManager em;
+        em.update_entry(Entry(true, false, "plugin_a", 1000, 1, ""));
+        em.update_entry(Entry(true, false, "plugin_b", 1000, 1, ""));
+        EXPECT_EQ(2, em.update_entry(Entry(true, false, "plugin_c", 1000, 1, "")));
+        EXPECT_EQ(1, em.update_entry(Entry(false, true, "plugin_b", 2000, 1, "")));
+
+        em.delete_entry("plugin_a");
+        em.delete_entry("unknown_plugin");
+
+        ASSERT_EQ(2, em.get_entry_list().size());
+        EXPECT_FALSE(!!em.get_entry_index("plugin_a"));
+        ASSERT_TRUE(!!em.get_entry_index("plugin_b"));
+        ASSERT_TRUE(!!em.get_entry_index("plugin_c"));
+        EXPECT_EQ(0, *em.get_entry_index("plugin_b"));
+        EXPECT_EQ(1, *em.get_entry_index("plugin_c"));
+        EXPECT_EQ(2000, em.get_entry_list()[*em.get_entry_index("plugin_b")].timestamp_);
+
+        // Re-registering a deleted entry appends it
+        EXPECT_EQ(2, em.update_entry(Entry(true, false, "plugin_a", 3000, 1, "")));
+        EXPECT_EQ("plugin_a", em.get_entry_by_name("plugin_a")->name_);
+    }
     
 }
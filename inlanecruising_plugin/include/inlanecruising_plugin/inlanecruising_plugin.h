@@ -25,6 +25,7 @@
 #include <boost/geometry.hpp>
 #include <carma_wm/Geometry.h>
 #include <basic_autonomy/basic_autonomy.h>
+#include <basic_autonomy/trajectory_generation_engine.h>
 #include <cav_srvs/PlanTrajectory.h>
 #include <carma_wm/WMListener.h>
 #include <carma_debug_msgs/TrajectoryCurvatureSpeeds.h>
@@ -40,6 +41,7 @@ namespace inlanecruising_plugin
 using PublishPluginDiscoveryCB = std::function<void(const cav_msgs::Plugin&)>;
 using DebugPublisher = std::function<void(const carma_debug_msgs::TrajectoryCurvatureSpeeds&)>;
 using PointSpeedPair = basic_autonomy::waypoint_generation::PointSpeedPair;
+using WorldModelProvider = std::function<carma_wm::WorldModelConstPtr()>;
 
 /**
  * \brief Class containing primary business logic for the In-Lane Cruising Plugin
@@ -59,6 +61,17 @@ public:
   InLaneCruisingPlugin(carma_wm::WorldModelConstPtr wm, InLaneCruisingPluginConfig config,
                        PublishPluginDiscoveryCB plugin_discovery_publisher, DebugPublisher debug_publisher=[](const auto& msg){});
 
+  /**
+   * \brief Constructor which queries the world model to plan with at the start of each planning request
+   * 
+   * \param wm_provider Callback returning the world model to use for one plan, such as WMListener::getWorldModelSnapshot
+   * \param config The configuration to be used for this object
+   * \param plugin_discovery_publisher Callback which will publish the current plugin discovery state
+   * \param debug_publisher Callback which will publish a debug message. The callback defaults to no-op.
+   */ 
+  InLaneCruisingPlugin(WorldModelProvider wm_provider, InLaneCruisingPluginConfig config,
+                       PublishPluginDiscoveryCB plugin_discovery_publisher, DebugPublisher debug_publisher=[](const auto& msg){});
+
   /**
    * \brief Service callback for trajectory planning
    * 
@@ -96,7 +109,7 @@ public:
   
 private:
 
-  carma_wm::WorldModelConstPtr wm_;
+  WorldModelProvider wm_provider_;
   InLaneCruisingPluginConfig config_;
   PublishPluginDiscoveryCB plugin_discovery_publisher_;
   ros::ServiceClient yield_client_;
@@ -105,6 +118,9 @@ private:
   DebugPublisher debug_publisher_;
   carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg_;
 
+  // Reuses route lanelets, centerlines and spline fits between consecutive plans
+  basic_autonomy::waypoint_generation::TrajectoryGenerationEngine trajectory_engine_;
+
 };
 
 
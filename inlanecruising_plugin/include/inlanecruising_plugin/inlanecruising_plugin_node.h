@@ -43,8 +43,8 @@ public:
     ros::CARMANodeHandle nh;
     ros::CARMANodeHandle pnh("~");
 
-    carma_wm::WMListener wml;
-    auto wm_ = wml.getWorldModel();
+    // Map updates are applied in the background while each plan uses an immutable snapshot of the world model
+    carma_wm::WMListener wml(true, true);
 
     ros::Publisher discovery_pub = nh.advertise<cav_msgs::Plugin>("plugin_discovery", 1);
     ros::Publisher trajectory_debug_pub = pnh.advertise<carma_debug_msgs::TrajectoryCurvatureSpeeds>("debug/trajectory_planning", 1);
@@ -81,7 +81,7 @@ public:
 
     ROS_INFO_STREAM("InLaneCruisingPlugin Params After Accel Change" << config);
     
-    InLaneCruisingPlugin worker(wm_, config, [&discovery_pub](const auto& msg) { discovery_pub.publish(msg); },
+    InLaneCruisingPlugin worker([&wml]() { return wml.getWorldModelSnapshot(); }, config, [&discovery_pub](const auto& msg) { discovery_pub.publish(msg); },
                                              [&trajectory_debug_pub](const auto& msg) { trajectory_debug_pub.publish(msg); });
 
     ros::ServiceServer trajectory_srv_ = nh.advertiseService("plugins/InLaneCruisingPlugin/plan_trajectory",
@@ -40,7 +40,13 @@ namespace inlanecruising_plugin
 {
 InLaneCruisingPlugin::InLaneCruisingPlugin(carma_wm::WorldModelConstPtr wm, InLaneCruisingPluginConfig config,
                                            PublishPluginDiscoveryCB plugin_discovery_publisher, DebugPublisher debug_publisher)
-  : wm_(wm), config_(config), plugin_discovery_publisher_(plugin_discovery_publisher), debug_publisher_(debug_publisher)
+  : InLaneCruisingPlugin([wm]() { return wm; }, config, plugin_discovery_publisher, debug_publisher)
+{
+}
+
+InLaneCruisingPlugin::InLaneCruisingPlugin(WorldModelProvider wm_provider, InLaneCruisingPluginConfig config,
+                                           PublishPluginDiscoveryCB plugin_discovery_publisher, DebugPublisher debug_publisher)
+  : wm_provider_(wm_provider), config_(config), plugin_discovery_publisher_(plugin_discovery_publisher), debug_publisher_(debug_publisher)
 {
   plugin_discovery_msg_.name = "InLaneCruisingPlugin";
   plugin_discovery_msg_.version_id = "v1.0";
@@ -61,8 +67,11 @@ bool InLaneCruisingPlugin::plan_trajectory_cb(cav_srvs::PlanTrajectoryRequest& r
 {
    ros::WallTime start_time = ros::WallTime::now();  // Start timeing the execution time for planning so it can be logged
 
+  // Every query of this plan uses the same world model, so map updates received while planning cannot mix into it
+  carma_wm::WorldModelConstPtr wm = wm_provider_();
+
   lanelet::BasicPoint2d veh_pos(req.vehicle_state.x_pos_global, req.vehicle_state.y_pos_global);
-  double current_downtrack = wm_->routeTrackPos(veh_pos).downtrack;
+  double current_downtrack = wm->routeTrackPos(veh_pos).downtrack;
 
   // Only plan the trajectory for the initial LANE_FOLLOWING maneuver and any immediately sequential maneuvers of the same type
   std::vector<cav_msgs::Maneuver> maneuver_plan;
@@ -94,8 +103,8 @@ bool InLaneCruisingPlugin::plan_trajectory_cb(cav_srvs::PlanTrajectoryRequest& r
                                                                             config_.curvature_moving_average_window_size, config_.back_distance,
                                                                             config_.buffer_ending_downtrack);
   
-  auto points_and_target_speeds = basic_autonomy::waypoint_generation::create_geometry_profile(maneuver_plan, std::max((double)0, current_downtrack - config_.back_distance),
-                                                                         wm_, ending_state_before_buffer_, req.vehicle_state, wpg_general_config, wpg_detail_config);
+  auto points_and_target_speeds = trajectory_engine_.create_geometry_profile(maneuver_plan, std::max((double)0, current_downtrack - config_.back_distance),
+                                                                         wm, ending_state_before_buffer_, req.vehicle_state, wpg_general_config, wpg_detail_config);
 
   ROS_DEBUG_STREAM("points_and_target_speeds: " << points_and_target_speeds.size());
 
@@ -106,8 +115,8 @@ bool InLaneCruisingPlugin::plan_trajectory_cb(cav_srvs::PlanTrajectoryRequest& r
   original_trajectory.header.stamp = ros::Time::now();
   original_trajectory.trajectory_id = boost::uuids::to_string(boost::uuids::random_generator()());
 
-  original_trajectory.trajectory_points = basic_autonomy:: waypoint_generation::compose_lanefollow_trajectory_from_path(points_and_target_speeds, 
-                                                                                req.vehicle_state, req.header.stamp, wm_, ending_state_before_buffer_, debug_msg_, 
+  original_trajectory.trajectory_points = trajectory_engine_.compose_lanefollow_trajectory_from_path(points_and_target_speeds, 
+                                                                                req.vehicle_state, req.header.stamp, wm, ending_state_before_buffer_, debug_msg_, 
                                                                                 wpg_detail_config); // Compute the trajectory
   original_trajectory.initial_longitudinal_velocity = std::max(req.vehicle_state.longitudinal_vel, config_.minimum_speed);
 
@@ -36,6 +36,7 @@
 #include <cav_msgs/Maneuver.h>
 #include <basic_autonomy/basic_autonomy.h>
 #include <basic_autonomy/helper_functions.h>
+#include <basic_autonomy/trajectory_generation_engine.h>
 
 
 /**
@@ -252,6 +253,9 @@ public:
   cav_msgs::Plugin plugin_discovery_msg_;
   carma_debug_msgs::TrajectoryCurvatureSpeeds debug_msg_;
 
+  // Reuses route lanelets, centerlines and spline fits between consecutive plans
+  basic_autonomy::waypoint_generation::TrajectoryGenerationEngine trajectory_engine_;
+
   std::string light_controlled_intersection_strategy_ = "Carma/light_controlled_intersection";
 
   double epsilon_ = 0.001; //Small constant to compare (double) 0.0 with
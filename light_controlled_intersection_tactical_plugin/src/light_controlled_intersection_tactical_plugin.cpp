@@ -131,7 +131,7 @@ bool LightControlledIntersectionTacticalPlugin::plan_trajectory_cb(cav_srvs::Pla
     trajectory.trajectory_id = boost::uuids::to_string(boost::uuids::random_generator()());
 
     // Compose smooth trajectory/speed by resampling
-    trajectory.trajectory_points = basic_autonomy:: waypoint_generation::compose_lanefollow_trajectory_from_path(points_and_target_speeds, 
+    trajectory.trajectory_points = trajectory_engine_.compose_lanefollow_trajectory_from_path(points_and_target_speeds, 
                                                                                 req.vehicle_state, req.header.stamp, wm_, ending_state_before_buffer_, debug_msg_, 
                                                                                 wpg_detail_config); // Compute the trajectory
     trajectory.initial_longitudinal_velocity = req.vehicle_state.longitudinal_vel;
@@ -240,7 +240,7 @@ std::vector<PointSpeedPair> LightControlledIntersectionTacticalPlugin::create_ge
       cav_msgs::Maneuver temp_maneuver = maneuver;
       temp_maneuver.type =cav_msgs::Maneuver::LANE_FOLLOWING;
       ROS_DEBUG_STREAM("Creating Lane Follow Geometry");
-      std::vector<PointSpeedPair> lane_follow_points = basic_autonomy::waypoint_generation::create_lanefollow_geometry(maneuver, starting_downtrack, wm, ending_state_before_buffer, general_config, detailed_config, visited_lanelets);
+      std::vector<PointSpeedPair> lane_follow_points = trajectory_engine_.create_lanefollow_geometry(maneuver, starting_downtrack, wm, ending_state_before_buffer, general_config, detailed_config, visited_lanelets);
       points_and_target_speeds.insert(points_and_target_speeds.end(), lane_follow_points.begin(), lane_follow_points.end());
       
       break; // expected to receive only one maneuver to plan
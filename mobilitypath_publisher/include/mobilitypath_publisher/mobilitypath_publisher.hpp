@@ -21,7 +21,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/shared_ptr.hpp>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <ecef_projection/batch_projector.h>
 #include <bsm_helper/bsm_helper.h>
 #include <std_msgs/msg/string.hpp>
 #include <carma_planning_msgs/msg/trajectory_plan.hpp>
@@ -68,7 +68,7 @@ namespace mobilitypath_publisher
     carma_v2x_msgs::msg::BSMCoreData bsm_core_;
 
     // Map projection string, which defines the lat/lon -> map conversion
-    std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+    std::shared_ptr<const ecef_projection::BatchProjector> map_projector_;
 
     // Recipient's static ID (Empty string indicates a broadcast message)
     std::string recipient_id = "";
@@ -115,6 +115,13 @@ namespace mobilitypath_publisher
      */
     carma_v2x_msgs::msg::LocationECEF trajectory_point_to_ECEF(const carma_planning_msgs::msg::TrajectoryPlanPoint& traj_point) const;
 
+    /**
+     * \brief Converts a projected ECEF point to a LocationECEF message (accepts meters and outputs in cm)
+     * \param ecef_point The ECEF point
+     * \return The LocationECEF message
+     */
+    carma_v2x_msgs::msg::LocationECEF ecef_point_to_location(const lanelet::BasicPoint3d& ecef_point) const;
+
   public:
     /**
      * \brief MobilityPathPublication constructor 
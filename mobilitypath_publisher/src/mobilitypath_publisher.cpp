@@ -14,6 +14,7 @@
  * the License.
  */
 #include "mobilitypath_publisher/mobilitypath_publisher.hpp"
+#include <algorithm>
 
 namespace mobilitypath_publisher
 {
@@ -93,7 +94,7 @@ namespace mobilitypath_publisher
   void MobilityPathPublication::georeference_cb(const std_msgs::msg::String::UniquePtr msg)
   {
     // Build projector from proj string
-    map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());
+    map_projector_ = ecef_projection::BatchProjector::forGeoreference(msg->data);
   }
 
   void MobilityPathPublication::trajectory_cb(const carma_planning_msgs::msg::TrajectoryPlan::UniquePtr msg)
@@ -147,7 +148,21 @@ namespace mobilitypath_publisher
       throw std::invalid_argument("Received an empty vector of Trajectory Plan Points");
     }
 
-    carma_v2x_msgs::msg::LocationECEF ecef_location = trajectory_point_to_ECEF(traj_points[0]); //m to cm to fit the msg standard 
+    if (!map_projector_) {
+      throw std::invalid_argument("No map projector available for ecef conversion");
+    }
+
+    // Project every point which will be published in one batch. The message carries the location and at most 60 offsets
+    const size_t point_count = std::min(traj_points.size(), static_cast<size_t>(61));
+    std::vector<lanelet::BasicPoint3d> map_points;
+    map_points.reserve(point_count);
+    for (size_t i = 0; i < point_count; i++) {
+      map_points.emplace_back(traj_points[i].x, traj_points[i].y, 0.0);
+    }
+    std::vector<lanelet::BasicPoint3d> ecef_points;
+    map_projector_->mapToEcef(map_points, ecef_points);
+
+    carma_v2x_msgs::msg::LocationECEF ecef_location = ecef_point_to_location(ecef_points[0]); //m to cm to fit the msg standard 
 
     if (traj_points.size() < 2){
       RCLCPP_WARN_STREAM(this->get_logger(), "Received Trajectory Plan is too small");
@@ -155,16 +170,15 @@ namespace mobilitypath_publisher
     }
     else{
       carma_v2x_msgs::msg::LocationECEF prev_point = ecef_location;
-      for (size_t i=1; i<traj_points.size(); i++){
+      for (size_t i=1; i<point_count; i++){
                 
         carma_v2x_msgs::msg::LocationOffsetECEF offset;
-        carma_v2x_msgs::msg::LocationECEF new_point = trajectory_point_to_ECEF(traj_points[i]); //m to cm to fit the msg standard
+        carma_v2x_msgs::msg::LocationECEF new_point = ecef_point_to_location(ecef_points[i]); //m to cm to fit the msg standard
         offset.offset_x = (int16_t)(new_point.ecef_x - prev_point.ecef_x);  
         offset.offset_y = (int16_t)(new_point.ecef_y - prev_point.ecef_y);
         offset.offset_z = (int16_t)(new_point.ecef_z - prev_point.ecef_z);
         prev_point = new_point;
         traj.offsets.push_back(offset);
-        if( i >= 60 ){ break;};
       }
     }
 
@@ -178,9 +192,12 @@ namespace mobilitypath_publisher
     if (!map_projector_) {
       throw std::invalid_argument("No map projector available for ecef conversion");
     }
+    return ecef_point_to_location(map_projector_->mapToEcef({traj_point.x, traj_point.y, 0.0}));
+  }
+
+  carma_v2x_msgs::msg::LocationECEF MobilityPathPublication::ecef_point_to_location(const lanelet::BasicPoint3d& ecef_point) const
+  {
     carma_v2x_msgs::msg::LocationECEF location;    
-        
-    lanelet::BasicPoint3d ecef_point = map_projector_->projectECEF({traj_point.x, traj_point.y, 0.0}, 1);
     location.ecef_x = ecef_point.x() * 100.0;
     location.ecef_y = ecef_point.y() * 100.0;
     location.ecef_z = ecef_point.z() * 100.0;
@@ -118,7 +118,7 @@ namespace mobilitypath_visualizer {
 
     void MobilityPathVisualizer::georeferenceCallback(std_msgs::msg::String::UniquePtr msg) 
     {
-        map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());  // Build projector from proj string
+        map_projector_ = ecef_projection::BatchProjector::forGeoreference(msg->data);  // Build projector from proj string
     }
     
     void MobilityPathVisualizer::callbackMobilityPath(carma_v2x_msgs::msg::MobilityPath::UniquePtr msg)
@@ -187,22 +187,37 @@ namespace mobilitypath_visualizer {
         
         size_t count = std::max(prev_marker_list_size_[msg.m_header.sender_id], msg.trajectory.offsets.size());
 
-        auto curr_location_msg = msg; //variable to update on each iteration as offsets are measured since last traj point
-        
-        marker.id = 0;
-        geometry_msgs::msg::Point arrow_start;
-        RCLCPP_DEBUG_STREAM(get_logger(), "ECEF point x: " << curr_location_msg.trajectory.location.ecef_x << ", y:" << curr_location_msg.trajectory.location.ecef_y);
-        arrow_start = ECEFToMapPoint(curr_location_msg.trajectory.location); //also convert from cm to m
-        RCLCPP_DEBUG_STREAM(get_logger(), "Map point x: " << arrow_start.x << ", y:" << arrow_start.y);
+        if (!map_projector_) {
+            throw std::invalid_argument("No map projector available for ecef conversion");
+        }
+
+        // Project the whole trajectory at once. Offsets are measured from the previous point so marker i is the arrow from chain point i to chain point i + 1
+        lanelet::BasicPoint3d ecef_location((double)msg.trajectory.location.ecef_x/100.0, (double)msg.trajectory.location.ecef_y/100.0, (double)msg.trajectory.location.ecef_z/100.0); //convert from cm to m
+        std::vector<lanelet::BasicPoint3d> ecef_offsets;
+        ecef_offsets.reserve(msg.trajectory.offsets.size());
+        for (const auto& offset : msg.trajectory.offsets)
+        {
+            ecef_offsets.emplace_back(offset.offset_x/100.0, offset.offset_y/100.0, offset.offset_z/100.0);
+        }
+        RCLCPP_DEBUG_STREAM(get_logger(), "ECEF point x: " << msg.trajectory.location.ecef_x << ", y:" << msg.trajectory.location.ecef_y);
+        std::vector<lanelet::BasicPoint3d> map_points;
+        map_projector_->ecefChainToMap(ecef_location, ecef_offsets, map_points);
 
-        geometry_msgs::msg::Point arrow_end;
-        curr_location_msg.trajectory.location.ecef_x += + msg.trajectory.offsets[0].offset_x;
-        curr_location_msg.trajectory.location.ecef_y += + msg.trajectory.offsets[0].offset_y;
-        curr_location_msg.trajectory.location.ecef_z += + msg.trajectory.offsets[0].offset_z;
-        arrow_end = ECEFToMapPoint(curr_location_msg.trajectory.location); //also convert from cm to m
+        // Markers past the end of the chain are being deleted so reuse its last point
+        auto chain_point = [&map_points](size_t index)
+        {
+            const lanelet::BasicPoint3d& map_point = map_points[std::min(index, map_points.size() - 1)];
+            geometry_msgs::msg::Point point;
+            point.x = map_point.x();
+            point.y = map_point.y();
+            point.z = map_point.z();
+            return point;
+        };
 
-        marker.points.push_back(arrow_start);
-        marker.points.push_back(arrow_end);
+        marker.id = 0;
+        marker.points.push_back(chain_point(0));
+        marker.points.push_back(chain_point(1));
+        RCLCPP_DEBUG_STREAM(get_logger(), "Map point x: " << marker.points[0].x << ", y:" << marker.points[0].y);
 
         output.markers.push_back(marker);
 
@@ -219,22 +234,12 @@ namespace mobilitypath_visualizer {
             }
 
             marker.points = {};
-            RCLCPP_DEBUG_STREAM(get_logger(), "ECEF Point- DEBUG x: " << curr_location_msg.trajectory.location.ecef_x << ", y:" << curr_location_msg.trajectory.location.ecef_y);
-            arrow_start = ECEFToMapPoint(curr_location_msg.trajectory.location); //convert from cm to m
-            RCLCPP_DEBUG_STREAM(get_logger(), "Map Point- DEBUG x: " << arrow_start.x << ", y:" << arrow_start.y);
-
-            curr_location_msg.trajectory.location.ecef_x += msg.trajectory.offsets[i].offset_x;
-            curr_location_msg.trajectory.location.ecef_y += msg.trajectory.offsets[i].offset_y;
-            curr_location_msg.trajectory.location.ecef_z += msg.trajectory.offsets[i].offset_z;
-            arrow_end = ECEFToMapPoint(curr_location_msg.trajectory.location);
-
-            marker.points.push_back(arrow_start);
-            marker.points.push_back(arrow_end);
+            marker.points.push_back(chain_point(i));
+            marker.points.push_back(chain_point(i + 1));
 
             output.markers.push_back(marker);
         }
-        RCLCPP_DEBUG_STREAM(get_logger(), "Last ECEF Point- DEBUG x: " << curr_location_msg.trajectory.location.ecef_x << ", y:" << curr_location_msg.trajectory.location.ecef_y);
-        RCLCPP_DEBUG_STREAM(get_logger(), "Last Map Point- DEBUG x: " << arrow_end.x << ", y:" << arrow_end.y);
+        RCLCPP_DEBUG_STREAM(get_logger(), "Last Map Point- DEBUG x: " << map_points.back().x() << ", y:" << map_points.back().y());
         prev_marker_list_size_[msg.m_header.sender_id] = msg.trajectory.offsets.size();
         
         return output;
@@ -248,7 +253,7 @@ namespace mobilitypath_visualizer {
         }
         geometry_msgs::msg::Point output;
         
-        lanelet::BasicPoint3d map_point = map_projector_->projectECEF( { (double)ecef_point.ecef_x/100.0, (double)ecef_point.ecef_y/100.0, (double)ecef_point.ecef_z/100.0 } , -1);
+        lanelet::BasicPoint3d map_point = map_projector_->ecefToMap( { (double)ecef_point.ecef_x/100.0, (double)ecef_point.ecef_y/100.0, (double)ecef_point.ecef_z/100.0 } );
         output.x = map_point.x();
         output.y = map_point.y();
         output.z = map_point.z();
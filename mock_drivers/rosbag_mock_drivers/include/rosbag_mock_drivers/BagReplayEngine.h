@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#pragma once
+
+#include <ros/ros.h>
+#include <rosbag/bag.h>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include "rosbag_mock_drivers/MockDriver.h"
+
+namespace mock_drivers
+{
+/**
+ * \brief Type information shared by every RawMessage replayed from one bag connection
+ */
+struct RawMessageInfo
+{
+  std::string datatype;
+  std::string md5sum;
+  std::string definition;
+};
+
+/**
+ * \brief A message held in its serialized form.
+ *
+ * Publishing a RawMessage writes the stored bytes directly, so a message can be forwarded from a bag without being
+ * deserialized into its concrete type and copied to update its timestamp.
+ */
+struct RawMessage
+{
+  boost::shared_ptr<const RawMessageInfo> info;
+  std::vector<uint8_t> data;
+};
+
+/**
+ * \brief Configuration of the BagReplayEngine
+ */
+struct BagReplayConfig
+{
+  //! Path to the bag file
+  std::string bag_path;
+
+  //! Only bag topics under this prefix are replayed. The prefix is removed to get the output topic
+  std::string bag_prefix = "/bag";
+
+  //! Playback speed relative to the bag recording. Values of 0 or less replay as fast as possible
+  double rate = 1.0;
+
+  //! Messages published more than this many seconds after their scheduled time are counted as late
+  double late_tolerance = 0.01;
+
+  //! Messages which would be published more than this many seconds after their scheduled time are dropped.
+  //! Negative values disable dropping
+  double max_lateness = 0.5;
+
+  //! If true the bag is replayed repeatedly until ROS shuts down
+  bool loop = false;
+
+  //! Period in seconds at which replay statistics are logged
+  double stats_period = 10.0;
+
+  //! Publisher queue size for each replayed topic
+  int queue_size = 10;
+
+  //! Mock driver names (see createMockDriver) for which driver discovery is published
+  std::vector<std::string> drivers;
+};
+
+/**
+ * \brief Replay counters for a single output topic
+ */
+struct TopicReplayStats
+{
+  uint64_t published = 0;
+  uint64_t late = 0;     // Published, but more than late_tolerance after the scheduled time
+  uint64_t dropped = 0;  // Not published because it was more than max_lateness behind
+  double max_lateness = 0;
+};
+
+/**
+ * \brief Replays bag data as every mock driver from a single process.
+ *
+ * Replaces running rosbag play under the /bag prefix and forwarding the data through one MockDriver node per driver.
+ * Messages are read directly from the bag in serialized form. If the message begins with a std_msgs/Header its stamp
+ * is overwritten with ros::Time::now() in the serialized buffer, matching MockDriver::addPassthroughPub without
+ * deserializing or copying the message. Driver discovery is published for each configured driver.
+ *
+ * Playback is paced against wall time at the configured rate. When the engine falls behind, messages beyond
+ * max_lateness are dropped rather than published so that playback catches up. Late and dropped messages are counted
+ * per topic and logged periodically.
+ */
+class BagReplayEngine
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param nh Node handle in which the output topics and driver discovery topic are advertised
+   * \param config The replay configuration
+   *
+   * \throw std::invalid_argument if a driver name is not recognized
+   */
+  BagReplayEngine(const ros::NodeHandle& nh, const BagReplayConfig& config);
+
+  /**
+   * \brief Opens the bag and advertises one output topic per bag topic under the bag prefix
+   *
+   * \throw rosbag::BagException if the bag cannot be opened
+   */
+  void open();
+
+  /**
+   * \brief Replays the bag once. open() must have been called
+   *
+   * \return False if ROS shut down during replay. True otherwise
+   */
+  bool replayOnce();
+
+  /**
+   * \brief Opens the bag and replays it once or, if configured to loop, until ROS shuts down
+   */
+  void run();
+
+  /**
+   * \brief Returns the replay counters of each output topic accumulated since open() was called
+   */
+  std::map<std::string, TopicReplayStats> getStats() const;
+
+  /**
+   * \brief Returns the byte offset of the header stamp in serialized messages of the provided definition
+   *
+   * \param definition The full message definition text
+   *
+   * \return The offset or -1 if the first field of the message is not a std_msgs/Header
+   */
+  static int headerStampOffset(const std::string& definition);
+
+  /**
+   * \brief Overwrites the header stamp of a serialized message
+   *
+   * \param data The serialized message
+   * \param stamp_offset The offset returned by headerStampOffset
+   * \param stamp The new stamp
+   */
+  static void restamp(std::vector<uint8_t>& data, int stamp_offset, const ros::Time& stamp);
+
+private:
+  struct OutputTopic
+  {
+    ros::Publisher pub;
+    boost::shared_ptr<const RawMessageInfo> info;
+    int stamp_offset = -1;
+    TopicReplayStats stats;
+  };
+
+  /**
+   * \brief Publishes driver discovery for every configured driver if at least one second has passed since the last
+   */
+  void publishDiscovery();
+
+  /**
+   * \brief Logs the replay counters of every topic
+   */
+  void logStats() const;
+
+  ros::NodeHandle nh_;
+  BagReplayConfig config_;
+  rosbag::Bag bag_;
+
+  std::map<std::string, OutputTopic> outputs_;  // Keyed on bag topic
+
+  ros::Publisher discovery_pub_;
+  std::vector<boost::shared_ptr<MockDriver>> drivers_;
+  ros::WallTime last_discovery_;
+  ros::WallTime last_stats_;
+};
+
+}  // namespace mock_drivers
+
+namespace ros
+{
+namespace message_traits
+{
+template <>
+struct IsMessage<mock_drivers::RawMessage> : TrueType
+{
+};
+
+template <>
+struct MD5Sum<mock_drivers::RawMessage>
+{
+  static const char* value(const mock_drivers::RawMessage& m)
+  {
+    return m.info->md5sum.c_str();
+  }
+
+  static const char* value()
+  {
+    return "*";
+  }
+};
+
+template <>
+struct DataType<mock_drivers::RawMessage>
+{
+  static const char* value(const mock_drivers::RawMessage& m)
+  {
+    return m.info->datatype.c_str();
+  }
+
+  static const char* value()
+  {
+    return "*";
+  }
+};
+
+template <>
+struct Definition<mock_drivers::RawMessage>
+{
+  static const char* value(const mock_drivers::RawMessage& m)
+  {
+    return m.info->definition.c_str();
+  }
+};
+
+}  // namespace message_traits
+
+namespace serialization
+{
+template <>
+struct Serializer<mock_drivers::RawMessage>
+{
+  template <typename Stream>
+  inline static void write(Stream& stream, const mock_drivers::RawMessage& m)
+  {
+    std::memcpy(stream.advance(m.data.size()), m.data.data(), m.data.size());
+  }
+
+  template <typename Stream>
+  inline static void read(Stream& stream, mock_drivers::RawMessage& m)
+  {
+    m.data.resize(stream.getLength());
+    std::memcpy(m.data.data(), stream.advance(stream.getLength()), m.data.size());
+  }
+
+  inline static uint32_t serializedLength(const mock_drivers::RawMessage& m)
+  {
+    return m.data.size();
+  }
+};
+
+}  // namespace serialization
+}  // namespace ros
@@ -176,6 +176,15 @@ public:
    * \return False if this node should shutdown. True otherwise.
    */ 
   bool spinCallback();
+
+  /**
+   * \brief Builds the driver discovery message for this driver from getDriverTypes() and getDriverStatus()
+   *
+   * \param name The name to report the driver under
+   *
+   * \return The populated discovery message
+   */
+  cav_msgs::DriverStatus buildDiscoveryMessage(const std::string& name);
 };
 
 }  // namespace mock_drivers
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#pragma once
+
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include "rosbag_mock_drivers/MockDriver.h"
+
+namespace mock_drivers
+{
+/**
+ * \brief Creates the mock driver matching the provided driver name
+ *
+ * \param driver The driver name. One of camera, can, comms, controller, gnss, imu, lidar, radar or roadway_sensor
+ * \param dummy Flag passed to the driver constructor. If true the driver will not create any publishers or subscribers
+ *
+ * \return The mock driver or nullptr if the name is not recognized
+ */
+boost::shared_ptr<MockDriver> createMockDriver(const std::string& driver, bool dummy = false);
+
+}  // namespace mock_drivers
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "rosbag_mock_drivers/BagReplayEngine.h"
+#include "rosbag_mock_drivers/MockDriverFactory.h"
+#include <rosbag/view.h>
+#include <algorithm>
+#include <sstream>
+#include <boost/algorithm/string.hpp>
+
+namespace mock_drivers
+{
+namespace
+{
+// Seconds of idle time between checks for shutdown and driver discovery while waiting for the next message
+constexpr double MAX_IDLE_SLEEP = 0.1;
+}  // namespace
+
+BagReplayEngine::BagReplayEngine(const ros::NodeHandle& nh, const BagReplayConfig& config) : nh_(nh), config_(config)
+{
+  for (const auto& driver : config_.drivers)
+  {
+    auto mock_driver = createMockDriver(driver, true);
+    if (!mock_driver)
+    {
+      throw std::invalid_argument("Unsupported mock driver provided for bag replay: " + driver);
+    }
+    drivers_.push_back(mock_driver);
+  }
+}
+
+int BagReplayEngine::headerStampOffset(const std::string& definition)
+{
+  std::istringstream lines(definition);
+  std::string line;
+  while (std::getline(lines, line))
+  {
+    // Definitions of nested types follow a separator line and are not part of the top level message
+    if (boost::algorithm::starts_with(line, "===="))
+    {
+      break;
+    }
+
+    line = line.substr(0, line.find('#'));
+    boost::algorithm::trim(line);
+    if (line.empty() || line.find('=') != std::string::npos)
+    {
+      continue;  // Blank, comment or constant, none of which are serialized
+    }
+
+    std::string type = line.substr(0, line.find_first_of(" \t"));
+    if (type == "Header" || type == "std_msgs/Header")
+    {
+      return sizeof(uint32_t);  // The stamp follows the uint32 seq field
+    }
+    return -1;
+  }
+  return -1;
+}
+
+void BagReplayEngine::restamp(std::vector<uint8_t>& data, int stamp_offset, const ros::Time& stamp)
+{
+  if (stamp_offset < 0 || data.size() < stamp_offset + 2 * sizeof(uint32_t))
+  {
+    return;
+  }
+
+  ros::serialization::OStream stream(data.data() + stamp_offset, 2 * sizeof(uint32_t));
+  stream << stamp.sec << stamp.nsec;
+}
+
+void BagReplayEngine::open()
+{
+  bag_.open(config_.bag_path, rosbag::bagmode::Read);
+  outputs_.clear();
+
+  discovery_pub_ = nh_.advertise<cav_msgs::DriverStatus>("driver_discovery", 10);
+
+  std::string prefix = config_.bag_prefix;
+  if (prefix.empty() || prefix.back() != '/')
+  {
+    prefix += "/";
+  }
+
+  rosbag::View view(bag_);
+  for (const rosbag::ConnectionInfo* connection : view.getConnections())
+  {
+    if (!boost::algorithm::starts_with(connection->topic, prefix) || outputs_.count(connection->topic))
+    {
+      continue;
+    }
+
+    auto info = boost::make_shared<RawMessageInfo>();
+    info->datatype = connection->datatype;
+    info->md5sum = connection->md5sum;
+    info->definition = connection->msg_def;
+
+    bool latch = false;
+    if (connection->header)
+    {
+      auto latching = connection->header->find("latching");
+      latch = latching != connection->header->end() && latching->second == "1";
+    }
+
+    std::string output_topic = connection->topic.substr(prefix.size() - 1);  // Keep the leading '/'
+
+    ros::AdvertiseOptions options(output_topic, config_.queue_size, info->md5sum, info->datatype, info->definition);
+    options.latch = latch;
+
+    OutputTopic output;
+    output.pub = nh_.advertise(options);
+    output.info = info;
+    output.stamp_offset = headerStampOffset(info->definition);
+    outputs_[connection->topic] = output;
+
+    ROS_INFO_STREAM("Replaying " << connection->topic << " on " << output_topic << " as " << info->datatype
+                                 << (output.stamp_offset >= 0 ? " with updated header stamps" : ""));
+  }
+
+  if (outputs_.empty())
+  {
+    ROS_WARN_STREAM("Bag " << config_.bag_path << " contains no topics under " << prefix);
+  }
+}
+
+bool BagReplayEngine::replayOnce()
+{
+  std::vector<std::string> topics;
+  for (const auto& output : outputs_)
+  {
+    topics.push_back(output.first);
+  }
+
+  rosbag::View view(bag_, rosbag::TopicQuery(topics));
+  if (view.size() == 0)
+  {
+    return ros::ok();
+  }
+
+  const ros::Time bag_start = view.getBeginTime();
+  const ros::WallTime wall_start = ros::WallTime::now();
+
+  for (const rosbag::MessageInstance& instance : view)
+  {
+    OutputTopic& output = outputs_[instance.getTopic()];
+
+    if (config_.rate > 0)
+    {
+      ros::WallTime scheduled = wall_start + ros::WallDuration((instance.getTime() - bag_start).toSec() / config_.rate);
+
+      ros::WallTime now = ros::WallTime::now();
+      while (now < scheduled)
+      {
+        if (!ros::ok())
+        {
+          return false;
+        }
+        publishDiscovery();
+        ros::WallDuration(std::min((scheduled - now).toSec(), MAX_IDLE_SLEEP)).sleep();
+        now = ros::WallTime::now();
+      }
+
+      double lateness = (now - scheduled).toSec();
+      output.stats.max_lateness = std::max(output.stats.max_lateness, lateness);
+
+      // Dropping before the message is read skips the read and copy so playback can catch up
+      if (config_.max_lateness >= 0 && lateness > config_.max_lateness)
+      {
+        output.stats.dropped++;
+        continue;
+      }
+
+      if (lateness > config_.late_tolerance)
+      {
+        output.stats.late++;
+      }
+    }
+
+    if (!ros::ok())
+    {
+      return false;
+    }
+
+    auto msg = boost::make_shared<RawMessage>();
+    msg->info = output.info;
+    msg->data.resize(instance.size());
+    ros::serialization::OStream stream(msg->data.data(), msg->data.size());
+    instance.write(stream);
+
+    restamp(msg->data, output.stamp_offset, ros::Time::now());
+
+    output.pub.publish(msg);
+    output.stats.published++;
+
+    publishDiscovery();
+
+    ros::WallTime now = ros::WallTime::now();
+    if ((now - last_stats_).toSec() >= config_.stats_period)
+    {
+      logStats();
+      last_stats_ = now;
+    }
+  }
+
+  return ros::ok();
+}
+
+void BagReplayEngine::run()
+{
+  open();
+
+  last_stats_ = ros::WallTime::now();
+  while (replayOnce() && config_.loop)
+  {
+    ROS_INFO_STREAM("Restarting replay of " << config_.bag_path);
+  }
+
+  logStats();
+  bag_.close();
+}
+
+std::map<std::string, TopicReplayStats> BagReplayEngine::getStats() const
+{
+  std::map<std::string, TopicReplayStats> stats;
+  for (const auto& output : outputs_)
+  {
+    stats[output.second.pub.getTopic()] = output.second.stats;
+  }
+  return stats;
+}
+
+void BagReplayEngine::publishDiscovery()
+{
+  ros::WallTime now = ros::WallTime::now();
+  if (drivers_.empty() || (now - last_discovery_).toSec() < 0.95)
+  {
+    return;
+  }
+
+  // Report each driver under the name a standalone mock driver node in this namespace would have
+  for (size_t i = 0; i < drivers_.size(); i++)
+  {
+    discovery_pub_.publish(drivers_[i]->buildDiscoveryMessage(ros::names::append(nh_.getNamespace(), config_.drivers[i])));
+  }
+  last_discovery_ = now;
+}
+
+void BagReplayEngine::logStats() const
+{
+  for (const auto& output : outputs_)
+  {
+    const TopicReplayStats& stats = output.second.stats;
+    ROS_INFO_STREAM("Replay " << output.second.pub.getTopic() << ": published " << stats.published << ", late "
+                              << stats.late << ", dropped " << stats.dropped << ", max lateness "
+                              << stats.max_lateness << " s");
+  }
+}
+
+}  // namespace mock_drivers
@@ -61,10 +61,16 @@ bool MockDriver::spinCallback()
 }
 
 void MockDriver::driverDiscovery()
+{
+  mock_driver_node_.publishDataNoHeader<cav_msgs::DriverStatus>(driver_discovery_topic_,
+                                                                buildDiscoveryMessage(mock_driver_node_.getGraphName()));
+}
+
+cav_msgs::DriverStatus MockDriver::buildDiscoveryMessage(const std::string& name)
 {
   cav_msgs::DriverStatus discovery_msg;
 
-  discovery_msg.name = mock_driver_node_.getGraphName();
+  discovery_msg.name = name;
   discovery_msg.status = getDriverStatus();
 
   for (DriverType type : getDriverTypes())
@@ -111,6 +117,6 @@ void MockDriver::driverDiscovery()
     }
   }
 
-  mock_driver_node_.publishDataNoHeader<cav_msgs::DriverStatus>(driver_discovery_topic_, discovery_msg);
+  return discovery_msg;
 }
 }  // namespace mock_drivers
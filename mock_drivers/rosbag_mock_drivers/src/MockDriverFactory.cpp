@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "rosbag_mock_drivers/MockDriverFactory.h"
+#include "rosbag_mock_drivers/MockCameraDriver.h"
+#include "rosbag_mock_drivers/MockCANDriver.h"
+#include "rosbag_mock_drivers/MockCommsDriver.h"
+#include "rosbag_mock_drivers/MockControllerDriver.h"
+#include "rosbag_mock_drivers/MockGNSSDriver.h"
+#include "rosbag_mock_drivers/MockIMUDriver.h"
+#include "rosbag_mock_drivers/MockLidarDriver.h"
+#include "rosbag_mock_drivers/MockRadarDriver.h"
+#include "rosbag_mock_drivers/MockRoadwaySensorDriver.h"
+
+namespace mock_drivers
+{
+boost::shared_ptr<MockDriver> createMockDriver(const std::string& driver, bool dummy)
+{
+  if (driver == "camera")
+  {
+    return boost::make_shared<MockCameraDriver>(dummy);
+  }
+  else if (driver == "can")
+  {
+    return boost::make_shared<MockCANDriver>(dummy);
+  }
+  else if (driver == "comms")
+  {
+    return boost::make_shared<MockCommsDriver>(dummy);
+  }
+  else if (driver == "controller")
+  {
+    return boost::make_shared<MockControllerDriver>(dummy);
+  }
+  else if (driver == "gnss")
+  {
+    return boost::make_shared<MockGNSSDriver>(dummy);
+  }
+  else if (driver == "imu")
+  {
+    return boost::make_shared<MockIMUDriver>(dummy);
+  }
+  else if (driver == "lidar")
+  {
+    return boost::make_shared<MockLidarDriver>(dummy);
+  }
+  else if (driver == "radar")
+  {
+    return boost::make_shared<MockRadarDriver>(dummy);
+  }
+  else if (driver == "roadway_sensor")
+  {
+    return boost::make_shared<MockRoadwaySensorDriver>(dummy);
+  }
+
+  return nullptr;
+}
+
+}  // namespace mock_drivers
@@ -15,74 +15,57 @@
  */
 
 #include <ros/ros.h>
+#include <cstring>
 
-#include <rosbag_mock_drivers/MockCameraDriver.h>
-#include <rosbag_mock_drivers/MockCANDriver.h>
-#include <rosbag_mock_drivers/MockCommsDriver.h>
-#include <rosbag_mock_drivers/MockControllerDriver.h>
-#include <rosbag_mock_drivers/MockGNSSDriver.h>
-#include <rosbag_mock_drivers/MockIMUDriver.h>
-#include <rosbag_mock_drivers/MockLidarDriver.h>
-#include <rosbag_mock_drivers/MockRadarDriver.h>
-#include <rosbag_mock_drivers/MockRoadwaySensorDriver.h>
+#include <rosbag_mock_drivers/BagReplayEngine.h>
+#include <rosbag_mock_drivers/MockDriverFactory.h>
 
-int main(int argc, char** argv)
+/*!
+ * \brief Replays the bag specified by the private parameters as every configured mock driver from this process
+ */
+int runBagReplay()
 {
-  ros::init(argc, argv, "mock_driver");
-
-  if (strcmp("camera", argv[1]) == 0)
-  {
-    mock_drivers::MockCameraDriver node;
-    node.run();
-  }
+  ros::NodeHandle nh;
+  ros::NodeHandle pnh("~");
 
-  else if (strcmp("can", argv[1]) == 0)
-  {
-    mock_drivers::MockCANDriver node;
-    node.run();
-  }
-
-  else if (strcmp("comms", argv[1]) == 0)
-  {
-    mock_drivers::MockCommsDriver node;
-    node.run();
-  }
+  mock_drivers::BagReplayConfig config;
+  pnh.param<std::string>("bag_path", config.bag_path, "/opt/carma/data/mock_drivers/drivers.bag");
+  pnh.param<std::string>("bag_prefix", config.bag_prefix, config.bag_prefix);
+  pnh.param<double>("rate", config.rate, config.rate);
+  pnh.param<double>("late_tolerance", config.late_tolerance, config.late_tolerance);
+  pnh.param<double>("max_lateness", config.max_lateness, config.max_lateness);
+  pnh.param<bool>("loop", config.loop, config.loop);
+  pnh.param<double>("stats_period", config.stats_period, config.stats_period);
+  pnh.param<int>("queue_size", config.queue_size, config.queue_size);
+  pnh.param<std::vector<std::string>>("drivers", config.drivers, config.drivers);
 
-  else if (strcmp("controller", argv[1]) == 0)
-  {
-    mock_drivers::MockControllerDriver node;
-    node.run();
-  }
+  mock_drivers::BagReplayEngine engine(nh, config);
+  engine.run();
 
-  else if (strcmp("gnss", argv[1]) == 0)
-  {
-    mock_drivers::MockGNSSDriver node;
-    node.run();
-  }
+  return 0;
+}
 
-  else if (strcmp("imu", argv[1]) == 0)
-  {
-    mock_drivers::MockIMUDriver node;
-    node.run();
-  }
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "mock_driver");
 
-  else if (strcmp("lidar", argv[1]) == 0)
+  if (argc < 2)
   {
-    mock_drivers::MockLidarDriver node;
-    node.run();
+    ROS_ERROR_STREAM("A mock driver name or replay must be provided");
+    return 1;
   }
 
-  else if (strcmp("radar", argv[1]) == 0)
+  if (strcmp("replay", argv[1]) == 0)
   {
-    mock_drivers::MockRadarDriver node;
-    node.run();
+    return runBagReplay();
   }
 
-  else if (strcmp("roadway_sensor", argv[1]) == 0)
+  auto node = mock_drivers::createMockDriver(argv[1]);
+  if (!node)
   {
-    mock_drivers::MockRoadwaySensorDriver node;
-    node.run();
+    ROS_ERROR_STREAM("Unsupported mock driver: " << argv[1]);
+    return 1;
   }
 
-  return 0;
-}
\ No newline at end of file
+  return node->run();
+}
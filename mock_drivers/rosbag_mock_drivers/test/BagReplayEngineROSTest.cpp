@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gmock/gmock.h>
+#include <ros/ros.h>
+#include <rosbag/bag.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <std_msgs/String.h>
+#include <cav_msgs/DriverStatus.h>
+#include <rosbag_mock_drivers/BagReplayEngine.h>
+
+namespace mock_drivers
+{
+TEST(BagReplayEngine, header_stamp_offset)
+{
+  EXPECT_EQ(4, BagReplayEngine::headerStampOffset(ros::message_traits::definition<sensor_msgs::PointCloud2>()));
+  EXPECT_EQ(-1, BagReplayEngine::headerStampOffset(ros::message_traits::definition<std_msgs::String>()));
+  EXPECT_EQ(4, BagReplayEngine::headerStampOffset("# Comment\nuint8 CONSTANT=1\n\nstd_msgs/Header header # stamped\nfloat64 data\n"));
+  EXPECT_EQ(-1, BagReplayEngine::headerStampOffset("float64 data\nHeader header\n"));
+}
+
+TEST(BagReplayEngine, replay)
+{
+  const std::string bag_path = "/tmp/bag_replay_engine_test.bag";
+  const size_t cloud_count = 5;
+
+  sensor_msgs::PointCloud2 cloud;
+  cloud.header.frame_id = "velodyne";
+  cloud.header.stamp = ros::Time(10);
+  cloud.data.resize(1 << 20);
+  for (size_t i = 0; i < cloud.data.size(); i++)
+  {
+    cloud.data[i] = i % 251;
+  }
+
+  std_msgs::String text;
+  text.data = "passthrough";
+
+  {
+    rosbag::Bag bag(bag_path, rosbag::bagmode::Write);
+    for (size_t i = 0; i < cloud_count; i++)
+    {
+      cloud.header.seq = i;
+      bag.write("/bag/hardware_interface/lidar/points_raw", ros::Time(10) + ros::Duration(0.05 * i), cloud);
+    }
+    bag.write("/bag/hardware_interface/comms/text", ros::Time(10.1), text);
+    bag.write("/not_replayed", ros::Time(10.1), text);
+  }
+
+  ros::NodeHandle nh("/hardware_interface");
+
+  std::vector<sensor_msgs::PointCloud2ConstPtr> clouds;
+  std::vector<std_msgs::StringConstPtr> texts;
+  std::vector<cav_msgs::DriverStatusConstPtr> discoveries;
+
+  ros::Subscriber cloud_sub = nh.subscribe<sensor_msgs::PointCloud2>(
+      "lidar/points_raw", 10, [&](const sensor_msgs::PointCloud2ConstPtr& msg) { clouds.push_back(msg); });
+  ros::Subscriber text_sub = nh.subscribe<std_msgs::String>(
+      "comms/text", 10, [&](const std_msgs::StringConstPtr& msg) { texts.push_back(msg); });
+  ros::Subscriber discovery_sub = nh.subscribe<cav_msgs::DriverStatus>(
+      "driver_discovery", 10, [&](const cav_msgs::DriverStatusConstPtr& msg) { discoveries.push_back(msg); });
+
+  BagReplayConfig config;
+  config.bag_path = bag_path;
+  config.rate = 2.0;
+  config.max_lateness = -1;
+  config.drivers = { "lidar", "comms" };
+
+  BagReplayConfig unknown_driver_config = config;
+  unknown_driver_config.drivers = { "unknown" };
+  EXPECT_THROW(BagReplayEngine(nh, unknown_driver_config), std::invalid_argument);
+
+  BagReplayEngine engine(nh, config);
+  engine.open();
+
+  ros::Time replay_start = ros::Time::now();
+  ros::WallTime wall_start = ros::WallTime::now();
+  ASSERT_TRUE(engine.replayOnce());
+  // 0.2 s of bag time at twice the recorded rate
+  EXPECT_GE((ros::WallTime::now() - wall_start).toSec(), 0.09);
+
+  ros::WallTime end_time = ros::WallTime::now() + ros::WallDuration(5.0);
+  while (ros::ok() && end_time > ros::WallTime::now() && (clouds.size() < cloud_count || texts.empty()))
+  {
+    ros::spinOnce();
+    ros::WallDuration(0.01).sleep();
+  }
+
+  ASSERT_EQ(cloud_count, clouds.size());
+  for (size_t i = 0; i < cloud_count; i++)
+  {
+    EXPECT_EQ(i, clouds[i]->header.seq);
+    EXPECT_EQ("velodyne", clouds[i]->header.frame_id);
+    EXPECT_GE(clouds[i]->header.stamp, replay_start);  // Restamped
+    EXPECT_TRUE(clouds[i]->data == cloud.data);
+  }
+
+  ASSERT_EQ(1u, texts.size());
+  EXPECT_EQ("passthrough", texts[0]->data);
+
+  ASSERT_EQ(2u, discoveries.size());
+  EXPECT_EQ("/hardware_interface/lidar", discoveries[0]->name);
+  EXPECT_TRUE(discoveries[0]->lidar);
+  EXPECT_EQ("/hardware_interface/comms", discoveries[1]->name);
+  EXPECT_TRUE(discoveries[1]->comms);
+
+  auto stats = engine.getStats();
+  ASSERT_EQ(2u, stats.size());
+  EXPECT_EQ(cloud_count, stats["/hardware_interface/lidar/points_raw"].published);
+  EXPECT_EQ(0u, stats["/hardware_interface/lidar/points_raw"].dropped);
+  EXPECT_EQ(1u, stats["/hardware_interface/comms/text"].published);
+}
+
+}  // namespace mock_drivers
+
+/*!
+ * \brief Main entrypoint for unit tests
+ */
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "bag_replay_engine_test");
+
+  auto res = RUN_ALL_TESTS();
+
+  ros::shutdown();
+
+  return res;
+}
@@ -66,10 +66,11 @@ namespace motion_computation
     rcl_interfaces::msg::SetParametersResult parameter_update_callback(const std::vector<rclcpp::Parameter> &parameters);
 
     /**
-     * \brief Function to publish ExternalObjectList
+     * \brief Function to publish ExternalObjectList. Ownership of the message is passed to the publisher so
+     * intra-process subscribers receive it without a copy
      * \param obj_pred_msg ExternalObjectList message to be published
      */
-    void publishObject(const carma_perception_msgs::msg::ExternalObjectList& obj_pred_msg) const;
+    void publishObject(carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pred_msg);
 
     ////
     // Overrides
@@ -27,7 +27,7 @@
 #include <motion_predict/predict_ctrv.hpp>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <ecef_projection/batch_projector.h>
 #include <tuple>
 
 namespace motion_computation
@@ -47,7 +47,7 @@ namespace motion_computation
     class MotionComputationWorker
     {
         public:
-            using PublishObjectCallback = std::function<void(const carma_perception_msgs::msg::ExternalObjectList&)>;
+            using PublishObjectCallback = std::function<void(carma_perception_msgs::msg::ExternalObjectList::UniquePtr)>;
             using LookUpTransform = std::function<void()>;
 
             /*!
@@ -128,6 +128,14 @@ namespace motion_computation
              */
             tf2::Vector3 transform_to_map_frame(const tf2::Vector3& ecef_point) const;
 
+            /**
+             * \brief Transforms an ecef offset chain to map frame using internally saved map transform
+             * \param ecef_location first point of the chain in ecef
+             * \param ecef_offsets offset of each following point from the one before it
+             * \return points in map with the location first
+             */
+            std::vector<lanelet::BasicPoint3d> transform_to_map_frame(const lanelet::BasicPoint3d& ecef_location, const std::vector<lanelet::BasicPoint3d>& ecef_offsets) const;
+
         private:
 
             /**
@@ -157,7 +165,7 @@ namespace motion_computation
             // Queue for mobility path msgs to synchronize them with sensor msgs 
             carma_perception_msgs::msg::ExternalObjectList mobility_path_list_;
 
-            std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+            std::shared_ptr<const ecef_projection::BatchProjector> map_projector_;
     };
 
 } // namespace motion_computation
@@ -107,9 +107,12 @@ namespace motion_computation
     return CallbackReturn::SUCCESS;
   }
 
-  void MotionComputationNode::publishObject(const carma_perception_msgs::msg::ExternalObjectList& obj_pred_msg) const
+  void MotionComputationNode::publishObject(carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pred_msg)
   {
-    carma_obj_pub_->publish(obj_pred_msg);
+    RCLCPP_DEBUG_STREAM(get_logger(), "Publishing " << obj_pred_msg->objects.size() << " object predictions "
+      << (now() - rclcpp::Time(obj_pred_msg->header.stamp, get_clock()->get_clock_type())).seconds() * 1000.0 << " ms after sensor stamp");
+
+    carma_obj_pub_->publish(std::move(obj_pred_msg));
   }
 
 } // namespace motion_computation
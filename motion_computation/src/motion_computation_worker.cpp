@@ -22,10 +22,8 @@ namespace motion_computation{
 
     void MotionComputationWorker::predictionLogic(carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_list)
     {
-        carma_perception_msgs::msg::ExternalObjectList output_list;
-        carma_perception_msgs::msg::ExternalObjectList sensor_list;
-
-        for (auto obj : obj_list->objects)
+        // The received list is owned by this callback so predictions are added to its objects in place
+        for (auto& obj : obj_list->objects)
         {
             // Header contains the frame rest of the fields will use
             // obj.header = obj_list.objects[i].header;
@@ -77,27 +75,29 @@ namespace motion_computation{
                     obj, prediction_time_step_, prediction_period_, cv_x_accel_noise_, cv_y_accel_noise_,
                     prediction_process_noise_max_, prediction_confidence_drop_rate_);
             }
-            sensor_list.objects.emplace_back(obj);
         }//end for-loop
 
+        auto output_list = std::make_unique<carma_perception_msgs::msg::ExternalObjectList>();
+        output_list->header = obj_list->header; // Keep the sensor stamp so downstream latency can be measured
+
         // Determine mode
         switch(external_object_prediction_mode_)
         {
             case SENSORS_ONLY:
-                output_list = sensor_list;
+                output_list = std::move(obj_list);
                 break;
             case PATH_AND_SENSORS:
-                output_list = synchronizeAndAppend(sensor_list, mobility_path_list_);
+                output_list->objects = synchronizeAndAppend(*obj_list, std::move(mobility_path_list_)).objects;
                 break;
             case MOBILITY_PATH_ONLY:
-                output_list = mobility_path_list_;
+                output_list->objects = std::move(mobility_path_list_.objects);
                 break;
             default:
                 RCLCPP_WARN_STREAM(logger_->get_logger(), "Received invalid motion computation operational mode:" << external_object_prediction_mode_ << " publishing empty list.");
                 break;
         }
 
-        obj_pub_(output_list);
+        obj_pub_(std::move(output_list));
 
         // Clear mobility msg path queue since it is published
         mobility_path_list_.objects = {};
@@ -106,7 +106,7 @@ namespace motion_computation{
     void MotionComputationWorker::georeferenceCallback(const std_msgs::msg::String::UniquePtr msg) 
     {
         // Build projector from proj string
-        map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str()); 
+        map_projector_ = ecef_projection::BatchProjector::forGeoreference(msg->data);
     }
     
     void MotionComputationWorker::setPredictionTimeStep(double time_step)
@@ -204,25 +204,22 @@ namespace motion_computation{
 
         // get planned trajectory points
         carma_perception_msgs::msg::PredictedState prev_state;
-        tf2::Vector3 prev_pt_ecef {ecef_x, ecef_y, ecef_z};
 
-        auto prev_pt_map = transform_to_map_frame(prev_pt_ecef);
-        double prev_yaw = 0.0;
+        // Project the whole trajectory at once. map_points[0] is the location and map_points[i + 1] follows offset i
+        std::vector<lanelet::BasicPoint3d> ecef_offsets;
+        ecef_offsets.reserve(msg->trajectory.offsets.size());
+        for (const auto& offset : msg->trajectory.offsets)
+        {
+            ecef_offsets.emplace_back((double)offset.offset_x / 100.0, (double)offset.offset_y / 100.0, (double)offset.offset_z / 100.0); // offsets are in cm. Want m as final result
+        }
+        std::vector<lanelet::BasicPoint3d> map_points = transform_to_map_frame({ecef_x, ecef_y, ecef_z}, ecef_offsets);
 
-        double message_offset_x = 0.0; // units cm
-        double message_offset_y = 0.0;
-        double message_offset_z = 0.0;
+        tf2::Vector3 prev_pt_map {map_points[0].x(), map_points[0].y(), map_points[0].z()};
+        double prev_yaw = 0.0;
 
         for (size_t i = 0; i < msg->trajectory.offsets.size(); i ++)
         {
-            auto curr_pt_msg = msg->trajectory.offsets[i];
-
-            message_offset_x = (double)curr_pt_msg.offset_x + message_offset_x;
-            message_offset_y = (double)curr_pt_msg.offset_y + message_offset_y;
-            message_offset_z = (double)curr_pt_msg.offset_z + message_offset_z;
-
-            tf2::Vector3 curr_pt_ecef {ecef_x + message_offset_x /100.0, ecef_y + message_offset_y /100.0, ecef_z + message_offset_z /100.0}; // ecef_x is in m while message_offset_x is in cm. Want m as final result
-            auto curr_pt_map = transform_to_map_frame(curr_pt_ecef);
+            tf2::Vector3 curr_pt_map {map_points[i + 1].x(), map_points[i + 1].y(), map_points[i + 1].z()};
 
             carma_perception_msgs::msg::PredictedState curr_state;
             
@@ -423,9 +420,21 @@ namespace motion_computation{
             throw std::invalid_argument("No map projector available for ecef conversion");
         }
             
-        lanelet::BasicPoint3d map_point = map_projector_->projectECEF( { ecef_point.x(),  ecef_point.y(), ecef_point.z() } , -1); // Input should already be converted to m
+        lanelet::BasicPoint3d map_point = map_projector_->ecefToMap( { ecef_point.x(),  ecef_point.y(), ecef_point.z() } ); // Input should already be converted to m
         
         return tf2::Vector3(map_point.x(), map_point.y(), map_point.z());
     }
 
+    std::vector<lanelet::BasicPoint3d> MotionComputationWorker::transform_to_map_frame(const lanelet::BasicPoint3d& ecef_location, const std::vector<lanelet::BasicPoint3d>& ecef_offsets) const
+    {
+        if (!map_projector_) {
+            throw std::invalid_argument("No map projector available for ecef conversion");
+        }
+
+        std::vector<lanelet::BasicPoint3d> map_points;
+        map_projector_->ecefChainToMap(ecef_location, ecef_offsets, map_points); // Input should already be converted to m
+
+        return map_points;
+    }
+
 } // namespace motion_computation
\ No newline at end of file
@@ -31,19 +31,19 @@ namespace motion_computation
         rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr logger;
 
         // Create MotionComputationWorker object
-        MotionComputationWorker worker([](const carma_perception_msgs::msg::ExternalObjectList& obj_pub){}, logger);
+        MotionComputationWorker worker([](carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pub){}, logger);
     }
 
     TEST(MotionComputationWorker, motionPredictionCallback)
     {    
         bool published_data = false;
         rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr logger;
-        MotionComputationWorker mcw_sensor_only([&](const carma_perception_msgs::msg::ExternalObjectList& obj_pub){
+        MotionComputationWorker mcw_sensor_only([&](carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pub){
             published_data = true;
-            ASSERT_EQ(obj_pub.objects.size(), 1);
+            ASSERT_EQ(obj_pub->objects.size(), 1);
 
             bool isFilled = false;
-            for(auto item : obj_pub.objects)
+            for(auto item : obj_pub->objects)
             {
                 if(item.predictions.size() > 0);
                     isFilled = true;
@@ -52,14 +52,14 @@ namespace motion_computation
 
             }, logger); 
 
-        MotionComputationWorker mcw_mobility_only([&](const carma_perception_msgs::msg::ExternalObjectList& obj_pub){
+        MotionComputationWorker mcw_mobility_only([&](carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pub){
             published_data = true;
-            ASSERT_EQ(obj_pub.objects.size(), 0);
+            ASSERT_EQ(obj_pub->objects.size(), 0);
             }, logger);
 
-        MotionComputationWorker mcw_mixed_operation([&](const carma_perception_msgs::msg::ExternalObjectList& obj_pub){
+        MotionComputationWorker mcw_mixed_operation([&](carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pub){
             published_data = true;
-            ASSERT_EQ(obj_pub.objects.size(), 2);
+            ASSERT_EQ(obj_pub->objects.size(), 2);
             }, logger);
 
         mcw_sensor_only.setExternalObjectPredictionMode(motion_computation::SENSORS_ONLY);
@@ -150,7 +150,7 @@ namespace motion_computation
     TEST(MotionComputationWorker, composePredictedState)
     {    
         rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr logger;
-        MotionComputationWorker mcw([&](const carma_perception_msgs::msg::ExternalObjectList& obj_pub){}, logger);
+        MotionComputationWorker mcw([&](carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pub){}, logger);
 
         // 1 to 1 transform
         std::string base_proj = lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR;
@@ -189,7 +189,7 @@ namespace motion_computation
     TEST(MotionComputationWorker, mobilityPathToExternalObject)
     {   
         auto node = std::make_shared<rclcpp::Node>("test_node");
-        MotionComputationWorker mcw([&](const carma_perception_msgs::msg::ExternalObjectList& obj_pub){}, node->get_node_logging_interface());
+        MotionComputationWorker mcw([&](carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pub){}, node->get_node_logging_interface());
 
         // 1 to 1 transform
         std::string base_proj = lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR;
@@ -250,7 +250,7 @@ namespace motion_computation
     TEST(MotionComputationWorker, synchronizeAndAppend)
     {   
         auto node = std::make_shared<rclcpp::Node>("test_node");
-        MotionComputationWorker mcw_mixed_operation([&](const carma_perception_msgs::msg::ExternalObjectList& obj_pub){}, node->get_node_logging_interface());
+        MotionComputationWorker mcw_mixed_operation([&](carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_pub){}, node->get_node_logging_interface());
         mcw_mixed_operation.setExternalObjectPredictionMode(motion_computation::PATH_AND_SENSORS);
         mcw_mixed_operation.setMobilityPathPredictionTimeStep(0.2); // 0.2 Seconds
 
@@ -0,0 +1,75 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class J2735Framer
+ * @brief Finds the boundaries of a UPER encoded J2735 message frame within a received datagram
+ *
+ * A frame is a 2 byte message id followed by a 1 or 2 byte length and the message body. When the
+ * ids of the messages which may be received are known, candidate frame starts are filtered by id
+ * before the length is decoded. If every known id has the same nonzero value in its high or low
+ * byte, candidates are located with memchr on that byte. A zero byte is not used since it is common
+ * in UPER payloads. The standard J2735 ids (0x00xx with distinct low bytes) therefore test the id at
+ * each offset instead. Only if no frame with a known id is found does the framer fall back to
+ * trying every offset.
+ */
+class J2735Framer
+{
+public:
+    struct Frame
+    {
+        size_t offset = 0;     // Index of the first message id byte
+        size_t length = 0;     // Length of the frame including message id and length bytes
+        uint16_t msg_id = 0;
+    };
+
+    /**
+    * @brief Sets the message ids expected in received datagrams. An empty list disables the fast path
+    * @param ids J2735 message ids
+    */
+    void setKnownMessageIds(const std::vector<uint16_t>& ids);
+
+    /**
+    * @brief Finds the first frame in a datagram
+    * @param data pointer to the datagram
+    * @param size number of bytes in the datagram
+    * @param frame set to the located frame on success
+    * @return true if a frame was found
+    */
+    bool findFrame(const uint8_t* data, size_t size, Frame& frame) const;
+
+    /**
+    * @brief Attempts to decode a frame header at a specific offset
+    * @return true if a frame with a valid length which fits in the datagram starts at offset
+    */
+    static bool frameAt(const uint8_t* data, size_t size, size_t offset, Frame& frame);
+
+private:
+    std::bitset<65536> known_ids_;
+    bool has_known_ids_ = false;
+    bool use_sentinel_ = false;
+    uint8_t sentinel_ = 0;          // Byte value shared by every known id
+    size_t sentinel_offset_ = 0;    // Position of the shared byte within the id, 0 for the high byte and 1 for the low byte
+
+    bool findKnownFrame(const uint8_t* data, size_t size, Frame& frame) const;
+};
@@ -97,13 +97,17 @@ class NS3Adapter : public cav::DriverApplication
         boost::recursive_mutex dyn_cfg_mutex_;
         NS3Client ns3_client_;
 
-        std::deque<std::shared_ptr<std::vector<uint8_t>>> send_msg_queue_;
         bool connecting_ = false;
         std::shared_ptr <std::thread> connect_thread_;
         boost::system::error_code ns3_client_error_;
 
         std::vector<WaveConfigStruct> wave_cfg_items_;
         uint32_t queue_size_;
+        // Outbound messages held by the client before the oldest is dropped. Independent of the ROS queue depths in queue_size_
+        int max_send_queue_size_ = 1000;
+
+        // Drop count at the last backpressure warning
+        uint64_t last_reported_drops_ = 0;
 
         /**
         * @brief Initializes ROS context for this node
@@ -115,7 +119,7 @@ class NS3Adapter : public cav::DriverApplication
         /**
         * @brief Called by the base DriverApplication class after spin
         *
-        * Sends messages from the outgoing queue
+        * Reports backpressure on the outgoing send queue
         */
         virtual void post_spin() override;
 
@@ -188,11 +192,6 @@ class NS3Adapter : public cav::DriverApplication
         */
         bool sendMessageSrv(cav_srvs::SendMessage::Request& req, cav_srvs::SendMessage::Response& res);
 
-        /**
-        * @brief Sends a message from the queue of outbound messages
-        */
-        void sendMessageFromQueue();
-
         /**
         * @brief Callback for dynamic reconfig service
         * @param cfg
@@ -211,7 +210,10 @@ class NS3Adapter : public cav::DriverApplication
 
         cav_msgs::DriverStatus getDriverStatus();
 
-        std::deque<std::shared_ptr<std::vector<uint8_t>>> getMsgQueue();
+        /**
+        * @brief returns the statistics of the client's outbound send queue
+        */
+        NS3Client::SendMetrics getSendMetrics() const;
 
         /**
         * @brief converts a uint8_t vector to an ascii representation
@@ -23,10 +23,12 @@
 #include <condition_variable>
 #include <thread>
 #include <queue>
+#include <deque>
 #include <vector>
 
 
 #include "udp_listener.h"
+#include "j2735_framer.h"
 
 class NS3Client
 {
@@ -86,10 +88,44 @@ public:
     boost::signals2::signal<void(std::vector<uint8_t> const &, uint16_t id)> onMessageReceived;
 
     /**
-     * @brief sends a udp message
+     * @brief Statistics of the outbound send pipeline used to observe backpressure
+     */
+    struct SendMetrics
+    {
+        uint64_t enqueued = 0;         // Messages accepted by sendNS3Message
+        uint64_t sent = 0;             // Messages written to the socket
+        uint64_t dropped = 0;          // Oldest messages discarded because the queue was full
+        uint64_t send_errors = 0;      // Messages the socket failed to send
+        uint64_t batches = 0;          // Queue flushes performed by the io thread
+        size_t queue_depth = 0;        // Messages currently waiting to be sent or being sent
+        size_t max_queue_depth = 0;    // Highest queue depth observed
+        size_t max_batch_size = 0;     // Largest number of messages sent in one flush
+    };
+
+    /**
+     * @brief queues a udp message to be sent
+     *
+     * Messages are accumulated in a queue which the io thread drains in batches each time it wakes.
+     * Only one flush is posted at a time, so a burst of messages costs a single wakeup.
+     * @return false if the client is not connected
      */
     bool sendNS3Message(const std::shared_ptr<std::vector<uint8_t>>&message);
 
+    /**
+     * @brief Sets the maximum number of queued outbound messages. When full the oldest message is dropped
+     */
+    void setMaxSendQueueSize(size_t max_size);
+
+    /**
+     * @brief Sets the message ids expected in inbound datagrams so message boundaries can be found without a per byte scan
+     */
+    void setKnownMessageIds(const std::vector<uint16_t>& ids);
+
+    /**
+     * @brief returns a snapshot of the send pipeline statistics
+     */
+    SendMetrics getSendMetrics() const;
+
 
 private:
     std::unique_ptr<boost::asio::io_service> io_;
@@ -104,14 +140,41 @@ private:
     boost::asio::ip::udp::endpoint remote_udp_ep_;
     std::unique_ptr<cav::UDPListener> udp_listener_;
 
+    // outbound queue shared between callers of sendNS3Message and the io thread
+    mutable std::mutex send_mutex_;
+    std::deque<std::shared_ptr<std::vector<uint8_t>>> send_queue_;
+    bool flush_pending_ = false;
+    size_t in_flight_ = 0;
+    size_t max_send_queue_size_ = 1000;
+    SendMetrics send_metrics_;
+
+    // maximum number of messages sent by one flush before yielding the io thread
+    static constexpr size_t MAX_FLUSH_SIZE = 256;
+
+    // messages being sent by the current flush. Only accessed on output_strand_
+    std::vector<std::shared_ptr<std::vector<uint8_t>>> send_batch_;
+
+    J2735Framer framer_;
+
+    /**
+    * @brief sends every queued message. Runs on output_strand_
+    */
+    void flushSendQueue();
+
+    /**
+    * @brief writes a batch of datagrams to the socket
+    * @return number of datagrams sent
+    */
+    size_t sendBatch(const std::vector<std::shared_ptr<std::vector<uint8_t>>>& batch);
+
     /**
     * @brief maintains the process thread
     *
-    * This will parse through the incoming UDP packets to find what looks like a
-    * valid J2735 message. The UPER scheme makes it hard to definitively know if
-    * a message is valid or just noise, so all possible messages from a packet are
-    * sent. This will create some false positives, but will ensure that a falsely
-    * identified message doesn't keep a real one from getting through.
+    * This will use the J2735Framer to find what looks like a valid J2735 message
+    * in the incoming UDP packets. The UPER scheme makes it hard to definitively know if
+    * a message is valid or just noise, so when no message with a known id is found the
+    * first plausible frame is sent. This will create some false positives, but will ensure
+    * that a falsely identified message doesn't keep a real one from getting through.
     */
     void process(const std::shared_ptr<const std::vector<uint8_t>> &data);
 };
\ No newline at end of file
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstring>
+#include <iostream>
+#include "j2735_framer.h"
+
+void J2735Framer::setKnownMessageIds(const std::vector<uint16_t>& ids)
+{
+    known_ids_.reset();
+    has_known_ids_ = !ids.empty();
+    use_sentinel_ = false;
+
+    bool shared_high = has_known_ids_;
+    bool shared_low = has_known_ids_;
+    uint8_t high = has_known_ids_ ? static_cast<uint8_t>(ids.front() >> 8) : 0;
+    uint8_t low = has_known_ids_ ? static_cast<uint8_t>(ids.front() & 0xFF) : 0;
+
+    for (uint16_t id : ids)
+    {
+        known_ids_.set(id);
+        shared_high = shared_high && static_cast<uint8_t>(id >> 8) == high;
+        shared_low = shared_low && static_cast<uint8_t>(id & 0xFF) == low;
+    }
+
+    // Zero bytes are frequent in UPER payloads so they would find a candidate at nearly every offset
+    if (shared_high && high != 0)
+    {
+        use_sentinel_ = true;
+        sentinel_ = high;
+        sentinel_offset_ = 0;
+    }
+    else if (shared_low && low != 0)
+    {
+        use_sentinel_ = true;
+        sentinel_ = low;
+        sentinel_offset_ = 1;
+    }
+}
+
+bool J2735Framer::frameAt(const uint8_t* data, size_t size, size_t i, Frame& frame)
+{
+    // Valid message should begin with 2 bytes message ID and 1 byte length, and leave a byte for the body or 2nd length byte
+    if (size < 4 || i >= size - 3)
+    {
+        return false;
+    }
+
+    size_t len = 0;
+    size_t len_byte_1 = data[i + 2];
+    size_t len_bytes = 0;
+    // length < 128 encoded by single byte with msb set to 0
+    if ((len_byte_1 & 0x80) == 0x00)
+    {
+        len = len_byte_1;
+        len_bytes = 1;
+        // check for 0 length
+        if (len == 0)
+        {
+            return false;
+        }
+    }
+    // length < 16384 encoded by 14 bits in 2 bytes (10xxxxxx xxxxxxxx)
+    else if ((len_byte_1 & 0x40) == 0x00)
+    {
+        size_t len_byte_2 = data[i + 3];
+        len = ((len_byte_1 & 0x3f) << 8) | len_byte_2;
+        len_bytes = 2;
+    }
+    else
+    {
+        // TODO lengths greater than 16383 (0x3FFF) are encoded by splitting up the message into discrete chunks, each with its own length
+        // marker. It doesn't look like we'll be receiving anything that long
+        std::cerr << "J2735Framer::frameAt() : received a message with length field longer than 16383." << std::endl;
+        return false;
+    }
+
+    // The frame must fit in the datagram
+    size_t end_index = i + 2 + len_bytes + len;
+    if (end_index > size)
+    {
+        return false;
+    }
+
+    frame.offset = i;
+    frame.length = end_index - i;
+    frame.msg_id = static_cast<uint16_t>((static_cast<uint16_t>(data[i]) << 8) | data[i + 1]);
+    return true;
+}
+
+bool J2735Framer::findKnownFrame(const uint8_t* data, size_t size, Frame& frame) const
+{
+    if (size < 4)
+    {
+        return false;
+    }
+    const size_t last_start = size - 4;
+
+    if (use_sentinel_)
+    {
+        // memchr is vectorized by the C library so candidates are found without visiting each byte here
+        const uint8_t* cursor = data + sentinel_offset_;
+        const uint8_t* end = data + last_start + 1 + sentinel_offset_;
+        while (cursor < end)
+        {
+            const void* found = std::memchr(cursor, sentinel_, end - cursor);
+            if (!found)
+            {
+                return false;
+            }
+            size_t i = static_cast<const uint8_t*>(found) - data - sentinel_offset_;
+            uint16_t msg_id = static_cast<uint16_t>((static_cast<uint16_t>(data[i]) << 8) | data[i + 1]);
+            if (known_ids_.test(msg_id) && frameAt(data, size, i, frame))
+            {
+                return true;
+            }
+            cursor = data + i + sentinel_offset_ + 1;
+        }
+        return false;
+    }
+
+    for (size_t i = 0; i <= last_start; i++)
+    {
+        uint16_t msg_id = static_cast<uint16_t>((static_cast<uint16_t>(data[i]) << 8) | data[i + 1]);
+        if (known_ids_.test(msg_id) && frameAt(data, size, i, frame))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool J2735Framer::findFrame(const uint8_t* data, size_t size, Frame& frame) const
+{
+    if (has_known_ids_ && findKnownFrame(data, size, frame))
+    {
+        return true;
+    }
+
+    // The UPER scheme makes it hard to definitively know if a message is valid or just noise, so if no
+    // known message was found accept the first offset with a plausible header
+    for (size_t i = 0; i + 3 < size; i++)
+    {
+        if (frameAt(data, size, i, frame))
+        {
+            return true;
+        }
+    }
+    return false;
+}
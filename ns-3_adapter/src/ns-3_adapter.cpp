@@ -4,6 +4,7 @@
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/schema.h>
 #include <cav_msgs/ByteArray.h>
+#include <algorithm>
 #include <fstream>
 
 std::string NS3Adapter::uint8_vector_to_hex_string(const std::vector<uint8_t>& v) {
@@ -31,10 +32,27 @@ void NS3Adapter::initialize() {
     std::string wave_cfg_file;
     ros::NodeHandle pnh("~");
     pnh.param<std::string>("wave_cfg_file",wave_cfg_file,"etc/wave.json");
+    pnh.param<int>("max_send_queue_size", max_send_queue_size_, max_send_queue_size_);
     //pnh.param<int>("listening_port",config_.listening_port, 5398);
     //pnh.param<int>("dsrc_listening_port",config_.dsrc_listening_port, 1516);
     //pnh.param<std::string>("dsrc_address",config_.dsrc_address, "169.254.1.1");    
     loadWaveConfig(wave_cfg_file);
+
+    // Message ids from the wave config let the client locate inbound frames without scanning every byte
+    std::vector<uint16_t> known_ids;
+    for (const auto& item : wave_cfg_items_)
+    {
+        try
+        {
+            known_ids.push_back(static_cast<uint16_t>(std::stoul(item.ns3_id)));
+        }
+        catch (const std::exception& e)
+        {
+            ROS_WARN_STREAM("Ignoring invalid ns3_id " << item.ns3_id << " for wave config entry " << item.name);
+        }
+    }
+    ns3_client_.setKnownMessageIds(known_ids);
+    ns3_client_.setMaxSendQueueSize(static_cast<size_t>(std::max(1, max_send_queue_size_)));
     //comms_api_nh_.reset(new ros::NodeHandle("comms"));
     //dyn_cfg_server_.reset(new dynamic_reconfigure::Server<dsrc::DSRCConfig>(dyn_cfg_mutex_));
     //dyn_cfg_server_->updateConfig(config_);
@@ -171,7 +189,7 @@ std::vector<uint8_t> NS3Adapter::packMessage(const cav_msgs::ByteArray& message)
 * @brief Handles outbound messages from the ROS network
 * @param message
 *
-* This method receives a message from the ROS network, and adds it to the send queue.
+* This method receives a message from the ROS network, and adds it to the client's send queue.
 */
 void NS3Adapter::onOutboundMessage(const cav_msgs::ByteArrayPtr& message) {
     if(!ns3_client_.connected())
@@ -180,24 +198,9 @@ void NS3Adapter::onOutboundMessage(const cav_msgs::ByteArrayPtr& message) {
         return;
     }
     
-    std::shared_ptr<std::vector<uint8_t>> message_content = std::make_shared<std::vector<uint8_t>>(std::move(packMessage(*message)));
-    send_msg_queue_.push_back(std::move(message_content));
-}
-
-/**
-* @brief Sends a message from the queue of outbound messages
-*/
-void NS3Adapter::sendMessageFromQueue() {
-    if (!send_msg_queue_.empty()) {
-        ROS_DEBUG_STREAM("Sending message: " << std::string(send_msg_queue_.front()->begin(),send_msg_queue_.front()->end()));
-        bool success = ns3_client_.sendNS3Message(send_msg_queue_.front());
-        send_msg_queue_.pop_front();
-        if (!success) {
-            ROS_WARN_STREAM("Message send failed");
-        }
-        else {
-            ROS_DEBUG("Message successfully sent from queue");
-        }
+    std::shared_ptr<std::vector<uint8_t>> message_content = std::make_shared<std::vector<uint8_t>>(packMessage(*message));
+    if (!ns3_client_.sendNS3Message(message_content)) {
+        ROS_WARN_STREAM("Message send failed");
     }
 }
 
@@ -283,7 +286,17 @@ void NS3Adapter::pre_spin()
 
 
 void NS3Adapter::post_spin() {
-    sendMessageFromQueue();
+    NS3Client::SendMetrics metrics = ns3_client_.getSendMetrics();
+    if (metrics.dropped > last_reported_drops_)
+    {
+        ROS_WARN_STREAM_THROTTLE(1.0, "NS-3 send queue full, dropped " << metrics.dropped - last_reported_drops_
+                                      << " messages. Queue depth: " << metrics.queue_depth
+                                      << " max depth: " << metrics.max_queue_depth);
+        last_reported_drops_ = metrics.dropped;
+    }
+    ROS_DEBUG_STREAM_THROTTLE(5.0, "NS-3 send metrics enqueued: " << metrics.enqueued << " sent: " << metrics.sent
+                                   << " errors: " << metrics.send_errors << " batches: " << metrics.batches
+                                   << " max batch: " << metrics.max_batch_size);
 }
 
 /*void NS3Adapter::dynReconfigCB(dsrc::DSRCConfig & cfg, uint32_t level)
@@ -412,7 +425,7 @@ cav_msgs::DriverStatus NS3Adapter::getDriverStatus()
     return getStatus();
 }
 
-std::deque<std::shared_ptr<std::vector<uint8_t>>> NS3Adapter::getMsgQueue()
+NS3Client::SendMetrics NS3Adapter::getSendMetrics() const
 {
-    return send_msg_queue_;
+    return ns3_client_.getSendMetrics();
 }
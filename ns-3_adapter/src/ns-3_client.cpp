@@ -1,7 +1,17 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <iostream>
 #include <functional>
 #include "ns-3_client.h"
 
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+constexpr size_t NS3Client::MAX_FLUSH_SIZE;
+
 NS3Client::NS3Client() :
     running_(false)
 {}
@@ -91,77 +101,170 @@ void NS3Client::close() {
     io_thread_->join();
     udp_listener_->stop();
     udp_out_socket_.reset();
+    {
+        // A flush posted before the io service stopped will never run
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        send_queue_.clear();
+        flush_pending_ = false;
+        in_flight_ = 0;
+    }
     onDisconnect();
 }
 
 void NS3Client::process(const std::shared_ptr<const std::vector<uint8_t>>& data)
 {
     auto & entry = *data;
-    // Valid message should begin with 2 bytes message ID and 1 byte length.
-    for (size_t i = 0; i < entry.size() - 3; i++) { // leave 3 bytes after (for lsb of id, length byte 1, and either message body or length byte 2)
-        // Generate the 16-bit message id from two bytes, skip if it isn't a valid one
-        uint16_t msg_id = (static_cast<uint16_t>(entry[i]) << 8) | static_cast<uint16_t>(entry[i + 1]);
-
-        // Parse the length, check it doesn't run over
-        size_t len = 0;
-        size_t len_byte_1 = entry[i + 2];
-        int len_bytes = 0;
-        // length < 128 encoded by single byte with msb set to 0
-        if ((len_byte_1 & 0x80 ) == 0x00) {
-            len = static_cast<size_t>(len_byte_1);
-            len_bytes = 1;
-            // check for 0 length
-            if (len_byte_1 == 0x00) { continue; }
+    J2735Framer::Frame frame;
+    if (!framer_.findFrame(entry.data(), entry.size(), frame)) {
+        return;
+    }
+
+    // The frame is normally the whole datagram in which case it is passed on without a copy
+    if (frame.offset == 0 && frame.length == entry.size()) {
+        onMessageReceived(entry, frame.msg_id);
+        return;
+    }
+
+    std::vector<uint8_t> msg_vec(entry.begin() + frame.offset, entry.begin() + frame.offset + frame.length);
+    onMessageReceived(msg_vec, frame.msg_id);
+}
+
+bool NS3Client::sendNS3Message(const std::shared_ptr<std::vector<uint8_t>>&message) {
+    if(!running_) return false;
+
+    bool post_flush = false;
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        if (send_queue_.size() >= max_send_queue_size_ && !send_queue_.empty()) {
+            send_queue_.pop_front();
+            send_metrics_.dropped++;
         }
-            // length < 16384 encoded by 14 bits in 2 bytes (10xxxxxx xxxxxxxx)
-        else if ((len_byte_1 & 0x40) == 0x00) { //we know msb = 1, check that next bit is 0
-            if (i + 3 < entry.size()) {
-                size_t len_byte_2 = entry[i + 3];
-                len = ((len_byte_1 & 0x3f) << 8) | len_byte_2;
-                len_bytes = 2;
-            }
+        send_queue_.push_back(message);
+        send_metrics_.enqueued++;
+        send_metrics_.max_queue_depth = std::max(send_metrics_.max_queue_depth, send_queue_.size());
+
+        // Only one flush is outstanding at a time. It will pick up everything queued before it runs
+        if (!flush_pending_) {
+            flush_pending_ = true;
+            post_flush = true;
         }
-        else {
-            // TODO lengths greater than 16383 (0x3FFF) are encoded by splitting up the message into discrete chunks, each with its own length
-            // marker. It doesn't look like we'll be receiving anything that long
-            std::cerr << "NS3Client::process() : received a message with length field longer than 16383." << std::endl;
-            continue;
+    }
+
+    if (post_flush) {
+        try {
+            output_strand_->post([this]() { flushSendQueue(); });
         }
-        if (len == -1) { continue; }
-        // If the length makes sense bsmPub(fits in the buffer), copy out the message bytes and pass to the Application class
-        if ((i + 1 + len + len_bytes) < entry.size()) {
-            // bool found_valid_msg = true;
-            size_t start_index = i;
-            size_t end_index = i + 2 + len + len_bytes; // includes 2 msgID bytes before message body
-            //this constructor has range [first, last) hence the + 1
-            std::vector<uint8_t> msg_vec(entry.begin() + start_index, entry.begin() + end_index);
-            onMessageReceived(msg_vec, msg_id);
-            break;
+        catch (std::exception& e) {
+            std::lock_guard<std::mutex> lock(send_mutex_);
+            flush_pending_ = false;
+            return false;
         }
     }
+    return true;
 }
 
-bool NS3Client::sendNS3Message(const std::shared_ptr<std::vector<uint8_t>>&message) {
-    if(!running_) return false;
-    try {
-        output_strand_->post([this,message]()
-                             {
-                                 try
-                                 {
-                                     udp_out_socket_->send_to(boost::asio::buffer(*message), remote_udp_ep_);
-                                 }
-                                 catch(boost::system::system_error error_code)
-                                 {
-                                     onError(error_code.code());
-                                 }
-                                 catch(...)
-                                 {
-                                     onError(boost::asio::error::fault);
-                                 }
-                             });
-        return true;
-    }
-    catch (std::exception& e) {
-        return false;
+void NS3Client::flushSendQueue() {
+    send_batch_.clear();
+    bool repost = false;
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        // Bound the work done per handler so received packets are not starved during a burst
+        size_t count = std::min(send_queue_.size(), MAX_FLUSH_SIZE);
+        send_batch_.insert(send_batch_.end(), send_queue_.begin(), send_queue_.begin() + count);
+        send_queue_.erase(send_queue_.begin(), send_queue_.begin() + count);
+        in_flight_ = count;
+        repost = !send_queue_.empty();
+        flush_pending_ = repost;
+    }
+
+    if (repost) {
+        output_strand_->post([this]() { flushSendQueue(); });
+    }
+
+    if (send_batch_.empty()) {
+        return;
     }
+
+    size_t sent = 0;
+    try
+    {
+        sent = sendBatch(send_batch_);
+    }
+    catch(boost::system::system_error error_code)
+    {
+        onError(error_code.code());
+    }
+    catch(...)
+    {
+        onError(boost::asio::error::fault);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(send_mutex_);
+        send_metrics_.batches++;
+        send_metrics_.sent += sent;
+        send_metrics_.send_errors += send_batch_.size() - sent;
+        send_metrics_.max_batch_size = std::max(send_metrics_.max_batch_size, send_batch_.size());
+        in_flight_ = 0;
+    }
+    send_batch_.clear();
+}
+
+size_t NS3Client::sendBatch(const std::vector<std::shared_ptr<std::vector<uint8_t>>>& batch) {
+#if defined(__linux__)
+    // Write up to MAX_MMSG datagrams per system call
+    constexpr size_t MAX_MMSG = 64;
+    struct mmsghdr msgs[MAX_MMSG];
+    struct iovec iovecs[MAX_MMSG];
+    size_t sent = 0;
+
+    while (sent < batch.size()) {
+        size_t count = std::min(MAX_MMSG, batch.size() - sent);
+        for (size_t i = 0; i < count; i++) {
+            auto& message = *batch[sent + i];
+            iovecs[i].iov_base = message.data();
+            iovecs[i].iov_len = message.size();
+            std::memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+            msgs[i].msg_hdr.msg_name = remote_udp_ep_.data();
+            msgs[i].msg_hdr.msg_namelen = remote_udp_ep_.size();
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int result = ::sendmmsg(udp_out_socket_->native_handle(), msgs, count, 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                // Kernel buffer is full. Remaining datagrams are counted as send errors
+                break;
+            }
+            throw boost::system::system_error(boost::system::error_code(errno, boost::system::system_category()));
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return sent;
+#else
+    for (auto& message : batch) {
+        udp_out_socket_->send_to(boost::asio::buffer(*message), remote_udp_ep_);
+    }
+    return batch.size();
+#endif
+}
+
+void NS3Client::setMaxSendQueueSize(size_t max_size) {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    max_send_queue_size_ = max_size;
+}
+
+void NS3Client::setKnownMessageIds(const std::vector<uint16_t>& ids) {
+    framer_.setKnownMessageIds(ids);
+}
+
+NS3Client::SendMetrics NS3Client::getSendMetrics() const {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    SendMetrics metrics = send_metrics_;
+    metrics.queue_depth = send_queue_.size() + in_flight_;
+    return metrics;
 }
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Loopback benchmark of the NS-3 client. A local echo thread stands in for NS-3 and returns every
+ * datagram the client sends, so both the batched send path and the inbound framing are exercised.
+ * Run with: rosrun ns-3_adapter ns-3_adapter-client-benchmark [messages]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <boost/asio.hpp>
+#include "ns-3_client.h"
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile size_t g_sink = 0;
+
+// Equivalent of the per offset scan NS3Client::process performed before J2735Framer
+size_t legacyScan(const std::vector<uint8_t>& entry)
+{
+    for (size_t i = 0; i < entry.size() - 3; i++)
+    {
+        size_t len = 0;
+        size_t len_byte_1 = entry[i + 2];
+        size_t len_bytes = 0;
+        if ((len_byte_1 & 0x80) == 0x00)
+        {
+            len = len_byte_1;
+            len_bytes = 1;
+            if (len == 0) { continue; }
+        }
+        else if ((len_byte_1 & 0x40) == 0x00)
+        {
+            len = ((len_byte_1 & 0x3f) << 8) | entry[i + 3];
+            len_bytes = 2;
+        }
+        else
+        {
+            continue;
+        }
+        if ((i + 1 + len + len_bytes) < entry.size())
+        {
+            std::vector<uint8_t> msg_vec(entry.begin() + i, entry.begin() + i + 2 + len + len_bytes);
+            return msg_vec.size();
+        }
+    }
+    return 0;
+}
+
+template <typename F>
+void run(const std::string& name, size_t iterations, F&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    std::cout << name << ": " << ns << " ns/msg" << std::endl;
+}
+
+// Wakes the blocked echo thread with an empty datagram and waits for it to exit
+void stopEcho(std::atomic<bool>& running, boost::asio::io_service& io, unsigned short port, std::thread& thread)
+{
+    running = false;
+    boost::asio::ip::udp::socket socket(io, boost::asio::ip::udp::v4());
+    boost::system::error_code ec;
+    socket.send_to(boost::asio::buffer(&port, 0),
+                   boost::asio::ip::udp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), port), 0, ec);
+    thread.join();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    size_t messages = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    // A BSM sized frame preceded by bytes that the legacy scan must step over, as seen when
+    // the simulator prepends a header to the payload
+    std::vector<uint8_t> datagram = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x14, 0x81, 0x20};
+    datagram.resize(datagram.size() + 0x120, 0xC3);
+
+    std::cout << "NS-3 client benchmark (" << messages << " messages)" << std::endl;
+
+    J2735Framer framer;
+    framer.setKnownMessageIds({0x0012, 0x0013, 0x0014, 0x00F0});
+    J2735Framer::Frame frame;
+    run("framing legacy scan  ", messages, [&]() { g_sink = g_sink + legacyScan(datagram); });
+    run("framing J2735Framer  ", messages, [&]() {
+        framer.findFrame(datagram.data(), datagram.size(), frame);
+        g_sink = g_sink + frame.length;
+    });
+
+    // Echo thread standing in for NS-3
+    const unsigned short client_port = 5398;
+    boost::asio::io_service echo_io;
+    boost::asio::ip::udp::socket echo_socket(echo_io, boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), 0));
+    unsigned short echo_port = echo_socket.local_endpoint().port();
+    boost::asio::ip::udp::endpoint client_ep(boost::asio::ip::address::from_string("127.0.0.1"), client_port);
+    std::atomic<bool> echo_running(true);
+    std::thread echo_thread([&]() {
+        std::vector<uint8_t> buf(65535);
+        boost::asio::ip::udp::endpoint sender;
+        while (echo_running)
+        {
+            boost::system::error_code ec;
+            size_t n = echo_socket.receive_from(boost::asio::buffer(buf), sender, 0, ec);
+            if (ec || !echo_running) break;
+            echo_socket.send_to(boost::asio::buffer(buf.data(), n), client_ep, 0, ec);
+        }
+    });
+
+    std::atomic<size_t> received(0);
+    NS3Client client;
+    client.setKnownMessageIds({0x0012, 0x0013, 0x0014, 0x00F0});
+    client.setMaxSendQueueSize(messages);
+    client.onMessageReceived.connect([&](const std::vector<uint8_t>&, uint16_t) { received++; });
+    if (!client.connect("127.0.0.1", echo_port, client_port))
+    {
+        std::cerr << "Unable to bind client port " << client_port << std::endl;
+        stopEcho(echo_running, echo_io, echo_port, echo_thread);
+        return 1;
+    }
+
+    auto payload = std::make_shared<std::vector<uint8_t>>(datagram);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < messages; i++)
+    {
+        client.sendNS3Message(payload);
+    }
+    // Wait until the send queue has drained and echoes stop arriving
+    size_t last_received = 0;
+    do
+    {
+        last_received = received;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    } while (client.getSendMetrics().queue_depth > 0 || received != last_received);
+    auto end = std::chrono::steady_clock::now();
+
+    NS3Client::SendMetrics metrics = client.getSendMetrics();
+    double seconds = std::chrono::duration<double>(end - start).count() - 0.1;
+    std::cout << "loopback: " << metrics.sent / seconds << " msg/s sent, " << received << " echoes received" << std::endl;
+    std::cout << "  enqueued " << metrics.enqueued << " sent " << metrics.sent << " dropped " << metrics.dropped
+              << " errors " << metrics.send_errors << " batches " << metrics.batches << " max batch "
+              << metrics.max_batch_size << " max depth " << metrics.max_queue_depth << std::endl;
+
+    client.close();
+    stopEcho(echo_running, echo_io, echo_port, echo_thread);
+    return 0;
+}
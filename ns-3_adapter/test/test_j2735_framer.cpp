@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <j2735_framer.h>
+#include <gtest/gtest.h>
+
+TEST(J2735FramerTest, testWholeDatagram)
+{
+    J2735Framer framer;
+    J2735Framer::Frame frame;
+
+    // BSM id 0x0014 with a 3 byte body
+    std::vector<uint8_t> data = {0x00, 0x14, 0x03, 0xAA, 0xBB, 0xCC};
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 0);
+    EXPECT_EQ(frame.length, data.size());
+    EXPECT_EQ(frame.msg_id, 0x0014);
+
+    // Body runs past the end of the datagram
+    data = {0x00, 0x14, 0x09, 0xAA, 0xBB, 0xCC};
+    EXPECT_FALSE(framer.findFrame(data.data(), data.size(), frame));
+
+    // Too short to hold a header
+    data = {0x00, 0x14, 0x01};
+    EXPECT_FALSE(framer.findFrame(data.data(), data.size(), frame));
+}
+
+TEST(J2735FramerTest, testTwoByteLength)
+{
+    J2735Framer framer;
+    J2735Framer::Frame frame;
+
+    std::vector<uint8_t> data = {0x00, 0x14, 0x81, 0x00};
+    data.resize(4 + 256, 0x55);
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 0);
+    EXPECT_EQ(frame.length, data.size());
+
+    // Lengths above 16383 are not supported
+    data = {0x00, 0x14, 0xC0, 0x00, 0x00};
+    EXPECT_FALSE(J2735Framer::frameAt(data.data(), data.size(), 0, frame));
+}
+
+TEST(J2735FramerTest, testKnownIdsPreferred)
+{
+    J2735Framer framer;
+    J2735Framer::Frame frame;
+
+    // Leading bytes form a plausible frame with an unknown id before the SPaT message (0x0013)
+    std::vector<uint8_t> data = {0x7F, 0x01, 0x01, 0x00, 0x13, 0x02, 0xAA, 0xBB};
+
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 0);
+    EXPECT_EQ(frame.msg_id, 0x7F01);
+
+    framer.setKnownMessageIds({0x0013, 0x0014});
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 3);
+    EXPECT_EQ(frame.length, 5);
+    EXPECT_EQ(frame.msg_id, 0x0013);
+
+    // Ids which share no nonzero byte use the per byte search
+    framer.setKnownMessageIds({0x0013, 0x7F02});
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 3);
+
+    // Ids sharing a nonzero low byte are located by it
+    framer.setKnownMessageIds({0x0013, 0x7E13});
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 3);
+    EXPECT_EQ(frame.msg_id, 0x0013);
+
+    // And ids sharing a nonzero high byte by that
+    std::vector<uint8_t> high_data = {0x00, 0x00, 0x7F, 0x7F, 0x02, 0x01, 0xAA, 0x00};
+    framer.setKnownMessageIds({0x7F02, 0x7F03});
+    ASSERT_TRUE(framer.findFrame(high_data.data(), high_data.size(), frame));
+    EXPECT_EQ(frame.offset, 3);
+    EXPECT_EQ(frame.msg_id, 0x7F02);
+
+    // With no known message the first plausible frame is still returned
+    framer.setKnownMessageIds({0x00F0});
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 0);
+
+    framer.setKnownMessageIds({});
+    ASSERT_TRUE(framer.findFrame(data.data(), data.size(), frame));
+    EXPECT_EQ(frame.offset, 0);
+}
@@ -84,8 +84,8 @@ TEST(NS3AdapterTest, testonOutboundMessage)
     ROS_ERROR_STREAM("THISISATEST");
     //message->content.push_back(msg);
     worker.onOutboundMessage(message);
-    auto msg_q = worker.getMsgQueue();
-    EXPECT_EQ(msg_q.size(), 0);*/
+    auto metrics = worker.getSendMetrics();
+    EXPECT_EQ(metrics.queue_depth, 0);*/
 
 }
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef BATCHED_POSE_TRANSFORM_H
+#define BATCHED_POSE_TRANSFORM_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <geometry_msgs/msg/transform.hpp>
+
+namespace object{
+
+/**
+ * \brief Structure of arrays holding the pose and position covariance of every object in a frame.
+ *
+ * Each member has one entry per object so a transform can be applied to all objects with simple loops over contiguous
+ * arrays which the compiler can vectorize.
+ */
+struct ObjectPoseBatch
+{
+  /**
+   * \brief Resizes every array to hold the provided number of objects
+   */
+  void resize(size_t size);
+
+  /**
+   * \brief Returns the number of objects in the batch
+   */
+  size_t size() const;
+
+  // Centroid position
+  std::vector<double> x, y, z;
+
+  // Orientation quaternion
+  std::vector<double> qx, qy, qz, qw;
+
+  // Row major 3x3 position covariance. covariance[3 * row + col][i] is the element of object i
+  std::array<std::vector<double>, 9> covariance;
+};
+
+/**
+ * \brief Rigid transform which is applied to every pose of an ObjectPoseBatch.
+ *
+ * The rotation matrix is computed once on construction. Applying the transform gives the same positions and covariances
+ * as tf2::doTransform for each pose followed by covariance_helper::transformCovariance. Orientations are the normalized
+ * quaternion product, which is the same rotation as doTransform produces but may differ in sign.
+ */
+class BatchedPoseTransform
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param transform The transform from the frame of the batch to the output frame
+   */
+  explicit BatchedPoseTransform(const geometry_msgs::msg::Transform& transform);
+
+  /**
+   * \brief Transforms every position, orientation and position covariance of the batch in place
+   *
+   * \param batch The batch to transform
+   */
+  void apply(ObjectPoseBatch& batch) const;
+
+  /**
+   * \brief Returns the row major rotation matrix of the transform
+   */
+  const std::array<double, 9>& rotation() const;
+
+  /**
+   * \brief Returns R * R' for the rotation matrix R of the transform.
+   *
+   * This is the transformed orientation covariance of an object whose orientation covariance is the identity.
+   * Since it does not depend on the object it is computed once per transform.
+   */
+  const std::array<double, 9>& identityCovariance() const;
+
+private:
+  std::array<double, 9> rotation_;
+  std::array<double, 9> identity_covariance_;
+  double tx_, ty_, tz_;
+  double qx_, qy_, qz_, qw_;
+};
+
+}//object
+
+#endif /* BATCHED_POSE_TRANSFORM_H */
@@ -59,9 +59,10 @@ class ObjectDetectionTrackingNode : public carma_ros2_utils::CarmaLifecycleNode
   explicit ObjectDetectionTrackingNode(const rclcpp::NodeOptions& );
 
      /*! \fn publishObject()
-    \brief Callback to publish ObjectList
+    \brief Callback to publish ObjectList. Ownership of the message is passed to the publisher so intra-process
+     subscribers such as motion_computation receive it without a copy
    */
-  void publishObject(const carma_perception_msgs::msg::ExternalObjectList& obj_msg);
+  void publishObject(carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_msg);
 
   /*!
   * \brief Callback to lookup a transform between two frames
@@ -32,6 +32,7 @@
 #include <tf2_ros/transform_listener.h>
 #include <tf2_eigen/tf2_eigen.h>
 #include <boost/optional.hpp>
+#include "batched_pose_transform.h"
 
 namespace object{
 
@@ -40,7 +41,7 @@ class ObjectDetectionTrackingWorker
 
  public:
 
-  using PublishObjectCallback = std::function<void(const carma_perception_msgs::msg::ExternalObjectList&)>;
+  using PublishObjectCallback = std::function<void(carma_perception_msgs::msg::ExternalObjectList::UniquePtr)>;
 
   /**
    * Function which will return the most recent transform between the provided frames
@@ -82,6 +83,9 @@ class ObjectDetectionTrackingWorker
 
   // Logger interface
   rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr logger_;
+
+  // Poses of the objects in the current frame. Kept between frames to reuse its storage
+  ObjectPoseBatch pose_batch_;
   
 
   /**
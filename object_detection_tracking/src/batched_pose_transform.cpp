@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cmath>
+#include "batched_pose_transform.h"
+
+namespace object
+{
+
+void ObjectPoseBatch::resize(size_t size)
+{
+  x.resize(size);
+  y.resize(size);
+  z.resize(size);
+  qx.resize(size);
+  qy.resize(size);
+  qz.resize(size);
+  qw.resize(size);
+  for (auto& element : covariance)
+  {
+    element.resize(size);
+  }
+}
+
+size_t ObjectPoseBatch::size() const
+{
+  return x.size();
+}
+
+BatchedPoseTransform::BatchedPoseTransform(const geometry_msgs::msg::Transform& transform)
+  : tx_(transform.translation.x), ty_(transform.translation.y), tz_(transform.translation.z),
+    qx_(transform.rotation.x), qy_(transform.rotation.y), qz_(transform.rotation.z), qw_(transform.rotation.w)
+{
+  // Same construction as tf2::Matrix3x3::setRotation so results match the per object tf2 path
+  double s = 2.0 / (qx_ * qx_ + qy_ * qy_ + qz_ * qz_ + qw_ * qw_);
+  double xs = qx_ * s, ys = qy_ * s, zs = qz_ * s;
+  double wx = qw_ * xs, wy = qw_ * ys, wz = qw_ * zs;
+  double xx = qx_ * xs, xy = qx_ * ys, xz = qx_ * zs;
+  double yy = qy_ * ys, yz = qy_ * zs, zz = qz_ * zs;
+
+  rotation_ = { 1.0 - (yy + zz), xy - wz, xz + wy,
+                xy + wz, 1.0 - (xx + zz), yz - wx,
+                xz - wy, yz + wx, 1.0 - (xx + yy) };
+
+  const auto& R = rotation_;
+  for (size_t r = 0; r < 3; r++)
+  {
+    for (size_t c = 0; c < 3; c++)
+    {
+      identity_covariance_[3 * r + c] = R[3 * r] * R[3 * c] + R[3 * r + 1] * R[3 * c + 1] + R[3 * r + 2] * R[3 * c + 2];
+    }
+  }
+}
+
+void BatchedPoseTransform::apply(ObjectPoseBatch& batch) const
+{
+  const size_t size = batch.size();
+  const auto& R = rotation_;
+
+  // Positions
+  double* x = batch.x.data();
+  double* y = batch.y.data();
+  double* z = batch.z.data();
+  for (size_t i = 0; i < size; i++)
+  {
+    double px = x[i], py = y[i], pz = z[i];
+    x[i] = R[0] * px + R[1] * py + R[2] * pz + tx_;
+    y[i] = R[3] * px + R[4] * py + R[5] * pz + ty_;
+    z[i] = R[6] * px + R[7] * py + R[8] * pz + tz_;
+  }
+
+  // Orientations as the transform rotation applied to each object rotation
+  double* qx = batch.qx.data();
+  double* qy = batch.qy.data();
+  double* qz = batch.qz.data();
+  double* qw = batch.qw.data();
+  for (size_t i = 0; i < size; i++)
+  {
+    double bx = qx[i], by = qy[i], bz = qz[i], bw = qw[i];
+    double ox = qw_ * bx + qx_ * bw + qy_ * bz - qz_ * by;
+    double oy = qw_ * by - qx_ * bz + qy_ * bw + qz_ * bx;
+    double oz = qw_ * bz + qx_ * by - qy_ * bx + qz_ * bw;
+    double ow = qw_ * bw - qx_ * bx - qy_ * by - qz_ * bz;
+    double inv_norm = 1.0 / std::sqrt(ox * ox + oy * oy + oz * oz + ow * ow);
+    qx[i] = ox * inv_norm;
+    qy[i] = oy * inv_norm;
+    qz[i] = oz * inv_norm;
+    qw[i] = ow * inv_norm;
+  }
+
+  // Covariances as R * C * R' evaluated in the same order as covariance_helper::transformCovariance
+  std::array<double*, 9> C;
+  for (size_t k = 0; k < 9; k++)
+  {
+    C[k] = batch.covariance[k].data();
+  }
+  for (size_t i = 0; i < size; i++)
+  {
+    double c0 = C[0][i], c1 = C[1][i], c2 = C[2][i];
+    double c3 = C[3][i], c4 = C[4][i], c5 = C[5][i];
+    double c6 = C[6][i], c7 = C[7][i], c8 = C[8][i];
+
+    // M = R * C
+    double m0 = R[0] * c0 + R[1] * c3 + R[2] * c6;
+    double m1 = R[0] * c1 + R[1] * c4 + R[2] * c7;
+    double m2 = R[0] * c2 + R[1] * c5 + R[2] * c8;
+    double m3 = R[3] * c0 + R[4] * c3 + R[5] * c6;
+    double m4 = R[3] * c1 + R[4] * c4 + R[5] * c7;
+    double m5 = R[3] * c2 + R[4] * c5 + R[5] * c8;
+    double m6 = R[6] * c0 + R[7] * c3 + R[8] * c6;
+    double m7 = R[6] * c1 + R[7] * c4 + R[8] * c7;
+    double m8 = R[6] * c2 + R[7] * c5 + R[8] * c8;
+
+    // M * R'
+    C[0][i] = m0 * R[0] + m1 * R[1] + m2 * R[2];
+    C[1][i] = m0 * R[3] + m1 * R[4] + m2 * R[5];
+    C[2][i] = m0 * R[6] + m1 * R[7] + m2 * R[8];
+    C[3][i] = m3 * R[0] + m4 * R[1] + m5 * R[2];
+    C[4][i] = m3 * R[3] + m4 * R[4] + m5 * R[5];
+    C[5][i] = m3 * R[6] + m4 * R[7] + m5 * R[8];
+    C[6][i] = m6 * R[0] + m7 * R[1] + m8 * R[2];
+    C[7][i] = m6 * R[3] + m7 * R[4] + m8 * R[5];
+    C[8][i] = m6 * R[6] + m7 * R[7] + m8 * R[8];
+  }
+}
+
+const std::array<double, 9>& BatchedPoseTransform::rotation() const
+{
+  return rotation_;
+}
+
+const std::array<double, 9>& BatchedPoseTransform::identityCovariance() const
+{
+  return identity_covariance_;
+}
+
+}  // namespace object
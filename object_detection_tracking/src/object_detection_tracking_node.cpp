@@ -70,9 +70,12 @@ namespace object{
     return CallbackReturn::SUCCESS;
   }
 
-  void ObjectDetectionTrackingNode::publishObject(const carma_perception_msgs::msg::ExternalObjectList& obj_msg)
+  void ObjectDetectionTrackingNode::publishObject(carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_msg)
   {
-    carma_obj_pub_->publish(obj_msg);
+    RCLCPP_DEBUG_STREAM(get_logger(), "Publishing " << obj_msg->objects.size() << " external objects "
+      << (now() - rclcpp::Time(obj_msg->header.stamp, get_clock()->get_clock_type())).seconds() * 1000.0 << " ms after sensor stamp");
+
+    carma_obj_pub_->publish(std::move(obj_msg));
   }
 
   boost::optional<geometry_msgs::msg::TransformStamped> 
@@ -20,7 +20,6 @@
 #include <tf2/transform_datatypes.h>
 #include <tf2_ros/transform_listener.h>
 #include <tf2_eigen/tf2_eigen.h>
-#include "covariance_helper.h"
 
 namespace object
 {
@@ -39,9 +38,10 @@ bool ObjectDetectionTrackingWorker::isClass(const autoware_auto_msgs::msg::Track
 void ObjectDetectionTrackingWorker::detectedObjectCallback(autoware_auto_msgs::msg::TrackedObjects::UniquePtr  obj_array)
 {
 
-  carma_perception_msgs::msg::ExternalObjectList msg;
-  msg.header = obj_array->header;
-  msg.header.frame_id = map_frame_;
+  // The list is built in place and handed to the publisher so intra-process subscribers receive it without a copy
+  auto msg = std::make_unique<carma_perception_msgs::msg::ExternalObjectList>();
+  msg->header = obj_array->header;
+  msg->header.frame_id = map_frame_;
 
 
   auto transform = tf_lookup_(map_frame_, obj_array->header.frame_id, obj_array->header.stamp);
@@ -51,14 +51,38 @@ void ObjectDetectionTrackingWorker::detectedObjectCallback(autoware_auto_msgs::m
     return;
   }
 
-  geometry_msgs::msg::TransformStamped object_frame_tf = transform.get(); 
+  // The rotation is computed once for the frame and applied to every object in one pass over the batch
+  BatchedPoseTransform object_frame_tf(transform.get().transform);
 
-  for (size_t i = 0; i < obj_array->objects.size(); i++)
+  const size_t object_count = obj_array->objects.size();
+  pose_batch_.resize(object_count);
+
+  for (size_t i = 0; i < object_count; i++)
+  {
+    const auto& kinematics = obj_array->objects[i].kinematics;
+    pose_batch_.x[i] = kinematics.centroid_position.x;
+    pose_batch_.y[i] = kinematics.centroid_position.y;
+    pose_batch_.z[i] = kinematics.centroid_position.z;
+    pose_batch_.qx[i] = kinematics.orientation.x;
+    pose_batch_.qy[i] = kinematics.orientation.y;
+    pose_batch_.qz[i] = kinematics.orientation.z;
+    pose_batch_.qw[i] = kinematics.orientation.w;
+    for (size_t k = 0; k < 9; k++)
+    {
+      pose_batch_.covariance[k][i] = kinematics.position_covariance[k];
+    }
+  }
+
+  object_frame_tf.apply(pose_batch_);
+
+  msg->objects.reserve(object_count);
+
+  for (size_t i = 0; i < object_count; i++)
   {
     carma_perception_msgs::msg::ExternalObject obj;
 
     // Header contains the frame rest of the fields will use
-    obj.header = msg.header;
+    obj.header = msg->header;
 
     // Presence vector message is used to describe objects coming from potentially
     // different sources. The presence vector is used to determine what items are set
@@ -74,45 +98,29 @@ void ObjectDetectionTrackingWorker::detectedObjectCallback(autoware_auto_msgs::m
     // Object id. Matching ids on a topic should refer to the same object within some time period, expanded
     obj.id = obj_array->objects[i].object_id;
 
-    // Pose of the object within the frame specified in header
-    geometry_msgs::msg::PoseStamped input_object_pose;
-    input_object_pose.header = obj_array->header;
-    input_object_pose.pose.position = obj_array->objects[i].kinematics.centroid_position;
-    input_object_pose.pose.orientation = obj_array->objects[i].kinematics.orientation;
-
-    geometry_msgs::msg::PoseStamped output_pose;
-    // Transform the object input our map frame
-    tf2::doTransform(input_object_pose, output_pose, object_frame_tf);
-
-    obj.pose.pose = output_pose.pose;
-
-    // In ROS2 foxy the doTransform call does not set the covariance, so we need to do it manually
-    // Copy over the position covariance
-    // Variable names used here are row, column so row major order
-    auto xx = obj_array->objects[i].kinematics.position_covariance[0];
-    auto xy = obj_array->objects[i].kinematics.position_covariance[1];
-    auto xz = obj_array->objects[i].kinematics.position_covariance[2];
-    auto yx = obj_array->objects[i].kinematics.position_covariance[3];
-    auto yy = obj_array->objects[i].kinematics.position_covariance[4];
-    auto yz = obj_array->objects[i].kinematics.position_covariance[5];
-    auto zx = obj_array->objects[i].kinematics.position_covariance[6];
-    auto zy = obj_array->objects[i].kinematics.position_covariance[7];
-    auto zz = obj_array->objects[i].kinematics.position_covariance[8];
-
-    // This matrix represents the covariance of the object before transformation
-    std::array<double, 36> input_covariance = { 
-      xx, xy, xz,  0, 0, 0,
-      yx, yy, yz,  0, 0, 0,
-      zx, zy, zz,  0, 0, 0,
-      0,  0,  0,  1,  0, 0, // Since no covariance for the orientation is provided we will assume an identity relationship (1s on the diagonal)
-      0,  0,  0,  0,  1, 0, // TODO when autoware suplies this information we should update this to reflect the new covariance
-      0,  0,  0,  0,  0, 1
-    };
-
-    // Transform the covariance matrix
-    tf2::Transform covariance_transform;
-    tf2::fromMsg(object_frame_tf.transform, covariance_transform);
-    obj.pose.covariance = covariance_helper::transformCovariance(input_covariance, covariance_transform);
+    // Pose of the object transformed into our map frame
+    obj.pose.pose.position.x = pose_batch_.x[i];
+    obj.pose.pose.position.y = pose_batch_.y[i];
+    obj.pose.pose.position.z = pose_batch_.z[i];
+    obj.pose.pose.orientation.x = pose_batch_.qx[i];
+    obj.pose.pose.orientation.y = pose_batch_.qy[i];
+    obj.pose.pose.orientation.z = pose_batch_.qz[i];
+    obj.pose.pose.orientation.w = pose_batch_.qw[i];
+
+    // The 6x6 covariance is the transformed position covariance and an orientation covariance which is assumed to be
+    // the identity before transformation, since none is provided
+    // TODO when autoware suplies this information we should update this to reflect the new covariance
+    // The cross covariance blocks are zero before and after transformation
+    obj.pose.covariance.fill(0.0);
+    const auto& orientation_covariance = object_frame_tf.identityCovariance();
+    for (size_t row = 0; row < 3; row++)
+    {
+      for (size_t col = 0; col < 3; col++)
+      {
+        obj.pose.covariance[6 * row + col] = pose_batch_.covariance[3 * row + col][i];
+        obj.pose.covariance[6 * (row + 3) + col + 3] = orientation_covariance[3 * row + col];
+      }
+    }
 
     // Store the object ovarall confidence
     obj.confidence = obj_array->objects[i].existence_probability;
@@ -131,8 +139,8 @@ void ObjectDetectionTrackingWorker::detectedObjectCallback(autoware_auto_msgs::m
     double maxY = std::numeric_limits<double>::lowest();
     double maxHeight = std::numeric_limits<double>::lowest();
 
-    for(auto shape : obj_array->objects[i].shape) {
-      for (auto point :  shape.polygon.points) {
+    for(const auto& shape : obj_array->objects[i].shape) {
+      for (const auto& point :  shape.polygon.points) {
         
         if (point.x > maxX)
           maxX = point.x;
@@ -202,12 +210,12 @@ void ObjectDetectionTrackingWorker::detectedObjectCallback(autoware_auto_msgs::m
       obj.dynamic_obj = 0;
     }
 
-    msg.objects.emplace_back(obj);
+    msg->objects.emplace_back(std::move(obj));
   }
 
 
 
-  obj_pub_(msg);
+  obj_pub_(std::move(msg));
 }
 
 void ObjectDetectionTrackingWorker::setMapFrame(std::string map_frame)
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark of the per frame pose and covariance transform of detected objects.
+ * Each frame is transformed once by the batched transform and once by the per object tf2 calls it replaced.
+ *
+ * Run from the build directory with: build/object_detection_tracking/object_detection_tracking-transform-benchmark [object_count] [frames]
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <autoware_auto_msgs/msg/tracked_objects.hpp>
+#include "covariance_helper.h"
+#include "batched_pose_transform.h"
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+// The per object transform before BatchedPoseTransform
+void legacy_transform(const autoware_auto_msgs::msg::TrackedObjects& objects,
+                      const geometry_msgs::msg::TransformStamped& object_frame_tf,
+                      std::vector<geometry_msgs::msg::PoseWithCovariance>& out)
+{
+  out.resize(objects.objects.size());
+  for (size_t i = 0; i < objects.objects.size(); i++)
+  {
+    const auto& kinematics = objects.objects[i].kinematics;
+
+    geometry_msgs::msg::PoseStamped input_object_pose;
+    input_object_pose.header = objects.header;
+    input_object_pose.pose.position = kinematics.centroid_position;
+    input_object_pose.pose.orientation = kinematics.orientation;
+
+    geometry_msgs::msg::PoseStamped output_pose;
+    tf2::doTransform(input_object_pose, output_pose, object_frame_tf);
+    out[i].pose = output_pose.pose;
+
+    const auto& c = kinematics.position_covariance;
+    std::array<double, 36> input_covariance = {
+      c[0], c[1], c[2], 0, 0, 0,
+      c[3], c[4], c[5], 0, 0, 0,
+      c[6], c[7], c[8], 0, 0, 0,
+      0,    0,    0,    1, 0, 0,
+      0,    0,    0,    0, 1, 0,
+      0,    0,    0,    0, 0, 1
+    };
+
+    tf2::Transform covariance_transform;
+    tf2::fromMsg(object_frame_tf.transform, covariance_transform);
+    out[i].covariance = covariance_helper::transformCovariance(input_covariance, covariance_transform);
+  }
+}
+
+// The batched transform as used by ObjectDetectionTrackingWorker
+void batched_transform(const autoware_auto_msgs::msg::TrackedObjects& objects,
+                       const geometry_msgs::msg::TransformStamped& object_frame_tf,
+                       object::ObjectPoseBatch& batch,
+                       std::vector<geometry_msgs::msg::PoseWithCovariance>& out)
+{
+  object::BatchedPoseTransform transform(object_frame_tf.transform);
+
+  const size_t object_count = objects.objects.size();
+  batch.resize(object_count);
+  for (size_t i = 0; i < object_count; i++)
+  {
+    const auto& kinematics = objects.objects[i].kinematics;
+    batch.x[i] = kinematics.centroid_position.x;
+    batch.y[i] = kinematics.centroid_position.y;
+    batch.z[i] = kinematics.centroid_position.z;
+    batch.qx[i] = kinematics.orientation.x;
+    batch.qy[i] = kinematics.orientation.y;
+    batch.qz[i] = kinematics.orientation.z;
+    batch.qw[i] = kinematics.orientation.w;
+    for (size_t k = 0; k < 9; k++)
+    {
+      batch.covariance[k][i] = kinematics.position_covariance[k];
+    }
+  }
+
+  transform.apply(batch);
+
+  out.resize(object_count);
+  const auto& orientation_covariance = transform.identityCovariance();
+  for (size_t i = 0; i < object_count; i++)
+  {
+    out[i].pose.position.x = batch.x[i];
+    out[i].pose.position.y = batch.y[i];
+    out[i].pose.position.z = batch.z[i];
+    out[i].pose.orientation.x = batch.qx[i];
+    out[i].pose.orientation.y = batch.qy[i];
+    out[i].pose.orientation.z = batch.qz[i];
+    out[i].pose.orientation.w = batch.qw[i];
+    out[i].covariance.fill(0.0);
+    for (size_t row = 0; row < 3; row++)
+    {
+      for (size_t col = 0; col < 3; col++)
+      {
+        out[i].covariance[6 * row + col] = batch.covariance[3 * row + col][i];
+        out[i].covariance[6 * (row + 3) + col + 3] = orientation_covariance[3 * row + col];
+      }
+    }
+  }
+}
+
+// A frame of objects scattered around the sensor with a diagonal position covariance
+autoware_auto_msgs::msg::TrackedObjects make_frame(int object_count)
+{
+  autoware_auto_msgs::msg::TrackedObjects frame;
+  frame.header.frame_id = "velodyne";
+  frame.objects.resize(object_count);
+  for (int i = 0; i < object_count; i++)
+  {
+    auto& kinematics = frame.objects[i].kinematics;
+    kinematics.centroid_position.x = 50.0 * std::cos(0.1 * i);
+    kinematics.centroid_position.y = 50.0 * std::sin(0.1 * i);
+    kinematics.centroid_position.z = 0.5;
+    kinematics.orientation.z = std::sin(0.05 * i);
+    kinematics.orientation.w = std::cos(0.05 * i);
+    kinematics.position_covariance = { 0.2, 0.01, 0, 0.01, 0.3, 0, 0, 0, 0.1 };
+  }
+  return frame;
+}
+
+struct LatencyStats
+{
+  std::vector<double> samples_us;
+
+  void print(const std::string& name)
+  {
+    std::sort(samples_us.begin(), samples_us.end());
+    double total = 0;
+    for (double s : samples_us)
+    {
+      total += s;
+    }
+    std::cout << name << ": mean " << total / samples_us.size() << " us, p99 "
+              << samples_us[samples_us.size() * 99 / 100] << " us, max " << samples_us.back() << " us" << std::endl;
+  }
+};
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int object_count = argc > 1 ? std::stoi(argv[1]) : 500;
+  const int frames = argc > 2 ? std::stoi(argv[2]) : 2000;
+
+  auto frame = make_frame(object_count);
+
+  geometry_msgs::msg::TransformStamped object_frame_tf;
+  object_frame_tf.transform.translation.x = 1200.0;
+  object_frame_tf.transform.translation.y = -340.0;
+  object_frame_tf.transform.translation.z = 1.8;
+  object_frame_tf.transform.rotation.x = 0.01;
+  object_frame_tf.transform.rotation.y = -0.02;
+  object_frame_tf.transform.rotation.z = std::sin(0.6);
+  object_frame_tf.transform.rotation.w = std::cos(0.6);
+
+  object::ObjectPoseBatch batch;
+  std::vector<geometry_msgs::msg::PoseWithCovariance> legacy_out, batched_out;
+
+  LatencyStats legacy_stats, batched_stats;
+  legacy_stats.samples_us.reserve(frames);
+  batched_stats.samples_us.reserve(frames);
+
+  for (int f = 0; f < frames; f++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    legacy_transform(frame, object_frame_tf, legacy_out);
+    legacy_stats.samples_us.push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+    start = std::chrono::steady_clock::now();
+    batched_transform(frame, object_frame_tf, batch, batched_out);
+    batched_stats.samples_us.push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+    g_sink += legacy_out.back().pose.position.x + batched_out.back().pose.position.x;
+  }
+
+  // Largest difference between the two paths, to confirm they agree
+  double max_error = 0;
+  for (size_t i = 0; i < legacy_out.size(); i++)
+  {
+    max_error = std::max(max_error, std::abs(legacy_out[i].pose.position.x - batched_out[i].pose.position.x));
+    max_error = std::max(max_error, std::abs(legacy_out[i].pose.position.y - batched_out[i].pose.position.y));
+    max_error = std::max(max_error, std::abs(legacy_out[i].pose.position.z - batched_out[i].pose.position.z));
+    for (size_t k = 0; k < 36; k++)
+    {
+      max_error = std::max(max_error, std::abs(legacy_out[i].covariance[k] - batched_out[i].covariance[k]));
+    }
+  }
+
+  std::cout << frames << " frames of " << object_count << " objects" << std::endl;
+  legacy_stats.print("per object tf2");
+  batched_stats.print("batched       ");
+  std::cout << "max position and covariance difference: " << max_error << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include "covariance_helper.h"
+#include "batched_pose_transform.h"
+
+namespace object
+{
+
+namespace
+{
+geometry_msgs::msg::Quaternion randomQuaternion(std::mt19937& gen)
+{
+  std::normal_distribution<double> normal(0.0, 1.0);
+  double x = normal(gen), y = normal(gen), z = normal(gen), w = normal(gen);
+  double norm = std::sqrt(x * x + y * y + z * z + w * w);
+
+  geometry_msgs::msg::Quaternion q;
+  q.x = x / norm;
+  q.y = y / norm;
+  q.z = z / norm;
+  q.w = w / norm;
+  return q;
+}
+
+// Random symmetric positive semi-definite 3x3 matrix in row major order
+std::array<double, 9> randomCovariance(std::mt19937& gen)
+{
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  std::array<double, 9> a;
+  for (auto& v : a)
+  {
+    v = dist(gen);
+  }
+
+  std::array<double, 9> cov;
+  for (size_t r = 0; r < 3; r++)
+  {
+    for (size_t c = 0; c < 3; c++)
+    {
+      cov[3 * r + c] = a[3 * r] * a[3 * c] + a[3 * r + 1] * a[3 * c + 1] + a[3 * r + 2] * a[3 * c + 2];
+    }
+  }
+  return cov;
+}
+}  // namespace
+
+TEST(BatchedPoseTransformTest, matchesPerObjectTransform)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> position(-200.0, 200.0);
+  std::uniform_real_distribution<double> translation(-5000.0, 5000.0);
+
+  const size_t object_count = 200;
+
+  for (int trial = 0; trial < 20; trial++)
+  {
+    geometry_msgs::msg::TransformStamped tf;
+    tf.transform.translation.x = translation(gen);
+    tf.transform.translation.y = translation(gen);
+    tf.transform.translation.z = translation(gen);
+    tf.transform.rotation = randomQuaternion(gen);
+
+    ObjectPoseBatch batch;
+    batch.resize(object_count);
+    std::vector<geometry_msgs::msg::Pose> poses(object_count);
+    std::vector<std::array<double, 9>> covariances(object_count);
+
+    for (size_t i = 0; i < object_count; i++)
+    {
+      poses[i].position.x = position(gen);
+      poses[i].position.y = position(gen);
+      poses[i].position.z = position(gen);
+      poses[i].orientation = randomQuaternion(gen);
+      covariances[i] = randomCovariance(gen);
+
+      batch.x[i] = poses[i].position.x;
+      batch.y[i] = poses[i].position.y;
+      batch.z[i] = poses[i].position.z;
+      batch.qx[i] = poses[i].orientation.x;
+      batch.qy[i] = poses[i].orientation.y;
+      batch.qz[i] = poses[i].orientation.z;
+      batch.qw[i] = poses[i].orientation.w;
+      for (size_t k = 0; k < 9; k++)
+      {
+        batch.covariance[k][i] = covariances[i][k];
+      }
+    }
+
+    BatchedPoseTransform batched(tf.transform);
+    batched.apply(batch);
+    ASSERT_EQ(batch.size(), object_count);
+
+    tf2::Transform covariance_transform;
+    tf2::fromMsg(tf.transform, covariance_transform);
+
+    for (size_t i = 0; i < object_count; i++)
+    {
+      geometry_msgs::msg::PoseStamped input_pose, expected_pose;
+      input_pose.pose = poses[i];
+      tf2::doTransform(input_pose, expected_pose, tf);
+
+      EXPECT_NEAR(batch.x[i], expected_pose.pose.position.x, 1e-6);
+      EXPECT_NEAR(batch.y[i], expected_pose.pose.position.y, 1e-6);
+      EXPECT_NEAR(batch.z[i], expected_pose.pose.position.z, 1e-6);
+
+      // q and -q are the same rotation
+      const auto& q = expected_pose.pose.orientation;
+      double dot = batch.qx[i] * q.x + batch.qy[i] * q.y + batch.qz[i] * q.z + batch.qw[i] * q.w;
+      EXPECT_NEAR(std::abs(dot), 1.0, 1e-9);
+
+      const auto& c = covariances[i];
+      geometry_msgs::msg::PoseWithCovariance::_covariance_type input_covariance = {
+        c[0], c[1], c[2], 0, 0, 0,
+        c[3], c[4], c[5], 0, 0, 0,
+        c[6], c[7], c[8], 0, 0, 0,
+        0,    0,    0,    1, 0, 0,
+        0,    0,    0,    0, 1, 0,
+        0,    0,    0,    0, 0, 1
+      };
+      auto expected_covariance = covariance_helper::transformCovariance(input_covariance, covariance_transform);
+
+      for (size_t row = 0; row < 3; row++)
+      {
+        for (size_t col = 0; col < 3; col++)
+        {
+          EXPECT_NEAR(batch.covariance[3 * row + col][i], expected_covariance[6 * row + col], 1e-9);
+          EXPECT_NEAR(batched.identityCovariance()[3 * row + col], expected_covariance[6 * (row + 3) + col + 3], 1e-9);
+        }
+      }
+    }
+  }
+}
+
+TEST(BatchedPoseTransformTest, emptyBatch)
+{
+  geometry_msgs::msg::Transform tf;
+  tf.rotation.w = 1.0;
+
+  ObjectPoseBatch batch;
+  BatchedPoseTransform(tf).apply(batch);
+  ASSERT_EQ(batch.size(), 0u);
+}
+
+}  // namespace object
@@ -0,0 +1,124 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <rclcpp/duration.hpp>
+#include <rclcpp/time.hpp>
+#include <visualization_msgs/msg/marker.hpp>
+#include <visualization_msgs/msg/marker_array.hpp>
+
+namespace object_visualizer
+{
+
+  /**
+   * \brief Thresholds below which a change to a marker is not worth republishing
+   */
+  struct MarkerTolerances
+  {
+    //! Distance in m the marker position may move
+    double position = 0.05;
+
+    //! Angle in rad the marker orientation may rotate
+    double orientation = 0.02;
+
+    //! Change in m of each marker dimension
+    double scale = 0.05;
+  };
+
+  /**
+   * \brief Converts an object id to the id of its marker.
+   *
+   * Object ids are uint32 while marker ids are int32. Ids below 2^31 are kept and larger ids wrap to negative marker ids,
+   * 2^31 becoming -2^31 and 2^32 - 1 becoming -1, so every object keeps its own marker.
+   */
+  int32_t toMarkerId(uint32_t object_id);
+
+  /**
+   * \brief Tracks the markers last published for a set of objects so only the differences are published.
+   *
+   * Markers are keyed by their id, which is expected to be the object id. Each new set of markers produces:
+   * - ADD for markers which are new or whose pose, scale, type, color or frame changed beyond the tolerances
+   * - ADD for unchanged markers whose lifetime is half over, to keep them alive in RViz
+   * - DELETE for markers of the previous sets whose id is no longer present
+   *
+   * Every published marker carries the configured lifetime, so markers of objects which are never deleted, for example
+   * because a DELETE was dropped or the node stopped, expire on their own. A lifetime of zero keeps markers until they
+   * are deleted and disables the refreshes.
+   */
+  class MarkerCache
+  {
+  public:
+    /**
+     * \brief Constructor
+     *
+     * \param tolerances The changes which do not cause a marker to be republished
+     * \param lifetime The lifetime of published markers
+     */
+    explicit MarkerCache(const MarkerTolerances& tolerances = MarkerTolerances(),
+                         const rclcpp::Duration& lifetime = rclcpp::Duration(1, 0));
+
+    /**
+     * \brief Computes the markers to publish for a new set of markers and records them as published
+     *
+     * \param markers The markers of every current object. Markers whose id was already seen in the set are ignored
+     * \param now The current time, used to refresh markers before their lifetime ends
+     * \param[out] out The array to append the markers to publish to. It is left unchanged if nothing needs publishing
+     */
+    void update(const std::vector<visualization_msgs::msg::Marker>& markers, const rclcpp::Time& now,
+                visualization_msgs::msg::MarkerArray& out);
+
+    /**
+     * \brief Sets the tolerances used for the following updates
+     */
+    void setTolerances(const MarkerTolerances& tolerances);
+
+    /**
+     * \brief Sets the lifetime of the markers published by the following updates
+     */
+    void setLifetime(const rclcpp::Duration& lifetime);
+
+    /**
+     * \brief Forgets every published marker without deleting it
+     */
+    void clear();
+
+    /**
+     * \brief Returns the number of markers currently published
+     */
+    size_t size() const;
+
+  private:
+    struct Entry
+    {
+      visualization_msgs::msg::Marker marker;  // The marker as last published
+      rclcpp::Time published;
+      uint64_t generation = 0;  // The last update in which the marker was present
+    };
+
+    // Returns true if the new marker differs from the published one beyond the tolerances
+    bool changed(const visualization_msgs::msg::Marker& published, const visualization_msgs::msg::Marker& marker) const;
+
+    MarkerTolerances tolerances_;
+    rclcpp::Duration lifetime_;
+    std::unordered_map<int32_t, Entry> entries_;
+    uint64_t generation_ = 0;
+  };
+
+} // object_visualizer
@@ -39,6 +39,18 @@ namespace object_visualizer
     //! Roadway Obstacles marker rviz namespace
     std::string roadway_obstacles_viz_ns = "roadway_obstacles";
 
+    //! Lifetime of published markers in seconds. Unchanged markers are republished after half of it. 0 means forever
+    double marker_lifetime = 1.0;
+
+    //! Distance in meters an object must move before its marker is republished
+    double marker_position_tolerance = 0.05;
+
+    //! Angle in radians an object must rotate before its marker is republished
+    double marker_orientation_tolerance = 0.02;
+
+    //! Change in meters of an object dimension before its marker is republished
+    double marker_scale_tolerance = 0.05;
+
     // Stream operator for this config
     friend std::ostream &operator<<(std::ostream &output, const Config &c)
     {
@@ -47,6 +59,10 @@ namespace object_visualizer
            << "enable_roadway_objects_viz: " << c.enable_roadway_objects_viz << std::endl
            << "external_objects_viz_ns: " << c.external_objects_viz_ns << std::endl
            << "roadway_obstacles_viz_ns: " << c.roadway_obstacles_viz_ns << std::endl
+           << "marker_lifetime: " << c.marker_lifetime << std::endl
+           << "marker_position_tolerance: " << c.marker_position_tolerance << std::endl
+           << "marker_orientation_tolerance: " << c.marker_orientation_tolerance << std::endl
+           << "marker_scale_tolerance: " << c.marker_scale_tolerance << std::endl
            << "}" << std::endl;
       return output;
     }
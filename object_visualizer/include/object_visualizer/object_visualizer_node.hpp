@@ -25,6 +25,7 @@
 
 #include <carma_ros2_utils/carma_lifecycle_node.hpp>
 #include "object_visualizer/object_visualizer_config.hpp"
+#include "object_visualizer/marker_cache.hpp"
 
 namespace object_visualizer
 {
@@ -48,21 +49,14 @@ namespace object_visualizer
     // Node configuration
     Config config_;
 
-    // Previous object report sizes for clearing visualization on deleted objects
-    size_t prev_external_objects_size_ = 0;
-    size_t prev_roadway_obstacles_size_ = 0;
+    // Markers last published for each object id, so only changed, new and deleted objects are published
+    MarkerCache external_objects_cache_;
+    MarkerCache roadway_obstacles_cache_;
 
     /**
-     * \brief Adds a marker deletion for a number of markers which is the delta
-     *        between the new marker count and the previously published count
-     * 
-     * ASSUMPTION: The marker array's ids are already recomputed starting from zero, such that tracking ids is not needed.
-     * 
-     * \param[in/out] viz_msg The marker array to add deletion markers to
-     * \param[in/out] old_size The size of the previous published marker array. 
-     *                The positive delta between this and the size of the viz_msg determines the number of deletions added
-     */ 
-    void clear_and_update_old_objects(visualization_msgs::msg::MarkerArray &viz_msg, size_t &old_size);
+     * \brief Applies the marker lifetime and tolerances of the current config to the marker caches
+     */
+    void configure_marker_caches();
 
   public:
     /**
@@ -77,14 +71,16 @@ namespace object_visualizer
     parameter_update_callback(const std::vector<rclcpp::Parameter> &parameters);
 
     /**
-     * \brief External objects callback. Converts the message to a visualization message to republish
+     * \brief External objects callback. Converts the message to markers keyed by object id and publishes the
+     *        markers which changed since the last message, along with deletions for objects which are gone
      * 
      * \param msg The received message
      */
     void external_objects_callback(carma_perception_msgs::msg::ExternalObjectList::UniquePtr msg);
 
     /**
-     * \brief Roadway obstacles callback. Converts the message to a visualization message to republish
+     * \brief Roadway obstacles callback. Converts the message to markers keyed by object id and publishes the
+     *        markers which changed since the last message, along with deletions for objects which are gone
      * 
      * \param msg The received message
      */
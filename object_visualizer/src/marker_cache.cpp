@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+#include "object_visualizer/marker_cache.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace object_visualizer
+{
+  namespace
+  {
+    // Angle in rad between two orientations
+    double angleBetween(const geometry_msgs::msg::Quaternion& a, const geometry_msgs::msg::Quaternion& b)
+    {
+      double norm_a = std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w);
+      double norm_b = std::sqrt(b.x * b.x + b.y * b.y + b.z * b.z + b.w * b.w);
+      if (norm_a == 0.0 || norm_b == 0.0) {
+        return (norm_a == norm_b) ? 0.0 : M_PI;
+      }
+      double dot = std::fabs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w) / (norm_a * norm_b);
+      return 2.0 * std::acos(std::min(1.0, dot));
+    }
+
+    bool sameColor(const std_msgs::msg::ColorRGBA& a, const std_msgs::msg::ColorRGBA& b)
+    {
+      return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+    }
+
+    visualization_msgs::msg::Marker deletion(const visualization_msgs::msg::Marker& published)
+    {
+      visualization_msgs::msg::Marker marker;
+      marker.header = published.header;
+      marker.ns = published.ns;
+      marker.id = published.id;
+      marker.action = visualization_msgs::msg::Marker::DELETE;
+      return marker;
+    }
+  }
+
+  int32_t toMarkerId(uint32_t object_id)
+  {
+    const uint32_t max_id = static_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+    if (object_id <= max_id) {
+      return static_cast<int32_t>(object_id);
+    }
+    // Converting an out of range value to a signed type is implementation defined before C++20, so the wrap is explicit
+    return static_cast<int32_t>(object_id - max_id - 1) + std::numeric_limits<int32_t>::min();
+  }
+
+  MarkerCache::MarkerCache(const MarkerTolerances& tolerances, const rclcpp::Duration& lifetime)
+    : tolerances_(tolerances), lifetime_(lifetime)
+  {}
+
+  void MarkerCache::update(const std::vector<visualization_msgs::msg::Marker>& markers, const rclcpp::Time& now,
+                           visualization_msgs::msg::MarkerArray& out)
+  {
+    generation_++;
+
+    // Refresh markers once half their lifetime has passed so they are replaced before RViz drops them
+    const bool refresh = lifetime_.nanoseconds() > 0;
+    const rclcpp::Duration refresh_period = rclcpp::Duration(lifetime_.nanoseconds() / 2);
+
+    for (const auto& marker : markers) {
+      auto it = entries_.find(marker.id);
+
+      if (it != entries_.end()) {
+        Entry& entry = it->second;
+
+        if (entry.generation == generation_) {
+          continue; // Duplicate id in this set
+        }
+        entry.generation = generation_;
+
+        bool stale = refresh && (now - entry.published) >= refresh_period;
+        if (!stale && !changed(entry.marker, marker)) {
+          continue;
+        }
+
+        // A marker moved to another namespace is a different marker to RViz
+        if (entry.marker.ns != marker.ns) {
+          out.markers.push_back(deletion(entry.marker));
+        }
+
+        entry.marker = marker;
+        entry.marker.action = visualization_msgs::msg::Marker::ADD;
+        entry.marker.lifetime = lifetime_;
+        entry.published = now;
+        out.markers.push_back(entry.marker);
+        continue;
+      }
+
+      Entry entry;
+      entry.marker = marker;
+      entry.marker.action = visualization_msgs::msg::Marker::ADD;
+      entry.marker.lifetime = lifetime_;
+      entry.published = now;
+      entry.generation = generation_;
+      out.markers.push_back(entry.marker);
+      entries_.emplace(marker.id, std::move(entry));
+    }
+
+    // Delete the markers of objects which are gone, in id order so the output is deterministic
+    std::vector<int32_t> removed;
+    for (const auto& pair : entries_) {
+      if (pair.second.generation != generation_) {
+        removed.push_back(pair.first);
+      }
+    }
+    std::sort(removed.begin(), removed.end());
+
+    for (int32_t id : removed) {
+      out.markers.push_back(deletion(entries_.at(id).marker));
+      entries_.erase(id);
+    }
+  }
+
+  bool MarkerCache::changed(const visualization_msgs::msg::Marker& published, const visualization_msgs::msg::Marker& marker) const
+  {
+    if (published.type != marker.type || published.ns != marker.ns || published.header.frame_id != marker.header.frame_id
+        || !sameColor(published.color, marker.color)) {
+      return true;
+    }
+
+    double dx = published.pose.position.x - marker.pose.position.x;
+    double dy = published.pose.position.y - marker.pose.position.y;
+    double dz = published.pose.position.z - marker.pose.position.z;
+    if (std::sqrt(dx * dx + dy * dy + dz * dz) > tolerances_.position) {
+      return true;
+    }
+
+    if (angleBetween(published.pose.orientation, marker.pose.orientation) > tolerances_.orientation) {
+      return true;
+    }
+
+    return std::fabs(published.scale.x - marker.scale.x) > tolerances_.scale
+        || std::fabs(published.scale.y - marker.scale.y) > tolerances_.scale
+        || std::fabs(published.scale.z - marker.scale.z) > tolerances_.scale;
+  }
+
+  void MarkerCache::setTolerances(const MarkerTolerances& tolerances)
+  {
+    tolerances_ = tolerances;
+  }
+
+  void MarkerCache::setLifetime(const rclcpp::Duration& lifetime)
+  {
+    lifetime_ = lifetime;
+  }
+
+  void MarkerCache::clear()
+  {
+    entries_.clear();
+  }
+
+  size_t MarkerCache::size() const
+  {
+    return entries_.size();
+  }
+
+} // object_visualizer
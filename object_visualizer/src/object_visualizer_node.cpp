@@ -14,6 +14,7 @@
  * the License.
  */
 #include "object_visualizer/object_visualizer_node.hpp"
+#include <algorithm>
 
 namespace object_visualizer
 {
@@ -30,6 +31,10 @@ namespace object_visualizer
     config_.enable_roadway_objects_viz = declare_parameter<bool>("enable_roadway_objects_viz", config_.enable_roadway_objects_viz);
     config_.external_objects_viz_ns = declare_parameter<std::string>("external_objects_viz_ns", config_.external_objects_viz_ns);
     config_.roadway_obstacles_viz_ns = declare_parameter<std::string>("roadway_obstacles_viz_ns", config_.roadway_obstacles_viz_ns);
+    config_.marker_lifetime = declare_parameter<double>("marker_lifetime", config_.marker_lifetime);
+    config_.marker_position_tolerance = declare_parameter<double>("marker_position_tolerance", config_.marker_position_tolerance);
+    config_.marker_orientation_tolerance = declare_parameter<double>("marker_orientation_tolerance", config_.marker_orientation_tolerance);
+    config_.marker_scale_tolerance = declare_parameter<double>("marker_scale_tolerance", config_.marker_scale_tolerance);
   }
 
   rcl_interfaces::msg::SetParametersResult Node::parameter_update_callback(const std::vector<rclcpp::Parameter> &parameters)
@@ -47,9 +52,19 @@ namespace object_visualizer
         {"roadway_obstacles_viz_ns", config_.roadway_obstacles_viz_ns}
       }, parameters);
 
+    auto error3 = update_params<double>(
+      {
+        {"marker_lifetime", config_.marker_lifetime},
+        {"marker_position_tolerance", config_.marker_position_tolerance},
+        {"marker_orientation_tolerance", config_.marker_orientation_tolerance},
+        {"marker_scale_tolerance", config_.marker_scale_tolerance}
+      }, parameters);
+
+    configure_marker_caches();
+
     rcl_interfaces::msg::SetParametersResult result;
 
-    result.successful = !error && !error2;
+    result.successful = !error && !error2 && !error3;
 
     return result;
   }
@@ -64,6 +79,14 @@ namespace object_visualizer
     get_parameter<bool>("enable_roadway_objects_viz", config_.enable_roadway_objects_viz);
     get_parameter<std::string>("external_objects_viz_ns", config_.external_objects_viz_ns);
     get_parameter<std::string>("roadway_obstacles_viz_ns", config_.roadway_obstacles_viz_ns);
+    get_parameter<double>("marker_lifetime", config_.marker_lifetime);
+    get_parameter<double>("marker_position_tolerance", config_.marker_position_tolerance);
+    get_parameter<double>("marker_orientation_tolerance", config_.marker_orientation_tolerance);
+    get_parameter<double>("marker_scale_tolerance", config_.marker_scale_tolerance);
+
+    configure_marker_caches();
+    external_objects_cache_.clear();
+    roadway_obstacles_cache_.clear();
 
     // Register runtime parameter update callback
     add_on_set_parameters_callback(std::bind(&Node::parameter_update_callback, this, std_ph::_1));
@@ -92,13 +115,10 @@ namespace object_visualizer
       return;
     }
 
-    visualization_msgs::msg::MarkerArray viz_msg;
-    viz_msg.markers.reserve(msg->objects.size());
-
-    
-    size_t id = 0; // We always count the id from zero so we can delete markers later in a consistent manner
+    std::vector<visualization_msgs::msg::Marker> markers;
+    markers.reserve(msg->objects.size());
 
-    for (auto obj : msg->objects) {
+    for (const auto& obj : msg->objects) {
       visualization_msgs::msg::Marker marker;
       
       marker.header = msg->header;
@@ -122,7 +142,7 @@ namespace object_visualizer
         marker.color.a = 1.0;
       }
 
-      marker.id = id;
+      marker.id = toMarkerId(obj.id); // Markers are keyed by object id so they can be diffed across messages
       marker.type = visualization_msgs::msg::Marker::CUBE;
       marker.action = visualization_msgs::msg::Marker::ADD;
       marker.pose = obj.pose.pose;
@@ -130,34 +150,31 @@ namespace object_visualizer
       marker.scale.y = obj.size.y * 2.0;
       marker.scale.z = obj.size.z * 2.0;
 
-      viz_msg.markers.push_back(marker);
-
-      id++;
+      markers.push_back(marker);
     }
 
-    clear_and_update_old_objects(viz_msg, prev_external_objects_size_);
+    visualization_msgs::msg::MarkerArray viz_msg;
+    external_objects_cache_.update(markers, now(), viz_msg);
 
-    external_objects_viz_pub_->publish(viz_msg);
+    if (!viz_msg.markers.empty()) {
+      external_objects_viz_pub_->publish(viz_msg);
+    }
 
   }
 
-  void Node::clear_and_update_old_objects(visualization_msgs::msg::MarkerArray &viz_msg, size_t &old_size)
+  void Node::configure_marker_caches()
   {
-    size_t size_swap = viz_msg.markers.size();
+    MarkerTolerances tolerances;
+    tolerances.position = config_.marker_position_tolerance;
+    tolerances.orientation = config_.marker_orientation_tolerance;
+    tolerances.scale = config_.marker_scale_tolerance;
 
-    // Delete any markers from the previous message that are no longer in the current message
-    if (viz_msg.markers.size() < old_size) {
+    rclcpp::Duration lifetime(static_cast<rcl_duration_value_t>(std::max(0.0, config_.marker_lifetime) * 1e9));
 
-      for (size_t i = viz_msg.markers.size(); i < old_size; ++i) {
-        visualization_msgs::msg::Marker marker;
-        marker.id = i;
-        marker.action = visualization_msgs::msg::Marker::DELETE;
-        viz_msg.markers.push_back(marker);
-      }
-
-    }
-
-    old_size = size_swap; // Assign the new size of added objects to the old size
+    external_objects_cache_.setTolerances(tolerances);
+    external_objects_cache_.setLifetime(lifetime);
+    roadway_obstacles_cache_.setTolerances(tolerances);
+    roadway_obstacles_cache_.setLifetime(lifetime);
   }
 
   void Node::roadway_obstacles_callback(carma_perception_msgs::msg::RoadwayObstacleList::UniquePtr msg)
@@ -169,12 +186,10 @@ namespace object_visualizer
       return;
     }
 
-    visualization_msgs::msg::MarkerArray viz_msg;
+    std::vector<visualization_msgs::msg::Marker> markers;
+    markers.reserve(msg->roadway_obstacles.size());
 
-    viz_msg.markers.reserve(msg->roadway_obstacles.size());
-
-    size_t id = 0; // We always count the id from zero so we can delete markers later in a consistent manner
-    for (auto obj : msg->roadway_obstacles) {
+    for (const auto& obj : msg->roadway_obstacles) {
       visualization_msgs::msg::Marker marker;
       
       marker.header = obj.object.header;
@@ -204,7 +219,7 @@ namespace object_visualizer
         marker.color.a = 1.0;
       }
 
-      marker.id = id;
+      marker.id = toMarkerId(obj.object.id); // Markers are keyed by object id so they can be diffed across messages
       marker.type = visualization_msgs::msg::Marker::CUBE;
       marker.action = visualization_msgs::msg::Marker::ADD;
       marker.pose = obj.object.pose.pose;
@@ -212,14 +227,15 @@ namespace object_visualizer
       marker.scale.y = obj.object.size.y * 2.0;
       marker.scale.z = obj.object.size.z * 2.0;
 
-      viz_msg.markers.push_back(marker);
-
-      id++;
+      markers.push_back(marker);
     }
 
-    clear_and_update_old_objects(viz_msg, prev_roadway_obstacles_size_);
+    visualization_msgs::msg::MarkerArray viz_msg;
+    roadway_obstacles_cache_.update(markers, now(), viz_msg);
 
-    roadway_obstacles_viz_pub_->publish(viz_msg);
+    if (!viz_msg.markers.empty()) {
+      roadway_obstacles_viz_pub_->publish(viz_msg);
+    }
 
   }
 
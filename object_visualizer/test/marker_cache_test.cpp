@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "object_visualizer/marker_cache.hpp"
+
+namespace
+{
+  visualization_msgs::msg::Marker makeMarker(int32_t id, double x, double y = 0.0)
+  {
+    visualization_msgs::msg::Marker marker;
+    marker.header.frame_id = "map";
+    marker.ns = "external_objects";
+    marker.id = id;
+    marker.type = visualization_msgs::msg::Marker::CUBE;
+    marker.pose.position.x = x;
+    marker.pose.position.y = y;
+    marker.scale.x = 4.0;
+    marker.scale.y = 2.0;
+    marker.scale.z = 1.5;
+    marker.color.b = 1.0;
+    marker.color.a = 1.0;
+    return marker;
+  }
+
+  rclcpp::Time seconds(double t)
+  {
+    return rclcpp::Time(static_cast<int64_t>(std::llround(t * 1e9)));
+  }
+
+  // Counts the markers of a diff with the given action
+  size_t countActions(const visualization_msgs::msg::MarkerArray& diff, int32_t action)
+  {
+    size_t count = 0;
+    for (const auto& marker : diff.markers) {
+      if (marker.action == action) {
+        count++;
+      }
+    }
+    return count;
+  }
+}
+
+TEST(MarkerCache, addsOnlyChangedMarkers)
+{
+  object_visualizer::MarkerCache cache(object_visualizer::MarkerTolerances(), rclcpp::Duration(1, 0));
+
+  visualization_msgs::msg::MarkerArray diff;
+  cache.update({ makeMarker(7, 0.0), makeMarker(3, 10.0) }, seconds(0.0), diff);
+
+  ASSERT_EQ(2u, diff.markers.size());
+  EXPECT_EQ(7, diff.markers[0].id);
+  EXPECT_EQ(3, diff.markers[1].id);
+  EXPECT_EQ(visualization_msgs::msg::Marker::ADD, diff.markers[0].action);
+  EXPECT_EQ(1, diff.markers[0].lifetime.sec);
+  EXPECT_EQ(2u, cache.size());
+
+  // Unchanged and moved within the tolerance
+  diff.markers.clear();
+  cache.update({ makeMarker(7, 0.01), makeMarker(3, 10.0) }, seconds(0.1), diff);
+  EXPECT_TRUE(diff.markers.empty());
+
+  // Moved beyond the tolerance
+  diff.markers.clear();
+  cache.update({ makeMarker(7, 0.5), makeMarker(3, 10.0) }, seconds(0.2), diff);
+  ASSERT_EQ(1u, diff.markers.size());
+  EXPECT_EQ(7, diff.markers[0].id);
+  EXPECT_DOUBLE_EQ(0.5, diff.markers[0].pose.position.x);
+
+  // Small movements accumulate against the last published pose
+  diff.markers.clear();
+  cache.update({ makeMarker(7, 0.54), makeMarker(3, 10.0) }, seconds(0.3), diff);
+  EXPECT_TRUE(diff.markers.empty());
+  cache.update({ makeMarker(7, 0.56), makeMarker(3, 10.0) }, seconds(0.4), diff);
+  ASSERT_EQ(1u, diff.markers.size());
+  EXPECT_EQ(7, diff.markers[0].id);
+}
+
+TEST(MarkerCache, orientationScaleAndClassChanges)
+{
+  object_visualizer::MarkerCache cache;
+
+  visualization_msgs::msg::MarkerArray diff;
+  cache.update({ makeMarker(1, 0.0), makeMarker(2, 5.0), makeMarker(3, 10.0) }, seconds(0.0), diff);
+  ASSERT_EQ(3u, diff.markers.size());
+
+  // Marker 1 turns by 0.1 rad, marker 2 grows and marker 3 is reclassified as a pedestrian (red)
+  auto turned = makeMarker(1, 0.0);
+  turned.pose.orientation.z = std::sin(0.05);
+  turned.pose.orientation.w = std::cos(0.05);
+  auto grown = makeMarker(2, 5.0);
+  grown.scale.x = 4.2;
+  auto reclassified = makeMarker(3, 10.0);
+  reclassified.color.r = 1.0;
+  reclassified.color.b = 0.0;
+
+  diff.markers.clear();
+  cache.update({ turned, grown, reclassified }, seconds(0.1), diff);
+  ASSERT_EQ(3u, diff.markers.size());
+  EXPECT_EQ(3u, countActions(diff, visualization_msgs::msg::Marker::ADD));
+
+  // Turns below the tolerance are ignored
+  turned.pose.orientation.z = std::sin(0.055);
+  turned.pose.orientation.w = std::cos(0.055);
+  diff.markers.clear();
+  cache.update({ turned, grown, reclassified }, seconds(0.2), diff);
+  EXPECT_TRUE(diff.markers.empty());
+}
+
+TEST(MarkerCache, deletesOnlyDisappearedIds)
+{
+  object_visualizer::MarkerCache cache;
+
+  visualization_msgs::msg::MarkerArray diff;
+  cache.update({ makeMarker(5, 0.0), makeMarker(1, 5.0), makeMarker(9, 10.0) }, seconds(0.0), diff);
+
+  diff.markers.clear();
+  cache.update({ makeMarker(1, 5.0), makeMarker(4, 20.0) }, seconds(0.1), diff);
+
+  // The new marker is added and the two which are gone are deleted in id order
+  ASSERT_EQ(3u, diff.markers.size());
+  EXPECT_EQ(4, diff.markers[0].id);
+  EXPECT_EQ(visualization_msgs::msg::Marker::ADD, diff.markers[0].action);
+  EXPECT_EQ(5, diff.markers[1].id);
+  EXPECT_EQ(visualization_msgs::msg::Marker::DELETE, diff.markers[1].action);
+  EXPECT_EQ("external_objects", diff.markers[1].ns);
+  EXPECT_EQ(9, diff.markers[2].id);
+  EXPECT_EQ(visualization_msgs::msg::Marker::DELETE, diff.markers[2].action);
+  EXPECT_EQ(2u, cache.size());
+
+  // Deleted markers are only deleted once
+  diff.markers.clear();
+  cache.update({ makeMarker(1, 5.0), makeMarker(4, 20.0) }, seconds(0.2), diff);
+  EXPECT_TRUE(diff.markers.empty());
+
+  diff.markers.clear();
+  cache.update({}, seconds(0.3), diff);
+  EXPECT_EQ(2u, countActions(diff, visualization_msgs::msg::Marker::DELETE));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(MarkerCache, largeObjectIds)
+{
+  EXPECT_EQ(7, object_visualizer::toMarkerId(7u));
+  EXPECT_EQ(2147483647, object_visualizer::toMarkerId(2147483647u));
+  EXPECT_EQ(std::numeric_limits<int32_t>::min(), object_visualizer::toMarkerId(2147483648u));
+  EXPECT_EQ(-1, object_visualizer::toMarkerId(4294967295u));
+
+  // Objects with ids of 2^31 and above keep distinct markers which are diffed and deleted like any other
+  object_visualizer::MarkerCache cache;
+  visualization_msgs::msg::MarkerArray diff;
+  cache.update({ makeMarker(object_visualizer::toMarkerId(4294967295u), 0.0),
+                 makeMarker(object_visualizer::toMarkerId(2147483647u), 5.0) }, seconds(0.0), diff);
+  EXPECT_EQ(2u, countActions(diff, visualization_msgs::msg::Marker::ADD));
+
+  diff.markers.clear();
+  cache.update({ makeMarker(object_visualizer::toMarkerId(2147483647u), 5.0) }, seconds(0.1), diff);
+  ASSERT_EQ(1u, diff.markers.size());
+  EXPECT_EQ(-1, diff.markers[0].id);
+  EXPECT_EQ(visualization_msgs::msg::Marker::DELETE, diff.markers[0].action);
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST(MarkerCache, refreshesBeforeLifetimeEnds)
+{
+  object_visualizer::MarkerCache cache(object_visualizer::MarkerTolerances(), rclcpp::Duration(1, 0));
+
+  visualization_msgs::msg::MarkerArray diff;
+  cache.update({ makeMarker(1, 0.0) }, seconds(0.0), diff);
+
+  diff.markers.clear();
+  cache.update({ makeMarker(1, 0.0) }, seconds(0.4), diff);
+  EXPECT_TRUE(diff.markers.empty());
+
+  cache.update({ makeMarker(1, 0.0) }, seconds(0.5), diff);
+  ASSERT_EQ(1u, diff.markers.size());
+  EXPECT_EQ(visualization_msgs::msg::Marker::ADD, diff.markers[0].action);
+
+  // Markers which never expire are never refreshed
+  cache.setLifetime(rclcpp::Duration(0, 0));
+  diff.markers.clear();
+  cache.update({ makeMarker(1, 0.0) }, seconds(100.0), diff);
+  EXPECT_TRUE(diff.markers.empty());
+}
+
+TEST(MarkerCache, duplicateAndNamespaceChanges)
+{
+  object_visualizer::MarkerCache cache;
+
+  visualization_msgs::msg::MarkerArray diff;
+  cache.update({ makeMarker(1, 0.0), makeMarker(1, 50.0) }, seconds(0.0), diff);
+  ASSERT_EQ(1u, diff.markers.size());
+  EXPECT_DOUBLE_EQ(0.0, diff.markers[0].pose.position.x);
+
+  // The marker in the old namespace is deleted when the namespace changes
+  auto renamed = makeMarker(1, 0.0);
+  renamed.ns = "objects";
+  diff.markers.clear();
+  cache.update({ renamed }, seconds(0.1), diff);
+  ASSERT_EQ(2u, diff.markers.size());
+  EXPECT_EQ(visualization_msgs::msg::Marker::DELETE, diff.markers[0].action);
+  EXPECT_EQ("external_objects", diff.markers[0].ns);
+  EXPECT_EQ(visualization_msgs::msg::Marker::ADD, diff.markers[1].action);
+  EXPECT_EQ("objects", diff.markers[1].ns);
+}
+
+TEST(MarkerCache, syntheticObjectStream)
+{
+  // 200 tracked objects at 10 Hz for 3 s. Even ids are parked and odd ids drive at 10 m/s. From 1 s on the 20 objects with
+  // the highest ids leave, and from 2 s on 10 new ones arrive
+  object_visualizer::MarkerCache cache(object_visualizer::MarkerTolerances(), rclcpp::Duration(1, 0));
+
+  size_t adds = 0;
+  size_t deletes = 0;
+  for (int frame = 0; frame < 30; frame++) {
+    double t = 0.1 * frame;
+    int object_count = frame < 10 ? 200 : 180;
+    std::vector<visualization_msgs::msg::Marker> markers;
+    for (int id = 0; id < object_count; id++) {
+      markers.push_back(makeMarker(id, id % 2 == 0 ? 0.0 : 10.0 * t, 4.0 * id));
+    }
+    if (frame >= 20) {
+      for (int id = 1000; id < 1010; id++) {
+        markers.push_back(makeMarker(id, 0.0, 4.0 * id));
+      }
+    }
+
+    visualization_msgs::msg::MarkerArray diff;
+    cache.update(markers, seconds(t), diff);
+
+    size_t frame_adds = countActions(diff, visualization_msgs::msg::Marker::ADD);
+    size_t frame_deletes = countActions(diff, visualization_msgs::msg::Marker::DELETE);
+    adds += frame_adds;
+    deletes += frame_deletes;
+
+    if (frame == 0) {
+      EXPECT_EQ(200u, frame_adds);
+    } else if (frame == 10) {
+      EXPECT_EQ(20u, frame_deletes);
+    } else if (frame == 20) {
+      // 90 moving, 90 parked refreshed and 10 new
+      EXPECT_EQ(190u, frame_adds);
+      EXPECT_EQ(0u, frame_deletes);
+    } else if (frame % 5 != 0) {
+      // Between refreshes only the moving objects are published
+      EXPECT_EQ(static_cast<size_t>(object_count / 2), frame_adds);
+      EXPECT_EQ(0u, frame_deletes);
+    }
+  }
+
+  // Deletions are only sent once, for the objects which left
+  EXPECT_EQ(20u, deletes);
+  EXPECT_EQ(190u, cache.size());
+
+  // Parked objects are only republished on refresh, well below the 200 markers per frame published before
+  EXPECT_LT(adds, 200u * 30u * 3u / 5u);
+}
@@ -58,7 +58,7 @@ TEST(Testobject_visualizer, external_objects_test){
     obj2.id = 2;
     obj2.object_type = carma_perception_msgs::msg::ExternalObject::SMALL_VEHICLE;
 
-    msg->objects.push_back(obj2); // Duplicate the object so that we can check the id is incremented
+    msg->objects.push_back(obj2); // Second object so that we can check each object gets its own marker
 
 
 
@@ -83,8 +83,8 @@ TEST(Testobject_visualizer, external_objects_test){
 
     // Check that the result is correct
     ASSERT_EQ(result.markers.size(), 2u);
-    ASSERT_EQ(result.markers[0].id, 0);
-    ASSERT_EQ(result.markers[1].id, 1);
+    ASSERT_EQ(result.markers[0].id, 1); // Markers are identified by their object id
+    ASSERT_EQ(result.markers[1].id, 2);
 
     ASSERT_EQ(result.markers[0].header.frame_id.compare("map"), 0);
     ASSERT_EQ(result.markers[0].pose.position.x, obj.pose.pose.position.x);
@@ -128,6 +128,8 @@ TEST(Testobject_visualizer, external_objects_test){
     ASSERT_EQ(result.markers.size(), 2u);
     ASSERT_EQ(result.markers[0].action, visualization_msgs::msg::Marker::DELETE);
     ASSERT_EQ(result.markers[1].action, visualization_msgs::msg::Marker::DELETE);
+    ASSERT_EQ(result.markers[0].id, 1);
+    ASSERT_EQ(result.markers[1].id, 2);
 
 }
 
@@ -179,6 +181,7 @@ TEST(Testobject_visualizer, roadway_obstacles_test){
     obj3.id = 3;
     obj3.object_type = carma_perception_msgs::msg::ExternalObject::SMALL_VEHICLE;
 
+    obs3.object = obj3;
     obs3.connected_vehicle_type.type = carma_perception_msgs::msg::ConnectedVehicleType::NOT_CONNECTED;
 
     msg->roadway_obstacles.push_back(obs3);
@@ -206,9 +209,9 @@ TEST(Testobject_visualizer, roadway_obstacles_test){
 
     // Check that the result is correct
     ASSERT_EQ(result.markers.size(), 3u);
-    ASSERT_EQ(result.markers[0].id, 0);
-    ASSERT_EQ(result.markers[1].id, 1);
-    ASSERT_EQ(result.markers[2].id, 2);
+    ASSERT_EQ(result.markers[0].id, 1);
+    ASSERT_EQ(result.markers[1].id, 2);
+    ASSERT_EQ(result.markers[2].id, 3);
 
     ASSERT_EQ(result.markers[0].header.frame_id.compare("map"), 0);
     ASSERT_EQ(result.markers[0].pose.position.x, obj.pose.pose.position.x);
@@ -258,6 +261,9 @@ TEST(Testobject_visualizer, roadway_obstacles_test){
     ASSERT_EQ(result.markers[0].action, visualization_msgs::msg::Marker::DELETE);
     ASSERT_EQ(result.markers[1].action, visualization_msgs::msg::Marker::DELETE);
     ASSERT_EQ(result.markers[2].action, visualization_msgs::msg::Marker::DELETE);
+    ASSERT_EQ(result.markers[0].id, 1);
+    ASSERT_EQ(result.markers[1].id, 2);
+    ASSERT_EQ(result.markers[2].id, 3);
 
 }
 
@@ -18,7 +18,10 @@
 #define PLAN_DELEGATOR_INCLUDE_PLAN_DELEGATOR_HPP_
 
 #include <unordered_map>
+#include <future>
+#include <mutex>
 #include <math.h>
+#include <boost/optional.hpp>
 #include <ros/ros.h>
 #include <cav_msgs/ManeuverPlan.h>
 #include <cav_msgs/GuidanceState.h>
@@ -32,6 +35,8 @@
 #include <carma_wm/WMListener.h>
 #include <carma_wm/WorldModel.h>
 #include <carma_wm/Geometry.h>
+#include <planning_trace/trace_reporter.h>
+#include "planner_request_pool.hpp"
 
 // TODO Replace this Macro if possible
 /**
@@ -62,6 +67,26 @@
 
 namespace plan_delegator
 {
+    /**
+     * \brief Running statistics of PlanTrajectory service call latency for a single tactical plugin
+     */
+    struct PlannerLatency
+    {
+        size_t call_count = 0;
+        double last_ms = 0.0;
+        double mean_ms = 0.0;
+        double max_ms = 0.0;
+    };
+
+    /**
+     * \brief A PlanTrajectory request made ahead of the planning cycle reaching its maneuver
+     */
+    struct PredictedTrajectory
+    {
+        cav_srvs::PlanTrajectory request; // The request as sent, without its response
+        std::future<boost::optional<cav_srvs::PlanTrajectory>> result; // Yields the response or none if the call failed
+    };
+
     class PlanDelegator
     {
         public:
@@ -116,6 +141,26 @@ namespace plan_delegator
             void lookupFrontBumperTransform();
             
             void updateManeuverDistances(cav_msgs::Maneuver& maneuver);
+
+            /**
+             * \brief Generate a PlanTrajectory service request for a maneuver using the start state stored in the maneuver parameters
+             * rather than the end of a previously planned trajectory. Used to request trajectories for later maneuvers in parallel.
+             * \return a PlanTrajectory object or boost::none if the maneuver start position could not be found on the route
+             */
+            boost::optional<cav_srvs::PlanTrajectory> composePredictedPlanTrajectoryRequest(const cav_msgs::Maneuver& maneuver, const uint16_t& current_maneuver_index) const;
+
+            /**
+             * \brief Check if a request composed from predicted maneuver start state is close enough to the request composed from the
+             * actual end of the planned trajectory that its response can be used in place of a new sequential service call
+             * \return true if position, speed and time all fall within the configured pipelined planning tolerances
+             */
+            bool isPredictedRequestConsistent(const cav_srvs::PlanTrajectory& predicted, const cav_srvs::PlanTrajectory& actual) const;
+
+            /**
+             * \brief Get the PlanTrajectory service call latency statistics recorded for each tactical plugin
+             */
+            std::unordered_map<std::string, PlannerLatency> getPlannerLatency() const;
+
         protected:
         
             // ROS params
@@ -124,6 +169,11 @@ namespace plan_delegator
             double trajectory_planning_rate_ = 10.0;
             double max_trajectory_duration_ = 6.0;
             double min_crawl_speed_ = 2.2352; // Min crawl speed in m/s
+            bool pipelined_planning_enabled_ = false;
+            double pipelined_position_tolerance_ = 1.0; // Max distance in m between predicted and planned maneuver start
+            double pipelined_speed_tolerance_ = 0.5; // Max speed difference in m/s between predicted and planned maneuver start
+            double pipelined_time_tolerance_ = 0.5; // Max time difference in s between predicted and planned maneuver start
+            int pipelined_max_lookahead_ = 1; // Max number of maneuvers after the first active one requested ahead of time
 
             // map to store service clients
             std::unordered_map<std::string, ros::ServiceClient> trajectory_planners_;
@@ -158,6 +208,16 @@ namespace plan_delegator
             tf2_ros::Buffer tf2_buffer_;
             std::unique_ptr<tf2_ros::TransformListener> tf2_listener_;
 
+            // Publishes the planning cycle latency histograms and exports trace spans
+            std::unique_ptr<planning_trace::TraceReporter> trace_reporter_;
+
+            // PlanTrajectory latency per tactical plugin. Guarded by latency_mutex_ since pipelined calls record from worker threads
+            std::unordered_map<std::string, PlannerLatency> planner_latency_;
+            mutable std::mutex latency_mutex_;
+
+            // Workers for pipelined requests. Declared last so requests in flight finish before the members they use are destroyed
+            std::unique_ptr<PlannerRequestPool> request_pool_;
+
             /**
              * \brief Callback function for triggering trajectory planning
              */
@@ -187,6 +247,19 @@ namespace plan_delegator
              */
             cav_msgs::TrajectoryPlan planTrajectory();
 
+            /**
+             * \brief Call the PlanTrajectory service of a tactical plugin and record the call latency
+             * \return true if the service call succeeded
+             */
+            bool callPlanner(ros::ServiceClient client, const std::string& planner_name, cav_srvs::PlanTrajectory& plan_req);
+
+            /**
+             * \brief Request trajectories for up to pipelined_max_lookahead_ maneuvers after the first active one from their
+             * predicted start states. Maneuvers are skipped while every request worker is busy
+             * \return map from maneuver index to the pending request
+             */
+            std::unordered_map<uint16_t, PredictedTrajectory> requestPredictedTrajectories();
+
     };
 }
 #endif // PLAN_DELEGATOR_INCLUDE_PLAN_DELEGATOR_HPP_
\ No newline at end of file
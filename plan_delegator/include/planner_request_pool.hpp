@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef PLAN_DELEGATOR_INCLUDE_PLANNER_REQUEST_POOL_HPP_
+#define PLAN_DELEGATOR_INCLUDE_PLANNER_REQUEST_POOL_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace plan_delegator
+{
+    /**
+     * \brief Fixed set of worker threads which run speculative PlanTrajectory requests off the planning cycle.
+     *
+     * A request is only accepted while a worker is idle, so requests which are still in flight from an earlier cycle limit
+     * the requests of the next one rather than queueing up behind each other. Results are returned through promises
+     * owned by the tasks, so a planning cycle which stops early can drop its futures without waiting for the calls.
+     */
+    class PlannerRequestPool
+    {
+        public:
+
+            /**
+             * \brief Constructor
+             * \param thread_count Number of worker threads, which is also the number of requests that can be in flight
+             */
+            explicit PlannerRequestPool(size_t thread_count);
+
+            /**
+             * \brief Destructor. Waits for the requests in flight to finish
+             */
+            ~PlannerRequestPool();
+
+            PlannerRequestPool(const PlannerRequestPool&) = delete;
+            PlannerRequestPool& operator=(const PlannerRequestPool&) = delete;
+
+            /**
+             * \brief Run a task on a worker if one is idle
+             * \return true if the task was accepted, false if every worker is busy
+             */
+            bool trySubmit(std::function<void()> task);
+
+            /**
+             * \brief Number of tasks accepted which have not finished
+             */
+            size_t busyCount() const;
+
+        private:
+
+            void workerLoop();
+
+            std::vector<std::thread> workers_;
+            std::deque<std::function<void()>> tasks_;
+            size_t busy_count_ = 0;  // Tasks queued or running
+            bool stopping_ = false;
+            mutable std::mutex mutex_;
+            std::condition_variable task_available_;
+    };
+}
+
+#endif // PLAN_DELEGATOR_INCLUDE_PLANNER_REQUEST_POOL_HPP_
@@ -14,6 +14,8 @@
  * the License.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <carma_wm/Geometry.h>
 #include "plan_delegator.hpp"
@@ -36,6 +38,15 @@ namespace plan_delegator
         pnh_.param<double>("trajectory_planning_rate", trajectory_planning_rate_, 10.0);
         pnh_.param<double>("trajectory_duration_threshold", max_trajectory_duration_, 6.0);
         pnh_.param<double>("min_speed", min_crawl_speed_, min_crawl_speed_);
+        pnh_.param<bool>("enable_pipelined_planning", pipelined_planning_enabled_, pipelined_planning_enabled_);
+        pnh_.param<double>("pipelined_position_tolerance", pipelined_position_tolerance_, pipelined_position_tolerance_);
+        pnh_.param<double>("pipelined_speed_tolerance", pipelined_speed_tolerance_, pipelined_speed_tolerance_);
+        pnh_.param<double>("pipelined_time_tolerance", pipelined_time_tolerance_, pipelined_time_tolerance_);
+        pnh_.param<int>("pipelined_max_lookahead", pipelined_max_lookahead_, pipelined_max_lookahead_);
+        if (pipelined_planning_enabled_ && pipelined_max_lookahead_ > 0)
+        {
+            request_pool_.reset(new PlannerRequestPool(pipelined_max_lookahead_));
+        }
 
         traj_pub_ = nh_.advertise<cav_msgs::TrajectoryPlan>("plan_trajectory", 5);
         plan_sub_ = nh_.subscribe("final_maneuver_plan", 5, &PlanDelegator::maneuverPlanCallback, this);
@@ -44,6 +55,7 @@ namespace plan_delegator
         pose_sub_ = nh_.subscribe<geometry_msgs::PoseStamped>("current_pose", 5,
             [this](const geometry_msgs::PoseStampedConstPtr& pose) {this->latest_pose_ = *pose;});
         guidance_state_sub_ = nh_.subscribe<cav_msgs::GuidanceState>("guidance_state", 5, &PlanDelegator::guidanceStateCallback, this);
+        trace_reporter_.reset(new planning_trace::TraceReporter(nh_, pnh_));
 
         lookupFrontBumperTransform();
         wm_ = wml_->getWorldModel();
@@ -169,6 +181,149 @@ namespace plan_delegator
         SET_MANEUVER_PROPERTY(maneuver, end_dist, adjusted_end_dist);
     }
 
+    boost::optional<cav_srvs::PlanTrajectory> PlanDelegator::composePredictedPlanTrajectoryRequest(const cav_msgs::Maneuver& maneuver, const uint16_t& current_maneuver_index) const
+    {
+        double start_dist = GET_MANEUVER_PROPERTY(maneuver, start_dist);
+        auto start_point = wm_->pointFromRouteTrackPos(carma_wm::TrackPos(start_dist, 0.0));
+        if (!start_point)
+        {
+            return boost::none;
+        }
+
+        auto plan_req = cav_srvs::PlanTrajectory{};
+        plan_req.request.maneuver_plan = latest_maneuver_plan_;
+        plan_req.request.header.stamp = GET_MANEUVER_PROPERTY(maneuver, start_time);
+        plan_req.request.vehicle_state.x_pos_global = start_point->x();
+        plan_req.request.vehicle_state.y_pos_global = start_point->y();
+        plan_req.request.vehicle_state.longitudinal_vel = GET_MANEUVER_PROPERTY(maneuver, start_speed);
+        plan_req.request.maneuver_index_to_plan = current_maneuver_index;
+        return plan_req;
+    }
+
+    bool PlanDelegator::isPredictedRequestConsistent(const cav_srvs::PlanTrajectory& predicted, const cav_srvs::PlanTrajectory& actual) const
+    {
+        const auto& p = predicted.request;
+        const auto& a = actual.request;
+        double position_diff = std::hypot(p.vehicle_state.x_pos_global - a.vehicle_state.x_pos_global,
+                                          p.vehicle_state.y_pos_global - a.vehicle_state.y_pos_global);
+        double speed_diff = std::fabs(p.vehicle_state.longitudinal_vel - a.vehicle_state.longitudinal_vel);
+        double time_diff = std::fabs((p.header.stamp - a.header.stamp).toSec());
+
+        ROS_DEBUG_STREAM("Predicted start state error for maneuver " << a.maneuver_index_to_plan << " position: " << position_diff
+                            << " speed: " << speed_diff << " time: " << time_diff);
+
+        return p.maneuver_index_to_plan == a.maneuver_index_to_plan
+            && position_diff <= pipelined_position_tolerance_
+            && speed_diff <= pipelined_speed_tolerance_
+            && time_diff <= pipelined_time_tolerance_;
+    }
+
+    std::unordered_map<std::string, PlannerLatency> PlanDelegator::getPlannerLatency() const
+    {
+        std::lock_guard<std::mutex> lock(latency_mutex_);
+        return planner_latency_;
+    }
+
+    bool PlanDelegator::callPlanner(ros::ServiceClient client, const std::string& planner_name, cav_srvs::PlanTrajectory& plan_req)
+    {
+        auto start = std::chrono::steady_clock::now();
+        bool success = false;
+        {
+            // The plan id is passed explicitly since pipelined calls are made from worker threads outside the planning cycle
+            planning_trace::ScopedSpan planner_span("tactical/" + planner_name, plan_req.request.maneuver_plan.maneuver_plan_id);
+            success = client.call(plan_req);
+        }
+        double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(latency_mutex_);
+        PlannerLatency& latency = planner_latency_[planner_name];
+        latency.call_count++;
+        latency.last_ms = elapsed_ms;
+        latency.mean_ms += (elapsed_ms - latency.mean_ms) / latency.call_count;
+        latency.max_ms = std::max(latency.max_ms, elapsed_ms);
+
+        ROS_DEBUG_STREAM("PlanTrajectory call to " << planner_name << " for maneuver " << plan_req.request.maneuver_index_to_plan
+                            << " took " << elapsed_ms << " ms (mean " << latency.mean_ms << " ms, max " << latency.max_ms << " ms)");
+        return success;
+    }
+
+    std::unordered_map<uint16_t, PredictedTrajectory> PlanDelegator::requestPredictedTrajectories()
+    {
+        std::unordered_map<uint16_t, PredictedTrajectory> pending;
+        if (!request_pool_)
+        {
+            return pending;
+        }
+
+        lanelet::BasicPoint2d current_loc(latest_pose_.pose.position.x, latest_pose_.pose.position.y);
+        double current_downtrack = 0;
+        {
+            planning_trace::ScopedSpan wm_query_span("plan_delegator/world_model_query");
+            current_downtrack = wm_->routeTrackPos(current_loc).downtrack;
+        }
+
+        bool first_active = true;
+        int lookahead = 0;
+        for (uint16_t i = 0; i < latest_maneuver_plan_.maneuvers.size() && lookahead < pipelined_max_lookahead_; ++i)
+        {
+            const auto& maneuver = latest_maneuver_plan_.maneuvers[i];
+            if (isManeuverExpired(maneuver) || current_downtrack > GET_MANEUVER_PROPERTY(maneuver, end_dist))
+            {
+                continue;
+            }
+            // The first active maneuver is always planned from the current vehicle state
+            if (first_active)
+            {
+                first_active = false;
+                continue;
+            }
+            lookahead++;
+
+            auto predicted_req = composePredictedPlanTrajectoryRequest(maneuver, i);
+            if (!predicted_req)
+            {
+                ROS_DEBUG_STREAM("Could not predict start state of maneuver " << i << " so it will be planned sequentially");
+                continue;
+            }
+
+            // Clients are resolved on this thread since getPlannerClientByName modifies the client map
+            std::string planner_name = GET_MANEUVER_PROPERTY(maneuver, parameters.planning_tactical_plugin);
+            ros::ServiceClient client = getPlannerClientByName(planner_name);
+
+            // The promise is owned by the task so the planning cycle can drop the future without waiting for the call
+            auto promise = std::make_shared<std::promise<boost::optional<cav_srvs::PlanTrajectory>>>();
+            PredictedTrajectory predicted;
+            predicted.request = *predicted_req;
+            predicted.result = promise->get_future();
+
+            bool submitted = request_pool_->trySubmit(
+                [this, client, planner_name, predicted_req, promise]() mutable
+                {
+                    try
+                    {
+                        if (!callPlanner(client, planner_name, *predicted_req))
+                        {
+                            predicted_req = boost::none;
+                        }
+                        promise->set_value(predicted_req);
+                    }
+                    catch (...)
+                    {
+                        promise->set_exception(std::current_exception());
+                    }
+                });
+
+            if (!submitted)
+            {
+                ROS_DEBUG_STREAM("Request workers are busy so maneuver " << i << " will be planned sequentially");
+                break;
+            }
+            pending.emplace(i, std::move(predicted));
+        }
+
+        return pending;
+    }
+
     cav_msgs::TrajectoryPlan PlanDelegator::planTrajectory()
     {
         cav_msgs::TrajectoryPlan latest_trajectory_plan;
@@ -183,6 +338,15 @@ namespace plan_delegator
         
         // Track the index of the starting maneuver in the maneuver plan that this trajectory plan service request is for
         uint16_t current_maneuver_index = 0;
+
+        // In pipelined mode later maneuvers are requested up front from their predicted start states
+        // The responses are used below in place of sequential calls when the prediction matches the planned trajectory
+        // Unused requests are left to finish on the request workers without blocking this cycle
+        std::unordered_map<uint16_t, PredictedTrajectory> predicted_trajectories;
+        if (pipelined_planning_enabled_)
+        {
+            predicted_trajectories = requestPredictedTrajectories();
+        }
         
         // Loop through maneuver list to make service call to applicable Tactical Plugin
         while(current_maneuver_index < latest_maneuver_plan_.maneuvers.size())
@@ -200,7 +364,11 @@ namespace plan_delegator
             }
             
             lanelet::BasicPoint2d current_loc(latest_pose_.pose.position.x, latest_pose_.pose.position.y);
-            double current_downtrack = wm_->routeTrackPos(current_loc).downtrack;
+            double current_downtrack = 0;
+            {
+                planning_trace::ScopedSpan wm_query_span("plan_delegator/world_model_query");
+                current_downtrack = wm_->routeTrackPos(current_loc).downtrack;
+            }
             ROS_DEBUG_STREAM("current_downtrack" << current_downtrack);
             double maneuver_end_dist = GET_MANEUVER_PROPERTY(maneuver, end_dist);
             ROS_DEBUG_STREAM("maneuver_end_dist" << maneuver_end_dist);
@@ -222,7 +390,44 @@ namespace plan_delegator
             // compose service request
             auto plan_req = composePlanTrajectoryRequest(latest_trajectory_plan, current_maneuver_index);
 
-            if(client.call(plan_req))
+            bool call_succeeded = false;
+            auto predicted = predicted_trajectories.find(current_maneuver_index);
+            // Only wait for the response if the request it answers matches the planned start state
+            if (predicted != predicted_trajectories.end() && !latest_trajectory_plan.trajectory_points.empty()
+                && isPredictedRequestConsistent(predicted->second.request, plan_req))
+            {
+                boost::optional<cav_srvs::PlanTrajectory> predicted_req;
+                try
+                {
+                    predicted_req = predicted->second.result.get();
+                }
+                catch (const std::exception& e)
+                {
+                    ROS_WARN_STREAM("Pipelined request for maneuver " << current_maneuver_index << " failed: " << e.what());
+                }
+
+                if (predicted_req)
+                {
+                    ROS_DEBUG_STREAM("Using pipelined trajectory for maneuver " << current_maneuver_index);
+                    plan_req = *predicted_req;
+                    call_succeeded = true;
+                }
+                else
+                {
+                    ROS_DEBUG_STREAM("Pipelined call for maneuver " << current_maneuver_index << " failed. Falling back to sequential call");
+                }
+            }
+            else if (predicted != predicted_trajectories.end())
+            {
+                ROS_DEBUG_STREAM("Pipelined trajectory for maneuver " << current_maneuver_index << " does not match planned start state. Falling back to sequential call");
+            }
+
+            if (!call_succeeded)
+            {
+                call_succeeded = callPlanner(client, maneuver_planner, plan_req);
+            }
+
+            if(call_succeeded)
             {
                 // validate trajectory before add to the plan
                 if(!isTrajectoryValid(plan_req.response.trajectory_plan))
@@ -275,6 +480,7 @@ namespace plan_delegator
 
     void PlanDelegator::onTrajPlanTick(const ros::TimerEvent& te)
     {
+        planning_trace::CycleScope planning_cycle("plan_delegator/planning_cycle", latest_maneuver_plan_.maneuver_plan_id);
         cav_msgs::TrajectoryPlan trajectory_plan = planTrajectory();
         
         // Check if planned trajectory is valid before send out
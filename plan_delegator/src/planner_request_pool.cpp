@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "planner_request_pool.hpp"
+
+namespace plan_delegator
+{
+    PlannerRequestPool::PlannerRequestPool(size_t thread_count)
+    {
+        workers_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i)
+        {
+            workers_.emplace_back(&PlannerRequestPool::workerLoop, this);
+        }
+    }
+
+    PlannerRequestPool::~PlannerRequestPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        task_available_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    bool PlannerRequestPool::trySubmit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ || busy_count_ >= workers_.size())
+            {
+                return false;
+            }
+            busy_count_++;
+            tasks_.push_back(std::move(task));
+        }
+        task_available_.notify_one();
+        return true;
+    }
+
+    size_t PlannerRequestPool::busyCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return busy_count_;
+    }
+
+    void PlannerRequestPool::workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                task_available_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                {
+                    return;  // Stopping with nothing left to run
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+
+            task();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_count_--;
+        }
+    }
+}
@@ -14,6 +14,8 @@
  * the License.
  */
 
+#include <atomic>
+#include <future>
 #include <thread>
 #include <chrono>
 #include <cav_msgs/ManeuverPlan.h>
@@ -155,6 +157,78 @@
         EXPECT_EQ(1, num);
     }
 
+    TEST(TestPlanDelegator, TestPredictedRequestConsistency) {
+        PlanDelegatorTest pd;
+
+        cav_srvs::PlanTrajectory actual;
+        actual.request.maneuver_index_to_plan = 1;
+        actual.request.header.stamp = ros::Time(10.0);
+        actual.request.vehicle_state.x_pos_global = 100.0;
+        actual.request.vehicle_state.y_pos_global = 5.0;
+        actual.request.vehicle_state.longitudinal_vel = 10.0;
+
+        cav_srvs::PlanTrajectory predicted = actual;
+        predicted.request.header.stamp = ros::Time(10.2);
+        predicted.request.vehicle_state.x_pos_global = 100.5;
+        predicted.request.vehicle_state.longitudinal_vel = 10.3;
+        EXPECT_TRUE(pd.isPredictedRequestConsistent(predicted, actual));
+
+        // Each tolerance is checked independently
+        cav_srvs::PlanTrajectory far = predicted;
+        far.request.vehicle_state.y_pos_global = 7.0;
+        EXPECT_FALSE(pd.isPredictedRequestConsistent(far, actual));
+
+        cav_srvs::PlanTrajectory slow = predicted;
+        slow.request.vehicle_state.longitudinal_vel = 8.0;
+        EXPECT_FALSE(pd.isPredictedRequestConsistent(slow, actual));
+
+        cav_srvs::PlanTrajectory late = predicted;
+        late.request.header.stamp = ros::Time(11.0);
+        EXPECT_FALSE(pd.isPredictedRequestConsistent(late, actual));
+
+        cav_srvs::PlanTrajectory other_maneuver = predicted;
+        other_maneuver.request.maneuver_index_to_plan = 2;
+        EXPECT_FALSE(pd.isPredictedRequestConsistent(other_maneuver, actual));
+
+        // No latency is recorded until a planner is called
+        EXPECT_TRUE(pd.getPlannerLatency().empty());
+    }
+
+    TEST(TestPlanDelegator, TestPlannerRequestPool) {
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        std::atomic<int> finished(0);
+        auto last = std::make_shared<std::promise<int>>();
+        std::future<int> last_result = last->get_future();
+
+        {
+            plan_delegator::PlannerRequestPool pool(2);
+            auto blocking_task = [&finished, released]() { released.wait(); finished++; };
+
+            // Requests are only accepted while a worker is idle
+            EXPECT_TRUE(pool.trySubmit(blocking_task));
+            EXPECT_TRUE(pool.trySubmit(blocking_task));
+            EXPECT_FALSE(pool.trySubmit(blocking_task));
+            EXPECT_EQ(2u, pool.busyCount());
+
+            release.set_value();
+            while (pool.busyCount() > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            EXPECT_EQ(2, finished.load());
+
+            EXPECT_TRUE(pool.trySubmit([last]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                last->set_value(1);
+            }));
+        }
+
+        // Destruction waits for the requests in flight
+        ASSERT_EQ(std::future_status::ready, last_result.wait_for(std::chrono::seconds(0)));
+        EXPECT_EQ(1, last_result.get());
+    }
+
     /*!
     * \brief Main entrypoint for unit tests
     */
@@ -0,0 +1,66 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "tracer.h"
+
+namespace planning_trace
+{
+/**
+ * \brief Writes spans to a file in the Chrome trace event format for offline analysis.
+ *
+ * The file uses the JSON array form of the format, whose closing bracket is optional, so it can be appended to for the
+ * life of a node and still be opened in chrome://tracing or Perfetto if the node is killed. Each span is a complete
+ * ("X") event with the cycle id in its arguments. Files written by several nodes can be loaded together since span
+ * times are wall clock times and each node is its own process.
+ */
+class ChromeTraceExporter
+{
+public:
+  /**
+   * \brief Constructor. Creates or truncates the file
+   *
+   * \param path The path of the file to write
+   * \param process_name The name shown for the spans of this process, typically the node name
+   *
+   * \throws std::runtime_error if the file cannot be opened
+   */
+  ChromeTraceExporter(const std::string& path, const std::string& process_name);
+
+  /**
+   * \brief Appends spans to the file and flushes it
+   */
+  void write(const std::vector<Span>& spans);
+
+  /**
+   * \brief Writes a single span as a trace event without a trailing separator
+   *
+   * \param out The stream to write to
+   * \param span The span to write
+   * \param process_id The process id of the event
+   */
+  static void writeEvent(std::ostream& out, const Span& span, int process_id);
+
+private:
+  std::ofstream out_;
+  int process_id_;
+};
+}  // namespace planning_trace
@@ -0,0 +1,95 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace planning_trace
+{
+/**
+ * \brief Histogram of span durations with power of two bucket bounds.
+ *
+ * Bucket i counts durations greater than the bound of bucket i - 1 and up to 2^i us, so the buckets cover 1 us to a
+ * little over half an hour with a relative error of at most a factor of 2. The last bucket also counts any longer
+ * duration. Adding a sample is constant time and does not allocate.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr size_t BUCKET_COUNT = 32;
+
+  /**
+   * \brief Adds a duration to the histogram
+   *
+   * \param duration_us The duration in microseconds. Negative durations are counted as 0
+   */
+  void add(double duration_us);
+
+  /**
+   * \brief Adds the samples of another histogram to this one
+   */
+  void merge(const LatencyHistogram& other);
+
+  /**
+   * \brief Removes all samples
+   */
+  void reset();
+
+  /**
+   * \brief Returns the number of samples
+   */
+  uint64_t count() const;
+
+  /**
+   * \brief Returns the mean duration in microseconds or 0 if there are no samples
+   */
+  double meanUs() const;
+
+  /**
+   * \brief Returns the largest duration in microseconds or 0 if there are no samples
+   */
+  double maxUs() const;
+
+  /**
+   * \brief Returns an upper bound on the provided percentile of the durations. This is the bound of the bucket holding
+   * the percentile, limited to the largest duration seen.
+   *
+   * \param fraction The percentile as a fraction between 0 and 1
+   *
+   * \return The percentile in microseconds or 0 if there are no samples
+   */
+  double percentileUs(double fraction) const;
+
+  /**
+   * \brief Returns the number of samples in each bucket
+   */
+  const std::array<uint64_t, BUCKET_COUNT>& buckets() const;
+
+  /**
+   * \brief Returns the largest duration in microseconds counted by the provided bucket
+   */
+  static double bucketUpperBoundUs(size_t bucket);
+
+private:
+  std::array<uint64_t, BUCKET_COUNT> buckets_{};
+  uint64_t count_ = 0;
+  double sum_us_ = 0;
+  double max_us_ = 0;
+};
+}  // namespace planning_trace
@@ -0,0 +1,83 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <ros/ros.h>
+#include "chrome_trace_exporter.h"
+#include "tracer.h"
+
+namespace planning_trace
+{
+/**
+ * \brief Periodically publishes the latency histograms of a tracer and exports its spans.
+ *
+ * The histograms are published on the global planning_latency topic as a DiagnosticArray with one status per span name,
+ * so every traced node shares the topic and is identified by the hardware_id of its statuses. Each status holds the
+ * statistics of the spans recorded since the previous publication, followed by the same statistics since the node
+ * started under keys prefixed with "total_".
+ *
+ * Parameters read from the private node handle:
+ * - planning_trace_enabled: Enables tracing. Defaults to true
+ * - planning_trace_publish_period: Time in s between histogram publications and span exports. Defaults to 1.0
+ * - planning_trace_export_path: File to write spans to in the Chrome trace event format. Spans are not exported if
+ *   empty, which is the default
+ */
+class TraceReporter
+{
+public:
+  /**
+   * \brief Constructor. Reads the parameters, creates the publisher and starts the report timer
+   *
+   * \param nh Node handle used for the planning_latency topic and the timer
+   * \param pnh Private node handle used for the parameters
+   * \param tracer The tracer to report
+   */
+  TraceReporter(ros::NodeHandle& nh, ros::NodeHandle& pnh, Tracer& tracer = Tracer::global());
+
+  /**
+   * \brief Exports the spans recorded since the last report and publishes the histograms of the interval since the
+   * last report and of the node lifetime
+   */
+  void report();
+
+  /**
+   * \brief Converts histograms to a DiagnosticArray with one status per span name. Each status holds the sample count,
+   * mean, p50, p90, p99 and max in microseconds of the interval histogram, then of the total histogram with keys
+   * prefixed by "total_".
+   *
+   * \param interval_histograms The histograms of the last interval, keyed by span name. Span names without an
+   * interval histogram report a count of 0
+   * \param total_histograms The histograms since the node started, keyed by span name. One status is created for each
+   * \param hardware_id The hardware_id of each status, typically the node name
+   */
+  static diagnostic_msgs::DiagnosticArray toDiagnostics(
+      const std::map<std::string, LatencyHistogram>& interval_histograms,
+      const std::map<std::string, LatencyHistogram>& total_histograms, const std::string& hardware_id);
+
+private:
+  Tracer& tracer_;
+  std::string node_name_;
+  ros::Publisher latency_pub_;
+  ros::Timer report_timer_;
+  std::unique_ptr<ChromeTraceExporter> exporter_;
+  std::map<std::string, LatencyHistogram> total_histograms_;  // Every interval merged since the node started
+};
+}  // namespace planning_trace
@@ -0,0 +1,228 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "latency_histogram.h"
+
+/**
+ * \brief The planning_trace namespace contains the tracing used to break down where time goes in a planning cycle.
+ *
+ * Code is instrumented with ScopedSpan timers. Spans opened while a CycleScope is active on the same thread belong to
+ * that planning cycle and are recorded with its cycle id once the cycle ends. The cycle id is the maneuver plan id, so
+ * spans recorded by the arbitrator, the plan delegator and the plugins they call for the same plan can be joined
+ * offline. Every recorded span is added to a latency histogram for its name and kept in a bounded buffer until it is
+ * drained by an exporter.
+ *
+ * Tracing is enabled by default. When it is disabled a ScopedSpan costs one relaxed atomic load and reads no clock.
+ */
+namespace planning_trace
+{
+/**
+ * \brief A single timed section of code
+ */
+struct Span
+{
+  std::string cycle_id;  // Id of the planning cycle the span belongs to. Empty for spans outside a cycle
+  std::string name;
+  int64_t start_ns = 0;  // Wall clock time since the epoch so spans from different processes line up
+  double duration_us = 0;
+  uint64_t thread_id = 0;
+  uint32_t depth = 0;  // Number of spans enclosing this one on the same thread
+};
+
+/**
+ * \brief Collects spans and the per name latency histograms of those spans. Thread safe.
+ */
+class Tracer
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param span_capacity The number of spans kept until they are drained. The oldest spans are dropped once it is
+   * reached. Histograms are still updated for dropped spans
+   */
+  explicit Tracer(size_t span_capacity = 8192);
+
+  /**
+   * \brief Returns the process wide tracer used by default by CycleScope and ScopedSpan
+   */
+  static Tracer& global();
+
+  /**
+   * \brief Enables or disables tracing. Spans which are already open when tracing is disabled are still recorded
+   */
+  void setEnabled(bool enabled);
+
+  /**
+   * \brief Returns true if tracing is enabled
+   */
+  bool enabled() const
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * \brief Records a completed span
+   */
+  void record(Span span);
+
+  /**
+   * \brief Records several completed spans under a single lock
+   */
+  void record(std::vector<Span>& spans);
+
+  /**
+   * \brief Removes and returns the buffered spans in the order they were recorded
+   */
+  std::vector<Span> drainSpans();
+
+  /**
+   * \brief Returns the number of spans dropped because the buffer was full since the tracer was created
+   */
+  uint64_t droppedSpans() const;
+
+  /**
+   * \brief Returns a copy of the latency histogram of each span name
+   */
+  std::map<std::string, LatencyHistogram> histograms() const;
+
+  /**
+   * \brief Removes all samples from the histograms
+   */
+  void resetHistograms();
+
+  /**
+   * \brief Removes and returns the histograms, so the next call covers only the spans recorded after this one
+   */
+  std::map<std::string, LatencyHistogram> drainHistograms();
+
+private:
+  void recordLocked(Span& span);
+
+  std::atomic<bool> enabled_{ true };
+  size_t span_capacity_;
+  mutable std::mutex mutex_;
+  std::deque<Span> spans_;
+  uint64_t dropped_spans_ = 0;
+  std::map<std::string, LatencyHistogram> histograms_;
+};
+
+/**
+ * \brief Marks a planning cycle on the current thread.
+ *
+ * Spans closed on this thread while the scope is active are buffered in the scope. When the scope ends they are
+ * recorded with the final cycle id, followed by a span covering the whole cycle. The id can be set after the scope is
+ * opened since the arbitrator only learns the plan id once the plan has been generated.
+ */
+class CycleScope
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param name The name of the span covering the whole cycle. Must outlive the scope, so typically a string literal
+   * \param cycle_id The id of the cycle. May be left empty and set later with setCycleId
+   * \param tracer The tracer to record the spans to
+   */
+  explicit CycleScope(const char* name, const std::string& cycle_id = "", Tracer& tracer = Tracer::global());
+
+  ~CycleScope();
+
+  CycleScope(const CycleScope&) = delete;
+  CycleScope& operator=(const CycleScope&) = delete;
+
+  /**
+   * \brief Sets the id recorded with the spans of this cycle
+   */
+  void setCycleId(const std::string& cycle_id);
+
+  /**
+   * \brief Returns the id of this cycle
+   */
+  const std::string& cycleId() const;
+
+  /**
+   * \brief Returns the innermost active cycle on the current thread or nullptr if there is none
+   */
+  static CycleScope* current();
+
+private:
+  friend class ScopedSpan;
+
+  Tracer* tracer_ = nullptr;  // Null when tracing was disabled when the scope was opened
+  const char* name_;
+  std::string cycle_id_;
+  std::chrono::steady_clock::time_point start_;
+  int64_t start_ns_ = 0;
+  std::vector<Span> spans_;
+  CycleScope* previous_ = nullptr;
+};
+
+/**
+ * \brief Times the enclosing scope.
+ *
+ * The span belongs to the active CycleScope of the current thread unless a cycle id is provided explicitly, which is
+ * needed for spans on worker threads.
+ */
+class ScopedSpan
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param name The name of the span. Must outlive the span, so typically a string literal
+   * \param tracer The tracer to record the span to
+   */
+  explicit ScopedSpan(const char* name, Tracer& tracer = Tracer::global());
+
+  /**
+   * \brief Constructor for spans with names built at run time, such as those including a plugin name. The name is only
+   * copied when tracing is enabled.
+   *
+   * \param name The name of the span
+   * \param cycle_id The id of the cycle the span belongs to. If empty the active CycleScope of the thread is used
+   * \param tracer The tracer to record the span to
+   */
+  ScopedSpan(const std::string& name, const std::string& cycle_id, Tracer& tracer = Tracer::global());
+
+  ~ScopedSpan();
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+  void start();
+
+  Tracer* tracer_ = nullptr;  // Null when tracing was disabled when the span was opened
+  const char* static_name_ = nullptr;
+  std::string name_;
+  std::string cycle_id_;
+  bool explicit_cycle_ = false;
+  std::chrono::steady_clock::time_point start_;
+  int64_t start_ns_ = 0;
+  uint32_t depth_ = 0;
+};
+}  // namespace planning_trace
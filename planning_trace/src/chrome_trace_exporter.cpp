@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <planning_trace/chrome_trace_exporter.h>
+#include <cstdio>
+#include <iomanip>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace planning_trace
+{
+namespace
+{
+void writeJsonString(std::ostream& out, const std::string& value)
+{
+  out << '"';
+  for (char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+          out << escaped;
+        }
+        else
+        {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+}  // namespace
+
+ChromeTraceExporter::ChromeTraceExporter(const std::string& path, const std::string& process_name)
+  : out_(path, std::ios::out | std::ios::trunc), process_id_(static_cast<int>(::getpid()))
+{
+  if (!out_.is_open())
+  {
+    throw std::runtime_error("Could not open trace export file " + path);
+  }
+
+  // Metadata event naming the process in trace viewers
+  out_ << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << process_id_ << ",\"args\":{\"name\":";
+  writeJsonString(out_, process_name);
+  out_ << "}},\n";
+  out_.flush();
+}
+
+void ChromeTraceExporter::write(const std::vector<Span>& spans)
+{
+  for (const auto& span : spans)
+  {
+    writeEvent(out_, span, process_id_);
+    out_ << ",\n";
+  }
+  out_.flush();
+}
+
+void ChromeTraceExporter::writeEvent(std::ostream& out, const Span& span, int process_id)
+{
+  // Trace event times are in microseconds
+  out << "{\"name\":";
+  writeJsonString(out, span.name);
+  out << ",\"cat\":\"planning\",\"ph\":\"X\",\"ts\":" << span.start_ns / 1000 << '.' << std::setw(3)
+      << std::setfill('0') << span.start_ns % 1000 << std::setfill(' ') << ",\"dur\":" << std::fixed
+      << std::setprecision(3) << span.duration_us << std::defaultfloat << ",\"pid\":" << process_id
+      << ",\"tid\":" << (span.thread_id & 0xFFFFFFFF) << ",\"args\":{\"cycle\":";
+  writeJsonString(out, span.cycle_id);
+  out << ",\"depth\":" << span.depth << "}}";
+}
+}  // namespace planning_trace
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <planning_trace/latency_histogram.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace planning_trace
+{
+namespace
+{
+size_t bucketIndex(double duration_us)
+{
+  if (!(duration_us > 1.0))
+  {
+    return 0;
+  }
+  // duration_us = mantissa * 2^exponent with mantissa in [0.5, 1). Exact powers of two belong to the bucket they bound
+  int exponent = 0;
+  double mantissa = std::frexp(duration_us, &exponent);
+  size_t bucket = static_cast<size_t>(mantissa == 0.5 ? exponent - 1 : exponent);
+  return std::min(bucket, LatencyHistogram::BUCKET_COUNT - 1);
+}
+}  // namespace
+
+void LatencyHistogram::add(double duration_us)
+{
+  duration_us = std::max(0.0, duration_us);
+  buckets_[bucketIndex(duration_us)]++;
+  count_++;
+  sum_us_ += duration_us;
+  max_us_ = std::max(max_us_, duration_us);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+  for (size_t i = 0; i < BUCKET_COUNT; i++)
+  {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  sum_us_ += other.sum_us_;
+  max_us_ = std::max(max_us_, other.max_us_);
+}
+
+void LatencyHistogram::reset()
+{
+  buckets_.fill(0);
+  count_ = 0;
+  sum_us_ = 0;
+  max_us_ = 0;
+}
+
+uint64_t LatencyHistogram::count() const
+{
+  return count_;
+}
+
+double LatencyHistogram::meanUs() const
+{
+  return count_ == 0 ? 0.0 : sum_us_ / static_cast<double>(count_);
+}
+
+double LatencyHistogram::maxUs() const
+{
+  return max_us_;
+}
+
+double LatencyHistogram::percentileUs(double fraction) const
+{
+  if (count_ == 0)
+  {
+    return 0.0;
+  }
+
+  fraction = std::min(1.0, std::max(0.0, fraction));
+  uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count_))));
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; i++)
+  {
+    cumulative += buckets_[i];
+    if (cumulative >= target)
+    {
+      return std::min(bucketUpperBoundUs(i), max_us_);
+    }
+  }
+  return max_us_;
+}
+
+const std::array<uint64_t, LatencyHistogram::BUCKET_COUNT>& LatencyHistogram::buckets() const
+{
+  return buckets_;
+}
+
+double LatencyHistogram::bucketUpperBoundUs(size_t bucket)
+{
+  if (bucket >= BUCKET_COUNT - 1)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+  return std::ldexp(1.0, static_cast<int>(bucket));
+}
+}  // namespace planning_trace
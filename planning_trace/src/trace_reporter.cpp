@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <planning_trace/trace_reporter.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace planning_trace
+{
+namespace
+{
+diagnostic_msgs::KeyValue keyValue(const std::string& key, double value)
+{
+  diagnostic_msgs::KeyValue key_value;
+  key_value.key = key;
+  std::ostringstream stream;
+  stream << value;
+  key_value.value = stream.str();
+  return key_value;
+}
+
+void addValues(diagnostic_msgs::DiagnosticStatus& status, const std::string& prefix, const LatencyHistogram& histogram)
+{
+  status.values.push_back(keyValue(prefix + "count", static_cast<double>(histogram.count())));
+  status.values.push_back(keyValue(prefix + "mean_us", histogram.meanUs()));
+  status.values.push_back(keyValue(prefix + "p50_us", histogram.percentileUs(0.5)));
+  status.values.push_back(keyValue(prefix + "p90_us", histogram.percentileUs(0.9)));
+  status.values.push_back(keyValue(prefix + "p99_us", histogram.percentileUs(0.99)));
+  status.values.push_back(keyValue(prefix + "max_us", histogram.maxUs()));
+}
+}  // namespace
+
+TraceReporter::TraceReporter(ros::NodeHandle& nh, ros::NodeHandle& pnh, Tracer& tracer)
+  : tracer_(tracer), node_name_(ros::this_node::getName())
+{
+  bool enabled = true;
+  double publish_period = 1.0;
+  std::string export_path;
+  pnh.param<bool>("planning_trace_enabled", enabled, enabled);
+  pnh.param<double>("planning_trace_publish_period", publish_period, publish_period);
+  pnh.param<std::string>("planning_trace_export_path", export_path, export_path);
+
+  tracer_.setEnabled(enabled);
+  if (!enabled)
+  {
+    ROS_INFO_STREAM("Planning trace disabled");
+    return;
+  }
+
+  if (!export_path.empty())
+  {
+    try
+    {
+      exporter_.reset(new ChromeTraceExporter(export_path, node_name_));
+      ROS_INFO_STREAM("Exporting planning trace spans to " << export_path);
+    }
+    catch (const std::runtime_error& e)
+    {
+      ROS_ERROR_STREAM("Planning trace spans will not be exported: " << e.what());
+    }
+  }
+
+  latency_pub_ = nh.advertise<diagnostic_msgs::DiagnosticArray>("planning_latency", 1);
+  report_timer_ = nh.createTimer(ros::Duration(publish_period), [this](const ros::TimerEvent&) { report(); });
+}
+
+void TraceReporter::report()
+{
+  std::vector<Span> spans = tracer_.drainSpans();
+  if (exporter_ && !spans.empty())
+  {
+    exporter_->write(spans);
+  }
+
+  std::map<std::string, LatencyHistogram> interval_histograms = tracer_.drainHistograms();
+  for (const auto& entry : interval_histograms)
+  {
+    total_histograms_[entry.first].merge(entry.second);
+  }
+
+  diagnostic_msgs::DiagnosticArray msg = toDiagnostics(interval_histograms, total_histograms_, node_name_);
+  msg.header.stamp = ros::Time::now();
+  latency_pub_.publish(msg);
+}
+
+diagnostic_msgs::DiagnosticArray TraceReporter::toDiagnostics(
+    const std::map<std::string, LatencyHistogram>& interval_histograms,
+    const std::map<std::string, LatencyHistogram>& total_histograms, const std::string& hardware_id)
+{
+  diagnostic_msgs::DiagnosticArray msg;
+  msg.status.reserve(total_histograms.size());
+  for (const auto& entry : total_histograms)
+  {
+    auto interval_it = interval_histograms.find(entry.first);
+
+    diagnostic_msgs::DiagnosticStatus status;
+    status.level = diagnostic_msgs::DiagnosticStatus::OK;
+    status.name = entry.first;
+    status.hardware_id = hardware_id;
+    addValues(status, "", interval_it != interval_histograms.end() ? interval_it->second : LatencyHistogram());
+    addValues(status, "total_", entry.second);
+    msg.status.push_back(status);
+  }
+  return msg;
+}
+}  // namespace planning_trace
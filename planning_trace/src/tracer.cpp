@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <planning_trace/tracer.h>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace planning_trace
+{
+namespace
+{
+// Innermost active cycle and number of open spans on each thread
+thread_local CycleScope* t_current_cycle = nullptr;
+thread_local uint32_t t_span_depth = 0;
+
+int64_t wallTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+double elapsedUs(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t currentThreadId()
+{
+  return std::hash<std::thread::id>()(std::this_thread::get_id());
+}
+}  // namespace
+
+Tracer::Tracer(size_t span_capacity) : span_capacity_(span_capacity)
+{
+}
+
+Tracer& Tracer::global()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::record(Span span)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  recordLocked(span);
+}
+
+void Tracer::record(std::vector<Span>& spans)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& span : spans)
+  {
+    recordLocked(span);
+  }
+}
+
+void Tracer::recordLocked(Span& span)
+{
+  histograms_[span.name].add(span.duration_us);
+
+  if (span_capacity_ == 0)
+  {
+    dropped_spans_++;
+    return;
+  }
+  if (spans_.size() >= span_capacity_)
+  {
+    spans_.pop_front();
+    dropped_spans_++;
+  }
+  spans_.push_back(std::move(span));
+}
+
+std::vector<Span> Tracer::drainSpans()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Span> drained(std::make_move_iterator(spans_.begin()), std::make_move_iterator(spans_.end()));
+  spans_.clear();
+  return drained;
+}
+
+uint64_t Tracer::droppedSpans() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_spans_;
+}
+
+std::map<std::string, LatencyHistogram> Tracer::histograms() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return histograms_;
+}
+
+void Tracer::resetHistograms()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  histograms_.clear();
+}
+
+std::map<std::string, LatencyHistogram> Tracer::drainHistograms()
+{
+  std::map<std::string, LatencyHistogram> histograms;
+  std::lock_guard<std::mutex> lock(mutex_);
+  histograms.swap(histograms_);
+  return histograms;
+}
+
+CycleScope::CycleScope(const char* name, const std::string& cycle_id, Tracer& tracer) : name_(name)
+{
+  if (!tracer.enabled())
+  {
+    return;
+  }
+  tracer_ = &tracer;
+  cycle_id_ = cycle_id;
+  start_ = std::chrono::steady_clock::now();
+  start_ns_ = wallTimeNs();
+  previous_ = t_current_cycle;
+  t_current_cycle = this;
+}
+
+CycleScope::~CycleScope()
+{
+  if (!tracer_)
+  {
+    return;
+  }
+  t_current_cycle = previous_;
+
+  Span cycle_span;
+  cycle_span.name = name_;
+  cycle_span.start_ns = start_ns_;
+  cycle_span.duration_us = elapsedUs(start_);
+  cycle_span.thread_id = currentThreadId();
+  cycle_span.depth = t_span_depth;
+
+  for (auto& span : spans_)
+  {
+    span.cycle_id = cycle_id_;
+  }
+  cycle_span.cycle_id = std::move(cycle_id_);
+  spans_.push_back(std::move(cycle_span));
+  tracer_->record(spans_);
+}
+
+void CycleScope::setCycleId(const std::string& cycle_id)
+{
+  if (tracer_)
+  {
+    cycle_id_ = cycle_id;
+  }
+}
+
+const std::string& CycleScope::cycleId() const
+{
+  return cycle_id_;
+}
+
+CycleScope* CycleScope::current()
+{
+  return t_current_cycle;
+}
+
+ScopedSpan::ScopedSpan(const char* name, Tracer& tracer)
+{
+  if (!tracer.enabled())
+  {
+    return;
+  }
+  tracer_ = &tracer;
+  static_name_ = name;
+  start();
+}
+
+ScopedSpan::ScopedSpan(const std::string& name, const std::string& cycle_id, Tracer& tracer)
+{
+  if (!tracer.enabled())
+  {
+    return;
+  }
+  tracer_ = &tracer;
+  name_ = name;
+  if (!cycle_id.empty())
+  {
+    cycle_id_ = cycle_id;
+    explicit_cycle_ = true;
+  }
+  start();
+}
+
+void ScopedSpan::start()
+{
+  depth_ = t_span_depth++;
+  start_ns_ = wallTimeNs();
+  start_ = std::chrono::steady_clock::now();
+}
+
+ScopedSpan::~ScopedSpan()
+{
+  if (!tracer_)
+  {
+    return;
+  }
+  double duration_us = elapsedUs(start_);
+  t_span_depth--;
+
+  Span span;
+  span.name = static_name_ ? std::string(static_name_) : std::move(name_);
+  span.start_ns = start_ns_;
+  span.duration_us = duration_us;
+  span.thread_id = currentThreadId();
+  span.depth = depth_;
+
+  // Spans of the active cycle are recorded together when the cycle ends, once its id is known
+  if (!explicit_cycle_ && t_current_cycle && t_current_cycle->tracer_ == tracer_)
+  {
+    t_current_cycle->spans_.push_back(std::move(span));
+    return;
+  }
+  span.cycle_id = std::move(cycle_id_);
+  tracer_->record(std::move(span));
+}
+}  // namespace planning_trace
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+#include <planning_trace/chrome_trace_exporter.h>
+#include <planning_trace/latency_histogram.h>
+#include <planning_trace/trace_reporter.h>
+#include <planning_trace/tracer.h>
+
+namespace planning_trace
+{
+TEST(LatencyHistogramTest, bucketsAndPercentiles)
+{
+  LatencyHistogram histogram;
+  EXPECT_EQ(0u, histogram.count());
+  EXPECT_DOUBLE_EQ(0.0, histogram.percentileUs(0.99));
+
+  histogram.add(-5.0);  // Counted as 0
+  histogram.add(1.0);
+  histogram.add(2.0);
+  histogram.add(3.0);
+  histogram.add(1000.0);
+
+  EXPECT_EQ(5u, histogram.count());
+  EXPECT_EQ(2u, histogram.buckets()[0]);
+  EXPECT_EQ(1u, histogram.buckets()[1]);  // Powers of two are in the bucket they bound
+  EXPECT_EQ(1u, histogram.buckets()[2]);
+  EXPECT_EQ(1u, histogram.buckets()[10]);  // 512 < 1000 <= 1024
+  EXPECT_DOUBLE_EQ(1006.0 / 5.0, histogram.meanUs());
+  EXPECT_DOUBLE_EQ(1000.0, histogram.maxUs());
+
+  EXPECT_DOUBLE_EQ(1.0, histogram.percentileUs(0.2));
+  EXPECT_DOUBLE_EQ(2.0, histogram.percentileUs(0.5));
+  EXPECT_DOUBLE_EQ(4.0, histogram.percentileUs(0.8));
+  EXPECT_DOUBLE_EQ(1000.0, histogram.percentileUs(0.99));  // Bucket bound is capped at the max
+
+  LatencyHistogram other;
+  other.add(5000.0);
+  histogram.merge(other);
+  EXPECT_EQ(6u, histogram.count());
+  EXPECT_DOUBLE_EQ(5000.0, histogram.maxUs());
+
+  histogram.reset();
+  EXPECT_EQ(0u, histogram.count());
+  EXPECT_DOUBLE_EQ(0.0, histogram.maxUs());
+}
+
+TEST(TracerTest, spansJoinCycle)
+{
+  Tracer tracer;
+  {
+    CycleScope cycle("cycle", "", tracer);
+    EXPECT_EQ(&cycle, CycleScope::current());
+    {
+      ScopedSpan outer("outer", tracer);
+      ScopedSpan inner(std::string("inner"), "", tracer);
+    }
+    // Spans are not recorded until the cycle ends
+    EXPECT_TRUE(tracer.drainSpans().empty());
+    cycle.setCycleId("plan_1");
+  }
+  EXPECT_EQ(nullptr, CycleScope::current());
+
+  std::vector<Span> spans = tracer.drainSpans();
+  ASSERT_EQ(3u, spans.size());
+  EXPECT_EQ("inner", spans[0].name);
+  EXPECT_EQ(1u, spans[0].depth);
+  EXPECT_EQ("outer", spans[1].name);
+  EXPECT_EQ(0u, spans[1].depth);
+  EXPECT_EQ("cycle", spans[2].name);
+  for (const auto& span : spans)
+  {
+    EXPECT_EQ("plan_1", span.cycle_id);
+  }
+  EXPECT_GE(spans[2].duration_us, spans[1].duration_us);
+  EXPECT_GE(spans[1].duration_us, spans[0].duration_us);
+
+  auto histograms = tracer.histograms();
+  ASSERT_EQ(3u, histograms.size());
+  EXPECT_EQ(1u, histograms["outer"].count());
+  EXPECT_TRUE(tracer.drainSpans().empty());
+}
+
+TEST(TracerTest, spansOutsideCycle)
+{
+  Tracer tracer;
+  {
+    ScopedSpan span("standalone", tracer);
+  }
+
+  // Spans on other threads do not join the cycle of this thread unless given its id
+  {
+    CycleScope cycle("cycle", "plan_2", tracer);
+    std::thread worker([&tracer]() {
+      ScopedSpan joined(std::string("worker_joined"), "plan_2", tracer);
+      ScopedSpan standalone("worker_standalone", tracer);
+    });
+    worker.join();
+  }
+
+  std::vector<Span> spans = tracer.drainSpans();
+  ASSERT_EQ(4u, spans.size());
+  EXPECT_EQ("standalone", spans[0].name);
+  EXPECT_TRUE(spans[0].cycle_id.empty());
+  EXPECT_EQ("worker_standalone", spans[1].name);
+  EXPECT_TRUE(spans[1].cycle_id.empty());
+  EXPECT_EQ("worker_joined", spans[2].name);
+  EXPECT_EQ("plan_2", spans[2].cycle_id);
+  EXPECT_NE(spans[0].thread_id, spans[2].thread_id);
+  EXPECT_EQ("cycle", spans[3].name);
+  EXPECT_EQ("plan_2", spans[3].cycle_id);
+}
+
+TEST(TracerTest, disabled)
+{
+  Tracer tracer;
+  tracer.setEnabled(false);
+  {
+    CycleScope cycle("cycle", "plan_3", tracer);
+    EXPECT_EQ(nullptr, CycleScope::current());
+    ScopedSpan span("span", tracer);
+  }
+  EXPECT_TRUE(tracer.drainSpans().empty());
+  EXPECT_TRUE(tracer.histograms().empty());
+}
+
+TEST(TracerTest, boundedBuffer)
+{
+  Tracer tracer(2);
+  for (int i = 0; i < 5; i++)
+  {
+    Span span;
+    span.name = "span_" + std::to_string(i);
+    tracer.record(span);
+  }
+
+  std::vector<Span> spans = tracer.drainSpans();
+  ASSERT_EQ(2u, spans.size());
+  EXPECT_EQ("span_3", spans[0].name);
+  EXPECT_EQ("span_4", spans[1].name);
+  EXPECT_EQ(3u, tracer.droppedSpans());
+  EXPECT_EQ(5u, tracer.histograms().size());
+
+  tracer.resetHistograms();
+  EXPECT_TRUE(tracer.histograms().empty());
+}
+
+TEST(TracerTest, drainHistograms)
+{
+  Tracer tracer;
+  Span span;
+  span.name = "span";
+  span.duration_us = 100.0;
+  tracer.record(span);
+  tracer.record(span);
+
+  auto histograms = tracer.drainHistograms();
+  ASSERT_EQ(1u, histograms.count("span"));
+  EXPECT_EQ(2u, histograms["span"].count());
+  EXPECT_TRUE(tracer.histograms().empty());
+
+  span.duration_us = 300.0;
+  tracer.record(span);
+  histograms = tracer.drainHistograms();
+  EXPECT_EQ(1u, histograms["span"].count());
+  EXPECT_NEAR(300.0, histograms["span"].meanUs(), 1e-9);
+}
+
+TEST(TraceReporterTest, toDiagnostics)
+{
+  std::map<std::string, LatencyHistogram> interval, total;
+  interval["active"].add(200.0);
+  total["active"].add(100.0);
+  total["active"].add(200.0);
+  total["idle"].add(50.0);
+
+  diagnostic_msgs::DiagnosticArray msg = TraceReporter::toDiagnostics(interval, total, "node");
+  ASSERT_EQ(2u, msg.status.size());
+
+  std::map<std::string, std::map<std::string, double>> values;
+  for (const auto& status : msg.status)
+  {
+    EXPECT_EQ("node", status.hardware_id);
+    for (const auto& key_value : status.values)
+    {
+      values[status.name][key_value.key] = std::stod(key_value.value);
+    }
+  }
+
+  EXPECT_EQ(1.0, values["active"]["count"]);
+  EXPECT_NEAR(200.0, values["active"]["mean_us"], 1e-6);
+  EXPECT_EQ(2.0, values["active"]["total_count"]);
+  EXPECT_NEAR(150.0, values["active"]["total_mean_us"], 1e-6);
+
+  // No samples in the interval, but the lifetime statistics are still published
+  EXPECT_EQ(0.0, values["idle"]["count"]);
+  EXPECT_EQ(1.0, values["idle"]["total_count"]);
+  EXPECT_NEAR(50.0, values["idle"]["total_max_us"], 1e-6);
+}
+
+TEST(ChromeTraceExporterTest, writeEvent)
+{
+  Span span;
+  span.cycle_id = "plan\"1";
+  span.name = "arbitrator/generate_plan";
+  span.start_ns = 1634067044000012345;
+  span.duration_us = 12.5;
+  span.thread_id = 7;
+  span.depth = 1;
+
+  std::ostringstream out;
+  ChromeTraceExporter::writeEvent(out, span, 42);
+  EXPECT_EQ("{\"name\":\"arbitrator/generate_plan\",\"cat\":\"planning\",\"ph\":\"X\",\"ts\":1634067044000012.345,"
+            "\"dur\":12.500,\"pid\":42,\"tid\":7,\"args\":{\"cycle\":\"plan\\\"1\",\"depth\":1}}",
+            out.str());
+}
+
+TEST(ChromeTraceExporterTest, writeFile)
+{
+  EXPECT_THROW(ChromeTraceExporter("/nonexistent_dir/trace.json", "node"), std::runtime_error);
+
+  std::string path = "/tmp/planning_trace_test.json";
+  {
+    ChromeTraceExporter exporter(path, "/arbitrator");
+    Span span;
+    span.name = "span";
+    exporter.write({ span, span });
+  }
+
+  std::ifstream in(path);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  std::string text = contents.str();
+  std::remove(path.c_str());
+
+  EXPECT_EQ('[', text.front());
+  EXPECT_NE(std::string::npos, text.find("\"args\":{\"name\":\"/arbitrator\"}"));
+  size_t events = 0;
+  for (size_t pos = text.find("\"ph\":\"X\""); pos != std::string::npos; pos = text.find("\"ph\":\"X\"", pos + 1))
+  {
+    events++;
+  }
+  EXPECT_EQ(2u, events);
+}
+}  // namespace planning_trace
@@ -27,6 +27,7 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <math.h>
 #include <carma_utils/CARMAUtils.h>
+#include <basic_autonomy/trajectory_view.h>
 #include "platoon_control_worker.h"
 
 
@@ -56,7 +57,7 @@ namespace platoon_control
 			autoware_msgs::ControlCommandStamped composeCtrlCmd(double linear_vel, double steering_angle);
 
 			// find the point correspoding to the lookahead distance
-			cav_msgs::TrajectoryPlanPoint getLookaheadTrajectoryPoint(cav_msgs::TrajectoryPlan trajectory_plan);
+			const cav_msgs::TrajectoryPlanPoint& getLookaheadTrajectoryPoint(const basic_autonomy::TrajectoryView& trajectory) const;
 			
 			// local copy of pose
         	geometry_msgs::PoseStamped pose_msg_;
@@ -94,7 +95,8 @@ namespace platoon_control
 			// callback function for current twist
 			void currentTwist_cb(const geometry_msgs::TwistStamped::ConstPtr& twist);
 
-			double getTrajectorySpeed(std::vector<cav_msgs::TrajectoryPlanPoint> trajectory_points);
+			// average speed between the first and last trajectory points
+			double getTrajectorySpeed(const basic_autonomy::TrajectoryView& trajectory) const;
 
 			
 
@@ -99,10 +99,12 @@ namespace platoon_control
             ROS_WARN_STREAM("PlatoonControlPlugin cannot execute trajectory as only 1 point was provided");
             return;
         }
-        cav_msgs::TrajectoryPlanPoint first_trajectory_point = tp->trajectory_points[1]; // TODO this variable appears to be misnamed. It is the second trajectory point
-        cav_msgs::TrajectoryPlanPoint lookahead_point = getLookaheadTrajectoryPoint(*tp);
+        basic_autonomy::TrajectoryView trajectory(*tp);
 
-        trajectory_speed_ = getTrajectorySpeed(tp->trajectory_points);
+        const cav_msgs::TrajectoryPlanPoint& first_trajectory_point = tp->trajectory_points[1]; // TODO this variable appears to be misnamed. It is the second trajectory point
+        const cav_msgs::TrajectoryPlanPoint& lookahead_point = getLookaheadTrajectoryPoint(trajectory);
+
+        trajectory_speed_ = getTrajectorySpeed(trajectory);
 
     	
         
@@ -111,9 +113,9 @@ namespace platoon_control
 
     }
 
-    cav_msgs::TrajectoryPlanPoint PlatoonControlPlugin::getLookaheadTrajectoryPoint(cav_msgs::TrajectoryPlan trajectory_plan)
+    const cav_msgs::TrajectoryPlanPoint& PlatoonControlPlugin::getLookaheadTrajectoryPoint(const basic_autonomy::TrajectoryView& trajectory) const
     {   
-        cav_msgs::TrajectoryPlanPoint lookahead_point;
+        const std::vector<cav_msgs::TrajectoryPlanPoint>& trajectory_points = trajectory.plan().trajectory_points;
 
         double lookahead_dist = config_.lookaheadRatio * current_speed_;
         ROS_DEBUG_STREAM("lookahead based on speed: " << lookahead_dist);
@@ -122,17 +124,13 @@ namespace platoon_control
         ROS_DEBUG_STREAM("final lookahead: " << lookahead_dist);
             
         double traveled_dist = 0.0;
-        bool found_point = false;
 
-        for (size_t i = 1; i<trajectory_plan.trajectory_points.size() - 1; i++)
+        for (size_t i = 1; i<trajectory_points.size() - 1; i++)
         {
-            double dx =  pose_msg_.pose.position.x - trajectory_plan.trajectory_points[i].x;
-            double dy =  pose_msg_.pose.position.y - trajectory_plan.trajectory_points[i].y;
+            double dx =  pose_msg_.pose.position.x - trajectory_points[i].x;
+            double dy =  pose_msg_.pose.position.y - trajectory_points[i].y;
 
-            double dx1 = trajectory_plan.trajectory_points[i].x - trajectory_plan.trajectory_points[i-1].x;
-            double dy1 = trajectory_plan.trajectory_points[i].y - trajectory_plan.trajectory_points[i-1].y;
-            double dist1 = std::sqrt(dx1*dx1 + dy1*dy1);  
-            ROS_DEBUG_STREAM("trajectory spacing: " << dist1);          
+            ROS_DEBUG_STREAM("trajectory spacing: " << std::hypot(trajectory_points[i].x - trajectory_points[i-1].x, trajectory_points[i].y - trajectory_points[i-1].y));
 
             double dist = std::sqrt(dx*dx + dy*dy);            
 
@@ -140,21 +138,13 @@ namespace platoon_control
 
             if ((lookahead_dist - traveled_dist) < 1.0)
             {
-                lookahead_point =  trajectory_plan.trajectory_points[i];
-                found_point = true;
                 ROS_DEBUG_STREAM("found lookahead point at index: " << i);
-                break;
+                return trajectory_points[i];
             }
         }
 
-        if (!found_point)
-        {
-            lookahead_point = trajectory_plan.trajectory_points.back();
-            ROS_DEBUG_STREAM("lookahead point set as the last trajectory point");
-        }
-
-        
-        return lookahead_point;
+        ROS_DEBUG_STREAM("lookahead point set as the last trajectory point");
+        return trajectory_points.back();
     }
 
     void PlatoonControlPlugin::pose_cb(const geometry_msgs::PoseStampedConstPtr& msg)
@@ -232,28 +222,25 @@ namespace platoon_control
         ctrl_pub_.publish(ctrl_msg);
     }
 
-    // extract maximum speed of trajectory
-    double PlatoonControlPlugin::getTrajectorySpeed(std::vector<cav_msgs::TrajectoryPlanPoint> trajectory_points)
+    // extract average speed of trajectory
+    double PlatoonControlPlugin::getTrajectorySpeed(const basic_autonomy::TrajectoryView& trajectory) const
     {   
-        double trajectory_speed = 0;
+        const std::vector<cav_msgs::TrajectoryPlanPoint>& trajectory_points = trajectory.plan().trajectory_points;
 
-        double dx1 = trajectory_points[trajectory_points.size()-1].x - trajectory_points[0].x;
-        double dy1 = trajectory_points[trajectory_points.size()-1].y - trajectory_points[0].y;
+        double dx1 = trajectory_points.back().x - trajectory_points.front().x;
+        double dy1 = trajectory_points.back().y - trajectory_points.front().y;
         double d1 = sqrt(dx1*dx1 + dy1*dy1); 
-        double t1 = (trajectory_points[trajectory_points.size()-1].target_time.toSec() - trajectory_points[0].target_time.toSec());
+        double t1 = (trajectory_points.back().target_time.toSec() - trajectory_points.front().target_time.toSec());
 
         double avg_speed = d1/t1;
 
-        for(size_t i = 0; i < trajectory_points.size() - 2; i++ )
-        {            double dx = trajectory_points[i + 1].x - trajectory_points[i].x;
-            double dy = trajectory_points[i + 1].y - trajectory_points[i].y;
-            double d = sqrt(dx*dx + dy*dy); 
-            double t = (trajectory_points[i + 1].target_time.toSec() - trajectory_points[i].target_time.toSec());
-            double v = d/t;
-            if(v > trajectory_speed)
-            {
-                trajectory_speed = v;
-            }
+        // The fastest segment is only logged. The view's downtracks and times already exclude repeated timestamps
+        const std::vector<double>& downtracks = trajectory.downtracks();
+        const std::vector<double>& times = trajectory.times();
+        double trajectory_speed = 0;
+        for (size_t i = 1; i < trajectory.size(); i++)
+        {
+            trajectory_speed = std::max(trajectory_speed, (downtracks[i] - downtracks[i - 1]) / (times[i] - times[i - 1]));
         }
 
         ROS_DEBUG_STREAM("trajectory speed: " << trajectory_speed);
@@ -44,9 +44,34 @@ TEST(PlatoonControlPluginTest, test2)
 
     platoon_control::PlatoonControlPlugin pc;
     pc.current_speed_ = 5;
-    cav_msgs::TrajectoryPlanPoint out = pc.getLookaheadTrajectoryPoint(tp);
+    cav_msgs::TrajectoryPlanPoint out = pc.getLookaheadTrajectoryPoint(basic_autonomy::TrajectoryView(tp));
     EXPECT_EQ(out.x, 10.0);
 }
 
+TEST(PlatoonControlPluginTest, test_lookahead_ignores_repeated_timestamps)
+{
+    cav_msgs::TrajectoryPlan tp;
+    cav_msgs::TrajectoryPlanPoint point;
+    for (int i = 0; i < 6; i++)
+    {
+        point.x = 5.0 * i;
+        point.y = 0.0;
+        point.target_time = ros::Time(i / 2); // Every point shares its timestamp with a neighbor
+        tp.trajectory_points.push_back(point);
+    }
+
+    basic_autonomy::TrajectoryView trajectory(tp);
+    ASSERT_EQ(3u, trajectory.size());
+
+    platoon_control::PlatoonControlPlugin pc;
+    pc.current_speed_ = 10;
+    pc.pose_msg_.pose.position.x = 0.0;
+
+    // The lookahead search runs over every point of the plan, not only those with unique timestamps
+    const cav_msgs::TrajectoryPlanPoint& out = pc.getLookaheadTrajectoryPoint(trajectory);
+    EXPECT_EQ(&out, &tp.trajectory_points[4]);
+    EXPECT_NEAR(out.x, 20.0, 0.0001);
+}
+
 
 
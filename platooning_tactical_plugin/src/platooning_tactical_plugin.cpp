@@ -33,7 +33,7 @@
 #include <platooning_tactical_plugin/smoothing/SplineI.h>
 #include <platooning_tactical_plugin/smoothing/BSpline.h>
 #include <platooning_tactical_plugin/log/log.h>
-#include <platooning_tactical_plugin/smoothing/filters.h>
+#include <basic_autonomy/smoothing/filters.h>
 #include <unordered_set>
 
 using oss = std::ostringstream;
@@ -611,7 +611,9 @@ std::vector<cav_msgs::TrajectoryPlanPoint> PlatooningTacticalPlugin::compose_tra
 
   log::printDoublesPerLineWithPrefix("raw_curvatures[i]: ", better_curvature);
 
-  std::vector<double> curvatures = smoothing::moving_average_filter(better_curvature, config_.curvature_moving_average_window_size);
+  std::vector<double> curvatures(better_curvature.size());
+  basic_autonomy::smoothing::trailing_moving_average(better_curvature.data(), curvatures.data(), curvatures.size(),
+                                                     config_.curvature_moving_average_window_size);
 
   std::vector<double> ideal_speeds =
       trajectory_utils::constrained_speeds_for_curvatures(curvatures, config_.lateral_accel_limit);
@@ -678,7 +680,8 @@ std::vector<cav_msgs::TrajectoryPlanPoint> PlatooningTacticalPlugin::compose_tra
 
   log::printDoublesPerLineWithPrefix("postAccel[i]: ", final_actual_speeds);
 
-  final_actual_speeds = smoothing::moving_average_filter(final_actual_speeds, config_.speed_moving_average_window_size);
+  basic_autonomy::smoothing::trailing_moving_average(final_actual_speeds.data(), final_actual_speeds.data(),
+                                                     final_actual_speeds.size(), config_.speed_moving_average_window_size);
   log::printDoublesPerLineWithPrefix("post_average[i]: ", final_actual_speeds);
 
   for (auto& s : final_actual_speeds)  // Limit minimum speed. TODO how to handle stopping?
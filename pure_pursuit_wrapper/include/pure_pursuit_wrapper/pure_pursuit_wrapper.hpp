@@ -24,10 +24,11 @@
 #include "pure_pursuit_wrapper_config.hpp"
 #include <algorithm>
 #include <trajectory_utils/trajectory_utils.h>
+#include <basic_autonomy/trajectory_view.h>
 
 namespace pure_pursuit_wrapper {
 
-using WaypointPub = std::function<void(autoware_msgs::Lane)>;
+using WaypointPub = std::function<void(const autoware_msgs::Lane&)>;
 using PluginDiscoveryPub = std::function<void(cav_msgs::Plugin)>;
 /*!
  * Main class for the node to handle the ROS interfacing.
@@ -40,6 +41,15 @@ class PurePursuitWrapper {
 
         void trajectoryPlanHandler(const cav_msgs::TrajectoryPlan::ConstPtr& tp);
 
+        /**
+         * \brief Converts a trajectory to the lane published to pure pursuit.
+         * Each waypoint takes the position of a kept point of the view and its speed after apply_response_lag.
+         *
+         * \param trajectory View of the trajectory plan to convert
+         * \param[out] lane The lane to fill. Its waypoints are overwritten in place
+         */
+        void trajectoryToLane(const basic_autonomy::TrajectoryView& trajectory, autoware_msgs::Lane& lane) const;
+
         bool onSpin();
 
         /**
@@ -50,7 +60,7 @@ class PurePursuitWrapper {
          * 
          * \return A Shifted trajectory
          */ 
-        std::vector<double> apply_response_lag(const std::vector<double>& speeds, const std::vector<double> downtracks, double response_lag) const;
+        std::vector<double> apply_response_lag(const std::vector<double>& speeds, const std::vector<double>& downtracks, double response_lag) const;
 
         /**
          * \brief Drops any points that sequentially have same target_time and return new trajectory_points in order to avoid divide by zero situation
@@ -65,6 +75,7 @@ class PurePursuitWrapper {
     WaypointPub waypoint_pub_;
     PluginDiscoveryPub plugin_discovery_pub_;
     cav_msgs::Plugin plugin_discovery_msg_;
+    autoware_msgs::Lane lane_; // Reused between plans to avoid reallocating the waypoints
 
 };
 
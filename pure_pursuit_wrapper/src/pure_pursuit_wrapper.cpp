@@ -15,7 +15,6 @@
  */
 
 #include "pure_pursuit_wrapper/pure_pursuit_wrapper.hpp"
-#include <trajectory_utils/conversions/conversions.h>
 #include <carma_wm/Geometry.h>
 #include <algorithm>
 
@@ -44,52 +43,40 @@ void PurePursuitWrapper::trajectoryPlanHandler(const cav_msgs::TrajectoryPlan::C
 {
   ROS_DEBUG_STREAM("Received TrajectoryPlanCurrentPosecallback message");
 
-  std::vector<double> times;
-  std::vector<double> downtracks;
+  basic_autonomy::TrajectoryView trajectory(*tp); // Drops duplicated timestamps and computes the speed profile
+  ROS_DEBUG_STREAM("Original Trajectory size:"<<tp->trajectory_points.size() <<" Size after removing duplicate timestamps:"<<trajectory.size());
 
-  //Remove trajectory points with duplicated timestamps
-  std::vector<cav_msgs::TrajectoryPlanPoint> trajectory_points = remove_repeated_timestamps(tp->trajectory_points);
-  ROS_DEBUG_STREAM("Original Trajectory size:"<<tp->trajectory_points.size() <<" Size after removing duplicate timestamps:"<<trajectory_points.size());
-
-  trajectory_utils::conversions::trajectory_to_downtrack_time(trajectory_points, &downtracks, &times);
-
-  std::vector<double> speeds;
-  trajectory_utils::conversions::time_to_speed(downtracks, times, tp->initial_longitudinal_velocity, &speeds);
-
-  if (speeds.size() != trajectory_points.size())
+  if (trajectory.empty())
   {
-    throw std::invalid_argument("Speeds and trajectory points sizes do not match");
+    throw std::invalid_argument("Received trajectory plan with no points");
   }
 
-  for (size_t i =0; i < speeds.size(); i++) { // Ensure 0 is min speed
-    speeds[i] = std::max(0.0, speeds[i]);
-  }
+  lane_.header = tp->header;
+  trajectoryToLane(trajectory, lane_);
+  waypoint_pub_(lane_);
+};
 
-  std::vector<double> lag_speeds = apply_response_lag(speeds, downtracks, config_.vehicle_response_lag); // This call requires that the first speed point be current speed to work as expected
+void PurePursuitWrapper::trajectoryToLane(const basic_autonomy::TrajectoryView& trajectory, autoware_msgs::Lane& lane) const
+{
+  std::vector<double> lag_speeds = apply_response_lag(trajectory.speeds(), trajectory.downtracks(), config_.vehicle_response_lag); // This call requires that the first speed point be current speed to work as expected
 
-  autoware_msgs::Lane lane;
-  lane.header = tp->header;
-  std::vector<autoware_msgs::Waypoint> waypoints;
-  waypoints.reserve(trajectory_points.size());
+  // Only the position and speed are ever set, so waypoints kept from a previous lane can be overwritten without being reset
+  lane.waypoints.resize(trajectory.size());
 
-  for (int i = 0; i < trajectory_points.size(); i++)
+  for (size_t i = 0; i < trajectory.size(); i++)
   {
-    autoware_msgs::Waypoint wp;
-
-    wp.pose.pose.position.x = trajectory_points[i].x;
-    wp.pose.pose.position.y = trajectory_points[i].y;
+    const cav_msgs::TrajectoryPlanPoint& point = trajectory.point(i);
+    autoware_msgs::Waypoint& wp = lane.waypoints[i];
+    wp.pose.pose.position.x = point.x;
+    wp.pose.pose.position.y = point.y;
     wp.twist.twist.linear.x = lag_speeds[i];
-    ROS_DEBUG_STREAM("Setting waypoint idx: " << i <<", with planner: << " << trajectory_points[i].planner_plugin_name << ", x: " << trajectory_points[i].x << 
-                            ", y: " << trajectory_points[i].y <<
+    ROS_DEBUG_STREAM("Setting waypoint idx: " << i <<", with planner: << " << point.planner_plugin_name << ", x: " << point.x << 
+                            ", y: " << point.y <<
                             ", speed: " << lag_speeds[i]* 2.23694 << "mph");
-    waypoints.push_back(wp);
   }
+}
 
-  lane.waypoints = waypoints;
-  waypoint_pub_(lane);
-};
-
-std::vector<double> PurePursuitWrapper::apply_response_lag(const std::vector<double>& speeds, const std::vector<double> downtracks, double response_lag) const { // Note first speed is assumed to be vehicle speed
+std::vector<double> PurePursuitWrapper::apply_response_lag(const std::vector<double>& speeds, const std::vector<double>& downtracks, double response_lag) const { // Note first speed is assumed to be vehicle speed
   if (speeds.size() != downtracks.size()) {
     throw std::invalid_argument("Speed list and downtrack list are not the same size.");
   }
@@ -34,7 +34,7 @@ int main(int argc, char** argv)
 
   pure_pursuit_wrapper::PurePursuitWrapper purePursuitWrapper(
       config, 
-      [&waypoints_pub](auto msg) { waypoints_pub.publish(msg); },
+      [&waypoints_pub](const auto& msg) { waypoints_pub.publish(msg); },
       [&discovery_pub](auto msg) { discovery_pub.publish(msg); });
 
   // Trajectory Plan Subscriber
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark of the trajectory plan handler latency with plans arriving at the control rate.
+ * Each plan is handled once by the TrajectoryView based handler and once by the copy based conversion it replaced.
+ *
+ * Run with: rosrun pure_pursuit_wrapper pure_pursuit_wrapper-handler-benchmark [point_count] [plan_rate_hz] [seconds]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <trajectory_utils/conversions/conversions.h>
+#include "pure_pursuit_wrapper/pure_pursuit_wrapper.hpp"
+
+namespace
+{
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+// The handler before TrajectoryView, which copies the points to remove duplicates and copies the finished waypoints into the lane
+void legacy_handler(pure_pursuit_wrapper::PurePursuitWrapper& ppw, const cav_msgs::TrajectoryPlan::ConstPtr& tp, double response_lag,
+                    const std::function<void(autoware_msgs::Lane)>& pub)
+{
+  std::vector<double> times;
+  std::vector<double> downtracks;
+
+  std::vector<cav_msgs::TrajectoryPlanPoint> trajectory_points = ppw.remove_repeated_timestamps(tp->trajectory_points);
+
+  trajectory_utils::conversions::trajectory_to_downtrack_time(trajectory_points, &downtracks, &times);
+
+  std::vector<double> speeds;
+  trajectory_utils::conversions::time_to_speed(downtracks, times, tp->initial_longitudinal_velocity, &speeds);
+
+  for (size_t i = 0; i < speeds.size(); i++)
+  {
+    speeds[i] = std::max(0.0, speeds[i]);
+  }
+
+  std::vector<double> lag_speeds = ppw.apply_response_lag(speeds, downtracks, response_lag);
+
+  autoware_msgs::Lane lane;
+  lane.header = tp->header;
+  std::vector<autoware_msgs::Waypoint> waypoints;
+  waypoints.reserve(trajectory_points.size());
+
+  for (size_t i = 0; i < trajectory_points.size(); i++)
+  {
+    autoware_msgs::Waypoint wp;
+    wp.pose.pose.position.x = trajectory_points[i].x;
+    wp.pose.pose.position.y = trajectory_points[i].y;
+    wp.twist.twist.linear.x = lag_speeds[i];
+    waypoints.push_back(wp);
+  }
+
+  lane.waypoints = waypoints;
+  pub(lane);
+}
+
+// A plan along a gentle curve as produced by the tactical plugins, starting at the vehicle position for the given cycle
+cav_msgs::TrajectoryPlan::ConstPtr make_plan(int point_count, int cycle, double period)
+{
+  const double speed = 15.0;
+  const double spacing = 1.0;
+  const double start = cycle * period * speed;
+
+  cav_msgs::TrajectoryPlan::Ptr plan(new cav_msgs::TrajectoryPlan());
+  plan->header.frame_id = "map";
+  plan->initial_longitudinal_velocity = speed;
+  plan->trajectory_points.reserve(point_count);
+
+  cav_msgs::TrajectoryPlanPoint point;
+  point.planner_plugin_name = "InLaneCruisingPlugin";
+  point.controller_plugin_name = "PurePursuit";
+  point.lane_id = "1200";
+  for (int i = 0; i < point_count; i++)
+  {
+    double s = start + i * spacing;
+    point.x = s;
+    point.y = 50.0 * std::sin(s / 500.0);
+    point.target_time = ros::Time(s / speed + 1.0);
+    plan->trajectory_points.push_back(point);
+  }
+  return plan;
+}
+
+struct LatencyStats
+{
+  std::vector<double> samples_us;
+
+  void print(const std::string& name, double budget_us)
+  {
+    std::sort(samples_us.begin(), samples_us.end());
+    double total = 0;
+    for (double s : samples_us)
+    {
+      total += s;
+    }
+    double mean = total / samples_us.size();
+    std::cout << name << ": mean " << mean << " us, p99 " << samples_us[samples_us.size() * 99 / 100] << " us, max "
+              << samples_us.back() << " us (" << 100.0 * mean / budget_us << "% of the control period)" << std::endl;
+  }
+};
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  const int point_count = argc > 1 ? std::stoi(argv[1]) : 200;
+  const int plan_rate_hz = argc > 2 ? std::stoi(argv[2]) : 30;
+  const int seconds = argc > 3 ? std::stoi(argv[3]) : 60;
+
+  const double period = 1.0 / plan_rate_hz;
+  const int cycles = plan_rate_hz * seconds;
+
+  pure_pursuit_wrapper::PurePursuitWrapperConfig config;
+  pure_pursuit_wrapper::PurePursuitWrapper ppw(
+      config, [](const autoware_msgs::Lane& lane) { g_sink += lane.waypoints.back().twist.twist.linear.x; },
+      [](const cav_msgs::Plugin&) {});
+  auto legacy_pub = [](autoware_msgs::Lane lane) { g_sink += lane.waypoints.back().twist.twist.linear.x; };
+
+  // Plans are built ahead of time so that only the handlers are timed
+  std::vector<cav_msgs::TrajectoryPlan::ConstPtr> plans;
+  plans.reserve(cycles);
+  for (int i = 0; i < cycles; i++)
+  {
+    plans.push_back(make_plan(point_count, i, period));
+  }
+
+  LatencyStats view_stats, legacy_stats;
+  view_stats.samples_us.reserve(cycles);
+  legacy_stats.samples_us.reserve(cycles);
+
+  for (const auto& plan : plans)
+  {
+    auto start = std::chrono::steady_clock::now();
+    legacy_handler(ppw, plan, config.vehicle_response_lag, legacy_pub);
+    legacy_stats.samples_us.push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+    start = std::chrono::steady_clock::now();
+    ppw.trajectoryPlanHandler(plan);
+    view_stats.samples_us.push_back(
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+  }
+
+  const double budget_us = 1e6 * period;
+  std::cout << cycles << " plans of " << point_count << " points at " << plan_rate_hz << " Hz" << std::endl;
+  legacy_stats.print("copying handler", budget_us);
+  view_stats.print("view handler   ", budget_us);
+
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include <boost/optional/optional.hpp>
+#include <trajectory_utils/conversions/conversions.h>
 
 TEST(pure_pursuit_wrapper, trajectoryPlanHandler)
 {
@@ -70,6 +71,63 @@ TEST(pure_pursuit_wrapper, trajectoryPlanHandler)
   ASSERT_NEAR(14.0, lane.waypoints[2].pose.pose.position.y, 0.0000001);
 }
 
+TEST(pure_pursuit_wrapper, trajectoryPlanHandlerRepeatedTimestampsAndLag)
+{
+  cav_msgs::TrajectoryPlan plan;
+  plan.initial_longitudinal_velocity = 5.0;
+
+  boost::optional<autoware_msgs::Lane> wp_msg;
+  boost::optional<cav_msgs::Plugin> plugin_msg;
+  pure_pursuit_wrapper::PurePursuitWrapperConfig config;
+  config.vehicle_response_lag = 0.5;  // 2.5 m lookahead at 5 m/s
+  pure_pursuit_wrapper::PurePursuitWrapper ppw(config, [&wp_msg](auto msg) { wp_msg = msg; },
+                                               [&plugin_msg](auto msg) { plugin_msg = msg; });
+
+  cav_msgs::TrajectoryPlanPoint tpp;
+  for (int i = 0; i < 10; i++)
+  {
+    tpp.x = i;
+    tpp.y = 0.2 * i;
+    tpp.target_time = ros::Time(i == 4 ? 0.3 : 0.1 * i);  // Point 4 repeats the timestamp of point 3
+    plan.trajectory_points.push_back(tpp);
+  }
+
+  // Expected lane computed from the trajectory with the duplicate removed using the trajectory_utils conversions
+  std::vector<cav_msgs::TrajectoryPlanPoint> trajectory_points = ppw.remove_repeated_timestamps(plan.trajectory_points);
+  ASSERT_EQ(9, trajectory_points.size());
+
+  std::vector<double> downtracks, times, speeds;
+  trajectory_utils::conversions::trajectory_to_downtrack_time(trajectory_points, &downtracks, &times);
+  trajectory_utils::conversions::time_to_speed(downtracks, times, plan.initial_longitudinal_velocity, &speeds);
+  for (auto& speed : speeds)
+  {
+    speed = std::max(0.0, speed);
+  }
+  std::vector<double> lag_speeds = ppw.apply_response_lag(speeds, downtracks, config.vehicle_response_lag);
+
+  cav_msgs::TrajectoryPlan::ConstPtr plan_ptr(new cav_msgs::TrajectoryPlan(plan));
+  ppw.trajectoryPlanHandler(plan_ptr);
+
+  ASSERT_TRUE(!!wp_msg);
+  ASSERT_EQ(trajectory_points.size(), wp_msg->waypoints.size());
+  for (size_t i = 0; i < trajectory_points.size(); i++)
+  {
+    ASSERT_NEAR(trajectory_points[i].x, wp_msg->waypoints[i].pose.pose.position.x, 0.0000001);
+    ASSERT_NEAR(trajectory_points[i].y, wp_msg->waypoints[i].pose.pose.position.y, 0.0000001);
+    ASSERT_NEAR(lag_speeds[i], wp_msg->waypoints[i].twist.twist.linear.x, 0.0000001);
+  }
+
+  // A shorter plan reuses the lane without leaving stale waypoints behind
+  plan.trajectory_points.resize(3);
+  plan_ptr.reset(new cav_msgs::TrajectoryPlan(plan));
+  ppw.trajectoryPlanHandler(plan_ptr);
+  ASSERT_EQ(3, wp_msg->waypoints.size());
+
+  plan.trajectory_points.clear();
+  plan_ptr.reset(new cav_msgs::TrajectoryPlan(plan));
+  ASSERT_THROW(ppw.trajectoryPlanHandler(plan_ptr), std::invalid_argument);
+}
+
 TEST(pure_pursuit_wrapper, onSpin)
 {
   cav_msgs::TrajectoryPlan plan;
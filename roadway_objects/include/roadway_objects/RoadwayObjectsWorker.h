@@ -43,7 +43,27 @@ public:
   */
   void externalObjectsCallback(const cav_msgs::ExternalObjectListConstPtr& msg);
 
+  /*!
+    \brief Returns the time from the sensor stamp of the most recently published obstacle list to its publication.
+    This is the end to end latency of the perception pipeline from object detection to roadway obstacles.
+  */
+  ros::Duration getLastLatency() const;
+
 private:
+  /*!
+    \brief Records the latency of an obstacle list published now for objects sensed at the provided stamp and
+    periodically logs a summary
+  */
+  void recordLatency(const ros::Time& sensor_stamp);
+
+  // Number of published lists summarized by each latency log
+  static constexpr size_t LATENCY_REPORT_PERIOD = 100;
+
+  ros::Duration last_latency_;
+  double latency_sum_ = 0.0;
+  double latency_max_ = 0.0;
+  size_t latency_count_ = 0;
+
   // local copy of external object publihsers
 
   PublishObstaclesCallback obj_pub_;
@@ -21,6 +21,7 @@
 #include <boost/geometry/geometries/polygon.hpp>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#include <algorithm>
 
 namespace objects
 {
@@ -45,7 +46,9 @@ void RoadwayObjectsWorker::externalObjectsCallback(const cav_msgs::ExternalObjec
     return;
   }
 
-  for (auto object : obj_array->objects)
+  obstacle_list.roadway_obstacles.reserve(obj_array->objects.size());
+
+  for (const auto& object : obj_array->objects)
   {
     lanelet::Optional<cav_msgs::RoadwayObstacle> obs = wm_->toRoadwayObstacle(object);
     if (!obs)
@@ -58,5 +61,50 @@ void RoadwayObjectsWorker::externalObjectsCallback(const cav_msgs::ExternalObjec
   }
 
   obj_pub_(obstacle_list);
+
+  // The list stamp is the sensor stamp. Lists without one use the oldest object stamp
+  ros::Time sensor_stamp = obj_array->header.stamp;
+  if (sensor_stamp.isZero())
+  {
+    for (const auto& object : obj_array->objects)
+    {
+      if (sensor_stamp.isZero() || (!object.header.stamp.isZero() && object.header.stamp < sensor_stamp))
+      {
+        sensor_stamp = object.header.stamp;
+      }
+    }
+  }
+
+  if (!sensor_stamp.isZero())
+  {
+    recordLatency(sensor_stamp);
+  }
+}
+
+void RoadwayObjectsWorker::recordLatency(const ros::Time& sensor_stamp)
+{
+  last_latency_ = ros::Time::now() - sensor_stamp;
+
+  double latency = last_latency_.toSec();
+  ROS_DEBUG_STREAM("roadway_objects published obstacles " << latency * 1000.0 << " ms after sensor stamp");
+
+  latency_sum_ += latency;
+  latency_max_ = std::max(latency_max_, latency);
+  latency_count_++;
+
+  if (latency_count_ == LATENCY_REPORT_PERIOD)
+  {
+    ROS_INFO_STREAM("Perception latency from sensor stamp to roadway obstacles over the last " << latency_count_
+                    << " lists: mean " << latency_sum_ / latency_count_ * 1000.0 << " ms, max " << latency_max_ * 1000.0
+                    << " ms");
+    latency_sum_ = 0.0;
+    latency_max_ = 0.0;
+    latency_count_ = 0;
+  }
+}
+
+ros::Duration RoadwayObjectsWorker::getLastLatency() const
+{
+  return last_latency_;
 }
 }  // namespace objects
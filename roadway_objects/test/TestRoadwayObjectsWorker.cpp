@@ -135,4 +135,55 @@ TEST(RoadwayObjectsWorkerTest, testExternalObjectCallback)
   ASSERT_NEAR(obs.predicted_down_track_confidences[0], 0.9, 0.00001);
 }
 
+TEST(RoadwayObjectsWorkerTest, testLatencyFromSensorStamp)
+{
+  std::shared_ptr<carma_wm::CARMAWorldModel> cmw = std::make_shared<carma_wm::CARMAWorldModel>();
+
+  auto p1 = carma_wm::getPoint(9, 0, 0);
+  auto p2 = carma_wm::getPoint(9, 9, 0);
+  auto p3 = carma_wm::getPoint(2, 0, 0);
+  auto p4 = carma_wm::getPoint(2, 9, 0);
+  lanelet::LineString3d right_ls_1(lanelet::utils::getId(), { p1, p2 });
+  lanelet::LineString3d left_ls_1(lanelet::utils::getId(), { p3, p4 });
+  auto ll_1 = carma_wm::getLanelet(left_ls_1, right_ls_1);
+  cmw->setMap(lanelet::utils::createMap({ ll_1 }, {}));
+
+  bool published = false;
+  RoadwayObjectsWorker row(std::static_pointer_cast<const carma_wm::WorldModel>(cmw),
+                           [&](const cav_msgs::RoadwayObstacleList& objs) -> void { published = true; });
+
+  ASSERT_EQ(row.getLastLatency(), ros::Duration(0));
+
+  cav_msgs::ExternalObject obj;
+  obj.id = 1;
+  obj.pose.pose.position.x = 6;
+  obj.pose.pose.position.y = 5;
+  obj.pose.pose.orientation.w = 1;
+  obj.size.x = 1;
+  obj.size.y = 1;
+
+  // The list stamp is used when available, even if an object has an older stamp
+  cav_msgs::ExternalObjectList obj_list;
+  obj_list.header.stamp = ros::Time::now() - ros::Duration(0.5);
+  obj.header.stamp = obj_list.header.stamp - ros::Duration(2.0);
+  obj_list.objects.push_back(obj);
+
+  row.externalObjectsCallback(cav_msgs::ExternalObjectListConstPtr(new cav_msgs::ExternalObjectList(obj_list)));
+
+  ASSERT_TRUE(published);
+  ASSERT_GE(row.getLastLatency().toSec(), 0.5);
+  ASSERT_LT(row.getLastLatency().toSec(), 2.0);
+
+  // Lists without a stamp use the oldest object stamp
+  obj_list.header.stamp = ros::Time(0);
+  obj_list.objects[0].header.stamp = ros::Time::now() - ros::Duration(2.0);
+  obj.header.stamp = ros::Time::now() - ros::Duration(1.0);
+  obj_list.objects.push_back(obj);
+
+  row.externalObjectsCallback(cav_msgs::ExternalObjectListConstPtr(new cav_msgs::ExternalObjectList(obj_list)));
+
+  ASSERT_GE(row.getLastLatency().toSec(), 2.0);
+  ASSERT_LT(row.getLastLatency().toSec(), 5.0);
+}
+
 }  // namespace objects
@@ -0,0 +1,95 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_routing/Route.h>
+
+namespace route {
+
+    using RouteConstPtr = std::shared_ptr<const lanelet::routing::Route>;
+
+    /**
+     * \brief The inputs which determine a computed route
+     */
+    struct RouteKey
+    {
+        lanelet::Id start_lanelet = lanelet::InvalId;
+        std::vector<lanelet::Id> via_lanelets;
+        lanelet::Id end_lanelet = lanelet::InvalId;
+        // The destination point. Kept as plain values so the key needs no aligned allocator
+        double end_x = 0.0;
+        double end_y = 0.0;
+        // WorldModel::getMapUpdateCount of the map and routing graph. Unlike the map version it changes with every geofence
+        size_t map_update_count = 0;
+
+        bool operator==(const RouteKey& other) const;
+    };
+
+    /**
+     * \brief Thread safe cache of computed routes.
+     *
+     * Routes are evicted least recently used first once the capacity is reached. Routes computed before a map update can
+     * never be requested again once a route computed after it is added, so they are dropped at that point.
+     */
+    class RouteCache
+    {
+
+    public:
+        /**
+         * \brief Constructor
+         * \param capacity The maximum number of routes kept
+         */
+        explicit RouteCache(size_t capacity = 16);
+
+        /**
+         * \brief Returns the route computed for the provided key
+         * \param key The route inputs
+         * \return The cached route. nullptr if there is no route cached for the key
+         */
+        RouteConstPtr find(const RouteKey& key);
+
+        /**
+         * \brief Adds a computed route to the cache
+         * \param key The route inputs
+         * \param route The route computed from the inputs
+         */
+        void insert(const RouteKey& key, RouteConstPtr route);
+
+        /**
+         * \brief Removes all cached routes
+         */
+        void clear();
+
+        /**
+         * \brief Returns the number of cached routes
+         */
+        size_t size() const;
+
+    private:
+        mutable std::mutex mutex_;
+        // Most recently used first
+        std::list<std::pair<RouteKey, RouteConstPtr>> entries_;
+        size_t capacity_;
+    };
+
+}
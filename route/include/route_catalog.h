@@ -0,0 +1,79 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <boost/cstdint.hpp>
+
+namespace route {
+
+    /**
+     * \brief Index of the route files in the route directory.
+     *
+     * Each route file is read once to find its destination name. On refresh the directory is listed again and only files
+     * which are new or whose modification time or size changed are read. Entries of removed files are dropped.
+     * Modification times have a resolution of one second, so a file rewritten with the same size within the second it
+     * was last read keeps its old entry until it is modified again.
+     */
+    class RouteCatalog
+    {
+
+    public:
+        struct Entry
+        {
+            // File name without the .csv extension
+            std::string route_id;
+            // Name of the final destination. Empty if the last line of the file has no name
+            std::string route_name;
+            std::time_t last_write_time = 0;
+            boost::uintmax_t file_size = 0;
+        };
+
+        /**
+         * \brief Sets the directory containing the route files and forgets all entries
+         * \param directory The route file directory
+         */
+        void setDirectory(const std::string& directory);
+
+        /**
+         * \brief Brings the entries up to date with the route directory
+         * \return False if the route directory does not exist, in which case there are no entries
+         */
+        bool refresh();
+
+        /**
+         * \brief Returns the entries for the route files found by the last refresh, keyed by route id
+         */
+        const std::map<std::string, Entry>& entries() const;
+
+        /**
+         * \brief Returns the number of route files read since the directory was set
+         */
+        size_t filesRead() const;
+
+    private:
+        // Reads the destination name from the last non empty line of a route file
+        std::string readRouteName(const std::string& file_path);
+
+        std::string directory_;
+        std::map<std::string, Entry> entries_;
+        size_t files_read_ = 0;
+    };
+
+}
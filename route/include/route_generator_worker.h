@@ -43,6 +43,7 @@
 #include <lanelet2_extension/projection/local_frame_projector.h>
 #include <lanelet2_extension/io/autoware_osm_parser.h>
 #include <functional>
+#include <future>
 #include <std_msgs/String.h>
 #include <tf2_ros/transform_listener.h>
 #include <tf2/LinearMath/Transform.h>
@@ -50,6 +51,9 @@
 
 
 #include "route_state_worker.h"
+#include "route_progress_tracker.h"
+#include "route_catalog.h"
+#include "route_cache.h"
 
 namespace route {
 
@@ -78,18 +82,23 @@ namespace route {
         void setWorldModelPtr(carma_wm::WorldModelConstPtr wm);
 
         /**
-         * \brief Generate Lanelet2 route based on input destinations
+         * \brief Generate Lanelet2 route based on input destinations. Routes are cached so a route which was already computed
+         * for the same lanelets since the last map update is returned without searching the routing graph again.
+         * This function is safe to call from a thread other than the spin thread.
          * \param start Lanelet 2D point in map frame indicates the starting point of selected route
          * \param via A vector of lanelet 2D points in map frame which contains points we want to visit along the route
-         * \param end Lanelet 2D point in map frame indicates the final destination of selected route
+         * \param end Lanelet 2D point in map frame indicates the final destination of selected route. It is used as the route end point
          * \param map_pointer A constant pointer to lanelet vector map
          * \param graph_pointer A constant pointer to lanelet vector map routing graph
+         * \param map_update_count The WorldModel::getMapUpdateCount of the provided map and routing graph
+         * \return The route. nullptr if no route could be found
          */
-        lanelet::Optional<lanelet::routing::Route> routing(const lanelet::BasicPoint2d start,
-                                                        const std::vector<lanelet::BasicPoint2d>& via,
-                                                        const lanelet::BasicPoint2d end,
-                                                        const lanelet::LaneletMapConstPtr map_pointer,
-                                                        const carma_wm::LaneletRoutingGraphConstPtr graph_pointer) const;
+        RouteConstPtr routing(const lanelet::BasicPoint2d start,
+                              const std::vector<lanelet::BasicPoint2d>& via,
+                              const lanelet::BasicPoint2d end,
+                              const lanelet::LaneletMapConstPtr map_pointer,
+                              const carma_wm::LaneletRoutingGraphConstPtr graph_pointer,
+                              size_t map_update_count);
 
         /**
          * \brief Get_available_route service callback. Call this service will response with a list of route names for user to select
@@ -176,6 +185,7 @@ namespace route {
          * \param route Route object from lanelet2 lib routing function
          */
         cav_msgs::Route compose_route_msg(const lanelet::Optional<lanelet::routing::Route>& route);
+        cav_msgs::Route compose_route_msg(const lanelet::routing::Route& route);
 
         /**
          * \brief Spin callback which will be called frequently based on spin rate
@@ -186,6 +196,7 @@ namespace route {
          * \param route Route object from lanelet2 lib routing function
          */
         visualization_msgs::Marker compose_route_marker_msg(const lanelet::Optional<lanelet::routing::Route>& route);
+        visualization_msgs::Marker compose_route_marker_msg(const lanelet::routing::Route& route);
 
         /**
         * \brief crosstrack_error_check is a function that determines when the vehicle has left the route and reports when a crosstrack error has
@@ -227,7 +238,15 @@ namespace route {
          * \param destination_points_in_map vector of destination points
          * \note Destination points will be removed if the current pose is past those points.
         */
-        lanelet::Optional<lanelet::routing::Route> reroute_after_route_invalidation(std::vector<lanelet::BasicPoint2d>& destination_points_in_map);
+        RouteConstPtr reroute_after_route_invalidation(std::vector<lanelet::BasicPoint2d>& destination_points_in_map);
+
+        /**
+         * \brief Starts computing a new route based on the destination points on a separate thread
+         * \param destination_points_in_map vector of destination points
+         * \note Destination points will be removed if the current pose is past those points.
+         * \return Future holding the new route. nullptr if no route could be found
+        */
+        std::future<RouteConstPtr> start_reroute(std::vector<lanelet::BasicPoint2d>& destination_points_in_map);
 
         /**
          * \brief Initialize transform lookup from front bumper to map
@@ -247,6 +266,12 @@ namespace route {
         // directory of route files
         std::string route_file_path_;
 
+        // index of the route files in the route directory
+        RouteCatalog route_catalog_;
+
+        // routes computed by the routing function
+        RouteCache route_cache_;
+
         // const pointer to world model object
         carma_wm::WorldModelConstPtr world_model_;
 
@@ -257,8 +282,8 @@ namespace route {
         visualization_msgs::Marker route_marker_msg_;
         std::vector<lanelet::ConstPoint3d> points_; 
         
-        //List of lanelets in the route
-        lanelet::ConstLanelets route_llts;
+        // Lanelets in the route and the route lanelet the vehicle was last matched to
+        RouteProgressTracker route_tracker_;
 
         // maximum cross track error which can trigger left route event
         double cross_track_max_;
@@ -295,6 +320,12 @@ namespace route {
         // private helper function to add a new route event into event queue
         void publish_route_event(uint8_t event_type);        
 
+        // replaces the lanelets tracked for route progress with the lanelets of the provided route
+        void set_route_lanelets(const std::vector<lanelet::Id>& lanelet_ids);
+
+        // crosstrack error check against an already computed lanelet polygon
+        bool crosstrack_error_check(const lanelet::BasicPoint2d& position, const lanelet::BasicPolygon2d& current_polygon);
+
         double cross_track_dist;
 
         // counter to record how many times vehicle's position exceeds crosstrack distance
@@ -318,6 +349,12 @@ namespace route {
         tf2_ros::Buffer tf2_buffer_;
         std::unique_ptr<tf2_ros::TransformListener> tf2_listener_;
 
+        // map version used for the pending reroute
+        size_t reroute_map_version_ = 0;
+
+        // pending reroute. Declared last so it is waited for before the members it uses are destroyed
+        std::future<RouteConstPtr> reroute_future_;
+
     };
 
 }
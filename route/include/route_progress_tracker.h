@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <vector>
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/primitives/Polygon.h>
+
+namespace route {
+
+    /**
+     * \brief Tracks which lanelet of the route the vehicle is on as it drives along the route.
+     *
+     * The route lanelets are kept in route order with their 2d polygon and bounding box computed once when the route is set.
+     * An update only measures the distance to the lanelets in a small window around the previous match. The window is moved
+     * forward while lanelets further down the route are closer, so the vehicle may pass several short lanelets between updates.
+     * This keeps the cost of an update independent of the route length. The whole route is searched only when there is no
+     * previous match or when no lanelet near the previous match is within the reacquire distance, for example after a reroute.
+     */
+    class RouteProgressTracker
+    {
+
+    public:
+        /**
+         * \brief Constructor
+         * \param lanelets_behind Number of route lanelets before the previous match which are searched on each update
+         * \param lanelets_ahead Number of route lanelets after the previous match which are searched on each update
+         * \param reacquire_distance Distance in m from the closest lanelet of the window beyond which the whole route is searched
+         */
+        explicit RouteProgressTracker(size_t lanelets_behind = 1, size_t lanelets_ahead = 3, double reacquire_distance = 5.0);
+
+        /**
+         * \brief Replaces the tracked route and forgets the previous match
+         * \param route_lanelets The lanelets of the route in route order
+         */
+        void setRoute(const lanelet::ConstLanelets& route_lanelets);
+
+        /**
+         * \brief Appends a lanelet to the end of the tracked route
+         * \param llt The lanelet to append
+         */
+        void addLanelet(const lanelet::ConstLanelet& llt);
+
+        /**
+         * \brief Removes all route lanelets
+         */
+        void clear();
+
+        /**
+         * \brief Finds the route lanelet closest to the provided position, searching near the previous match first
+         * \param position The current position of the vehicle
+         * \return The closest route lanelet. A default constructed lanelet if the route is empty
+         */
+        lanelet::ConstLanelet update(const lanelet::BasicPoint2d& position);
+
+        /**
+         * \brief Returns the cached 2d polygon of the lanelet matched by the last update
+         * \throw std::invalid_argument if there has been no successful update since the route was set
+         */
+        const lanelet::BasicPolygon2d& currentPolygon() const;
+
+        /**
+         * \brief Returns the route index of the lanelet matched by the last update
+         * \throw std::invalid_argument if there has been no successful update since the route was set
+         */
+        size_t currentIndex() const;
+
+        /**
+         * \brief Returns the number of route lanelets
+         */
+        size_t size() const;
+
+        /**
+         * \brief Returns true if there are no route lanelets
+         */
+        bool empty() const;
+
+    private:
+
+        struct RouteLanelet
+        {
+            lanelet::ConstLanelet llt;
+            lanelet::BasicPolygon2d polygon;
+            // Axis aligned bounds of the polygon. Kept as plain values so the vector needs no aligned allocator
+            double min_x, min_y, max_x, max_y;
+        };
+
+        // Distance from the position to the polygon of the route lanelet at index. Zero if the position is inside it
+        double distance(size_t index, const lanelet::BasicPoint2d& position) const;
+
+        // Searches indices [begin, end) and returns the index of the closest lanelet. Sets min_distance to its distance
+        size_t search(size_t begin, size_t end, const lanelet::BasicPoint2d& position, double& min_distance) const;
+
+        std::vector<RouteLanelet> route_lanelets_;
+        size_t lanelets_behind_;
+        size_t lanelets_ahead_;
+        double reacquire_distance_;
+
+        bool has_match_ = false;
+        size_t current_index_ = 0;
+    };
+
+}
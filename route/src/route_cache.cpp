@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "route_cache.h"
+
+namespace route {
+
+    bool RouteKey::operator==(const RouteKey& other) const
+    {
+        return start_lanelet == other.start_lanelet && via_lanelets == other.via_lanelets && end_lanelet == other.end_lanelet
+            && end_x == other.end_x && end_y == other.end_y && map_update_count == other.map_update_count;
+    }
+
+    RouteCache::RouteCache(size_t capacity) : capacity_(capacity)
+    {}
+
+    RouteConstPtr RouteCache::find(const RouteKey& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end(); ++it)
+        {
+            if (it->first == key)
+            {
+                entries_.splice(entries_.begin(), entries_, it);
+                return entries_.front().second;
+            }
+        }
+        return nullptr;
+    }
+
+    void RouteCache::insert(const RouteKey& key, RouteConstPtr route)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.remove_if([&key](const std::pair<RouteKey, RouteConstPtr>& entry) {
+            return entry.first.map_update_count < key.map_update_count || entry.first == key;
+        });
+
+        if (capacity_ == 0)
+        {
+            return;
+        }
+        entries_.emplace_front(key, std::move(route));
+        while (entries_.size() > capacity_)
+        {
+            entries_.pop_back();
+        }
+    }
+
+    void RouteCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+
+    size_t RouteCache::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+}
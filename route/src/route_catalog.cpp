@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "route_catalog.h"
+#include <cctype>
+#include <fstream>
+#include <set>
+#include <boost/filesystem.hpp>
+#include <ros/ros.h>
+
+namespace route {
+
+    void RouteCatalog::setDirectory(const std::string& directory)
+    {
+        directory_ = directory;
+        entries_.clear();
+        files_read_ = 0;
+    }
+
+    bool RouteCatalog::refresh()
+    {
+        boost::filesystem::path route_path_object(directory_);
+        if(!boost::filesystem::exists(route_path_object))
+        {
+            entries_.clear();
+            return false;
+        }
+
+        std::set<std::string> found_ids;
+        boost::filesystem::directory_iterator end_point;
+        for(boost::filesystem::directory_iterator itr(route_path_object); itr != end_point; ++itr)
+        {
+            if(boost::filesystem::is_directory(itr->status()))
+            {
+                continue;
+            }
+
+            // assume route files ending with ".csv", before that is the actual route name
+            auto full_file_name = itr->path().filename().generic_string();
+            if(full_file_name.find(".csv") == full_file_name.npos)
+            {
+                continue;
+            }
+            std::string route_id = full_file_name.substr(0, full_file_name.find(".csv"));
+            found_ids.insert(route_id);
+
+            boost::system::error_code ec;
+            std::time_t last_write_time = boost::filesystem::last_write_time(itr->path(), ec);
+            boost::uintmax_t file_size = boost::filesystem::file_size(itr->path(), ec);
+
+            auto entry = entries_.find(route_id);
+            if(entry != entries_.end() && !ec && entry->second.last_write_time == last_write_time && entry->second.file_size == file_size)
+            {
+                continue; // unchanged since it was last read
+            }
+
+            Entry new_entry;
+            new_entry.route_id = route_id;
+            new_entry.route_name = readRouteName(itr->path().generic_string());
+            new_entry.last_write_time = last_write_time;
+            new_entry.file_size = file_size;
+            entries_[route_id] = new_entry;
+        }
+
+        // drop the entries of removed files
+        for(auto it = entries_.begin(); it != entries_.end();)
+        {
+            if(found_ids.find(it->first) == found_ids.end())
+            {
+                it = entries_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return true;
+    }
+
+    const std::map<std::string, RouteCatalog::Entry>& RouteCatalog::entries() const
+    {
+        return entries_;
+    }
+
+    size_t RouteCatalog::filesRead() const
+    {
+        return files_read_;
+    }
+
+    std::string RouteCatalog::readRouteName(const std::string& file_path)
+    {
+        files_read_++;
+
+        std::ifstream fin(file_path);
+        if(!fin.is_open())
+        {
+            ROS_ERROR_STREAM("File open failed...");
+            return "";
+        }
+
+        std::string dest_name;
+        std::string temp;
+        while(std::getline(fin, temp))
+        {
+            if(temp != "") dest_name = temp;
+        }
+
+        auto last_comma = dest_name.find_last_of(',');
+        std::string name = last_comma == dest_name.npos ? dest_name : dest_name.substr(last_comma + 1);
+        if(name.empty() || std::isdigit(static_cast<unsigned char>(name.at(0))))
+        {
+            return "";
+        }
+        return name;
+    }
+
+}
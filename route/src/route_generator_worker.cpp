@@ -17,6 +17,7 @@
 #include <math.h>
 #include "route_generator_worker.h"
 #include <functional>
+#include <chrono>
 #include <lanelet2_core/utility/Utilities.h>
 
 namespace route {
@@ -26,11 +27,12 @@ namespace route {
         this->world_model_ = wm;
     }
 
-    lanelet::Optional<lanelet::routing::Route> RouteGeneratorWorker::routing(const lanelet::BasicPoint2d start,
-                                                                             const std::vector<lanelet::BasicPoint2d>& via,
-                                                                             const lanelet::BasicPoint2d end,
-                                                                             const lanelet::LaneletMapConstPtr map_pointer,
-                                                                             const carma_wm::LaneletRoutingGraphConstPtr graph_pointer) const
+    RouteConstPtr RouteGeneratorWorker::routing(const lanelet::BasicPoint2d start,
+                                                const std::vector<lanelet::BasicPoint2d>& via,
+                                                const lanelet::BasicPoint2d end,
+                                                const lanelet::LaneletMapConstPtr map_pointer,
+                                                const carma_wm::LaneletRoutingGraphConstPtr graph_pointer,
+                                                size_t map_update_count)
     {
         // find start lanelet
         auto start_lanelet_vector = lanelet::geometry::findNearest(map_pointer->laneletLayer, start, 1);
@@ -38,7 +40,7 @@ namespace route {
         if(start_lanelet_vector.empty())
         {
             ROS_ERROR_STREAM("Found no lanelets in the map. Routing cannot be done.");
-            return lanelet::Optional<lanelet::routing::Route>();
+            return nullptr;
         }
         // extract starting lanelet
         auto start_lanelet = lanelet::ConstLanelet(start_lanelet_vector[0].second.constData());
@@ -53,8 +55,39 @@ namespace route {
             auto via_lanelet_vector = lanelet::geometry::findNearest(map_pointer->laneletLayer, point, 1);
             via_lanelets_vector.push_back(lanelet::ConstLanelet(via_lanelet_vector[0].second.constData()));
         }
+        // reuse the route if it was already computed for these lanelets since the map was last updated
+        RouteKey key;
+        key.start_lanelet = start_lanelet.id();
+        for(const auto& llt : via_lanelets_vector)
+        {
+            key.via_lanelets.push_back(llt.id());
+        }
+        key.end_lanelet = end_lanelet.id();
+        key.end_x = end.x();
+        key.end_y = end.y();
+        key.map_update_count = map_update_count;
+
+        RouteConstPtr cached_route = route_cache_.find(key);
+        if(cached_route)
+        {
+            ROS_DEBUG_STREAM("Using cached route from lanelet " << key.start_lanelet << " to lanelet " << key.end_lanelet);
+            return cached_route;
+        }
+
         // routing
-        return graph_pointer->getRouteVia(start_lanelet, via_lanelets_vector, end_lanelet);
+        auto route = graph_pointer->getRouteVia(start_lanelet, via_lanelets_vector, end_lanelet);
+        if(!route)
+        {
+            return nullptr;
+        }
+
+        // Specify the end point of the route that is inside the last lanelet
+        auto computed_route = std::make_shared<lanelet::routing::Route>(std::move(route.get()));
+        lanelet::Point3d end_point{lanelet::utils::getId(), end.x(), end.y(), 0};
+        computed_route->setEndPoint(end_point);
+
+        route_cache_.insert(key, computed_route);
+        return computed_route;
     }
 
     void RouteGeneratorWorker::setReroutingChecker(std::function<bool()> inputFunction)
@@ -64,46 +97,17 @@ namespace route {
 
     bool RouteGeneratorWorker::get_available_route_cb(cav_srvs::GetAvailableRoutesRequest& req, cav_srvs::GetAvailableRoutesResponse& resp)
     {
-        boost::filesystem::path route_path_object(this->route_file_path_);
-        if(boost::filesystem::exists(route_path_object))
+        // only route files which were added or changed since the last call are read
+        if(route_catalog_.refresh())
         {   
-            boost::filesystem::directory_iterator end_point;
-            // read all route files in the given directory
-            for(boost::filesystem::directory_iterator itr(route_path_object); itr != end_point; ++itr)
+            for(const auto& entry : route_catalog_.entries())
             {
-                if(!boost::filesystem::is_directory(itr->status()))
+                if(!entry.second.route_name.empty())
                 {
-                    auto full_file_name = itr->path().filename().generic_string();
                     cav_msgs::Route route_msg;
-
-                    //Include logic that sorts out invalid route files based on their ending*/
-                    if(full_file_name.find(".csv") != full_file_name.npos)
-                     { 
-                       // assume route files ending with ".csv", before that is the actual route name
-                        route_msg.route_id = full_file_name.substr(0, full_file_name.find(".csv"));
-                        std::ifstream fin(itr->path().generic_string());
-                        std::string dest_name;
-                        if(fin.is_open())
-                        {
-                            while (!fin.eof())
-                            {
-                                std::string temp;
-                                std::getline(fin, temp);
-                                if(temp != "") dest_name = temp;
-                            }
-                            fin.close();
-                        } 
-                        else
-                        {
-                           ROS_ERROR_STREAM("File open failed...");
-                        }
-                        auto last_comma = dest_name.find_last_of(',');
-                        if(!std::isdigit(dest_name.substr(last_comma + 1).at(0)))
-                        {
-                            route_msg.route_name = dest_name.substr(last_comma + 1);
-                            resp.availableRoutes.push_back(route_msg);
-                        }
-                     }
+                    route_msg.route_id = entry.second.route_id;
+                    route_msg.route_name = entry.second.route_name;
+                    resp.availableRoutes.push_back(route_msg);
                 }
             }
             
@@ -120,6 +124,7 @@ namespace route {
     void RouteGeneratorWorker::set_route_file_path(const std::string& path)
     {
         this->route_file_path_ = path;
+        route_catalog_.setDirectory(path);
         // after route path is set, worker will able to transit state and provide route selection service
         this->rs_worker_.on_route_event(RouteStateWorker::RouteEvent::ROUTE_LOADED);
         publish_route_event(cav_msgs::RouteEvent::ROUTE_LOADED);
@@ -224,7 +229,7 @@ namespace route {
             auto route = routing(destination_points_in_map_with_vehicle.front(),
                                 std::vector<lanelet::BasicPoint2d>(destination_points_in_map_with_vehicle.begin() + 1, destination_points_in_map_with_vehicle.end() - 1),
                                 destination_points_in_map_with_vehicle.back(),
-                                world_model_->getMap(), world_model_->getMapRoutingGraph());
+                                world_model_->getMap(), world_model_->getMapRoutingGraph(), world_model_->getMapUpdateCount());
             // check if route succeeded
             if(!route)
             {
@@ -235,7 +240,7 @@ namespace route {
                 return true;
             }
 
-            if (check_for_duplicate_lanelets_in_shortest_path(route.get()))
+            if (check_for_duplicate_lanelets_in_shortest_path(*route))
             {
                 ROS_ERROR_STREAM("At least one duplicate Lanelet ID occurs in the shortest path. Routing cannot be completed.");
                 resp.errorStatus = cav_srvs::SetActiveRouteResponse::ROUTING_FAILURE;
@@ -244,23 +249,13 @@ namespace route {
                 return true;
             }
 
-            // Specify the end point of the route that is inside the last lanelet
-            lanelet::Point3d end_point{lanelet::utils::getId(), destination_points_in_map_with_vehicle.back().x(), destination_points_in_map_with_vehicle.back().y(), 0};
-
-            route->setEndPoint(end_point);
-
             // update route message
-            route_msg_ = compose_route_msg(route);
+            route_msg_ = compose_route_msg(*route);
 
-            for(auto id : route_msg_.route_path_lanelet_ids)
-            {
-                auto ll = world_model_->getMap()->laneletLayer.get(id);
-                route_llts.push_back(ll);
-
-            }
+            set_route_lanelets(route_msg_.route_path_lanelet_ids);
 
             route_msg_.route_name = req.routeID;
-            route_marker_msg_ = compose_route_marker_msg(route);
+            route_marker_msg_ = compose_route_marker_msg(*route);
             route_msg_.header.stamp = ros::Time::now();
             route_msg_.header.frame_id = "map";
             route_msg_.map_version = world_model_->getMapVersion();
@@ -368,16 +363,21 @@ namespace route {
     }
 
     visualization_msgs::Marker RouteGeneratorWorker::compose_route_marker_msg(const lanelet::Optional<lanelet::routing::Route>& route)
+    {
+        return compose_route_marker_msg(route.get());
+    }
+
+    visualization_msgs::Marker RouteGeneratorWorker::compose_route_marker_msg(const lanelet::routing::Route& route)
     {
         std::vector<lanelet::ConstPoint3d> points;
-        auto end_point_3d = route.get().getEndPoint();
-        auto last_ll = route.get().shortestPath().back();
+        auto end_point_3d = route.getEndPoint();
+        auto last_ll = route.shortestPath().back();
         double end_point_downtrack = carma_wm::geometry::trackPos(last_ll, {end_point_3d.x(), end_point_3d.y()}).downtrack;
         double lanelet_downtrack = carma_wm::geometry::trackPos(last_ll, last_ll.centerline().back().basicPoint2d()).downtrack;
         // get number of points to display using ratio of the downtracks
         int points_until_end_point = (int) last_ll.centerline().size() * (end_point_downtrack / lanelet_downtrack);
   
-        for(const auto& ll : route.get().shortestPath())
+        for(const auto& ll : route.shortestPath())
         {
             if (ll.id() == last_ll.id())
             {
@@ -434,21 +434,26 @@ namespace route {
     }
 
     cav_msgs::Route RouteGeneratorWorker::compose_route_msg(const lanelet::Optional<lanelet::routing::Route>& route)
+    {
+        return compose_route_msg(route.get());
+    }
+
+    cav_msgs::Route RouteGeneratorWorker::compose_route_msg(const lanelet::routing::Route& route)
     {
         cav_msgs::Route msg;
         // iterate through the shortest path to populate shortest_path_lanelet_ids
-        for(const auto& ll : route.get().shortestPath())
+        for(const auto& ll : route.shortestPath())
         {
             msg.shortest_path_lanelet_ids.push_back(ll.id());
         }
         // iterate through all lanelet in the route to populate route_path_lanelet_ids
-        for(const auto& ll : route.get().laneletSubmap()->laneletLayer)
+        for(const auto& ll : route.laneletSubmap()->laneletLayer)
         {
             msg.route_path_lanelet_ids.push_back(ll.id());
         }
-        msg.end_point.x  = route->getEndPoint().x();
-        msg.end_point.y  = route->getEndPoint().y();
-        msg.end_point.z  = route->getEndPoint().z();
+        msg.end_point.x  = route.getEndPoint().x();
+        msg.end_point.y  = route.getEndPoint().y();
+        msg.end_point.z  = route.getEndPoint().z();
 
         return msg;
     }
@@ -492,8 +497,12 @@ namespace route {
         updated_vehicle_pose.pose.position.y = frontbumper_transform_.getOrigin().getY();
         updated_vehicle_pose.pose.position.z = frontbumper_transform_.getOrigin().getZ();
         vehicle_pose_ = updated_vehicle_pose; 
-            
-        if(this->rs_worker_.get_route_state() == RouteStateWorker::RouteState::FOLLOWING) {
+
+        // While a reroute is computed the previous route is still the one in use, so keep tracking progress along it
+        bool following = this->rs_worker_.get_route_state() == RouteStateWorker::RouteState::FOLLOWING;
+        bool rerouting = this->rs_worker_.get_route_state() == RouteStateWorker::RouteState::ROUTING && reroute_future_.valid();
+
+        if(following || rerouting) {
             // convert from pose stamp into lanelet basic 2D point
             current_loc_ = lanelet::BasicPoint2d(vehicle_pose_->pose.position.x, vehicle_pose_->pose.position.y);
             // get dt ct from world model
@@ -511,17 +520,22 @@ namespace route {
                 return;
             }
 
-            auto current_lanelet = get_closest_lanelet_from_route_llts(current_loc_);
+            auto current_lanelet = route_tracker_.update(current_loc_);
             auto lanelet_track = carma_wm::geometry::trackPos(current_lanelet, current_loc_);
             ll_id_ = current_lanelet.id();
             ll_crosstrack_distance_ = lanelet_track.crosstrack;
             ll_downtrack_distance_ = lanelet_track.downtrack;
             current_crosstrack_distance_ = track.crosstrack;
             current_downtrack_distance_ = track.downtrack;
-            // Determine speed limit
+            // Determine speed limit. The route speed limits are cached by the world model so this is a lookup for route lanelets
+            lanelet::Optional<double> route_speed_limit = world_model_->getRouteSpeedLimitProfile().speedLimit(ll_id_);
             lanelet::Optional<carma_wm::TrafficRulesConstPtr> traffic_rules = world_model_->getTrafficRules();
             
-            if (traffic_rules) 
+            if (route_speed_limit)
+            {
+                speed_limit_ = *route_speed_limit;
+            }
+            else if (traffic_rules) 
             {
                 auto laneletIterator = world_model_->getMap()->laneletLayer.find(ll_id_);
                 if (laneletIterator != world_model_->getMap()->laneletLayer.end()) {
@@ -539,9 +553,14 @@ namespace route {
             {
                 ROS_ERROR_STREAM("Failed to set the current speed limit. Valid traffic rules object could not be built.");
             }
-            geometry_msgs::PoseStampedPtr pose_ptr(new geometry_msgs::PoseStamped(*vehicle_pose_));
+            // departure and arrival are only evaluated against the route being followed, not one being replaced
+            if (!following)
+            {
+                return;
+            }
+
             // check if we left the seleted route by cross track error
-            bool departed = crosstrack_error_check(pose_ptr, current_lanelet);
+            bool departed = crosstrack_error_check(current_loc_, route_tracker_.currentPolygon());
             if (departed)
                 {
                     this->rs_worker_.on_route_event(RouteStateWorker::RouteEvent::ROUTE_DEPARTED);
@@ -587,7 +606,12 @@ namespace route {
         route_event_queue.push(event_type);
     }
     
-    lanelet::Optional<lanelet::routing::Route> RouteGeneratorWorker::reroute_after_route_invalidation(std::vector<lanelet::BasicPoint2d>& destination_points_in_map)
+    RouteConstPtr RouteGeneratorWorker::reroute_after_route_invalidation(std::vector<lanelet::BasicPoint2d>& destination_points_in_map)
+    {
+        return start_reroute(destination_points_in_map).get();
+    }
+
+    std::future<RouteConstPtr> RouteGeneratorWorker::start_reroute(std::vector<lanelet::BasicPoint2d>& destination_points_in_map)
     {
         std::vector<lanelet::BasicPoint2d> destination_points_in_map_temp;
         
@@ -607,12 +631,26 @@ namespace route {
         
         ROS_DEBUG_STREAM("New destination_points_in_map.size:" << destination_points_in_map_.size());
 
-        auto route=routing(current_loc_, // Route from current location through future destinations
-                            std::vector<lanelet::BasicPoint2d>(destination_points_in_map_.begin(), destination_points_in_map_.end() - 1),
-                            destination_points_in_map_.back(),
-                            world_model_->getMap(), world_model_->getMapRoutingGraph());
+        if(destination_points_in_map_.empty())
+        {
+            std::promise<RouteConstPtr> no_route;
+            no_route.set_value(nullptr);
+            return no_route.get_future();
+        }
 
-        return route;
+        // Route from current location through future destinations. The map is not updated while a reroute is pending so the
+        // search can run on a snapshot of the map and routing graph without holding up the spin callback
+        lanelet::BasicPoint2d start = current_loc_;
+        std::vector<lanelet::BasicPoint2d> via(destination_points_in_map_.begin(), destination_points_in_map_.end() - 1);
+        lanelet::BasicPoint2d end = destination_points_in_map_.back();
+        lanelet::LaneletMapConstPtr map = world_model_->getMap();
+        carma_wm::LaneletRoutingGraphConstPtr graph = world_model_->getMapRoutingGraph();
+        reroute_map_version_ = world_model_->getMapVersion();
+        size_t map_update_count = world_model_->getMapUpdateCount();
+
+        return std::async(std::launch::async, [this, start, via, end, map, graph, map_update_count]() {
+            return routing(start, via, end, map, graph, map_update_count);
+        });
     }
 
     bool RouteGeneratorWorker::spin_callback()
@@ -620,11 +658,18 @@ namespace route {
         // Update vehicle position
         bumper_pose_cb();
 
-        if(reroutingChecker()==true)
+        if(!reroute_future_.valid() && reroutingChecker()==true)
         {
            this->rs_worker_.on_route_event(RouteStateWorker::RouteEvent::ROUTE_INVALIDATION);
            publish_route_event(cav_msgs::RouteEvent::ROUTE_INVALIDATION);
-           auto route = reroute_after_route_invalidation(destination_points_in_map_);
+           reroute_future_ = start_reroute(destination_points_in_map_);
+        }
+
+        // the previous route stays in place until the new route is ready, then the route, marker and tracked lanelets are
+        // all replaced in the same spin
+        if(reroute_future_.valid() && reroute_future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+           auto route = reroute_future_.get();
 
            // check if route successed
            if(!route)
@@ -634,7 +679,7 @@ namespace route {
                 publish_route_event(cav_msgs::RouteEvent::ROUTE_GEN_FAILED);
                 return true;
             }
-            else if(check_for_duplicate_lanelets_in_shortest_path(route.get()))
+            else if(check_for_duplicate_lanelets_in_shortest_path(*route))
             {
                 ROS_ERROR_STREAM("At least one duplicate Lanelet ID occurs in the shortest path. Routing cannot be completed.");
                 this->rs_worker_.on_route_event(RouteStateWorker::RouteEvent::ROUTE_GEN_FAILED);
@@ -647,11 +692,12 @@ namespace route {
                 publish_route_event(cav_msgs::RouteEvent::ROUTE_STARTED);  
             }    
             std::string original_route_name = route_msg_.route_name;
-            route_msg_=compose_route_msg(route);
+            route_msg_=compose_route_msg(*route);
             route_msg_.route_name = original_route_name;
             route_msg_.is_rerouted = true;
-            route_msg_.map_version = world_model_->getMapVersion();
-            route_marker_msg_=compose_route_marker_msg(route);
+            route_msg_.map_version = reroute_map_version_;
+            set_route_lanelets(route_msg_.route_path_lanelet_ids);
+            route_marker_msg_=compose_route_marker_msg(*route);
             new_route_msg_generated_=true;
             new_route_marker_generated_=true;
         }
@@ -696,17 +742,19 @@ namespace route {
         position.x()= msg->pose.position.x;
         position.y()= msg->pose.position.y;
 
-        if(boost::geometry::within(position, current.polygon2d())) //If vehicle is inside current_lanelet, there is no crosstrack error
-        {
-            cte_count_ = 0;
-            return false;
-        }
+        return crosstrack_error_check(position, current.polygon2d().basicPolygon());
+    }
 
-        ROS_DEBUG_STREAM("LLt Polygon Dimensions1: " << current.polygon2d().front().x()<< ", "<< current.polygon2d().front().y());
-        ROS_DEBUG_STREAM("LLt Polygon Dimensions2: " << current.polygon2d().back().x()<< ", "<< current.polygon2d().back().y());
-        ROS_DEBUG_STREAM("Distance1: "<< boost::geometry::distance(position, current.polygon2d())<<" Crosstrack: "<< cross_track_dist );
+    bool RouteGeneratorWorker::crosstrack_error_check(const lanelet::BasicPoint2d& position, const lanelet::BasicPolygon2d& current_polygon)
+    {
+        // The distance to a polygon is zero when the point is inside it, in which case there is no crosstrack error
+        double distance = boost::geometry::distance(position, current_polygon);
+
+        ROS_DEBUG_STREAM("LLt Polygon Dimensions1: " << current_polygon.front().x()<< ", "<< current_polygon.front().y());
+        ROS_DEBUG_STREAM("LLt Polygon Dimensions2: " << current_polygon.back().x()<< ", "<< current_polygon.back().y());
+        ROS_DEBUG_STREAM("Distance1: "<< distance <<" Crosstrack: "<< cross_track_dist );
     
-        if (boost::geometry::distance(position, current.polygon2d()) > cross_track_dist) //Evaluate lanelet crosstrack distance from vehicle
+        if (distance > cross_track_dist) //Evaluate lanelet crosstrack distance from vehicle
             {
                 cte_count_++;
 
@@ -730,18 +778,18 @@ namespace route {
 
     lanelet::ConstLanelet RouteGeneratorWorker::get_closest_lanelet_from_route_llts(lanelet::BasicPoint2d position)
     {
-       double min = std::numeric_limits<double>::infinity();
-        lanelet::ConstLanelet min_llt;
-        for (auto i: route_llts)
-         {
-            double dist = boost::geometry::distance(position, i.polygon2d());
-            if (dist < min)
-            {
-                min = dist;
-                min_llt = i;
-            }
-     }
-    return min_llt;
+        return route_tracker_.update(position);
+    }
+
+    void RouteGeneratorWorker::set_route_lanelets(const std::vector<lanelet::Id>& lanelet_ids)
+    {
+        lanelet::ConstLanelets route_lanelets;
+        route_lanelets.reserve(lanelet_ids.size());
+        for(auto id : lanelet_ids)
+        {
+            route_lanelets.push_back(world_model_->getMap()->laneletLayer.get(id));
+        }
+        route_tracker_.setRoute(route_lanelets);
     }
 
     void RouteGeneratorWorker::set_CTE_dist(double cte_dist)
@@ -757,7 +805,7 @@ namespace route {
 
     void RouteGeneratorWorker::addllt(lanelet::ConstLanelet llt)
     {
-        route_llts.push_back(llt);
+        route_tracker_.addLanelet(llt);
     }
 
 
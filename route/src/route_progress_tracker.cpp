@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "route_progress_tracker.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <lanelet2_core/geometry/Polygon.h>
+
+namespace route {
+
+    RouteProgressTracker::RouteProgressTracker(size_t lanelets_behind, size_t lanelets_ahead, double reacquire_distance)
+        : lanelets_behind_(lanelets_behind), lanelets_ahead_(lanelets_ahead), reacquire_distance_(reacquire_distance)
+    {}
+
+    void RouteProgressTracker::setRoute(const lanelet::ConstLanelets& route_lanelets)
+    {
+        clear();
+        route_lanelets_.reserve(route_lanelets.size());
+        for (const auto& llt : route_lanelets)
+        {
+            addLanelet(llt);
+        }
+    }
+
+    void RouteProgressTracker::addLanelet(const lanelet::ConstLanelet& llt)
+    {
+        RouteLanelet entry;
+        entry.llt = llt;
+        entry.polygon = llt.polygon2d().basicPolygon();
+        entry.min_x = entry.min_y = std::numeric_limits<double>::infinity();
+        entry.max_x = entry.max_y = -std::numeric_limits<double>::infinity();
+        for (const auto& point : entry.polygon)
+        {
+            entry.min_x = std::min(entry.min_x, point.x());
+            entry.min_y = std::min(entry.min_y, point.y());
+            entry.max_x = std::max(entry.max_x, point.x());
+            entry.max_y = std::max(entry.max_y, point.y());
+        }
+        route_lanelets_.push_back(std::move(entry));
+    }
+
+    void RouteProgressTracker::clear()
+    {
+        route_lanelets_.clear();
+        has_match_ = false;
+        current_index_ = 0;
+    }
+
+    lanelet::ConstLanelet RouteProgressTracker::update(const lanelet::BasicPoint2d& position)
+    {
+        if (route_lanelets_.empty())
+        {
+            has_match_ = false;
+            return lanelet::ConstLanelet();
+        }
+
+        double min_distance = std::numeric_limits<double>::infinity();
+        size_t best = 0;
+
+        if (has_match_)
+        {
+            size_t begin = current_index_ > lanelets_behind_ ? current_index_ - lanelets_behind_ : 0;
+            size_t end = std::min(route_lanelets_.size(), current_index_ + lanelets_ahead_ + 1);
+            best = search(begin, end, position, min_distance);
+
+            // The vehicle may have passed the whole window since the last update. Keep moving forward while the next lanelet is closer
+            while (best == end - 1 && min_distance > 0.0 && end < route_lanelets_.size())
+            {
+                double next_distance = distance(end, position);
+                if (next_distance >= min_distance)
+                {
+                    break;
+                }
+                best = end;
+                min_distance = next_distance;
+                end++;
+            }
+        }
+
+        if (!has_match_ || min_distance > reacquire_distance_)
+        {
+            best = search(0, route_lanelets_.size(), position, min_distance);
+        }
+
+        has_match_ = true;
+        current_index_ = best;
+        return route_lanelets_[best].llt;
+    }
+
+    const lanelet::BasicPolygon2d& RouteProgressTracker::currentPolygon() const
+    {
+        if (!has_match_)
+        {
+            throw std::invalid_argument("RouteProgressTracker has not matched a route lanelet");
+        }
+        return route_lanelets_[current_index_].polygon;
+    }
+
+    size_t RouteProgressTracker::currentIndex() const
+    {
+        if (!has_match_)
+        {
+            throw std::invalid_argument("RouteProgressTracker has not matched a route lanelet");
+        }
+        return current_index_;
+    }
+
+    size_t RouteProgressTracker::size() const
+    {
+        return route_lanelets_.size();
+    }
+
+    bool RouteProgressTracker::empty() const
+    {
+        return route_lanelets_.empty();
+    }
+
+    double RouteProgressTracker::distance(size_t index, const lanelet::BasicPoint2d& position) const
+    {
+        return boost::geometry::distance(position, route_lanelets_[index].polygon);
+    }
+
+    size_t RouteProgressTracker::search(size_t begin, size_t end, const lanelet::BasicPoint2d& position, double& min_distance) const
+    {
+        min_distance = std::numeric_limits<double>::infinity();
+        size_t best = begin;
+        for (size_t i = begin; i < end; i++)
+        {
+            const auto& entry = route_lanelets_[i];
+
+            // The distance to the bounding box is a lower bound on the distance to the polygon
+            double dx = std::max({ entry.min_x - position.x(), 0.0, position.x() - entry.max_x });
+            double dy = std::max({ entry.min_y - position.y(), 0.0, position.y() - entry.max_y });
+            if (std::sqrt(dx * dx + dy * dy) >= min_distance)
+            {
+                continue;
+            }
+
+            double dist = distance(i, position);
+            if (dist < min_distance) // Strictly smaller so the first lanelet in route order wins ties
+            {
+                min_distance = dist;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+}
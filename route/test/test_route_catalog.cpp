@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "route_catalog.h"
+#include "route_cache.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace
+{
+    void writeFile(const boost::filesystem::path& path, const std::string& contents)
+    {
+        std::ofstream fout(path.generic_string());
+        fout << contents;
+    }
+
+    route::RouteKey getKey(lanelet::Id start, lanelet::Id end, size_t map_update_count)
+    {
+        route::RouteKey key;
+        key.start_lanelet = start;
+        key.end_lanelet = end;
+        key.end_x = 1.0;
+        key.end_y = 2.0;
+        key.map_update_count = map_update_count;
+        return key;
+    }
+}
+
+TEST(RouteCatalogTest, testResourceRoutes)
+{
+    route::RouteCatalog catalog;
+    catalog.setDirectory("../resource/route/");
+    ASSERT_TRUE(catalog.refresh());
+    ASSERT_EQ(5u, catalog.entries().size());
+    ASSERT_EQ("DEST3", catalog.entries().at("Test_town01_route_1").route_name);
+
+    // Nothing changed so no file is read again
+    size_t files_read = catalog.filesRead();
+    ASSERT_TRUE(catalog.refresh());
+    ASSERT_EQ(files_read, catalog.filesRead());
+
+    catalog.setDirectory("../resource/no_such_directory/");
+    ASSERT_FALSE(catalog.refresh());
+    ASSERT_TRUE(catalog.entries().empty());
+}
+
+TEST(RouteCatalogTest, testFileChanges)
+{
+    boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(directory);
+
+    writeFile(directory / "route_a.csv", "-77.1,38.9,72,START\n-77.2,38.8,72,END_A\n\n");
+    writeFile(directory / "route_b.csv", "-77.1,38.9,72\n-77.2,38.8,72\n");
+    writeFile(directory / "notes.txt", "not a route");
+
+    route::RouteCatalog catalog;
+    catalog.setDirectory(directory.generic_string() + "/");
+    ASSERT_TRUE(catalog.refresh());
+    ASSERT_EQ(2u, catalog.entries().size());
+    ASSERT_EQ(2u, catalog.filesRead());
+    ASSERT_EQ("END_A", catalog.entries().at("route_a").route_name);
+    ASSERT_EQ("", catalog.entries().at("route_b").route_name); // Last point has no destination name
+
+    // A changed file is read again and a new file is added
+    writeFile(directory / "route_b.csv", "-77.1,38.9,72\n-77.2,38.8,72,END_B\n");
+    writeFile(directory / "route_c.csv", "-77.1,38.9,72,END_C\n");
+    ASSERT_TRUE(catalog.refresh());
+    ASSERT_EQ(3u, catalog.entries().size());
+    ASSERT_EQ(4u, catalog.filesRead());
+    ASSERT_EQ("END_B", catalog.entries().at("route_b").route_name);
+    ASSERT_EQ("END_C", catalog.entries().at("route_c").route_name);
+
+    // A removed file is dropped
+    boost::filesystem::remove(directory / "route_a.csv");
+    ASSERT_TRUE(catalog.refresh());
+    ASSERT_EQ(2u, catalog.entries().size());
+    ASSERT_EQ(0u, catalog.entries().count("route_a"));
+    ASSERT_EQ(4u, catalog.filesRead());
+
+    boost::filesystem::remove_all(directory);
+}
+
+TEST(RouteCacheTest, testFindAndInsert)
+{
+    route::RouteCache cache(2);
+    route::RouteConstPtr route_1 = std::make_shared<lanelet::routing::Route>();
+    route::RouteConstPtr route_2 = std::make_shared<lanelet::routing::Route>();
+    route::RouteConstPtr route_3 = std::make_shared<lanelet::routing::Route>();
+
+    ASSERT_EQ(nullptr, cache.find(getKey(1, 2, 0)));
+
+    cache.insert(getKey(1, 2, 0), route_1);
+    ASSERT_EQ(route_1, cache.find(getKey(1, 2, 0)));
+
+    // Every part of the key must match
+    auto via_key = getKey(1, 2, 0);
+    via_key.via_lanelets.push_back(5);
+    ASSERT_EQ(nullptr, cache.find(via_key));
+    auto end_key = getKey(1, 2, 0);
+    end_key.end_x = 1.5;
+    ASSERT_EQ(nullptr, cache.find(end_key));
+    ASSERT_EQ(nullptr, cache.find(getKey(1, 2, 1)));
+
+    // The least recently used route is evicted
+    cache.insert(getKey(3, 4, 0), route_2);
+    ASSERT_EQ(route_1, cache.find(getKey(1, 2, 0)));
+    cache.insert(getKey(5, 6, 0), route_3);
+    ASSERT_EQ(2u, cache.size());
+    ASSERT_EQ(nullptr, cache.find(getKey(3, 4, 0)));
+    ASSERT_EQ(route_1, cache.find(getKey(1, 2, 0)));
+
+    // Routes computed before a map update are dropped when a route computed after it is added
+    cache.insert(getKey(1, 2, 1), route_2);
+    ASSERT_EQ(1u, cache.size());
+    ASSERT_EQ(route_2, cache.find(getKey(1, 2, 1)));
+
+    cache.clear();
+    ASSERT_EQ(0u, cache.size());
+}
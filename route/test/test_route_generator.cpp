@@ -586,6 +586,36 @@ TEST(RouteGeneratorTest, test_reroute_after_route_invalidation)
 
 }
 
+TEST(RouteGeneratorTest, test_reroute_recomputed_after_map_update)
+{
+    route::RouteGeneratorWorker worker;
+
+    auto cmw= carma_wm::test::getGuidanceTestMap();
+    worker.setWorldModelPtr(cmw);
+    carma_wm::test::setRouteByIds({1200, 1201,1202,1203}, cmw);
+
+    std::vector<lanelet::BasicPoint2d> dest_points;
+    dest_points.push_back(lanelet::BasicPoint2d{1.85, 87.5});
+
+    auto route = worker.reroute_after_route_invalidation(dest_points);
+    ASSERT_TRUE(!!route);
+
+    // Routing to the same destination on an unchanged map reuses the route
+    ASSERT_EQ(route, worker.reroute_after_route_invalidation(dest_points));
+
+    // A geofence rebuilds the routing graph without changing the map version, so every input of the route is the same
+    size_t map_version = cmw->getMapVersion();
+    auto graph = cmw->getMapRoutingGraph();
+    cmw->setMap(cmw->getMutableMap(), map_version, true);
+    ASSERT_EQ(map_version, cmw->getMapVersion());
+    ASSERT_NE(graph, cmw->getMapRoutingGraph());
+
+    auto updated_route = worker.reroute_after_route_invalidation(dest_points);
+    ASSERT_TRUE(!!updated_route);
+    ASSERT_NE(route, updated_route);
+    ASSERT_EQ(updated_route->shortestPath().size(), 4);
+}
+
 TEST(RouteGeneratorTest, test_setReroutingChecker)
 {
     route::RouteGeneratorWorker worker;
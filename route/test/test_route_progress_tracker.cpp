@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/WMTestLibForGuidance.h>
+#include "route_progress_tracker.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using carma_wm::test::getPoint;
+using carma_wm::test::getLanelet;
+
+namespace
+{
+    // A straight 3.7 m wide route along the y axis. Each lanelet starts where the previous one ends
+    lanelet::ConstLanelets getStraightRoute(const std::vector<double>& lengths)
+    {
+        lanelet::ConstLanelets route;
+        double y = 0;
+        for (double length : lengths)
+        {
+            route.push_back(getLanelet({ getPoint(0, y, 0), getPoint(0, y + length, 0) },
+                                       { getPoint(3.7, y, 0), getPoint(3.7, y + length, 0) }));
+            y += length;
+        }
+        return route;
+    }
+}
+
+TEST(RouteProgressTrackerTest, emptyRoute)
+{
+    route::RouteProgressTracker tracker;
+
+    ASSERT_TRUE(tracker.empty());
+    ASSERT_EQ(lanelet::InvalId, tracker.update(lanelet::BasicPoint2d(1.0, 1.0)).id());
+    ASSERT_THROW(tracker.currentIndex(), std::invalid_argument);
+    ASSERT_THROW(tracker.currentPolygon(), std::invalid_argument);
+}
+
+TEST(RouteProgressTrackerTest, followsRoute)
+{
+    auto route = getStraightRoute(std::vector<double>(20, 10.0));
+    route::RouteProgressTracker tracker;
+    tracker.setRoute(route);
+    ASSERT_EQ(20u, tracker.size());
+
+    for (size_t i = 0; i < route.size(); i++)
+    {
+        lanelet::BasicPoint2d position(1.85, 10.0 * i + 5.0);
+        ASSERT_EQ(route[i].id(), tracker.update(position).id());
+        ASSERT_EQ(i, tracker.currentIndex());
+        ASSERT_TRUE(boost::geometry::within(position, tracker.currentPolygon()));
+    }
+
+    // Beside the route the closest lanelet is still tracked
+    ASSERT_EQ(route[19].id(), tracker.update(lanelet::BasicPoint2d(6.0, 195.0)).id());
+}
+
+TEST(RouteProgressTrackerTest, passesShortLanelets)
+{
+    // Several lanelets shorter than the distance travelled between updates
+    auto route = getStraightRoute({ 10.0, 10.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 10.0, 10.0 });
+    route::RouteProgressTracker tracker(1, 3);
+    tracker.setRoute(route);
+
+    ASSERT_EQ(route[1].id(), tracker.update(lanelet::BasicPoint2d(1.85, 15.0)).id());
+    // Lanelet 9 is six lanelets ahead of the previous match, outside the search window
+    ASSERT_EQ(route[9].id(), tracker.update(lanelet::BasicPoint2d(1.85, 27.5)).id());
+    ASSERT_EQ(route[11].id(), tracker.update(lanelet::BasicPoint2d(1.85, 45.0)).id());
+}
+
+TEST(RouteProgressTrackerTest, reacquiresAfterJump)
+{
+    auto route = getStraightRoute(std::vector<double>(20, 10.0));
+    route::RouteProgressTracker tracker(1, 3, 5.0);
+    tracker.setRoute(route);
+
+    ASSERT_EQ(route[15].id(), tracker.update(lanelet::BasicPoint2d(1.85, 155.0)).id());
+    ASSERT_EQ(route[2].id(), tracker.update(lanelet::BasicPoint2d(1.85, 25.0)).id());
+    ASSERT_EQ(2u, tracker.currentIndex());
+
+    // A new route forgets the previous match
+    auto new_route = getStraightRoute(std::vector<double>(5, 10.0));
+    tracker.setRoute(new_route);
+    ASSERT_EQ(5u, tracker.size());
+    ASSERT_THROW(tracker.currentIndex(), std::invalid_argument);
+    ASSERT_EQ(new_route[4].id(), tracker.update(lanelet::BasicPoint2d(1.85, 45.0)).id());
+}
+
+TEST(RouteProgressTrackerTest, matchesFullSearch)
+{
+    auto route = getStraightRoute({ 10.0, 3.0, 7.0, 0.5, 12.0, 4.0, 4.0, 20.0 });
+    route::RouteProgressTracker tracker;
+    tracker.setRoute(route);
+
+    for (double y = -2.0; y < 62.0; y += 0.7)
+    {
+        for (double x : { -1.0, 1.85, 5.0 })
+        {
+            lanelet::BasicPoint2d position(x, y);
+
+            // Distance to the lanelet a search of the whole route picks
+            double min = std::numeric_limits<double>::infinity();
+            for (const auto& llt : route)
+            {
+                min = std::min(min, boost::geometry::distance(position, llt.polygon2d()));
+            }
+
+            lanelet::ConstLanelet actual = tracker.update(position);
+            ASSERT_NEAR(min, boost::geometry::distance(position, actual.polygon2d()), 1e-9);
+        }
+    }
+}
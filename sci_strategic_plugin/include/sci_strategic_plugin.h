@@ -31,8 +31,7 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <cav_msgs/BSM.h>
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/classification.hpp>
+#include <strategy_params_parser/strategy_params.h>
 
 #include "sci_strategic_plugin_config.h"
 
@@ -352,6 +351,12 @@ public:
   // strategy for stop controlled intersection
   std::string stop_controlled_intersection_strategy_ = "Carma/stop_controlled_intersection";
   std::string previous_strategy_params_ = "";  
+
+  //! Keys of the schedule strategy params sent by carma streets
+  static const strategy_params::Schema schedule_params_schema_;
+
+  //! Reused storage for parsing schedule strategy params
+  strategy_params::ParsedParams schedule_params_{ schedule_params_schema_ };
   
 
 };
@@ -122,38 +122,40 @@ void SCIStrategicPlugin::currentPoseCb(const geometry_msgs::PoseStampedConstPtr&
   
 }
 
+const strategy_params::Schema SCIStrategicPlugin::schedule_params_schema_({ "st", "et", "dt", "dp", "access" });
+
 void SCIStrategicPlugin::parseStrategyParams(const std::string& strategy_params)
 {
   // sample strategy_params: "st:1634067044,et:1634067059, dt:1634067062.3256602,dp:2,,access: 0"
-  std::string params = strategy_params;
-  std::vector<std::string> inputsParams;
-  boost::algorithm::split(inputsParams, params, boost::is_any_of(","));
+  enum ScheduleParam { STOP_TIME, ENTER_TIME, DEPART_TIME, DEPART_POSITION, ACCESS };
+
+  strategy_params::parseKeyValue(strategy_params, schedule_params_);
 
-  std::vector<std::string> st_parsed;
-  boost::algorithm::split(st_parsed, inputsParams[0], boost::is_any_of(":"));
-  scheduled_stop_time_ = std::stoull(st_parsed[1]);
+  auto st = schedule_params_.getUInt(STOP_TIME);
+  auto et = schedule_params_.getUInt(ENTER_TIME);
+  auto dt = schedule_params_.getUInt(DEPART_TIME);
+  auto dp = schedule_params_.getInt(DEPART_POSITION);
+  auto access = schedule_params_.getInt(ACCESS);
+
+  if (!st || !et || !dt || !dp || !access)
+  {
+    ROS_WARN_STREAM("Ignoring incomplete schedule strategy params: " << strategy_params);
+    return;
+  }
+
+  scheduled_stop_time_ = *st;
   ROS_DEBUG_STREAM("scheduled_stop_time_: " << scheduled_stop_time_);
 
-  std::vector<std::string> et_parsed;
-  boost::algorithm::split(et_parsed, inputsParams[1], boost::is_any_of(":"));
-  scheduled_enter_time_ = std::stoull(et_parsed[1]);
+  scheduled_enter_time_ = *et;
   ROS_DEBUG_STREAM("scheduled_enter_time_: " << scheduled_enter_time_);
 
-  std::vector<std::string> dt_parsed;
-  boost::algorithm::split(dt_parsed, inputsParams[2], boost::is_any_of(":"));
-  scheduled_depart_time_ = std::stoull(dt_parsed[1]);
+  scheduled_depart_time_ = *dt;
   ROS_DEBUG_STREAM("scheduled_depart_time_: " << scheduled_depart_time_);
 
-
-  std::vector<std::string> dp_parsed;
-  boost::algorithm::split(dp_parsed, inputsParams[3], boost::is_any_of(":"));
-  scheduled_departure_position_ = std::stoi(dp_parsed[1]);
+  scheduled_departure_position_ = static_cast<uint32_t>(*dp);
   ROS_DEBUG_STREAM("scheduled_departure_position_: " << scheduled_departure_position_);
 
-  std::vector<std::string> access_parsed;
-  boost::algorithm::split(access_parsed, inputsParams[4], boost::is_any_of(":"));
-  int access = std::stoi(access_parsed[1]);
-  is_allowed_int_ = (access == 1);
+  is_allowed_int_ = (*access == 1);
   ROS_DEBUG_STREAM("is_allowed_int_: " << is_allowed_int_);
 
 }
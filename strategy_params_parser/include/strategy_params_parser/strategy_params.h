@@ -0,0 +1,232 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+/**
+ * \brief The strategy_params namespace contains a shared parser for the strategy_params field of MobilityOperation
+ * and MobilityRequest messages. Both the "TYPE|key:value,key:value" format used by most plugins and the JSON format
+ * used by port drayage are supported.
+ *
+ * Parsing never copies the input. All values are exposed as views into the caller's string, so the string passed to a
+ * parse function must outlive the ParsedParams object it populated. Once a ParsedParams object has been constructed
+ * it can be reused across messages without further heap allocation.
+ */
+namespace strategy_params
+{
+using string_view = boost::string_view;
+
+/**
+ * \brief A declared set of keys which a parser should extract. Keys are resolved to indexes once at startup so that
+ * lookups on the message hot path are by index.
+ *
+ * For JSON params nested keys are declared using dotted paths such as "location.latitude"
+ */
+class Schema
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param keys The keys in this schema. The index of each key in this list is the index used by ParsedParams accessors
+   */
+  Schema(std::initializer_list<std::string> keys);
+
+  //! Value returned by find() when a key is not part of the schema
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /**
+   * \brief Returns the number of keys in this schema
+   */
+  size_t size() const;
+
+  /**
+   * \brief Returns the key at the provided index
+   *
+   * \throws std::out_of_range if the index is not part of the schema
+   */
+  const std::string& key(size_t index) const;
+
+  /**
+   * \brief Returns the index of the provided key or npos if the key is not part of this schema
+   */
+  size_t find(string_view key) const;
+
+  /**
+   * \brief Returns the index of the key whose dotted path matches the provided path segments or npos if no key matches
+   *
+   * \param segments Pointer to the first segment of the path
+   * \param count The number of segments in the path
+   */
+  size_t findPath(const string_view* segments, size_t count) const;
+
+private:
+  std::vector<std::string> keys_;
+};
+
+/**
+ * \brief A single raw field of a key:value strategy params string. Fields without a key delimiter have an empty key.
+ */
+struct Field
+{
+  string_view key;
+  string_view value;
+};
+
+/**
+ * \brief The result of parsing a strategy params string against a Schema.
+ *
+ * Values for schema keys are available by schema index. In addition every field of a key:value string is recorded in
+ * order of appearance so that positional formats can be read without a schema.
+ */
+class ParsedParams
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param schema The schema whose keys will be extracted. Must outlive this object.
+   * \param expected_fields The number of positional fields to reserve storage for
+   */
+  explicit ParsedParams(const Schema& schema, size_t expected_fields = 16);
+
+  /**
+   * \brief Resets all values without releasing storage
+   */
+  void clear();
+
+  /**
+   * \brief Returns true if the key at the provided schema index was present in the last parsed message
+   */
+  bool has(size_t index) const;
+
+  /**
+   * \brief Returns the unconverted value for the provided schema index. The view is empty if the key was not present.
+   */
+  string_view raw(size_t index) const;
+
+  /**
+   * \brief Typed accessors for the value at the provided schema index.
+   *        Each returns an empty optional if the key was not present or the value could not be converted.
+   */
+  boost::optional<double> getDouble(size_t index) const;
+  boost::optional<int64_t> getInt(size_t index) const;
+  boost::optional<uint64_t> getUInt(size_t index) const;
+  boost::optional<bool> getBool(size_t index) const;
+
+  /**
+   * \brief Returns the value at the provided schema index copied into a string. This is the only accessor which
+   * allocates and is provided for callers which must store the value beyond the lifetime of the source message.
+   */
+  boost::optional<std::string> getString(size_t index) const;
+
+  /**
+   * \brief Returns the message type prefix of a "TYPE|key:value" string or an empty view if there was none
+   */
+  string_view type() const;
+
+  /**
+   * \brief Returns the number of fields found in the last parsed key:value message including fields with no key
+   */
+  size_t fieldCount() const;
+
+  /**
+   * \brief Returns the field at the provided position in the last parsed key:value message
+   *
+   * \throws std::out_of_range if the position is not less than fieldCount()
+   */
+  const Field& field(size_t position) const;
+
+  /**
+   * \brief Returns the schema this object was constructed with
+   */
+  const Schema& schema() const;
+
+  // Mutators used by the parse functions
+  void setValue(size_t index, string_view value);
+  void setType(string_view type);
+  void addField(string_view key, string_view value);
+
+private:
+  const Schema* schema_;
+  std::vector<string_view> values_;
+  std::vector<bool> present_;
+  std::vector<Field> fields_;
+  string_view type_;
+};
+
+/**
+ * \brief Delimiters of a key:value strategy params string
+ */
+struct KeyValueFormat
+{
+  char field_delimiter = ',';
+  char key_value_delimiter = ':';
+  char type_delimiter = '|';
+};
+
+/**
+ * \brief Tokenizes a key:value strategy params string such as "STATUS|CMDSPEED:1.0,DTD:20.5" in place.
+ *
+ * Whitespace around keys and values is ignored as are empty fields. If the same key appears more than once the last
+ * value is used. The type prefix is only recognized when the type delimiter appears before the first key delimiter.
+ *
+ * \param params The strategy params string to parse. Must outlive out.
+ * \param out The object to populate. It is cleared before parsing.
+ * \param format The delimiters to use
+ *
+ * \return True if at least one field was found
+ */
+bool parseKeyValue(string_view params, ParsedParams& out, const KeyValueFormat& format = KeyValueFormat());
+
+/**
+ * \brief Tokenizes a JSON encoded strategy params string in place.
+ *
+ * Only values of keys in the schema are recorded. String values are returned without their quotes and without
+ * unescaping. Arrays are skipped.
+ *
+ * \param params The JSON string to parse. Must outlive out.
+ * \param out The object to populate. It is cleared before parsing.
+ *
+ * \return True if the string was a well formed JSON object
+ */
+bool parseJson(string_view params, ParsedParams& out);
+
+/**
+ * \brief Allocation free conversions of raw values. These are used by the ParsedParams accessors and are exposed for
+ * callers reading positional fields.
+ *
+ * toUInt follows the behavior of std::stoull in that it converts the leading digits of the value and ignores any
+ * fractional part.
+ */
+boost::optional<double> toDouble(string_view value);
+boost::optional<int64_t> toInt(string_view value);
+boost::optional<uint64_t> toUInt(string_view value);
+boost::optional<bool> toBool(string_view value);
+
+/**
+ * \brief Returns the provided view with leading and trailing whitespace removed
+ */
+string_view trim(string_view value);
+
+}  // namespace strategy_params
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cctype>
+#include "strategy_params_parser/strategy_params.h"
+
+namespace strategy_params
+{
+namespace
+{
+/**
+ * \brief Recursive descent scanner over a JSON string. The current object path is kept in a fixed size stack of views
+ * so no allocation occurs while scanning.
+ */
+class JsonScanner
+{
+public:
+  JsonScanner(string_view json, ParsedParams& out) : p_(json.data()), end_(json.data() + json.size()), out_(out)
+  {
+  }
+
+  bool scan()
+  {
+    skipWhitespace();
+    if (!parseObject())
+    {
+      return false;
+    }
+    skipWhitespace();
+    return p_ == end_;
+  }
+
+private:
+  // Maximum nesting of objects and arrays. Bounds the recursion on malformed input
+  static constexpr size_t MAX_DEPTH = 16;
+
+  void skipWhitespace()
+  {
+    while (p_ < end_ && std::isspace(static_cast<unsigned char>(*p_)))
+    {
+      p_++;
+    }
+  }
+
+  bool consume(char c)
+  {
+    skipWhitespace();
+    if (p_ < end_ && *p_ == c)
+    {
+      p_++;
+      return true;
+    }
+    return false;
+  }
+
+  bool parseString(string_view& result)
+  {
+    if (!consume('"'))
+    {
+      return false;
+    }
+    const char* start = p_;
+    while (p_ < end_ && *p_ != '"')
+    {
+      if (*p_ == '\\')
+      {
+        p_++;  // Skip the escaped character
+      }
+      p_++;
+    }
+    if (p_ >= end_)
+    {
+      return false;
+    }
+    result = string_view(start, p_ - start);
+    p_++;  // Closing quote
+    return true;
+  }
+
+  bool parseLiteral(string_view& result)
+  {
+    const char* start = p_;
+    while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']' && !std::isspace(static_cast<unsigned char>(*p_)))
+    {
+      p_++;
+    }
+    result = string_view(start, p_ - start);
+    return !result.empty();
+  }
+
+  void record(string_view value)
+  {
+    if (array_depth_ > 0)
+    {
+      return;
+    }
+    size_t index = out_.schema().findPath(path_, depth_);
+    if (index != Schema::npos)
+    {
+      out_.setValue(index, value);
+    }
+  }
+
+  bool parseValue()
+  {
+    skipWhitespace();
+    if (p_ >= end_)
+    {
+      return false;
+    }
+
+    string_view value;
+    switch (*p_)
+    {
+      case '{':
+        return parseObject();
+      case '[':
+        return parseArray();
+      case '"':
+        if (!parseString(value))
+        {
+          return false;
+        }
+        record(value);
+        return true;
+      default:
+        if (!parseLiteral(value))
+        {
+          return false;
+        }
+        record(value);
+        return true;
+    }
+  }
+
+  bool parseArray()
+  {
+    consume('[');
+    if (depth_ + array_depth_ >= MAX_DEPTH)
+    {
+      return false;
+    }
+    array_depth_++;
+    if (consume(']'))
+    {
+      array_depth_--;
+      return true;
+    }
+    do
+    {
+      if (!parseValue())
+      {
+        return false;
+      }
+    } while (consume(','));
+    array_depth_--;
+    return consume(']');
+  }
+
+  bool parseObject()
+  {
+    if (!consume('{'))
+    {
+      return false;
+    }
+    if (consume('}'))
+    {
+      return true;
+    }
+    do
+    {
+      string_view key;
+      if (!parseString(key) || !consume(':') || depth_ + array_depth_ >= MAX_DEPTH)
+      {
+        return false;
+      }
+      path_[depth_++] = key;
+      bool valid = parseValue();
+      depth_--;
+      if (!valid)
+      {
+        return false;
+      }
+    } while (consume(','));
+    return consume('}');
+  }
+
+  const char* p_;
+  const char* end_;
+  ParsedParams& out_;
+  string_view path_[MAX_DEPTH];
+  size_t depth_ = 0;
+  size_t array_depth_ = 0;
+};
+
+}  // namespace
+
+bool parseJson(string_view params, ParsedParams& out)
+{
+  out.clear();
+  JsonScanner scanner(params, out);
+  return scanner.scan();
+}
+
+}  // namespace strategy_params
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "strategy_params_parser/strategy_params.h"
+
+namespace strategy_params
+{
+bool parseKeyValue(string_view params, ParsedParams& out, const KeyValueFormat& format)
+{
+  out.clear();
+
+  // A type prefix is only present if its delimiter comes before the first key
+  size_t type_end = params.find(format.type_delimiter);
+  if (type_end != string_view::npos && type_end < params.find(format.key_value_delimiter))
+  {
+    out.setType(trim(params.substr(0, type_end)));
+    params.remove_prefix(type_end + 1);
+  }
+
+  const Schema& schema = out.schema();
+
+  while (!params.empty())
+  {
+    size_t field_end = params.find(format.field_delimiter);
+    string_view field = params.substr(0, field_end);
+
+    if (field_end == string_view::npos)
+    {
+      params = string_view();
+    }
+    else
+    {
+      params.remove_prefix(field_end + 1);
+    }
+
+    field = trim(field);
+    if (field.empty())
+    {
+      continue;
+    }
+
+    size_t split = field.find(format.key_value_delimiter);
+    if (split == string_view::npos)
+    {
+      out.addField(string_view(), field);
+      continue;
+    }
+
+    string_view key = trim(field.substr(0, split));
+    string_view value = trim(field.substr(split + 1));
+    out.addField(key, value);
+
+    size_t index = schema.find(key);
+    if (index != Schema::npos)
+    {
+      out.setValue(index, value);
+    }
+  }
+
+  return out.fieldCount() > 0;
+}
+
+}  // namespace strategy_params
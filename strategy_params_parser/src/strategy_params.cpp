@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "strategy_params_parser/strategy_params.h"
+
+namespace strategy_params
+{
+constexpr size_t Schema::npos;
+
+Schema::Schema(std::initializer_list<std::string> keys) : keys_(keys)
+{
+}
+
+size_t Schema::size() const
+{
+  return keys_.size();
+}
+
+const std::string& Schema::key(size_t index) const
+{
+  return keys_.at(index);
+}
+
+size_t Schema::find(string_view key) const
+{
+  for (size_t i = 0; i < keys_.size(); i++)
+  {
+    if (key == keys_[i])
+    {
+      return i;
+    }
+  }
+  return npos;
+}
+
+size_t Schema::findPath(const string_view* segments, size_t count) const
+{
+  for (size_t i = 0; i < keys_.size(); i++)
+  {
+    string_view key(keys_[i]);
+    size_t pos = 0;
+    bool match = true;
+    for (size_t s = 0; s < count && match; s++)
+    {
+      const string_view& seg = segments[s];
+      bool is_last = (s + 1 == count);
+      size_t seg_end = pos + seg.size();
+
+      if (seg_end > key.size() || key.substr(pos, seg.size()) != seg)
+      {
+        match = false;
+      }
+      else if (is_last)
+      {
+        match = (seg_end == key.size());
+      }
+      else
+      {
+        match = (seg_end < key.size() && key[seg_end] == '.');
+        pos = seg_end + 1;
+      }
+    }
+    if (match && count > 0)
+    {
+      return i;
+    }
+  }
+  return npos;
+}
+
+ParsedParams::ParsedParams(const Schema& schema, size_t expected_fields)
+  : schema_(&schema), values_(schema.size()), present_(schema.size(), false)
+{
+  fields_.reserve(expected_fields);
+}
+
+void ParsedParams::clear()
+{
+  std::fill(present_.begin(), present_.end(), false);
+  fields_.clear();  // Capacity is retained so reuse does not allocate
+  type_ = string_view();
+}
+
+bool ParsedParams::has(size_t index) const
+{
+  return index < present_.size() && present_[index];
+}
+
+string_view ParsedParams::raw(size_t index) const
+{
+  if (!has(index))
+  {
+    return string_view();
+  }
+  return values_[index];
+}
+
+boost::optional<double> ParsedParams::getDouble(size_t index) const
+{
+  if (!has(index))
+  {
+    return boost::none;
+  }
+  return toDouble(values_[index]);
+}
+
+boost::optional<int64_t> ParsedParams::getInt(size_t index) const
+{
+  if (!has(index))
+  {
+    return boost::none;
+  }
+  return toInt(values_[index]);
+}
+
+boost::optional<uint64_t> ParsedParams::getUInt(size_t index) const
+{
+  if (!has(index))
+  {
+    return boost::none;
+  }
+  return toUInt(values_[index]);
+}
+
+boost::optional<bool> ParsedParams::getBool(size_t index) const
+{
+  if (!has(index))
+  {
+    return boost::none;
+  }
+  return toBool(values_[index]);
+}
+
+boost::optional<std::string> ParsedParams::getString(size_t index) const
+{
+  if (!has(index))
+  {
+    return boost::none;
+  }
+  return std::string(values_[index].data(), values_[index].size());
+}
+
+string_view ParsedParams::type() const
+{
+  return type_;
+}
+
+size_t ParsedParams::fieldCount() const
+{
+  return fields_.size();
+}
+
+const Field& ParsedParams::field(size_t position) const
+{
+  return fields_.at(position);
+}
+
+const Schema& ParsedParams::schema() const
+{
+  return *schema_;
+}
+
+void ParsedParams::setValue(size_t index, string_view value)
+{
+  if (index >= values_.size())
+  {
+    return;
+  }
+  values_[index] = value;
+  present_[index] = true;
+}
+
+void ParsedParams::setType(string_view type)
+{
+  type_ = type;
+}
+
+void ParsedParams::addField(string_view key, string_view value)
+{
+  fields_.push_back({ key, value });
+}
+
+string_view trim(string_view value)
+{
+  size_t start = 0;
+  size_t end = value.size();
+  while (start < end && std::isspace(static_cast<unsigned char>(value[start])))
+  {
+    start++;
+  }
+  while (end > start && std::isspace(static_cast<unsigned char>(value[end - 1])))
+  {
+    end--;
+  }
+  return value.substr(start, end - start);
+}
+
+namespace
+{
+/**
+ * \brief Converts plain decimal values such as "-77.1496214" without calling strtod.
+ *
+ * When the significant digits fit exactly in a double and the power of ten is itself exact a single multiply or
+ * divide yields the correctly rounded result, so this matches strtod bit for bit. Any other input returns false.
+ */
+bool fastDecimalToDouble(string_view value, double& result)
+{
+  static const double POWERS_OF_TEN[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                          1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  constexpr uint64_t MAX_EXACT_MANTISSA = 1ull << 53;
+
+  size_t i = 0;
+  bool negative = false;
+  if (i < value.size() && (value[i] == '-' || value[i] == '+'))
+  {
+    negative = (value[i] == '-');
+    i++;
+  }
+
+  uint64_t mantissa = 0;
+  size_t digits = 0;
+  size_t fraction_digits = 0;
+  bool in_fraction = false;
+  for (; i < value.size(); i++)
+  {
+    char c = value[i];
+    if (c >= '0' && c <= '9')
+    {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+      digits++;
+      if (in_fraction)
+      {
+        fraction_digits++;
+      }
+      if (digits > 15 || mantissa >= MAX_EXACT_MANTISSA)
+      {
+        return false;
+      }
+    }
+    else if (c == '.' && !in_fraction)
+    {
+      in_fraction = true;
+    }
+    else
+    {
+      return false;  // Exponents, hex, inf and nan are left to strtod
+    }
+  }
+
+  if (digits == 0)
+  {
+    return false;
+  }
+
+  result = static_cast<double>(mantissa) / POWERS_OF_TEN[fraction_digits];
+  if (negative)
+  {
+    result = -result;
+  }
+  return true;
+}
+}  // namespace
+
+boost::optional<double> toDouble(string_view value)
+{
+  value = trim(value);
+
+  double fast_result;
+  if (fastDecimalToDouble(value, fast_result))
+  {
+    return fast_result;
+  }
+
+  // strtod requires a null terminated string so the value is copied to the stack rather than the heap
+  constexpr size_t MAX_NUMBER_LENGTH = 64;
+  if (value.empty() || value.size() >= MAX_NUMBER_LENGTH)
+  {
+    return boost::none;
+  }
+  char buffer[MAX_NUMBER_LENGTH];
+  std::memcpy(buffer, value.data(), value.size());
+  buffer[value.size()] = '\0';
+
+  char* end = nullptr;
+  double result = std::strtod(buffer, &end);
+  if (end != buffer + value.size())
+  {
+    return boost::none;
+  }
+  return result;
+}
+
+boost::optional<uint64_t> toUInt(string_view value)
+{
+  value = trim(value);
+  size_t i = 0;
+  if (i < value.size() && value[i] == '+')
+  {
+    i++;
+  }
+
+  uint64_t result = 0;
+  size_t digits = 0;
+  for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; i++, digits++)
+  {
+    uint64_t digit = static_cast<uint64_t>(value[i] - '0');
+    if (result > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+    {
+      return boost::none;  // Overflow
+    }
+    result = result * 10 + digit;
+  }
+
+  if (digits == 0)
+  {
+    return boost::none;
+  }
+  return result;
+}
+
+boost::optional<int64_t> toInt(string_view value)
+{
+  value = trim(value);
+  bool negative = !value.empty() && value[0] == '-';
+  if (negative)
+  {
+    value.remove_prefix(1);
+  }
+
+  // Unlike toUInt the whole value must be an integer
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    if ((value[i] < '0' || value[i] > '9') && !(i == 0 && value[i] == '+'))
+    {
+      return boost::none;
+    }
+  }
+
+  auto magnitude = toUInt(value);
+  if (!magnitude || *magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+  {
+    return boost::none;
+  }
+  int64_t result = static_cast<int64_t>(*magnitude);
+  return negative ? -result : result;
+}
+
+boost::optional<bool> toBool(string_view value)
+{
+  value = trim(value);
+  if (value == "true" || value == "1")
+  {
+    return true;
+  }
+  if (value == "false" || value == "0")
+  {
+    return false;
+  }
+  return boost::none;
+}
+
+}  // namespace strategy_params
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Benchmark comparing the shared strategy params parser against the ad hoc parsers it replaces.
+ * Run with: rosrun strategy_params_parser strategy_params_parser-benchmark [iterations]
+ */
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <strategy_params_parser/strategy_params.h>
+
+namespace
+{
+const std::string STATUS_PARAMS = "STATUS|CMDSPEED:11.50,DTD:1250.25,SPEED:11.20,ECEFX:1105093.64,ECEFY:-4841498.13,"
+                                  "ECEFZ:3983170.71";
+const std::string INCIDENT_PARAMS = "lat:39.46636844371259,lon:-76.16919523566943,downtrack:57,uptrack:59,min_gap:2,"
+                                    "advisory_speed:1.2,event_reason:MOVE OVER LAW,event_type:CLOSED";
+const std::string DRAYAGE_PARAMS = "{ \"cmv_id\": \"123\", \"cargo_id\": \"321\", \"location\": { \"latitude\": "
+                                   "38.9549716, \"longitude\": -77.1496214 }, \"destination\": {\"latitude\": "
+                                   "38.9554377, \"longitude\": -77.1503421}, \"operation\": \"PICKUP\", "
+                                   "\"action_id\": \"32\" }";
+
+// Prevents the compiler from discarding benchmark results
+volatile double g_sink = 0;
+
+template <typename F>
+void run(const std::string& name, size_t iterations, F&& func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++)
+  {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  std::cout << name << ": " << ns << " ns/msg" << std::endl;
+}
+
+// Equivalent of PlatoonStrategicPlugin status parsing
+double legacySplitStatus(const std::string& strategy_params)
+{
+  std::vector<std::string> inputs;
+  boost::algorithm::split(inputs, strategy_params, boost::is_any_of(","));
+  double sum = 0;
+  for (size_t i = 0; i < inputs.size(); i++)
+  {
+    std::vector<std::string> parsed;
+    boost::algorithm::split(parsed, inputs[i], boost::is_any_of(":"));
+    sum += std::stod(parsed[1]);
+  }
+  return sum;
+}
+
+// Equivalent of TrafficIncidentParserWorker::mobilityMessageParser tokenization
+double legacyFindSubstrIncident(std::string strategy_params)
+{
+  std::vector<std::string> vec;
+  size_t pos = 0;
+  while ((pos = strategy_params.find(",")) != std::string::npos)
+  {
+    vec.push_back(strategy_params.substr(0, pos));
+    strategy_params.erase(0, pos + 1);
+  }
+  vec.push_back(strategy_params);
+
+  double sum = 0;
+  for (size_t i = 0; i < 6; i++)
+  {
+    std::string value;
+    for (size_t j = vec[i].find(':') + 1; j < vec[i].length(); j++)
+    {
+      value += vec[i][j];
+    }
+    sum += std::stod(value);
+  }
+  return sum;
+}
+
+// Equivalent of PortDrayageWorker::mobility_operation_message_parser
+double legacyPropertyTree(const std::string& strategy_params)
+{
+  boost::property_tree::ptree pt;
+  std::istringstream ss(strategy_params);
+  boost::property_tree::json_parser::read_json(ss, pt);
+  return pt.get<double>("location.latitude") + pt.get<double>("destination.longitude") +
+         pt.get<std::string>("cmv_id").size();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  size_t iterations = argc > 1 ? std::stoul(argv[1]) : 200000;
+
+  namespace sp = strategy_params;
+
+  sp::Schema status_schema({ "CMDSPEED", "DTD", "SPEED", "ECEFX", "ECEFY", "ECEFZ" });
+  sp::ParsedParams status(status_schema);
+
+  sp::Schema incident_schema({});
+  sp::ParsedParams incident(incident_schema);
+
+  sp::Schema drayage_schema({ "cmv_id", "location.latitude", "destination.longitude" });
+  sp::ParsedParams drayage(drayage_schema);
+
+  std::cout << "Strategy params parsing benchmark (" << iterations << " iterations)" << std::endl;
+
+  run("platoon status  legacy boost::split", iterations, [&]() { g_sink = g_sink + legacySplitStatus(STATUS_PARAMS); });
+  run("platoon status  strategy_params    ", iterations, [&]() {
+    sp::parseKeyValue(STATUS_PARAMS, status);
+    double sum = 0;
+    for (size_t i = 0; i < status_schema.size(); i++)
+    {
+      sum += status.getDouble(i).get_value_or(0);
+    }
+    g_sink = g_sink + sum;
+  });
+
+  run("incident        legacy find/substr ", iterations,
+      [&]() { g_sink = g_sink + legacyFindSubstrIncident(INCIDENT_PARAMS); });
+  run("incident        strategy_params    ", iterations, [&]() {
+    sp::parseKeyValue(INCIDENT_PARAMS, incident);
+    double sum = 0;
+    for (size_t i = 0; i < 6; i++)
+    {
+      sum += sp::toDouble(incident.field(i).value).get_value_or(0);
+    }
+    g_sink = g_sink + sum;
+  });
+
+  run("port drayage    legacy property_tree", iterations / 10,
+      [&]() { g_sink = g_sink + legacyPropertyTree(DRAYAGE_PARAMS); });
+  run("port drayage    strategy_params     ", iterations, [&]() {
+    sp::parseJson(DRAYAGE_PARAMS, drayage);
+    g_sink = g_sink + drayage.getDouble(1).get_value_or(0) + drayage.getDouble(2).get_value_or(0) +
+             drayage.raw(0).size();
+  });
+
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <strategy_params_parser/strategy_params.h>
+
+namespace strategy_params
+{
+TEST(StrategyParamsTest, keyValueBySchema)
+{
+  Schema schema({ "st", "et", "dt", "dp", "access" });
+  ParsedParams params(schema);
+
+  // Whitespace and empty fields are tolerated
+  std::string msg = "st:1634067044,et:1634067059, dt:1634067062.3256602,dp:2,,access: 0";
+  ASSERT_TRUE(parseKeyValue(msg, params));
+
+  EXPECT_EQ(5u, params.fieldCount());
+  EXPECT_EQ(1634067044u, *params.getUInt(0));
+  EXPECT_EQ(1634067059u, *params.getUInt(1));
+  EXPECT_EQ(1634067062u, *params.getUInt(2));  // Fraction is truncated like std::stoull
+  EXPECT_NEAR(1634067062.3256602, *params.getDouble(2), 0.0000001);
+  EXPECT_EQ(2, *params.getInt(3));
+  EXPECT_EQ(0, *params.getInt(4));
+  EXPECT_FALSE(*params.getBool(4));
+  EXPECT_TRUE(params.type().empty());
+
+  // Missing keys are reported as such after reuse
+  msg = "st:5";
+  ASSERT_TRUE(parseKeyValue(msg, params));
+  EXPECT_TRUE(params.has(0));
+  EXPECT_FALSE(params.has(1));
+  EXPECT_FALSE(!!params.getUInt(1));
+  EXPECT_TRUE(params.raw(1).empty());
+}
+
+TEST(StrategyParamsTest, keyValueTypePrefix)
+{
+  Schema schema({ "CMDSPEED", "DTD", "SPEED", "ECEFX", "ECEFY", "ECEFZ" });
+  ParsedParams params(schema);
+
+  std::string msg = "STATUS|CMDSPEED:11.5,DTD:20.25,SPEED:11.0,ECEFX:-1.5,ECEFY:2,ECEFZ:3e2";
+  ASSERT_TRUE(parseKeyValue(msg, params));
+
+  EXPECT_EQ("STATUS", params.type());
+  EXPECT_DOUBLE_EQ(11.5, *params.getDouble(0));
+  EXPECT_DOUBLE_EQ(20.25, *params.getDouble(1));
+  EXPECT_DOUBLE_EQ(11.0, *params.getDouble(2));
+  EXPECT_DOUBLE_EQ(-1.5, *params.getDouble(3));
+  EXPECT_DOUBLE_EQ(2.0, *params.getDouble(4));
+  EXPECT_DOUBLE_EQ(300.0, *params.getDouble(5));
+
+  // Unknown keys are still available positionally
+  msg = "INFO|REAR:veh_1,LENGTH:5.00";
+  ASSERT_TRUE(parseKeyValue(msg, params));
+  EXPECT_EQ("INFO", params.type());
+  ASSERT_EQ(2u, params.fieldCount());
+  EXPECT_EQ("REAR", params.field(0).key);
+  EXPECT_EQ("veh_1", params.field(0).value);
+  EXPECT_FALSE(params.has(0));
+}
+
+TEST(StrategyParamsTest, keyValuePositional)
+{
+  Schema schema({});
+  ParsedParams params(schema);
+
+  std::string msg = "lat:0.435,lon:0.555,downtrack:5,uptrack:5,min_gap:2,advisory_speed:1.2,event_reason:MOVE OVER "
+                    "LAW,event_type:CLOSED";
+  ASSERT_TRUE(parseKeyValue(msg, params));
+  ASSERT_EQ(8u, params.fieldCount());
+  EXPECT_EQ(0.435, *toDouble(params.field(0).value));
+  EXPECT_EQ("MOVE OVER LAW", params.field(6).value);
+  EXPECT_EQ("CLOSED", params.field(7).value);
+
+  EXPECT_FALSE(parseKeyValue("", params));
+  EXPECT_EQ(0u, params.fieldCount());
+}
+
+TEST(StrategyParamsTest, conversions)
+{
+  EXPECT_FALSE(!!toDouble("abc"));
+  EXPECT_FALSE(!!toDouble("1.5abc"));
+  EXPECT_FALSE(!!toDouble(""));
+  EXPECT_DOUBLE_EQ(-0.25, *toDouble(" -0.25 "));
+
+  // Plain decimals must convert exactly as strtod would
+  for (const char* decimal : { "0.435", "-76.16919523566943", "39.46636844371259", "1634067062.3256602", "0.1",
+                               "123456789012345", "1e5", "4841498.13" })
+  {
+    EXPECT_EQ(std::strtod(decimal, nullptr), *toDouble(decimal)) << decimal;
+  }
+
+  EXPECT_FALSE(!!toInt("1.5"));
+  EXPECT_FALSE(!!toInt("-"));
+  EXPECT_EQ(-42, *toInt("-42"));
+  EXPECT_EQ(42, *toInt("+42"));
+
+  EXPECT_FALSE(!!toUInt("-1"));
+  EXPECT_FALSE(!!toUInt("99999999999999999999999"));
+  EXPECT_EQ(7u, *toUInt("7.9"));
+
+  EXPECT_TRUE(*toBool("true"));
+  EXPECT_FALSE(*toBool("false"));
+  EXPECT_FALSE(!!toBool("yes"));
+}
+
+TEST(StrategyParamsTest, json)
+{
+  Schema schema({ "cmv_id", "cargo_id", "operation", "action_id", "location.latitude", "location.longitude",
+                  "destination.latitude", "destination.longitude", "cargo" });
+  ParsedParams params(schema);
+
+  std::string msg = "{ \"cmv_id\": \"123\", \"cargo_id\": \"321\", \"location\": { \"latitude\": 38.9549716, "
+                    "\"longitude\": -77.1496214 }, \"destination\": {\"latitude\": 38.9554377, \"longitude\": "
+                    "-77.1503421}, \"operation\": \"MOVING_TO_LOADING_AREA\", \"action_id\": \"32\", "
+                    "\"extras\": [1, {\"cargo\": true}], \"cargo\": false }";
+  ASSERT_TRUE(parseJson(msg, params));
+
+  EXPECT_EQ("123", params.raw(0));
+  EXPECT_EQ("321", *params.getString(1));
+  EXPECT_EQ("MOVING_TO_LOADING_AREA", params.raw(2));
+  EXPECT_EQ("32", params.raw(3));
+  EXPECT_DOUBLE_EQ(38.9549716, *params.getDouble(4));
+  EXPECT_DOUBLE_EQ(-77.1496214, *params.getDouble(5));
+  EXPECT_DOUBLE_EQ(38.9554377, *params.getDouble(6));
+  EXPECT_DOUBLE_EQ(-77.1503421, *params.getDouble(7));
+  EXPECT_FALSE(*params.getBool(8));  // Values inside arrays are not recorded
+
+  msg = "{ \"cmv_id\": \"123\", \"operation\": \"PICKUP\" }";
+  ASSERT_TRUE(parseJson(msg, params));
+  EXPECT_TRUE(params.has(0));
+  EXPECT_FALSE(params.has(1));
+  EXPECT_FALSE(params.has(4));
+
+  EXPECT_FALSE(parseJson("{ \"cmv_id\": \"123\" ", params));
+  EXPECT_FALSE(parseJson("{ \"cmv_id\" \"123\" }", params));
+  EXPECT_FALSE(parseJson("cmv_id:123", params));
+  EXPECT_TRUE(parseJson(" {} ", params));
+
+  // Nesting is bounded so malformed input cannot exhaust the stack
+  EXPECT_TRUE(parseJson("{ \"a\": [[[1]]] }", params));
+  EXPECT_FALSE(parseJson("{ \"a\": " + std::string(100000, '[') + " }", params));
+  EXPECT_FALSE(parseJson("{ \"a\": " + std::string(20, '[') + std::string(20, ']') + " }", params));
+  std::string deep_objects;
+  for (int i = 0; i < 100000; i++)
+  {
+    deep_objects += "{\"a\": [";
+  }
+  EXPECT_FALSE(parseJson(deep_objects, params));
+}
+
+}  // namespace strategy_params
@@ -19,12 +19,14 @@
 
 
 #include <memory>
+#include <unordered_map>
 
 #include "carma_msgs/msg/system_alert.hpp"
 #include "ros2_lifecycle_manager/ros2_lifecycle_manager.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "carma_ros2_utils/carma_lifecycle_node.hpp"
 #include "subsystem_controllers/base_subsystem_controller/base_subsystem_controller_config.hpp"
+#include "subsystem_controllers/base_subsystem_controller/lifecycle_transition_scheduler.hpp"
 
 namespace subsystem_controllers
 {
@@ -35,6 +37,7 @@ namespace subsystem_controllers
    *  - Takes in a list of required nodes and a namespace
    *  - Manages the lifecycle of all nodes which are the union of the required nodes and the namespace
    *  - Monitors the system_alert topic and if a node within its required node set crashes it notifies the larger system that the subsystem has failed  
+   *  - Optionally configures and activates independent managed nodes concurrently, following the declared lifecycle_dependencies
    */ 
   class BaseSubsystemController : public carma_ros2_utils::CarmaLifecycleNode
   {
@@ -55,6 +58,11 @@ namespace subsystem_controllers
 
     virtual void on_system_alert(const carma_msgs::msg::SystemAlert::UniquePtr msg);
 
+    /**
+     * \brief Returns the per node results of the most recent parallel configure or activate transition
+     */
+    std::vector<NodeTransitionResult> get_last_transition_results() const;
+
     ////
     // Overrides
     ////
@@ -86,9 +94,35 @@ namespace subsystem_controllers
      */ 
     std::vector<std::string> get_non_intersecting_set(const std::vector<std::string>& set_a, const std::vector<std::string>& set_b) const;
 
+    /**
+     * \brief Transitions all managed nodes with bringup_scheduler_ and logs the latency of each node
+     * 
+     * \param transition_name Name of the transition used for logging
+     * \param transition Performs the transition using the lifecycle manager of a single node. Returns true on success
+     * 
+     * \return True if every managed node completed the transition
+     */ 
+    bool run_parallel_transition(const std::string& transition_name, 
+      const std::function<bool(ros2_lifecycle_manager::Ros2LifecycleManager&)>& transition);
+
     //! Lifecycle Manager which will track the managed nodes and call their lifecycle services on request
     ros2_lifecycle_manager::Ros2LifecycleManager lifecycle_mgr_;
 
+    //! The managed nodes in the order they were discovered, used for parallel bring-up
+    std::vector<std::string> bringup_nodes_;
+
+    //! The value of parallel_bringup when the subsystem was last configured. Activation uses the same mode
+    bool parallel_bringup_active_ = false;
+
+    //! Single node lifecycle managers used for parallel bring-up so concurrent transitions share no manager state
+    std::unordered_map<std::string, std::shared_ptr<ros2_lifecycle_manager::Ros2LifecycleManager>> node_lifecycle_mgrs_;
+
+    //! Orders and runs the concurrent transitions for parallel bring-up
+    LifecycleTransitionScheduler bringup_scheduler_;
+
+    //! Per node results of the most recent parallel transition
+    std::vector<NodeTransitionResult> last_transition_results_;
+
     //! The subscriber for the system alert topic
     rclcpp::Subscription<carma_msgs::msg::SystemAlert>::SharedPtr system_alert_sub_;
 
@@ -45,6 +45,16 @@ namespace subsystem_controllers
     //! If this flag is true then all nodes under subsystem_namespace are treated as required in addition to any nodes in required_subsystem_nodes
     bool full_subsystem_required = false;
 
+    //! If this flag is true then the configure and activate transitions of independent managed nodes are run concurrently
+    bool parallel_bringup = false;
+
+    //! Maximum number of managed node transitions in progress at once when parallel_bringup is true
+    int max_parallel_transitions = 8;
+
+    //! Bring-up ordering constraints as "<node>:<dependency>[,<dependency>...]" entries. 
+    //  A node ending in '*' applies to every managed node with that prefix. Only used when parallel_bringup is true
+    std::vector<std::string> lifecycle_dependencies;
+
     // Stream operator for this config
     friend std::ostream &operator<<(std::ostream &output, const BaseSubSystemControllerConfig &c)
     {
@@ -54,6 +64,8 @@ namespace subsystem_controllers
              << "call_timeout_ms: " << c.call_timeout_ms << std::endl
              << "subsystem_namespace: " << c.subsystem_namespace << std::endl
              << "full_subsystem_required: " << c.full_subsystem_required << std::endl
+             << "parallel_bringup: " << c.parallel_bringup << std::endl
+             << "max_parallel_transitions: " << c.max_parallel_transitions << std::endl
              << "unmanaged_required_nodes: [ " << std::endl;
             
             for (auto node : c.unmanaged_required_nodes)
@@ -64,6 +76,11 @@ namespace subsystem_controllers
       for (auto node : c.required_subsystem_nodes)
         output << node << " ";
 
+      output << "] " << std::endl << "lifecycle_dependencies: [ ";
+
+      for (auto dependency : c.lifecycle_dependencies)
+        output << dependency << " ";
+
       output << "] " << std::endl
              << "}" << std::endl;
       return output;
@@ -0,0 +1,101 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace subsystem_controllers
+{
+  /**
+   * \brief Result of transitioning a single node
+   */
+  struct NodeTransitionResult
+  {
+    //! Fully qualified node name
+    std::string node;
+
+    //! True if the transition function reported success
+    bool success = false;
+
+    //! True if the node was not transitioned because one of its dependencies failed
+    bool skipped = false;
+
+    //! Time taken by the transition function. Zero for skipped nodes
+    std::chrono::nanoseconds latency{0};
+  };
+
+  /**
+   * \brief Runs one lifecycle transition across a set of nodes, transitioning independent nodes concurrently
+   *
+   * Nodes may declare dependencies on other nodes. A node is only transitioned once all of its dependencies
+   * have completed their transition successfully. If a dependency fails then the dependent nodes are skipped
+   * and reported as failed. Dependencies on nodes which are not part of the transition are ignored.
+   *
+   * With max_concurrency set to 1 and no dependencies, nodes are transitioned one at a time in the order provided.
+   */
+  class LifecycleTransitionScheduler
+  {
+  public:
+    //! Transitions the named node and returns true on success. Called from worker threads
+    using TransitionFunction = std::function<bool(const std::string &)>;
+
+    /**
+     * \brief Sets the dependency graph
+     *
+     * \param dependencies Map of node name to the names of the nodes which must complete their transition before it
+     */
+    void set_dependencies(const std::unordered_map<std::string, std::vector<std::string>> &dependencies);
+
+    /**
+     * \brief Adds dependencies from a list of "<node>:<dependency>[,<dependency>...]" entries.
+     *        A node ending in '*' applies the dependencies to every node in all_nodes with the preceding prefix.
+     *
+     * \param entries The dependency entries. Empty entries are ignored
+     * \param all_nodes The nodes which wildcard entries are expanded against
+     *
+     * \throw std::invalid_argument if an entry is malformed
+     */
+    void add_dependencies(const std::vector<std::string> &entries, const std::vector<std::string> &all_nodes);
+
+    /**
+     * \brief Returns the dependencies of the provided node
+     */
+    std::vector<std::string> get_dependencies(const std::string &node) const;
+
+    /**
+     * \brief Transitions the provided nodes
+     *
+     * \param nodes The nodes to transition
+     * \param transition The function which performs the transition of a single node
+     * \param max_concurrency The maximum number of transitions which may be in progress at once. Values below 1 are treated as 1
+     *
+     * \throw std::invalid_argument if the dependencies between the provided nodes contain a cycle. No transitions are attempted in this case
+     *
+     * \return One result per node in the order the transitions completed
+     */
+    std::vector<NodeTransitionResult> run(const std::vector<std::string> &nodes, const TransitionFunction &transition,
+                                          int max_concurrency) const;
+
+  private:
+    std::unordered_map<std::string, std::vector<std::string>> dependencies_;
+  };
+
+} // namespace subsystem_controllers
@@ -14,6 +14,7 @@
  * the License.
  */
 
+#include <algorithm>
 #include <unordered_set>
 #include "subsystem_controllers/base_subsystem_controller/base_subsystem_controller.hpp"
 #include "subsystem_controllers/base_subsystem_controller/base_subsystem_controller_config.hpp"
@@ -35,6 +36,9 @@ namespace subsystem_controllers
     base_config_.subsystem_namespace = this->declare_parameter<std::string>("subsystem_namespace", base_config_.subsystem_namespace);
     base_config_.full_subsystem_required = this->declare_parameter<bool>("full_subsystem_required", base_config_.full_subsystem_required);
     base_config_.unmanaged_required_nodes = this->declare_parameter<std::vector<std::string>>("unmanaged_required_nodes", base_config_.unmanaged_required_nodes);
+    base_config_.parallel_bringup = this->declare_parameter<bool>("parallel_bringup", base_config_.parallel_bringup);
+    base_config_.max_parallel_transitions = this->declare_parameter<int>("max_parallel_transitions", base_config_.max_parallel_transitions);
+    base_config_.lifecycle_dependencies = this->declare_parameter<std::vector<std::string>>("lifecycle_dependencies", base_config_.lifecycle_dependencies);
   
     // Handle fact that parameter vectors cannot be empty
     if (base_config_.required_subsystem_nodes.size() == 1 && base_config_.required_subsystem_nodes[0].empty()) {
@@ -45,6 +49,10 @@ namespace subsystem_controllers
       base_config_.unmanaged_required_nodes.clear();
     }
 
+    if (base_config_.lifecycle_dependencies.size() == 1 && base_config_.lifecycle_dependencies[0].empty()) {
+      base_config_.lifecycle_dependencies.clear();
+    }
+
   }
 
   void BaseSubsystemController::set_config(BaseSubSystemControllerConfig config)
@@ -103,6 +111,9 @@ namespace subsystem_controllers
     get_parameter<std::string>("subsystem_namespace", base_config_.subsystem_namespace);
     get_parameter<bool>("full_subsystem_required", base_config_.full_subsystem_required);
     get_parameter<std::vector<std::string>>("unmanaged_required_nodes", base_config_.unmanaged_required_nodes);
+    get_parameter<bool>("parallel_bringup", base_config_.parallel_bringup);
+    get_parameter<int>("max_parallel_transitions", base_config_.max_parallel_transitions);
+    get_parameter<std::vector<std::string>>("lifecycle_dependencies", base_config_.lifecycle_dependencies);
 
     // Handle fact that parameter vectors cannot be empty
     if (base_config_.required_subsystem_nodes.size() == 1 && base_config_.required_subsystem_nodes[0].empty()) {
@@ -113,6 +124,10 @@ namespace subsystem_controllers
       base_config_.unmanaged_required_nodes.clear();
     }
 
+    if (base_config_.lifecycle_dependencies.size() == 1 && base_config_.lifecycle_dependencies[0].empty()) {
+      base_config_.lifecycle_dependencies.clear();
+    }
+
     RCLCPP_INFO_STREAM(get_logger(), "Loaded config: " << base_config_);
 
     // Create subscriptions
@@ -144,7 +159,44 @@ namespace subsystem_controllers
     
 
     // With all of our managed nodes now being tracked we can execute their configure operations
-    bool success = lifecycle_mgr_.configure(std_msec(base_config_.service_timeout_ms), std_msec(base_config_.call_timeout_ms)).empty();
+    bool success = false;
+
+    // The mode is latched so activation transitions the same nodes in the same way even if the parameter changes
+    parallel_bringup_active_ = base_config_.parallel_bringup;
+    bringup_nodes_.clear();
+    node_lifecycle_mgrs_.clear();
+
+    if (parallel_bringup_active_)
+    {
+      bringup_scheduler_ = LifecycleTransitionScheduler();
+      try
+      {
+        bringup_scheduler_.add_dependencies(base_config_.lifecycle_dependencies, managed_nodes);
+      }
+      catch (const std::invalid_argument &e)
+      {
+        RCLCPP_ERROR_STREAM(get_logger(), "Invalid lifecycle_dependencies: " << e.what());
+        return CallbackReturn::FAILURE;
+      }
+
+      // Each node gets its own manager so that concurrent transitions do not share any manager state
+      bringup_nodes_ = managed_nodes;
+      for (const auto &node : managed_nodes)
+      {
+        auto node_mgr = std::make_shared<ros2_lifecycle_manager::Ros2LifecycleManager>(
+          get_node_base_interface(), get_node_graph_interface(), get_node_logging_interface(), get_node_services_interface());
+        node_mgr->set_managed_nodes({ node });
+        node_lifecycle_mgrs_.emplace(node, node_mgr);
+      }
+
+      success = run_parallel_transition("configure", [this](ros2_lifecycle_manager::Ros2LifecycleManager &mgr) {
+        return mgr.configure(std_msec(base_config_.service_timeout_ms), std_msec(base_config_.call_timeout_ms)).empty();
+      });
+    }
+    else
+    {
+      success = lifecycle_mgr_.configure(std_msec(base_config_.service_timeout_ms), std_msec(base_config_.call_timeout_ms)).empty();
+    }
 
     if (success)
     {
@@ -164,7 +216,18 @@ namespace subsystem_controllers
   {
     RCLCPP_INFO_STREAM(get_logger(), "Subsystem trying to activate");
 
-    bool success = lifecycle_mgr_.activate(std_msec(base_config_.service_timeout_ms), std_msec(base_config_.call_timeout_ms)).empty();
+    bool success = false;
+
+    if (parallel_bringup_active_)
+    {
+      success = run_parallel_transition("activate", [this](ros2_lifecycle_manager::Ros2LifecycleManager &mgr) {
+        return mgr.activate(std_msec(base_config_.service_timeout_ms), std_msec(base_config_.call_timeout_ms)).empty();
+      });
+    }
+    else
+    {
+      success = lifecycle_mgr_.activate(std_msec(base_config_.service_timeout_ms), std_msec(base_config_.call_timeout_ms)).empty();
+    }
 
     if (success)
     {
@@ -260,6 +323,72 @@ namespace subsystem_controllers
     }
   }
 
+  std::vector<NodeTransitionResult> BaseSubsystemController::get_last_transition_results() const
+  {
+    return last_transition_results_;
+  }
+
+  bool BaseSubsystemController::run_parallel_transition(const std::string &transition_name, 
+    const std::function<bool(ros2_lifecycle_manager::Ros2LifecycleManager&)> &transition)
+  {
+    const auto &managed_nodes = bringup_nodes_;
+
+    auto start = std::chrono::steady_clock::now();
+
+    try
+    {
+      last_transition_results_ = bringup_scheduler_.run(managed_nodes, [this, &transition](const std::string &node) {
+        auto it = node_lifecycle_mgrs_.find(node);
+        if (it == node_lifecycle_mgrs_.end())
+          return false;
+
+        return transition(*(it->second));
+      }, base_config_.max_parallel_transitions);
+    }
+    catch (const std::invalid_argument &e)
+    {
+      RCLCPP_ERROR_STREAM(get_logger(), "Unable to " << transition_name << " subsystem: " << e.what());
+      return false;
+    }
+
+    auto total = std::chrono::steady_clock::now() - start;
+
+    // Report the slowest nodes first as they determine the bring-up time
+    std::vector<NodeTransitionResult> sorted_results = last_transition_results_;
+    std::sort(sorted_results.begin(), sorted_results.end(), 
+      [](const NodeTransitionResult &a, const NodeTransitionResult &b) { return a.latency > b.latency; });
+
+    bool success = true;
+    std::chrono::nanoseconds summed_latency(0);
+    for (const auto &result : sorted_results)
+    {
+      summed_latency += result.latency;
+
+      if (result.skipped)
+      {
+        success = false;
+        RCLCPP_ERROR_STREAM(get_logger(), "Skipped " << transition_name << " of node: " << result.node << " as one of its dependencies failed");
+      }
+      else if (!result.success)
+      {
+        success = false;
+        RCLCPP_ERROR_STREAM(get_logger(), "Failed to " << transition_name << " node: " << result.node << " after " 
+          << std::chrono::duration_cast<std_msec>(result.latency).count() << " ms");
+      }
+      else
+      {
+        RCLCPP_INFO_STREAM(get_logger(), "Node " << result.node << " " << transition_name << " latency: " 
+          << std::chrono::duration_cast<std_msec>(result.latency).count() << " ms");
+      }
+    }
+
+    RCLCPP_INFO_STREAM(get_logger(), "Parallel " << transition_name << " of " << managed_nodes.size() << " nodes took " 
+      << std::chrono::duration_cast<std_msec>(total).count() << " ms. Sequential sum of node latencies: " 
+      << std::chrono::duration_cast<std_msec>(summed_latency).count() << " ms");
+
+    return success;
+  }
+
   std::vector<std::string> BaseSubsystemController::get_nodes_in_namespace(const std::string &node_namespace) const
   {
 
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <boost/algorithm/string.hpp>
+#include "subsystem_controllers/base_subsystem_controller/lifecycle_transition_scheduler.hpp"
+
+namespace subsystem_controllers
+{
+  void LifecycleTransitionScheduler::set_dependencies(const std::unordered_map<std::string, std::vector<std::string>> &dependencies)
+  {
+    dependencies_ = dependencies;
+  }
+
+  void LifecycleTransitionScheduler::add_dependencies(const std::vector<std::string> &entries, const std::vector<std::string> &all_nodes)
+  {
+    for (const auto &entry : entries)
+    {
+      std::string trimmed = boost::algorithm::trim_copy(entry);
+      if (trimmed.empty())
+        continue;
+
+      size_t separator = trimmed.find(':');
+      if (separator == std::string::npos || separator == 0 || separator == trimmed.size() - 1)
+      {
+        throw std::invalid_argument("Lifecycle dependency entry must have the form <node>:<dependency>[,<dependency>...] but was: " + entry);
+      }
+
+      std::string node = boost::algorithm::trim_copy(trimmed.substr(0, separator));
+
+      std::string dependency_list = trimmed.substr(separator + 1);
+      std::vector<std::string> dependencies;
+      boost::split(dependencies, dependency_list, boost::is_any_of(","));
+      for (auto &dependency : dependencies)
+      {
+        boost::algorithm::trim(dependency);
+      }
+      dependencies.erase(std::remove(dependencies.begin(), dependencies.end(), ""), dependencies.end());
+
+      std::vector<std::string> targets;
+      if (node.back() == '*')
+      {
+        std::string prefix = node.substr(0, node.size() - 1);
+        for (const auto &candidate : all_nodes)
+        {
+          if (candidate.find(prefix) == 0)
+            targets.push_back(candidate);
+        }
+      }
+      else
+      {
+        targets.push_back(node);
+      }
+
+      for (const auto &target : targets)
+      {
+        auto &target_dependencies = dependencies_[target];
+        for (const auto &dependency : dependencies)
+        {
+          // A wildcard may match one of its own dependencies, which must not depend on itself
+          if (dependency != target && std::find(target_dependencies.begin(), target_dependencies.end(), dependency) == target_dependencies.end())
+            target_dependencies.push_back(dependency);
+        }
+      }
+    }
+  }
+
+  std::vector<std::string> LifecycleTransitionScheduler::get_dependencies(const std::string &node) const
+  {
+    auto it = dependencies_.find(node);
+    if (it == dependencies_.end())
+      return {};
+
+    return it->second;
+  }
+
+  std::vector<NodeTransitionResult> LifecycleTransitionScheduler::run(const std::vector<std::string> &nodes, const TransitionFunction &transition,
+                                                                      int max_concurrency) const
+  {
+    // Build the dependency graph restricted to the provided nodes
+    std::vector<std::string> names;
+    names.reserve(nodes.size());
+    std::unordered_map<std::string, size_t> index;
+    for (const auto &node : nodes)
+    {
+      if (index.emplace(node, names.size()).second)
+        names.push_back(node);
+    }
+
+    const size_t count = names.size();
+    std::vector<std::vector<size_t>> dependents(count);
+    std::vector<size_t> waiting_on(count, 0);
+
+    for (size_t i = 0; i < count; i++)
+    {
+      for (const auto &dependency : get_dependencies(names[i]))
+      {
+        auto it = index.find(dependency);
+        if (it == index.end())
+          continue; // Not part of this transition
+
+        dependents[it->second].push_back(i);
+        waiting_on[i]++;
+      }
+    }
+
+    // Reject cycles up front so no node is left half transitioned
+    {
+      std::vector<size_t> remaining = waiting_on;
+      std::vector<size_t> stack;
+      for (size_t i = 0; i < count; i++)
+      {
+        if (remaining[i] == 0)
+          stack.push_back(i);
+      }
+
+      size_t visited = 0;
+      while (!stack.empty())
+      {
+        size_t i = stack.back();
+        stack.pop_back();
+        visited++;
+        for (size_t d : dependents[i])
+        {
+          if (--remaining[d] == 0)
+            stack.push_back(d);
+        }
+      }
+
+      if (visited != count)
+      {
+        throw std::invalid_argument("Lifecycle dependencies contain a cycle");
+      }
+    }
+
+    enum class NodeState { WAITING, RUNNING, DONE };
+    std::vector<NodeState> states(count, NodeState::WAITING);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<size_t> ready;
+    std::vector<NodeTransitionResult> results;
+    results.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+      if (waiting_on[i] == 0)
+        ready.push_back(i);
+    }
+
+    // Must be called with the mutex held
+    auto skip_dependents = [&](size_t failed) {
+      std::vector<size_t> stack(dependents[failed].begin(), dependents[failed].end());
+      while (!stack.empty())
+      {
+        size_t i = stack.back();
+        stack.pop_back();
+        if (states[i] != NodeState::WAITING)
+          continue;
+
+        states[i] = NodeState::DONE;
+        NodeTransitionResult result;
+        result.node = names[i];
+        result.skipped = true;
+        results.push_back(result);
+        stack.insert(stack.end(), dependents[i].begin(), dependents[i].end());
+      }
+    };
+
+    auto worker = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true)
+      {
+        cv.wait(lock, [&]() { return !ready.empty() || results.size() == count; });
+        if (ready.empty())
+          return; // All nodes are done
+
+        size_t i = ready.front();
+        ready.pop_front();
+        states[i] = NodeState::RUNNING;
+        lock.unlock();
+
+        NodeTransitionResult result;
+        result.node = names[i];
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+          result.success = transition(names[i]);
+        }
+        catch (...)
+        {
+          result.success = false;
+        }
+        result.latency = std::chrono::steady_clock::now() - start;
+
+        lock.lock();
+        states[i] = NodeState::DONE;
+        results.push_back(result);
+
+        if (result.success)
+        {
+          for (size_t d : dependents[i])
+          {
+            if (--waiting_on[d] == 0 && states[d] == NodeState::WAITING)
+              ready.push_back(d);
+          }
+        }
+        else
+        {
+          skip_dependents(i);
+        }
+
+        cv.notify_all();
+      }
+    };
+
+    size_t thread_count = std::min<size_t>(std::max(1, max_concurrency), std::max<size_t>(1, count));
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t t = 1; t < thread_count; t++)
+    {
+      threads.emplace_back(worker);
+    }
+    worker(); // The calling thread also performs transitions
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    return results;
+  }
+
+} // namespace subsystem_controllers
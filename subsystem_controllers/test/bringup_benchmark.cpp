@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+/**
+ * Multi-node bring-up harness for the BaseSubsystemController.
+ *
+ * Starts a number of lifecycle nodes, each of which sleeps for a fixed time in on_configure and on_activate
+ * to stand in for map loading, TF lookups and similar start up work. The same controller then brings
+ * them up sequentially and with parallel_bringup enabled and the total configure + activate time of each mode is printed.
+ *
+ * Run from the build directory with: build/subsystem_controllers/test/bringup_benchmark [node_count] [transition_delay_ms] [max_parallel_transitions]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "carma_ros2_utils/carma_lifecycle_node.hpp"
+#include "subsystem_controllers/base_subsystem_controller/base_subsystem_controller.hpp"
+
+namespace
+{
+  const std::string BENCHMARK_NAMESPACE = "/bringup_benchmark";
+
+  // Lifecycle node whose transitions take a fixed amount of time
+  class SlowLifecycleNode : public carma_ros2_utils::CarmaLifecycleNode
+  {
+  public:
+    SlowLifecycleNode(const rclcpp::NodeOptions &options, std::chrono::milliseconds delay)
+        : CarmaLifecycleNode(options), delay_(delay) {}
+
+    carma_ros2_utils::CallbackReturn handle_on_configure(const rclcpp_lifecycle::State &) override
+    {
+      std::this_thread::sleep_for(delay_);
+      return CallbackReturn::SUCCESS;
+    }
+
+    carma_ros2_utils::CallbackReturn handle_on_activate(const rclcpp_lifecycle::State &) override
+    {
+      std::this_thread::sleep_for(delay_);
+      return CallbackReturn::SUCCESS;
+    }
+
+  private:
+    std::chrono::milliseconds delay_;
+  };
+
+  rclcpp::NodeOptions options_for(const std::string &name)
+  {
+    rclcpp::NodeOptions options;
+    options.arguments({ "--ros-args", "-r", "__node:=" + name, "-r", "__ns:=" + BENCHMARK_NAMESPACE });
+    return options;
+  }
+
+  // Runs configure and activate on the controller and returns the elapsed time, or a negative value on failure
+  double bring_up(const std::shared_ptr<subsystem_controllers::BaseSubsystemController> &controller)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    if (controller->configure().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE)
+      return -1;
+
+    if (controller->activate().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE)
+      return -1;
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  // Returns the controller and its managed nodes to the unconfigured state
+  void tear_down(const std::shared_ptr<subsystem_controllers::BaseSubsystemController> &controller)
+  {
+    controller->deactivate();
+    controller->cleanup();
+  }
+}
+
+int main(int argc, char **argv)
+{
+  rclcpp::init(argc, argv);
+
+  auto args = rclcpp::remove_ros_arguments(argc, argv);
+  int node_count = args.size() > 1 ? std::stoi(args[1]) : 24;
+  std::chrono::milliseconds delay(args.size() > 2 ? std::stoi(args[2]) : 50);
+  int max_parallel = args.size() > 3 ? std::stoi(args[3]) : 8;
+
+  rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(), std::max(4, max_parallel + 2));
+
+  std::vector<std::shared_ptr<SlowLifecycleNode>> nodes;
+  std::vector<std::string> node_names;
+  for (int i = 0; i < node_count; i++)
+  {
+    std::string name = "node_" + std::to_string(i);
+    nodes.push_back(std::make_shared<SlowLifecycleNode>(options_for(name), delay));
+    node_names.push_back(BENCHMARK_NAMESPACE + "/" + name);
+    executor.add_node(nodes.back()->get_node_base_interface());
+  }
+
+  auto controller = std::make_shared<subsystem_controllers::BaseSubsystemController>(options_for("bringup_benchmark_controller"));
+  controller->set_parameter(rclcpp::Parameter("subsystem_namespace", BENCHMARK_NAMESPACE));
+  controller->set_parameter(rclcpp::Parameter("service_timeout_ms", 2000));
+  controller->set_parameter(rclcpp::Parameter("call_timeout_ms", static_cast<int>(delay.count()) * 10 + 1000));
+  controller->set_parameter(rclcpp::Parameter("max_parallel_transitions", max_parallel));
+  // The first node stands in for the world model which every other node depends on
+  controller->set_parameter(rclcpp::Parameter("lifecycle_dependencies",
+    std::vector<std::string>{ BENCHMARK_NAMESPACE + "/node_*:" + node_names.front() }));
+  executor.add_node(controller->get_node_base_interface());
+
+  std::thread spin_thread([&executor]() { executor.spin(); });
+
+  // Wait for the graph to report every node so that all are discovered by the controller
+  auto discovery_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (std::chrono::steady_clock::now() < discovery_deadline)
+  {
+    auto names = controller->get_node_names();
+    size_t found = std::count_if(node_names.begin(), node_names.end(),
+      [&names](const std::string &name) { return std::find(names.begin(), names.end(), name) != names.end(); });
+    if (found == node_names.size())
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  std::cout << "Bring-up of " << node_count << " nodes with " << delay.count() << " ms per transition" << std::endl;
+
+  controller->set_parameter(rclcpp::Parameter("parallel_bringup", false));
+  double sequential_ms = bring_up(controller);
+  std::cout << "sequential: " << sequential_ms << " ms" << std::endl;
+  tear_down(controller);
+
+  controller->set_parameter(rclcpp::Parameter("parallel_bringup", true));
+  double parallel_ms = bring_up(controller);
+  std::cout << "parallel (" << max_parallel << " at once, world model first): " << parallel_ms << " ms" << std::endl;
+
+  std::chrono::nanoseconds slowest(0);
+  for (const auto &result : controller->get_last_transition_results())
+    slowest = std::max(slowest, result.latency);
+  std::cout << "slowest activate: " << std::chrono::duration<double, std::milli>(slowest).count() << " ms" << std::endl;
+
+  tear_down(controller);
+
+  executor.cancel();
+  spin_thread.join();
+  rclcpp::shutdown();
+
+  return 0;
+}
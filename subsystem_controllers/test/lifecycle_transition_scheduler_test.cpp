@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <subsystem_controllers/base_subsystem_controller/lifecycle_transition_scheduler.hpp>
+
+namespace subsystem_controllers
+{
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  //! Start and end time of a mock transition
+  struct Interval
+  {
+    Clock::time_point start;
+    Clock::time_point end;
+  };
+
+  //! Mock transition which records when it ran for each node
+  class RecordingTransition
+  {
+  public:
+    explicit RecordingTransition(std::chrono::milliseconds duration) : duration_(duration) {}
+
+    bool operator()(const std::string& node)
+    {
+      Interval interval;
+      interval.start = Clock::now();
+      std::this_thread::sleep_for(duration_);
+      interval.end = Clock::now();
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      intervals_[node] = interval;
+      return true;
+    }
+
+    std::map<std::string, Interval> intervals() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return intervals_;
+    }
+
+  private:
+    std::chrono::milliseconds duration_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Interval> intervals_;
+  };
+
+  //! Greatest number of the intervals in progress at the same time
+  size_t max_overlap(const std::map<std::string, Interval>& intervals)
+  {
+    size_t max = 0;
+    for (const auto& a : intervals)
+    {
+      size_t overlap = 0;
+      for (const auto& b : intervals)
+      {
+        if (b.second.start <= a.second.start && a.second.start < b.second.end)
+          overlap++;
+      }
+      max = std::max(max, overlap);
+    }
+    return max;
+  }
+
+  const NodeTransitionResult& find_result(const std::vector<NodeTransitionResult>& results, const std::string& node)
+  {
+    auto it = std::find_if(results.begin(), results.end(), [&](const NodeTransitionResult& r) { return r.node == node; });
+    if (it == results.end())
+      throw std::runtime_error("Missing result for " + node);
+    return *it;
+  }
+}
+
+TEST(LifecycleTransitionScheduler, sequentialWithoutDependencies)
+{
+  LifecycleTransitionScheduler scheduler;
+  std::vector<std::string> order;
+
+  auto results = scheduler.run({ "/a", "/b", "/c" }, [&](const std::string& node) {
+    order.push_back(node);
+    return true;
+  }, 1);
+
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ(std::vector<std::string>({ "/a", "/b", "/c" }), order);
+  for (const auto& result : results)
+  {
+    EXPECT_TRUE(result.success);
+    EXPECT_FALSE(result.skipped);
+  }
+}
+
+TEST(LifecycleTransitionScheduler, dependenciesAreRespected)
+{
+  LifecycleTransitionScheduler scheduler;
+  std::vector<std::string> all_nodes = { "/guidance/plugins/a", "/guidance/plugins/b", "/environment/world_model", "/guidance/arbitrator" };
+  scheduler.add_dependencies({ "/guidance/plugins/*: /environment/world_model", "/guidance/arbitrator:/guidance/plugins/a,/guidance/plugins/b", "" },
+                             all_nodes);
+
+  EXPECT_EQ(std::vector<std::string>({ "/environment/world_model" }), scheduler.get_dependencies("/guidance/plugins/b"));
+
+  RecordingTransition transition(std::chrono::milliseconds(5));
+  auto results = scheduler.run(all_nodes, std::ref(transition), 4);
+
+  auto intervals = transition.intervals();
+  ASSERT_EQ(4u, intervals.size());
+  EXPECT_EQ(4u, results.size());
+
+  // Each node starts only after its dependencies have finished
+  const auto& world_model = intervals.at("/environment/world_model");
+  const auto& plugin_a = intervals.at("/guidance/plugins/a");
+  const auto& plugin_b = intervals.at("/guidance/plugins/b");
+  const auto& arbitrator = intervals.at("/guidance/arbitrator");
+  EXPECT_LE(world_model.end, plugin_a.start);
+  EXPECT_LE(world_model.end, plugin_b.start);
+  EXPECT_LE(plugin_a.end, arbitrator.start);
+  EXPECT_LE(plugin_b.end, arbitrator.start);
+}
+
+TEST(LifecycleTransitionScheduler, independentNodesRunConcurrently)
+{
+  LifecycleTransitionScheduler scheduler;
+  std::vector<std::string> nodes;
+  for (int i = 0; i < 8; i++)
+    nodes.push_back("/node_" + std::to_string(i));
+
+  RecordingTransition transition(std::chrono::milliseconds(50));
+  auto results = scheduler.run(nodes, std::ref(transition), 4);
+
+  // Concurrency is checked from the recorded intervals rather than the total time so the test does not depend on load
+  auto intervals = transition.intervals();
+  EXPECT_EQ(8u, results.size());
+  ASSERT_EQ(8u, intervals.size());
+  EXPECT_LE(max_overlap(intervals), 4u);
+  EXPECT_GE(max_overlap(intervals), 2u);
+
+  for (const auto& result : results)
+  {
+    EXPECT_GE(result.latency, std::chrono::milliseconds(50));
+  }
+}
+
+TEST(LifecycleTransitionScheduler, failedDependencySkipsDependents)
+{
+  LifecycleTransitionScheduler scheduler;
+  scheduler.set_dependencies({ { "/b", { "/a" } }, { "/c", { "/b" } }, { "/d", { "/unmanaged" } } });
+
+  std::vector<std::string> attempted;
+  auto results = scheduler.run({ "/a", "/b", "/c", "/d" }, [&](const std::string& node) {
+    attempted.push_back(node);
+    if (node == "/a")
+      throw std::runtime_error("Service call failed");
+    return true;
+  }, 1);
+
+  ASSERT_EQ(4u, results.size());
+  EXPECT_EQ(std::vector<std::string>({ "/a", "/d" }), attempted);
+
+  EXPECT_FALSE(find_result(results, "/a").success);
+  EXPECT_FALSE(find_result(results, "/a").skipped);
+  EXPECT_TRUE(find_result(results, "/b").skipped);
+  EXPECT_TRUE(find_result(results, "/c").skipped);
+  EXPECT_FALSE(find_result(results, "/c").success);
+  EXPECT_TRUE(find_result(results, "/d").success); // Dependencies outside the transition are ignored
+}
+
+TEST(LifecycleTransitionScheduler, cyclesAreRejected)
+{
+  LifecycleTransitionScheduler scheduler;
+  scheduler.set_dependencies({ { "/a", { "/b" } }, { "/b", { "/a" } } });
+
+  bool called = false;
+  EXPECT_THROW(scheduler.run({ "/a", "/b", "/c" }, [&](const std::string&) { called = true; return true; }, 2), std::invalid_argument);
+  EXPECT_FALSE(called);
+
+  EXPECT_THROW(scheduler.add_dependencies({ "/a" }, {}), std::invalid_argument);
+  EXPECT_THROW(scheduler.add_dependencies({ ":/a" }, {}), std::invalid_argument);
+}
+
+} // namespace subsystem_controllers
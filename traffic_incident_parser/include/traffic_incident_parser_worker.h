@@ -28,6 +28,7 @@
 #include <iostream>
 #include <string>
 #include <cstring>
+#include <strategy_params_parser/strategy_params.h>
 #include <vector>
 #include <algorithm>
 #include <sstream>
@@ -66,20 +67,13 @@ class TrafficIncidentParserWorker
   */
   void mobilityOperationCallback(const cav_msgs::MobilityOperation &mobility_msg);
 
-    /*! \fn mobilityMessageParser(std::string mobility_strategy_params)
+    /*! \fn mobilityMessageParser(const std::string& mobility_strategy_params)
     \brief mobilityMessageParser helps to parse incoming mobility operation message to required format
     \param  std::string mobility_strategy_params
 
     \return True if the new message is valid and can be used. False if not new or not valid.
   */
-  bool mobilityMessageParser(std::string mobility_strategy_params);
-
-    /*! \fn stringParserHelper(std::string str,int str_index)
-    \brief stringParserHelper helps to convert string to double data type.
-    \param  std::string to convert from str to double
-    \param  unsigned long idx to start looking at 
-  */
-  std::string stringParserHelper(std::string str, unsigned long str_index) const;
+  bool mobilityMessageParser(const std::string& mobility_strategy_params);
   
     /*! \fn composeTrafficControlMesssage()
     \brief composeTrafficControlMesssage algorithm for extracting the closed lanelet from internally saved mobility message (or geofence) params and assign it to trafic contol message. 
@@ -136,6 +130,10 @@ class TrafficIncidentParserWorker
   std::string projection_msg_;
   PublishTrafficControlCallback traffic_control_pub_;// local copy of external object publihsers
   carma_wm::WorldModelConstPtr wm_;
+
+  //! Schema and reused storage for parsing incident strategy params
+  static const strategy_params::Schema incident_params_schema_;
+  strategy_params::ParsedParams incident_params_{ incident_params_schema_ };
   
   /**
    * Queue which stores the current set of geofence messages to forward to any new connections
@@ -26,6 +26,9 @@
 namespace traffic
 {
 
+  // Incident params are positional so no keys are declared in the schema
+  const strategy_params::Schema TrafficIncidentParserWorker::incident_params_schema_({});
+
   TrafficIncidentParserWorker::TrafficIncidentParserWorker(carma_wm::WorldModelConstPtr wm,const PublishTrafficControlCallback &traffic_control_pub) : traffic_control_pub_(traffic_control_pub),wm_(wm){}
 
   void TrafficIncidentParserWorker::mobilityOperationCallback(const cav_msgs::MobilityOperation &mobility_msg)
@@ -61,51 +64,45 @@ namespace traffic
    }
 
 
-  bool TrafficIncidentParserWorker::mobilityMessageParser(std::string mobility_strategy_params)
+  bool TrafficIncidentParserWorker::mobilityMessageParser(const std::string& mobility_strategy_params)
   {
+    strategy_params::ParsedParams& params = incident_params_;
+    strategy_params::parseKeyValue(mobility_strategy_params, params);
 
-   std::vector<std::string> vec={};
-   std::string delimiter = ",";
-   size_t pos = 0;
-   std::string token;
-    while ((pos = mobility_strategy_params.find(delimiter)) != std::string::npos) 
-    {
-        token = mobility_strategy_params.substr(0, pos);
-        vec.push_back(token);
-        mobility_strategy_params.erase(0, pos + delimiter.length());
-    }
-    vec.push_back(mobility_strategy_params);
-
-    if (vec.size() != 8) 
+    if (params.fieldCount() != 8) 
     {
       ROS_ERROR_STREAM("Given mobility strategy params are not correctly formatted.");
       return false;
     }  
 
-    std::string lat_str=vec[0];
-    std::string lon_str=vec[1];
-    std::string downtrack_str=vec[2];
-    std::string uptrack_str=vec[3];
-    std::string min_gap_str=vec[4];
-    std::string speed_advisory_str=vec[5];
-    std::string event_reason_str=vec[6];
-    std::string event_type_str=vec[7];
-
     // Evaluate if this message should be forwarded based on the gps point
-    double temp_lat = stod(stringParserHelper(lat_str,lat_str.find_last_of("lat:")));
-    double temp_lon = stod(stringParserHelper(lon_str,lon_str.find_last_of("lon:")));
+    auto lat = strategy_params::toDouble(params.field(0).value);
+    auto lon = strategy_params::toDouble(params.field(1).value);
+    auto down_track_value = strategy_params::toDouble(params.field(2).value);
+    auto up_track_value = strategy_params::toDouble(params.field(3).value);
+    auto min_gap_value = strategy_params::toDouble(params.field(4).value);
+    auto speed_advisory_value = strategy_params::toDouble(params.field(5).value);
+
+    if (!lat || !lon || !down_track_value || !up_track_value || !min_gap_value || !speed_advisory_value)
+    {
+      ROS_ERROR_STREAM("Given mobility strategy params contain non numeric values: " << mobility_strategy_params);
+      return false;
+    }
+
+    double temp_lat = *lat;
+    double temp_lon = *lon;
     
     double constexpr APPROXIMATE_DEG_PER_5M = 0.00005;
     double delta_lat = temp_lat - latitude;
     double delta_lon = temp_lon - longitude;
     double approximate_degree_delta = sqrt(delta_lat*delta_lat + delta_lon*delta_lon);
     
-    double temp_down_track=stod(stringParserHelper(downtrack_str,downtrack_str.find_last_of("down_track:")));
-    double temp_up_track=stod(stringParserHelper(uptrack_str,uptrack_str.find_last_of("up_track:")));
-    double temp_min_gap=stod(stringParserHelper(min_gap_str,min_gap_str.find_last_of("min_gap:")));
-    double temp_speed_advisory=stod(stringParserHelper(speed_advisory_str,speed_advisory_str.find_last_of("advisory_speed:")));
-    std::string temp_event_reason=stringParserHelper(event_reason_str,event_reason_str.find_last_of("event_reason:"));
-    std::string temp_event_type=stringParserHelper(event_type_str,event_type_str.find_last_of("event_type:"));
+    double temp_down_track = *down_track_value;
+    double temp_up_track = *up_track_value;
+    double temp_min_gap = *min_gap_value;
+    double temp_speed_advisory = *speed_advisory_value;
+    strategy_params::string_view temp_event_reason = params.field(6).value;
+    strategy_params::string_view temp_event_type = params.field(7).value;
 
     if ( approximate_degree_delta < APPROXIMATE_DEG_PER_5M // If the vehicle has not moved more than 5m and the parameters remain unchanged
       && temp_down_track == down_track 
@@ -130,22 +127,12 @@ namespace traffic
     up_track = temp_up_track;
     min_gap = temp_min_gap;
     speed_advisory = temp_speed_advisory;
-    event_reason = temp_event_reason;
-    event_type = temp_event_type;
+    event_reason = temp_event_reason.to_string();
+    event_type = temp_event_type.to_string();
     
     return true;
   }
 
-  std::string TrafficIncidentParserWorker::stringParserHelper(std::string str, unsigned long str_index) const
-  {
-    std::string str_temp="";
-    for(int i=str_index+1;i<str.length();i++)
-    {
-        str_temp+=str[i];
-    }
-    return str_temp;
-  }
-
  lanelet::BasicPoint2d TrafficIncidentParserWorker::getIncidentOriginPoint() const
   {
     lanelet::projection::LocalFrameProjector projector(projection_msg_.c_str());
@@ -28,6 +28,7 @@
 #include <ros/publisher.h>
 #include <carma_utils/CARMAUtils.h>
 #include <ros/callback_queue.h>
+#include "trajectory_executor/trajectory_handoff.hpp"
 
 namespace trajectory_executor {
 
@@ -115,10 +116,15 @@ namespace trajectory_executor {
             ros::Subscriber _state_sub; // Guidance State subscriber
             std::map<std::string, ros::Publisher> _traj_publisher_map; // Outbound plan publishers
 
-            // Trajectory plan tracking data. Synchronized on _cur_traj_mutex
-            std::unique_ptr<cav_msgs::TrajectoryPlan> _cur_traj; 
-            int _timesteps_since_last_traj {0};
-            std::mutex _cur_traj_mutex;
+            /*!
+             * \brief Resolve the control plugin and its publisher for the first point of a trajectory
+             */
+            void resolveControlPlugin(ActiveTrajectory& traj);
+
+            // Trajectory plan tracking data. Handed from the message callbacks to the emit timer without locking
+            TrajectoryHandoff<ActiveTrajectory> _cur_traj;
+            // Serializes the message callbacks which write to _cur_traj. Never taken by the emit timer
+            std::mutex _writer_mutex;
             std::string default_control_plugin_;
             std::string default_control_plugin_topic_;
 
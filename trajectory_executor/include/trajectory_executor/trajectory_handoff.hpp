@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __TRAJECTORY_HANDOFF_HPP__
+#define __TRAJECTORY_HANDOFF_HPP__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <ros/publisher.h>
+#include <cav_msgs/TrajectoryPlan.h>
+
+namespace trajectory_executor {
+
+    /**
+     * Lock-free handoff of the latest value from a single writer thread to a single reader thread.
+     *
+     * The writer fills back() and calls publish(). The reader calls update() and then reads front().
+     * Neither side ever waits on the other. Three slots are used so that a slot being read is never
+     * the one being written, while the writer can still replace a published value the reader has
+     * not picked up yet. Slot contents are reused, so once their buffers have grown no further
+     * allocation occurs.
+     */
+    template <typename T>
+    class TrajectoryHandoff {
+        public:
+            TrajectoryHandoff() : _middle(MIDDLE_INIT) { }
+
+            /*!
+             * \brief The slot the writer may fill. Only valid on the writer thread.
+             */
+            T& back() { return _slots[_back]; }
+
+            /*!
+             * \brief Make the contents of back() available to the reader
+             */
+            void publish() {
+                uint8_t prev = _middle.exchange(_back | DIRTY_BIT, std::memory_order_acq_rel);
+                _back = prev & INDEX_MASK;
+            }
+
+            /*!
+             * \brief Swap the most recently published value into front() if there is one.
+             * Only valid on the reader thread.
+             *
+             * \return True if front() now holds a newly published value
+             */
+            bool update() {
+                if (!(_middle.load(std::memory_order_acquire) & DIRTY_BIT)) {
+                    return false;
+                }
+                uint8_t prev = _middle.exchange(_front, std::memory_order_acq_rel);
+                _front = prev & INDEX_MASK;
+                return true;
+            }
+
+            /*!
+             * \brief The slot the reader may use. Only valid on the reader thread.
+             */
+            T& front() { return _slots[_front]; }
+
+        private:
+            static constexpr uint8_t INDEX_MASK = 0x3;
+            static constexpr uint8_t DIRTY_BIT = 0x4;
+            static constexpr uint8_t MIDDLE_INIT = 2;
+
+            std::array<T, 3> _slots;
+            std::atomic<uint8_t> _middle;
+            uint8_t _back {0}; // Owned by writer
+            uint8_t _front {1}; // Owned by reader
+    };
+
+    /**
+     * The trajectory currently being executed along with data resolved once when it was received
+     */
+    struct ActiveTrajectory {
+        // False if there is no trajectory to execute, such as after guidance disengages
+        bool valid {false};
+        cav_msgs::TrajectoryPlan plan;
+        // Control plugin resolved from the first trajectory point
+        std::string control_plugin;
+        // Publisher of the control plugin or nullptr if no match was found
+        ros::Publisher* publisher {nullptr};
+        // Number of ticks this trajectory has been emitted for. Advanced by the reader instead of consuming points
+        int cursor {0};
+    };
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "trajectory_executor/trajectory_handoff.hpp"
+
+using trajectory_executor::TrajectoryHandoff;
+
+/*!
+ * \brief Test that the reader only ever sees the latest published value
+ */
+TEST(TrajectoryHandoffTest, test_latest_value) {
+    TrajectoryHandoff<int> handoff;
+    ASSERT_FALSE(handoff.update());
+
+    handoff.back() = 1;
+    handoff.publish();
+    handoff.back() = 2;
+    handoff.publish();
+
+    ASSERT_TRUE(handoff.update());
+    ASSERT_EQ(2, handoff.front());
+    ASSERT_FALSE(handoff.update());
+    ASSERT_EQ(2, handoff.front()); // Front is kept until a new value is published
+}
+
+/*!
+ * \brief Test that a concurrent reader never observes a partially written value
+ */
+TEST(TrajectoryHandoffTest, test_concurrent_handoff) {
+    TrajectoryHandoff<std::vector<long>> handoff;
+    const long num_values = 100000;
+
+    std::thread writer([&]() {
+        for (long i = 1; i <= num_values; i++) {
+            handoff.back().assign(64, i);
+            handoff.publish();
+        }
+    });
+
+    long last = 0;
+    while (last < num_values) {
+        if (handoff.update()) {
+            const std::vector<long>& values = handoff.front();
+            for (long v : values) {
+                ASSERT_EQ(values[0], v);
+            }
+            ASSERT_GE(values[0], last);
+            last = values[0];
+        }
+    }
+    writer.join();
+}
+
+/*!
+ * \brief Main entrypoint for unit tests
+ */
+int main (int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -24,11 +24,9 @@ namespace trajectory_executor
 {
 
     TrajectoryExecutor::TrajectoryExecutor(int traj_frequency) :
-        _timesteps_since_last_traj(0),
         _min_traj_publish_tickrate_hz(traj_frequency) { }
 
     TrajectoryExecutor::TrajectoryExecutor() :
-        _timesteps_since_last_traj(0),
         _min_traj_publish_tickrate_hz(10) { }
 
     std::map<std::string, std::string> TrajectoryExecutor::queryControlPlugins()
@@ -52,56 +50,81 @@ namespace trajectory_executor
         return out;
     }
     
+    void TrajectoryExecutor::resolveControlPlugin(ActiveTrajectory& traj)
+    {
+        traj.control_plugin.clear();
+        traj.publisher = nullptr;
+
+        if (traj.plan.trajectory_points.empty()) {
+            return;
+        }
+
+        // Determine the relevant control plugin for this trajectory
+        traj.control_plugin = traj.plan.trajectory_points[0].controller_plugin_name;
+        // if it instructed to use default control_plugin
+        if (traj.control_plugin == "default" || traj.control_plugin == "")
+            traj.control_plugin = default_control_plugin_;
+
+        // The publisher map is not modified after init so this pointer remains valid
+        std::map<std::string, ros::Publisher>::iterator it = _traj_publisher_map.find(traj.control_plugin);
+        if (it != _traj_publisher_map.end()) {
+            traj.publisher = &it->second;
+        }
+    }
+
     void TrajectoryExecutor::onNewTrajectoryPlan(const cav_msgs::TrajectoryPlan& msg)
     {
-        std::unique_lock<std::mutex> lock(_cur_traj_mutex); // Acquire lock until end of this function scope
+        std::lock_guard<std::mutex> lock(_writer_mutex);
         ROS_DEBUG("Received new trajectory plan!");
         ROS_DEBUG_STREAM("New Trajectory plan ID: " << msg.trajectory_id);
         ROS_DEBUG_STREAM("New plan contains " << msg.trajectory_points.size() << " points");
 
-        _cur_traj = std::unique_ptr<cav_msgs::TrajectoryPlan>(new cav_msgs::TrajectoryPlan(msg));
-        _timesteps_since_last_traj = 0;
+        // Copy into the spare slot. Its storage is reused so this does not allocate once the slot has grown
+        ActiveTrajectory& next = _cur_traj.back();
+        next.plan = msg;
+        next.valid = true;
+        next.cursor = 0;
+        resolveControlPlugin(next);
+        _cur_traj.publish();
         ROS_DEBUG_STREAM("Successfully swapped trajectories!");
     }
 
     void TrajectoryExecutor::guidanceStateMonitor(const cav_msgs::GuidanceStateConstPtr& msg)
     {
-        std::unique_lock<std::mutex> lock(_cur_traj_mutex); // Acquire lock until end of this function scope
+        std::lock_guard<std::mutex> lock(_writer_mutex);
         // TODO need to handle control handover once alernative planner system is finished
         if(msg->state != cav_msgs::GuidanceState::ENGAGED)
         {
-        	_cur_traj= nullptr;
+            ActiveTrajectory& next = _cur_traj.back();
+            next.valid = false;
+            next.cursor = 0;
+            _cur_traj.publish();
         }
     }
 
     void TrajectoryExecutor::onTrajEmitTick(const ros::TimerEvent& te)
     {
-        std::unique_lock<std::mutex> lock(_cur_traj_mutex);
         ROS_DEBUG("TrajectoryExecutor tick start!");
 
-        if (_cur_traj != nullptr) {
-            if (!_cur_traj->trajectory_points.empty()) {
-                // Determine the relevant control plugin for the current timestep
-                std::string control_plugin = _cur_traj->trajectory_points[0].controller_plugin_name;
-                // if it instructed to use default control_plugin
-                if (control_plugin == "default" || control_plugin =="")
-                    control_plugin = default_control_plugin_;
+        _cur_traj.update();
+        ActiveTrajectory& cur_traj = _cur_traj.front();
 
-                std::map<std::string, ros::Publisher>::iterator it = _traj_publisher_map.find(control_plugin);
-                if (it != _traj_publisher_map.end()) {
+        if (cur_traj.valid) {
+            if (!cur_traj.plan.trajectory_points.empty()) {
+                if (cur_traj.publisher != nullptr) {
                     ROS_DEBUG("Found match for control plugin %s at point %d in current trajectory!",
-                        control_plugin.c_str(),
-                        _timesteps_since_last_traj);
-                    it->second.publish(*_cur_traj);
+                        cur_traj.control_plugin.c_str(),
+                        cur_traj.cursor);
+                    cur_traj.publisher->publish(cur_traj.plan);
                 } else {
                     std::ostringstream description_builder;
                     description_builder << "No match found for control plugin " 
-                        << control_plugin << " at point " 
-                        << _timesteps_since_last_traj << " in current trajectory!";
+                        << cur_traj.control_plugin << " at point " 
+                        << cur_traj.cursor << " in current trajectory!";
 
                     throw std::invalid_argument(description_builder.str());
                 }
-                _timesteps_since_last_traj++;
+                cur_traj.cursor++;
             } else {
                 throw std::out_of_range("Ran out of trajectory data to consume!");
             }
@@ -139,7 +162,6 @@ namespace trajectory_executor
         this->_plan_sub = this->_public_nh->subscribe<const cav_msgs::TrajectoryPlan&>("trajectory", 5, &TrajectoryExecutor::onNewTrajectoryPlan, this);
         this->_state_sub = this->_public_nh->subscribe<cav_msgs::GuidanceState>("state", 5, &TrajectoryExecutor::guidanceStateMonitor, this);
 
-        this->_cur_traj = std::unique_ptr<cav_msgs::TrajectoryPlan>();
         ROS_DEBUG("Subscribed to inbound trajectory plans.");
 
         ROS_DEBUG("Setting up publishers for control plugin topics...");